@@ -25,6 +25,7 @@ inline void Errors::PopContext() {
 }
 
 inline void Errors::OnError(Location loc, string_view message) {
+  error_count_++;
   HandleOnError(loc, message);
 }
 
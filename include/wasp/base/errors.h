@@ -31,10 +31,17 @@ class Errors {
 
   virtual bool HasError() const = 0;
 
+  // The number of calls to OnError so far, so a caller can tell whether a
+  // particular step reported an error even if an earlier one already did.
+  size_t error_count() const { return error_count_; }
+
  protected:
   virtual void HandlePushContext(Location loc, string_view desc) = 0;
   virtual void HandlePopContext() = 0;
   virtual void HandleOnError(Location loc, string_view message) = 0;
+
+ private:
+  size_t error_count_ = 0;
 };
 
 }  // namespace wasp
@@ -0,0 +1,82 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BASE_ERRORS_BUFFER_H_
+#define WASP_BASE_ERRORS_BUFFER_H_
+
+#include <string>
+#include <vector>
+
+#include "wasp/base/errors.h"
+
+namespace wasp {
+
+// Records errors (with their contexts), so they can be replayed to another
+// Errors object later. This is useful when work is done in parallel, but the
+// errors should be reported in a deterministic order. Contexts are only
+// recorded if an error occurs inside them, so the buffer stays empty if there
+// are no errors.
+class ErrorsBuffer : public Errors {
+ public:
+  bool HasError() const override { return !errors_.empty(); }
+
+  void ReplayTo(Errors& errors) const {
+    for (auto&& error : errors_) {
+      for (auto&& context : error.contexts) {
+        errors.PushContext(context.loc, context.desc);
+      }
+      errors.OnError(error.loc, error.message);
+      for (size_t i = 0; i < error.contexts.size(); ++i) {
+        errors.PopContext();
+      }
+    }
+  }
+
+  void Clear() {
+    context_stack_.clear();
+    errors_.clear();
+  }
+
+ protected:
+  void HandlePushContext(Location loc, string_view desc) override {
+    context_stack_.push_back(Context{loc, std::string(desc)});
+  }
+
+  void HandlePopContext() override { context_stack_.pop_back(); }
+
+  void HandleOnError(Location loc, string_view message) override {
+    errors_.push_back(Error{context_stack_, loc, std::string(message)});
+  }
+
+ private:
+  struct Context {
+    Location loc;
+    std::string desc;
+  };
+
+  struct Error {
+    std::vector<Context> contexts;
+    Location loc;
+    std::string message;
+  };
+
+  std::vector<Context> context_stack_;
+  std::vector<Error> errors_;
+};
+
+}  // namespace wasp
+
+#endif // WASP_BASE_ERRORS_BUFFER_H_
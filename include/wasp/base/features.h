@@ -46,6 +46,9 @@ class Features {
   explicit Features();
   explicit Features(Bits);
 
+  // Returns the given bits, with the bits of the features they depend on.
+  static constexpr Bits AddDependencies(Bits);
+
   void EnableAll();
 
   bool HasFeatures(Features features) const {
@@ -83,6 +86,47 @@ class Features {
   Bits bits_ = 0;
 };
 
+// static
+constexpr Features::Bits Features::AddDependencies(Bits bits) {
+  if (bits & GC) {
+    bits |= FunctionReferences;
+  }
+  if (bits & (FunctionReferences | Exceptions)) {
+    bits |= ReferenceTypes;
+  }
+  if (bits & (ReferenceTypes | Memory64)) {
+    bits |= BulkMemory;
+  }
+  return bits;
+}
+
+// The bits of a default-constructed Features, and of one after EnableAll().
+constexpr Features::Bits kDefaultFeatureBits = Features::AddDependencies(0
+#define WASP_V(enum_, variable, flag, default_) \
+  | (default_ ? Features::enum_ : 0)
+#include "wasp/base/features.inc"
+#undef WASP_V
+);
+
+constexpr Features::Bits kAllFeatureBits = Features::AddDependencies(0
+#define WASP_V(enum_, variable, flag, default_) \
+  | Features::enum_
+#include "wasp/base/features.inc"
+#undef WASP_V
+);
+
+// A set of features that is known at compile time. It has the same queries as
+// Features, so code that is templated on its features can be instantiated for
+// a fixed set, where the feature checks fold away.
+template <Features::Bits kBits>
+struct FixedFeatures {
+  static constexpr Features::Bits bits() { return kBits; }
+
+#define WASP_V(enum_, variable, flag, default_) \
+  static constexpr bool variable##_enabled() { return kBits & Features::enum_; }
+#include "wasp/base/features.inc"
+#undef WASP_V
+};
 
 }  // namespace wasp
 
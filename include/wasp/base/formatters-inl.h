@@ -69,8 +69,8 @@ std::ostream& operator<<(std::ostream& os, const ::std::array<T, N>& self) {
   return os << "]";
 }
 
-template <typename T>
-std::ostream& operator<<(std::ostream& os, const ::std::vector<T>& self) {
+template <typename T, typename A>
+std::ostream& operator<<(std::ostream& os, const ::std::vector<T, A>& self) {
   return os << ::wasp::MakeSpan(self);
 }
 
@@ -65,9 +65,9 @@ std::ostream& operator<<(std::ostream&, ::wasp::SpanU8);
 template <typename T, size_t N>
 std::ostream& operator<<(std::ostream&, const ::std::array<T, N>&);
 
-// std::vector<T>
-template <typename T>
-std::ostream& operator<<(std::ostream&, const ::std::vector<T>&);
+// std::vector<T, A>
+template <typename T, typename A>
+std::ostream& operator<<(std::ostream&, const ::std::vector<T, A>&);
 
 // variant<Ts...>
 template <typename... Ts>
@@ -0,0 +1,59 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/base/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace wasp {
+
+template <typename F>
+void ParallelFor(size_t item_count, u32 thread_count, F&& func) {
+  thread_count = static_cast<u32>(
+      std::min<size_t>(std::max<u32>(thread_count, 1), item_count));
+  if (thread_count <= 1) {
+    for (size_t i = 0; i < item_count; ++i) {
+      func(u32{0}, i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next{0};
+  auto worker = [&](u32 thread_index) {
+    for (;;) {
+      size_t i = next.fetch_add(1, std::memory_order_relaxed);
+      if (i >= item_count) {
+        break;
+      }
+      func(thread_index, i);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count - 1);
+  for (u32 t = 1; t < thread_count; ++t) {
+    threads.emplace_back(worker, t);
+  }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace wasp
@@ -0,0 +1,43 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BASE_PARALLEL_H_
+#define WASP_BASE_PARALLEL_H_
+
+#include <cstddef>
+
+#include "wasp/base/types.h"
+
+namespace wasp {
+
+// Returns `count` if it is non-zero, otherwise the number of hardware threads
+// available (at least 1).
+u32 GetThreadCount(u32 count = 0);
+
+// Calls `func(thread_index, item_index)` once for every item in
+// [0, item_count), using at most `thread_count` threads. Items are handed out
+// in increasing order, but may complete in any order. `thread_index` is in
+// [0, thread_count), and can be used to select per-thread state. If
+// `thread_count` is 1 (or there is only one item), everything runs on the
+// calling thread.
+template <typename F>
+void ParallelFor(size_t item_count, u32 thread_count, F&& func);
+
+}  // namespace wasp
+
+#include "wasp/base/parallel-inl.h"
+
+#endif  // WASP_BASE_PARALLEL_H_
@@ -0,0 +1,60 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BASE_RESOURCE_LIMITS_H_
+#define WASP_BASE_RESOURCE_LIMITS_H_
+
+#include <limits>
+
+#include "wasp/base/types.h"
+
+namespace wasp {
+
+// Limits on the work done and memory allocated when reading and validating a
+// module, for modules that come from an untrusted source. Exceeding a limit is
+// reported as an error, the same way as a malformed or invalid module.
+//
+// By default, nothing is limited beyond what the binary format allows. The
+// limits that web embeddings use are a reasonable starting point for
+// untrusted modules: https://webassembly.github.io/spec/js-api/#limits
+struct ResourceLimits {
+  static constexpr Index kNoIndexLimit = std::numeric_limits<Index>::max();
+
+  // The number of functions. The binary reader counts the functions defined
+  // in the function section; the validator counts imported functions too.
+  Index max_functions = kNoIndexLimit;
+
+  // The number of locals in a function, including its parameters and any
+  // locals bound by `let`.
+  Index max_locals = kNoIndexLimit;
+
+  // The number of blocks (block, loop, if, try and let) that can be open at
+  // once in a function.
+  Index max_block_depth = kNoIndexLimit;
+
+  // The number of targets of a br_table instruction, not including the
+  // default target.
+  Index max_br_table_targets = kNoIndexLimit;
+
+  // The total size, in bytes, of the vectors that the binary reader allocates
+  // for the module (e.g. locals, br_table targets, type lists and segment
+  // initializers).
+  u64 max_allocated_bytes = std::numeric_limits<u64>::max();
+};
+
+}  // namespace wasp
+
+#endif  // WASP_BASE_RESOURCE_LIMITS_H_
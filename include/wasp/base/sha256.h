@@ -0,0 +1,58 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BASE_SHA256_H_
+#define WASP_BASE_SHA256_H_
+
+#include <array>
+
+#include "wasp/base/span.h"
+#include "wasp/base/types.h"
+
+namespace wasp {
+
+// Computes a SHA-256 digest incrementally. Unlike absl::Hash, the digest is
+// the same in every process, and it is infeasible to find two inputs with the
+// same digest, so it can be used to identify data by its contents (e.g. as a
+// key in an on-disk cache).
+class Sha256 {
+ public:
+  using Digest = std::array<u8, 32>;
+
+  Sha256();
+
+  void Update(SpanU8 data);
+  // Appends `value` as 8 little-endian bytes.
+  void Update(u64 value);
+
+  // Returns the digest of all the data passed to Update. The object can't be
+  // updated afterward, but a copy made before can.
+  Digest Finish();
+
+  static Digest Hash(SpanU8 data);
+
+ private:
+  void ProcessBlock(const u8* block);
+
+  std::array<u32, 8> state_;
+  std::array<u8, 64> buffer_;
+  size_t buffer_size_ = 0;
+  u64 length_ = 0;  // In bytes.
+};
+
+}  // namespace wasp
+
+#endif  // WASP_BASE_SHA256_H_
@@ -0,0 +1,226 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <cassert>
+
+namespace wasp::binary::visit {
+
+template <typename... Visitors>
+ComposedVisitor<Visitors...>::ComposedVisitor(Visitors&... visitors)
+    : visitors_{visitors...} {}
+
+template <typename... Visitors>
+Result ComposedVisitor<Visitors...>::result(size_t index) const {
+  assert(index < kCount);
+  return states_[index].module;
+}
+
+// static
+template <typename... Visitors>
+bool ComposedVisitor<Visitors...>::IsActive(const State& state, Scope scope) {
+  switch (scope) {
+    case Scope::Module:
+      return state.module == Result::Ok;
+    case Scope::Section:
+      return state.module == Result::Ok && state.in_section;
+    case Scope::Code:
+      return state.module == Result::Ok && state.in_section && state.in_code;
+  }
+  return false;
+}
+
+// static
+template <typename... Visitors>
+void ComposedVisitor<Visitors...>::SetInScope(State& state,
+                                              Scope scope,
+                                              bool value) {
+  switch (scope) {
+    case Scope::Module:
+      // The module scope is handled by BeginModule.
+      assert(false);
+      break;
+    case Scope::Section:
+      state.in_section = value;
+      break;
+    case Scope::Code:
+      state.in_code = value;
+      break;
+  }
+}
+
+template <typename... Visitors>
+Result ComposedVisitor<Visitors...>::Summarize(Scope scope) const {
+  bool all_failed = true;
+  bool any_active = false;
+  for (auto&& state : states_) {
+    all_failed &= state.module == Result::Fail;
+    any_active |= IsActive(state, scope);
+  }
+  if (all_failed) {
+    return Result::Fail;
+  }
+  return any_active ? Result::Ok : Result::Skip;
+}
+
+template <typename... Visitors>
+template <typename F>
+void ComposedVisitor<Visitors...>::ForEach(F&& func) {
+  ForEach(std::forward<F>(func), std::index_sequence_for<Visitors...>{});
+}
+
+template <typename... Visitors>
+template <typename F, size_t... Is>
+void ComposedVisitor<Visitors...>::ForEach(F&& func,
+                                           std::index_sequence<Is...>) {
+  (func(states_[Is], std::get<Is>(visitors_)), ...);
+}
+
+template <typename... Visitors>
+template <typename F>
+Result ComposedVisitor<Visitors...>::Begin(Scope outer, Scope inner, F&& func) {
+  ForEach([&](State& state, auto& visitor) {
+    bool in_scope = false;
+    if (IsActive(state, outer)) {
+      Result result = func(visitor);
+      if (result == Result::Fail) {
+        state.module = Result::Fail;
+      }
+      in_scope = result == Result::Ok;
+    }
+    SetInScope(state, inner, in_scope);
+  });
+  return Summarize(inner);
+}
+
+template <typename... Visitors>
+template <typename F>
+Result ComposedVisitor<Visitors...>::Call(Scope scope, F&& func) {
+  ForEach([&](State& state, auto& visitor) {
+    if (IsActive(state, scope) && func(visitor) == Result::Fail) {
+      state.module = Result::Fail;
+    }
+  });
+  return Summarize(Scope::Module) == Result::Fail ? Result::Fail : Result::Ok;
+}
+
+template <typename... Visitors>
+Result ComposedVisitor<Visitors...>::BeginModule(LazyModule& module) {
+  ctx_ = &module.ctx;
+  ForEach([&](State& state, auto& visitor) {
+    state = State{};
+    state.module = visitor.BeginModule(module);
+  });
+  return Summarize(Scope::Module);
+}
+
+template <typename... Visitors>
+Result ComposedVisitor<Visitors...>::EndModule(LazyModule& module) {
+  ForEach([&](State& state, auto& visitor) {
+    if (IsActive(state, Scope::Module)) {
+      state.module = visitor.EndModule(module);
+    }
+  });
+  return Summarize(Scope::Module);
+}
+
+template <typename... Visitors>
+Result ComposedVisitor<Visitors...>::OnSection(At<Section> section) {
+  return Begin(Scope::Module, Scope::Section,
+               [&](auto& visitor) { return visitor.OnSection(section); });
+}
+
+#define WASP_COMPOSED_SECTION(Name, SectionType, ItemType)               \
+  template <typename... Visitors>                                        \
+  Result ComposedVisitor<Visitors...>::Begin##Name##Section(             \
+      SectionType section) {                                             \
+    return Begin(Scope::Section, Scope::Section, [&](auto& visitor) {    \
+      return visitor.Begin##Name##Section(section);                      \
+    });                                                                  \
+  }                                                                      \
+                                                                         \
+  template <typename... Visitors>                                        \
+  Result ComposedVisitor<Visitors...>::On##Name(const At<ItemType>& item) { \
+    return Call(Scope::Section,                                          \
+                [&](auto& visitor) { return visitor.On##Name(item); });  \
+  }                                                                      \
+                                                                         \
+  template <typename... Visitors>                                        \
+  Result ComposedVisitor<Visitors...>::End##Name##Section(               \
+      SectionType section) {                                             \
+    return Call(Scope::Section, [&](auto& visitor) {                     \
+      return visitor.End##Name##Section(section);                        \
+    });                                                                  \
+  }
+
+WASP_COMPOSED_SECTION(Type, LazyTypeSection, DefinedType)
+WASP_COMPOSED_SECTION(Import, LazyImportSection, Import)
+WASP_COMPOSED_SECTION(Function, LazyFunctionSection, Function)
+WASP_COMPOSED_SECTION(Table, LazyTableSection, Table)
+WASP_COMPOSED_SECTION(Memory, LazyMemorySection, Memory)
+WASP_COMPOSED_SECTION(Global, LazyGlobalSection, Global)
+WASP_COMPOSED_SECTION(Event, LazyEventSection, Event)
+WASP_COMPOSED_SECTION(Export, LazyExportSection, Export)
+WASP_COMPOSED_SECTION(Start, StartSection, Start)
+WASP_COMPOSED_SECTION(Element, LazyElementSection, ElementSegment)
+WASP_COMPOSED_SECTION(DataCount, DataCountSection, DataCount)
+WASP_COMPOSED_SECTION(Data, LazyDataSection, DataSegment)
+
+#undef WASP_COMPOSED_SECTION
+
+template <typename... Visitors>
+Result ComposedVisitor<Visitors...>::BeginCodeSection(LazyCodeSection section) {
+  return Begin(Scope::Section, Scope::Section, [&](auto& visitor) {
+    return visitor.BeginCodeSection(section);
+  });
+}
+
+template <typename... Visitors>
+Result ComposedVisitor<Visitors...>::BeginCode(const At<CodeView>& code) {
+  assert(ctx_);
+  code_callbacks_.emplace(code, *ctx_);
+  return Begin(Scope::Section, Scope::Code,
+               [&](auto& visitor) { return code_callbacks_->Begin(visitor); });
+}
+
+template <typename... Visitors>
+Result ComposedVisitor<Visitors...>::OnInstruction(
+    const At<Instruction>& instr) {
+  return Call(Scope::Code,
+              [&](auto& visitor) { return visitor.OnInstruction(instr); });
+}
+
+template <typename... Visitors>
+Result ComposedVisitor<Visitors...>::EndCode(const At<CodeView>&) {
+  assert(code_callbacks_);
+  auto result = Call(Scope::Code, [&](auto& visitor) {
+    return code_callbacks_->End(visitor);
+  });
+  code_callbacks_.reset();
+  return result;
+}
+
+template <typename... Visitors>
+Result ComposedVisitor<Visitors...>::EndCodeSection(LazyCodeSection section) {
+  return Call(Scope::Section,
+              [&](auto& visitor) { return visitor.EndCodeSection(section); });
+}
+
+template <typename... Visitors>
+auto Compose(Visitors&... visitors) -> ComposedVisitor<Visitors...> {
+  return ComposedVisitor<Visitors...>{visitors...};
+}
+
+}  // namespace wasp::binary::visit
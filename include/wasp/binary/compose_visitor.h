@@ -0,0 +1,170 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BINARY_COMPOSE_VISITOR_H_
+#define WASP_BINARY_COMPOSE_VISITOR_H_
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "wasp/base/optional.h"
+#include "wasp/binary/visitor.h"
+
+namespace wasp::binary::visit {
+
+// A visitor that forwards every callback to several visitors, so they can all
+// run in a single pass over the module; each section, item and instruction is
+// decoded only once.
+//
+// Each visitor behaves as if it were visited on its own:
+//  * If a visitor returns Skip from BeginModule, OnSection, Begin*Section or
+//    BeginCode, it receives no further callbacks for that module, section or
+//    code. The composed visitor only returns Skip (so the contents aren't
+//    decoded at all) if no visitor wants them.
+//  * If a visitor returns Fail, it receives no further callbacks. The composed
+//    visitor only returns Fail (stopping the visit) once every visitor has
+//    failed.
+//
+// Since the result of Visit() only summarizes all visitors, use result() to
+// get the result of each one.
+//
+//   ValidateVisitor validate{...};
+//   CallGraphVisitor call_graph{...};
+//   auto composed = visit::Compose(validate, call_graph);
+//   visit::Visit(module, composed);
+//   if (composed.result(0) == visit::Result::Ok) { ... }
+//
+template <typename... Visitors>
+class ComposedVisitor {
+ public:
+  static constexpr size_t kCount = sizeof...(Visitors);
+
+  explicit ComposedVisitor(Visitors&... visitors);
+
+  // The result of the given visitor for the last visited module: Fail if it
+  // failed at any point, Skip if it skipped the module, and otherwise the
+  // result of its EndModule.
+  Result result(size_t index) const;
+
+  Result BeginModule(LazyModule&);
+  Result EndModule(LazyModule&);
+  Result OnSection(At<Section>);
+
+  Result BeginTypeSection(LazyTypeSection);
+  Result OnType(const At<DefinedType>&);
+  Result EndTypeSection(LazyTypeSection);
+
+  Result BeginImportSection(LazyImportSection);
+  Result OnImport(const At<Import>&);
+  Result EndImportSection(LazyImportSection);
+
+  Result BeginFunctionSection(LazyFunctionSection);
+  Result OnFunction(const At<Function>&);
+  Result EndFunctionSection(LazyFunctionSection);
+
+  Result BeginTableSection(LazyTableSection);
+  Result OnTable(const At<Table>&);
+  Result EndTableSection(LazyTableSection);
+
+  Result BeginMemorySection(LazyMemorySection);
+  Result OnMemory(const At<Memory>&);
+  Result EndMemorySection(LazyMemorySection);
+
+  Result BeginGlobalSection(LazyGlobalSection);
+  Result OnGlobal(const At<Global>&);
+  Result EndGlobalSection(LazyGlobalSection);
+
+  Result BeginEventSection(LazyEventSection);
+  Result OnEvent(const At<Event>&);
+  Result EndEventSection(LazyEventSection);
+
+  Result BeginExportSection(LazyExportSection);
+  Result OnExport(const At<Export>&);
+  Result EndExportSection(LazyExportSection);
+
+  Result BeginStartSection(StartSection);
+  Result OnStart(const At<Start>&);
+  Result EndStartSection(StartSection);
+
+  Result BeginElementSection(LazyElementSection);
+  Result OnElement(const At<ElementSegment>&);
+  Result EndElementSection(LazyElementSection);
+
+  Result BeginDataCountSection(DataCountSection);
+  Result OnDataCount(const At<DataCount>&);
+  Result EndDataCountSection(DataCountSection);
+
+  Result BeginCodeSection(LazyCodeSection);
+  Result BeginCode(const At<CodeView>&);
+  Result OnInstruction(const At<Instruction>&);
+  Result EndCode(const At<CodeView>&);
+  Result EndCodeSection(LazyCodeSection);
+
+  Result BeginDataSection(LazyDataSection);
+  Result OnData(const At<DataSegment>&);
+  Result EndDataSection(LazyDataSection);
+
+ private:
+  // How deeply nested a callback is; a visitor only receives a callback if it
+  // hasn't skipped any of the enclosing scopes.
+  enum class Scope { Module, Section, Code };
+
+  struct State {
+    Result module = Result::Skip;  // Result of the module as a whole.
+    bool in_section = false;
+    bool in_code = false;
+  };
+
+  static bool IsActive(const State&, Scope);
+  static void SetInScope(State&, Scope, bool);
+
+  // Returns Fail if all visitors have failed, Ok if any visitor is active in
+  // `scope`, and Skip otherwise.
+  Result Summarize(Scope) const;
+
+  // Calls `func(state, visitor)` for each visitor, in order.
+  template <typename F>
+  void ForEach(F&& func);
+  template <typename F, size_t... Is>
+  void ForEach(F&& func, std::index_sequence<Is...>);
+
+  // Used for callbacks that begin a new scope (e.g. BeginCode), where Skip
+  // means that the visitor is not interested in the scope's contents.
+  template <typename F>
+  Result Begin(Scope outer, Scope inner, F&& func);
+
+  // Used for all other callbacks, where Skip has no meaning.
+  template <typename F>
+  Result Call(Scope, F&& func);
+
+  std::tuple<Visitors&...> visitors_;
+  std::array<State, kCount> states_;
+  // The context of the module being visited, used to build the Code for
+  // visitors that don't take a CodeView.
+  ReadCtx* ctx_ = nullptr;
+  optional<CodeCallbacks> code_callbacks_;
+};
+
+template <typename... Visitors>
+auto Compose(Visitors&... visitors) -> ComposedVisitor<Visitors...>;
+
+}  // namespace wasp::binary::visit
+
+#include "wasp/binary/compose_visitor-inl.h"
+
+#endif  // WASP_BINARY_COMPOSE_VISITOR_H_
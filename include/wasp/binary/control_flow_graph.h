@@ -0,0 +1,90 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BINARY_CONTROL_FLOW_GRAPH_H_
+#define WASP_BINARY_CONTROL_FLOW_GRAPH_H_
+
+#include <vector>
+
+#include "wasp/base/span.h"
+#include "wasp/base/types.h"
+#include "wasp/binary/types.h"
+
+namespace wasp::binary {
+
+struct ReadCtx;
+
+using BasicBlockId = u32;
+constexpr BasicBlockId kInvalidBasicBlockId = ~0u;
+
+// The range of bytes of a function body (relative to the start of the body)
+// that belong to a basic block.
+struct BasicBlock {
+  u32 begin;
+  u32 end;
+};
+
+enum class ControlFlowEdgeKind : u8 {
+  Unconditional,  // Fallthrough or br.
+  True,           // Taken by br_if, or the `then` branch of if.
+  False,          // Not taken by br_if, or the `else` branch of if.
+  Case,           // br_table target `case_index`.
+  Default,        // br_table default target.
+};
+
+struct ControlFlowEdge {
+  // kInvalidBasicBlockId if this edge leaves the function.
+  BasicBlockId target;
+  ControlFlowEdgeKind kind;
+  Index case_index;  // Only used when `kind` is Case.
+};
+
+// The control-flow graph of a function body. Each basic block is a range of
+// instructions that are executed in order. Blocks that contain only
+// structural instructions (block, else, end and br) are removed, and edges to
+// them are forwarded to the next block, so every block holds some code.
+//
+// The successors of block `i` are
+// `edges[edge_offsets[i]..edge_offsets[i + 1])`, in the order the branches
+// appear in the body.
+struct ControlFlowGraph {
+  span<const ControlFlowEdge> successors(BasicBlockId id) const {
+    return span<const ControlFlowEdge>{edges.data() + edge_offsets[id],
+                                       edge_offsets[id + 1] - edge_offsets[id]};
+  }
+
+  // The bytes of the block, given the body the graph was built from.
+  SpanU8 code(SpanU8 body, BasicBlockId id) const {
+    return body.subspan(blocks[id].begin, blocks[id].end - blocks[id].begin);
+  }
+
+  // kInvalidBasicBlockId if the function has no code.
+  BasicBlockId start = kInvalidBasicBlockId;
+  std::vector<BasicBlock> blocks;
+  std::vector<u32> edge_offsets;  // blocks.size() + 1 entries.
+  std::vector<ControlFlowEdge> edges;
+};
+
+// Builds the control-flow graph of a function body. Only `ctx` is modified, so
+// the graphs of several functions can be built at once if each has its own
+// ReadCtx. Branches with an invalid depth are reported to `ctx.errors` and
+// ignored.
+auto BuildControlFlowGraph(const Code&, ReadCtx&) -> ControlFlowGraph;
+auto BuildControlFlowGraph(SpanU8 body, ReadCtx&) -> ControlFlowGraph;
+
+}  // namespace wasp::binary
+
+#endif  // WASP_BINARY_CONTROL_FLOW_GRAPH_H_
@@ -0,0 +1,44 @@
+//
+// Copyright 2018 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BINARY_LAZY_LOCALS_H_
+#define WASP_BINARY_LAZY_LOCALS_H_
+
+#include "wasp/base/at.h"
+#include "wasp/base/optional.h"
+#include "wasp/binary/lazy_section.h"
+#include "wasp/binary/types.h"
+
+namespace wasp::binary {
+
+struct ReadCtx;
+
+/// ---
+using LazyLocals = LazySection<Locals>;
+
+// Reads the locals of a CodeView as they are iterated. They were already
+// checked when the view was read, and this restarts ctx.local_count, so
+// iterate them at most once, before the instructions of the body.
+LazyLocals ReadLocals(const CodeView&, ReadCtx&);
+
+// Builds the Code for a view, decoding its locals into a vector. Since the
+// locals were already checked, this only fails if the vector would exceed
+// ctx.limits.max_allocated_bytes.
+OptAt<Code> ToCode(const At<CodeView>&, ReadCtx&);
+
+}  // namespace wasp::binary
+
+#endif  // WASP_BINARY_LAZY_LOCALS_H_
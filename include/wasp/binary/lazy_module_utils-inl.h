@@ -29,7 +29,7 @@ void ForEachFunctionName(LazyModule& module, F&& f) {
   LazyModule copy{module.data, module.ctx.features, errors};
 
   Index imported_function_count = 0;
-  for (auto section : module.sections) {
+  for (auto section : copy.sections) {
     if (section->is_known()) {
       auto known = section->known();
       switch (known->id) {
@@ -31,6 +31,11 @@ template <typename T>
 class LazySection {
  public:
   explicit LazySection(SpanU8, string_view name, ReadCtx&);
+  // Used when the count has already been read; `data` holds the items.
+  explicit LazySection(OptAt<Index> count,
+                       SpanU8 data,
+                       string_view name,
+                       ReadCtx&);
 
   OptAt<Index> count;
   LazySequence<T> sequence;
@@ -40,6 +45,13 @@ template <typename T>
 LazySection<T>::LazySection(SpanU8 data, string_view name, ReadCtx& ctx)
     : count{ReadCount(&data, ctx)}, sequence{data, count, name, ctx} {}
 
+template <typename T>
+LazySection<T>::LazySection(OptAt<Index> count,
+                            SpanU8 data,
+                            string_view name,
+                            ReadCtx& ctx)
+    : count{count}, sequence{data, count, name, ctx} {}
+
 }  // namespace wasp::binary
 
 #endif // WASP_BINARY_LAZY_SECTION_H_
@@ -75,6 +75,11 @@ class LazySequence : public LazySequenceBase {
   const_iterator cbegin() const { return begin(); }
   const_iterator cend() const { return end(); }
 
+  SpanU8 data() const { return data_; }
+  ReadCtx& ctx() const { return ctx_; }
+  string_view name() const { return name_; }
+  optional<Index> expected_count() const { return expected_count_; }
+
  private:
   template <typename Sequence>
   friend class LazySequenceIterator;
@@ -0,0 +1,162 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BINARY_PACKED_INSTRUCTION_LIST_H_
+#define WASP_BINARY_PACKED_INSTRUCTION_LIST_H_
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "wasp/base/types.h"
+#include "wasp/base/v128.h"
+#include "wasp/base/wasm_types.h"
+#include "wasp/binary/types.h"
+
+namespace wasp::binary {
+
+// A list of instructions that is much smaller than InstructionList, for
+// holding materialized function bodies.
+//
+// Each instruction is a fixed-size record holding its opcode, its immediate
+// kind and up to 8 bytes of immediate. Immediates that don't fit (br_table
+// targets, select types, v128 constants and shuffles) are stored out of line
+// in per-list pools, and the rare immediates with nested structure (let, the
+// GC immediates, and block types that are reference types) are stored as whole
+// Instructions. Locations are not kept.
+//
+// Instructions are unpacked when they are accessed, so operator[] and the
+// iterators return an Instruction by value. The opcode and kind can be read
+// without unpacking.
+class PackedInstructionList {
+ public:
+  struct Record {
+    Opcode opcode;
+    u8 kind;  // InstructionKind.
+    u32 lo;
+    u32 hi;
+  };
+
+  class const_iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = Instruction;
+    using reference = Instruction;
+    using pointer = void;
+
+    const_iterator() = default;
+
+    Instruction operator*() const { return (*list_)[index_]; }
+    Instruction operator[](difference_type n) const {
+      return (*list_)[index_ + n];
+    }
+
+    const_iterator& operator++() { ++index_; return *this; }
+    const_iterator operator++(int) { auto tmp = *this; ++index_; return tmp; }
+    const_iterator& operator--() { --index_; return *this; }
+    const_iterator operator--(int) { auto tmp = *this; --index_; return tmp; }
+    const_iterator& operator+=(difference_type n) { index_ += n; return *this; }
+    const_iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+
+    friend const_iterator operator+(const_iterator it, difference_type n) {
+      return it += n;
+    }
+    friend const_iterator operator+(difference_type n, const_iterator it) {
+      return it += n;
+    }
+    friend const_iterator operator-(const_iterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const_iterator lhs, const_iterator rhs) {
+      return static_cast<difference_type>(lhs.index_) -
+             static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const_iterator lhs, const_iterator rhs) {
+      return lhs.index_ == rhs.index_;
+    }
+    friend bool operator!=(const_iterator lhs, const_iterator rhs) {
+      return lhs.index_ != rhs.index_;
+    }
+    friend bool operator<(const_iterator lhs, const_iterator rhs) {
+      return lhs.index_ < rhs.index_;
+    }
+    friend bool operator<=(const_iterator lhs, const_iterator rhs) {
+      return lhs.index_ <= rhs.index_;
+    }
+    friend bool operator>(const_iterator lhs, const_iterator rhs) {
+      return lhs.index_ > rhs.index_;
+    }
+    friend bool operator>=(const_iterator lhs, const_iterator rhs) {
+      return lhs.index_ >= rhs.index_;
+    }
+
+   private:
+    friend class PackedInstructionList;
+
+    explicit const_iterator(const PackedInstructionList* list, size_t index)
+        : list_{list}, index_{index} {}
+
+    const PackedInstructionList* list_ = nullptr;
+    size_t index_ = 0;
+  };
+
+  PackedInstructionList() = default;
+  explicit PackedInstructionList(const InstructionList&);
+
+  void push_back(const Instruction&);
+  void reserve(size_t);
+  void clear();
+
+  bool empty() const { return records_.empty(); }
+  size_t size() const { return records_.size(); }
+
+  Opcode opcode(size_t index) const { return records_[index].opcode; }
+  InstructionKind kind(size_t index) const {
+    return static_cast<InstructionKind>(records_[index].kind);
+  }
+  Instruction operator[](size_t index) const;
+
+  const_iterator begin() const { return const_iterator{this, 0}; }
+  const_iterator end() const { return const_iterator{this, size()}; }
+
+  InstructionList ToInstructionList() const;
+
+  // The number of bytes used by the records and the out-of-line pools.
+  size_t memory_size() const;
+
+  friend bool operator==(const PackedInstructionList&,
+                         const PackedInstructionList&);
+  friend bool operator!=(const PackedInstructionList&,
+                         const PackedInstructionList&);
+
+ private:
+  u32 AddOther(const Instruction&);
+
+  std::vector<Record> records_;
+  std::vector<Index> indexes_;  // br_table targets, then the default target.
+  ValueTypeList value_types_;   // select types.
+  std::vector<v128> v128s_;     // v128 constants and shuffles.
+  std::vector<Instruction> others_;
+};
+
+static_assert(sizeof(PackedInstructionList::Record) == 16,
+              "PackedInstructionList::Record should be 16 bytes");
+
+}  // namespace wasp::binary
+
+#endif  // WASP_BINARY_PACKED_INSTRUCTION_LIST_H_
@@ -30,7 +30,10 @@ namespace wasp::binary {
 struct ReadCtx;
 
 // Read a full binary module eagerly (see ReadLazyModule to read lazily).
-auto ReadModule(SpanU8, ReadCtx&) -> optional<Module>;
+// Function bodies are read on `thread_count` threads (0 means one per hardware
+// thread); the result and the errors reported do not depend on the thread
+// count.
+auto ReadModule(SpanU8, ReadCtx&, u32 thread_count = 1) -> optional<Module>;
 
 
 template <typename T>
@@ -87,6 +90,9 @@ auto Read(SpanU8*, ReadCtx&, Tag<BrTableImmediate>) -> OptAt<BrTableImmediate>;
 auto Read(SpanU8*, ReadCtx&, Tag<CallIndirectImmediate>)
     -> OptAt<CallIndirectImmediate>;
 auto Read(SpanU8*, ReadCtx&, Tag<Code>) -> OptAt<Code>;
+// Reports the same errors as Read<Code>, but the locals are only checked, not
+// stored.
+auto Read(SpanU8*, ReadCtx&, Tag<CodeView>) -> OptAt<CodeView>;
 auto Read(SpanU8*, ReadCtx&, Tag<ConstantExpression>)
     -> OptAt<ConstantExpression>;
 auto Read(SpanU8*, ReadCtx&, Tag<CopyImmediate>, BulkImmediateKind)
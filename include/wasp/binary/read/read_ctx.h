@@ -19,6 +19,8 @@
 
 #include "wasp/base/features.h"
 #include "wasp/base/optional.h"
+#include "wasp/base/resource_limits.h"
+#include "wasp/base/span.h"
 #include "wasp/binary/types.h"
 
 namespace wasp {
@@ -33,8 +35,19 @@ struct ReadCtx {
 
   void Reset();
 
+  // Adds `size` to allocated_bytes before allocating a vector. Returns false
+  // and reports an error at `loc` if that would exceed the limit.
+  bool Allocate(Location loc, u64 size);
+
   Features features;
   Errors& errors;
+  ResourceLimits limits;
+  u64 allocated_bytes = 0;
+
+  // Set to the end of the data when a read fails because it needs more data
+  // than there is, rather than because the data is malformed. StreamDecoder
+  // uses this to tell whether an item just hasn't been fully received yet.
+  const u8* truncated_at = nullptr;
 
   optional<SectionId> last_section_id;
   Index defined_function_count = 0;
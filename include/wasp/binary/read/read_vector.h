@@ -19,6 +19,7 @@
 
 #include <vector>
 
+#include "wasp/base/concat.h"
 #include "wasp/base/errors_context_guard.h"
 #include "wasp/base/optional.h"
 #include "wasp/base/span.h"
@@ -30,13 +31,28 @@
 
 namespace wasp::binary {
 
+// Reads a count followed by that many items. The count is checked against
+// `max_count`, and the size of the vector is checked against (and counted
+// toward) ctx.limits.max_allocated_bytes, before anything is allocated.
 template <typename T>
-optional<std::vector<At<T>>> ReadVector(SpanU8* data,
-                                        ReadCtx& ctx,
-                                        string_view desc) {
+optional<std::vector<At<T>>> ReadVector(
+    SpanU8* data,
+    ReadCtx& ctx,
+    string_view desc,
+    Index max_count = ResourceLimits::kNoIndexLimit) {
   ErrorsContextGuard guard{ctx.errors, *data, desc};
   std::vector<At<T>> result;
+  // ReadCount also checks that the count isn't larger than the remaining
+  // data, since every item is at least one byte.
   WASP_TRY_READ(len, ReadCount(data, ctx));
+  if (len > max_count) {
+    ctx.errors.OnError(len.loc(),
+                       concat("Count exceeds limit: ", len, " > ", max_count));
+    return nullopt;
+  }
+  if (!ctx.Allocate(len.loc(), u64{len} * sizeof(At<T>))) {
+    return nullopt;
+  }
   result.reserve(len);
   for (u32 i = 0; i < len; ++i) {
     WASP_TRY_READ(elt, Read<T>(data, ctx));
@@ -45,6 +61,21 @@ optional<std::vector<At<T>>> ReadVector(SpanU8* data,
   return result;
 }
 
+// Reads a vector the same way as ReadVector, reporting the same errors, but
+// doesn't store the items, so nothing is allocated (or counted toward
+// ctx.limits.max_allocated_bytes). Returns the count.
+template <typename T>
+OptAt<Index> SkipVector(SpanU8* data, ReadCtx& ctx, string_view desc) {
+  ErrorsContextGuard guard{ctx.errors, *data, desc};
+  WASP_TRY_READ(len, ReadCount(data, ctx));
+  for (u32 i = 0; i < len; ++i) {
+    if (!Read<T>(data, ctx)) {
+      return nullopt;
+    }
+  }
+  return len;
+}
+
 }  // namespace wasp::binary
 
 #endif  // WASP_BINARY_READ_READ_VECTOR_H_
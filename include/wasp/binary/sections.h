@@ -41,6 +41,7 @@ using StartSection = OptAt<Start>;
 using LazyElementSection = LazySection<ElementSegment>;
 using DataCountSection = OptAt<DataCount>;
 using LazyCodeSection = LazySection<Code>;
+using LazyCodeViewSection = LazySection<CodeView>;
 using LazyDataSection = LazySection<DataSegment>;
 
 auto ReadTypeSection(SpanU8, ReadCtx&) -> LazyTypeSection;
@@ -65,6 +66,10 @@ auto ReadDataCountSection(SpanU8, ReadCtx&) -> DataCountSection;
 auto ReadDataCountSection(KnownSection, ReadCtx&) -> DataCountSection;
 auto ReadCodeSection(SpanU8, ReadCtx&) -> LazyCodeSection;
 auto ReadCodeSection(KnownSection, ReadCtx&) -> LazyCodeSection;
+// Like ReadCodeSection, but each item is a CodeView, so iterating the section
+// doesn't allocate.
+auto ReadCodeViewSection(SpanU8, ReadCtx&) -> LazyCodeViewSection;
+auto ReadCodeViewSection(KnownSection, ReadCtx&) -> LazyCodeViewSection;
 auto ReadDataSection(SpanU8, ReadCtx&) -> LazyDataSection;
 auto ReadDataSection(KnownSection, ReadCtx&) -> LazyDataSection;
 
@@ -0,0 +1,78 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BINARY_SEQUENCE_RANGE_H_
+#define WASP_BINARY_SEQUENCE_RANGE_H_
+
+#include <type_traits>
+#include <vector>
+
+#include "wasp/base/span.h"
+#include "wasp/base/types.h"
+#include "wasp/binary/lazy_sequence.h"
+#include "wasp/binary/linking_section/types.h"
+#include "wasp/binary/name_section/types.h"
+#include "wasp/binary/read/read_ctx.h"
+#include "wasp/binary/types.h"
+
+namespace wasp::binary {
+
+// A contiguous range of items from a sequence where each item is prefixed by
+// its length in bytes, e.g. the code section, or the subsections of the name
+// and linking sections.
+struct SequenceRange {
+  SpanU8 data;
+  Index first_index;  // The index of the first item in the whole sequence.
+  Index count;
+};
+
+using SequenceRangeList = std::vector<SequenceRange>;
+
+// Splits a sequence into at most `max_count` ranges, each with roughly the
+// same number of bytes. Only the length of each item is read, so this is much
+// cheaper than iterating the sequence.
+//
+// The ranges are independent, so they can be read on different threads, each
+// with its own ReadCtx (see ReadSequenceRange below).
+//
+// Errors are reported to the sequence's context. If an item's length is
+// malformed, the ranges stop before it. If the sequence has an expected
+// count, it is checked against the number of items found.
+auto SplitSequence(const LazySequence<Code>&, Index max_count)
+    -> SequenceRangeList;
+auto SplitSequence(const LazySequence<CodeView>&, Index max_count)
+    -> SequenceRangeList;
+auto SplitSequence(const LazySequence<NameSubsection>&, Index max_count)
+    -> SequenceRangeList;
+auto SplitSequence(const LazySequence<LinkingSubsection>&, Index max_count)
+    -> SequenceRangeList;
+
+// Returns a sequence that reads the items of `range` using `ctx`. Reading a
+// range only updates `ctx`, so if the sequence is part of a module that is
+// being read (e.g. by visit::Visit), the caller is responsible for updating
+// the module's context afterward (e.g. ReadCtx::code_count).
+template <typename T>
+auto ReadSequenceRange(const SequenceRange& range, ReadCtx& ctx)
+    -> LazySequence<T> {
+  if constexpr (std::is_same_v<T, Code> || std::is_same_v<T, CodeView>) {
+    ctx.code_count = range.first_index;
+  }
+  return LazySequence<T>{range.data, ctx};
+}
+
+}  // namespace wasp::binary
+
+#endif  // WASP_BINARY_SEQUENCE_RANGE_H_
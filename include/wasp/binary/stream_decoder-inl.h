@@ -0,0 +1,363 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <cassert>
+#include <type_traits>
+
+#include "wasp/binary/lazy_expression.h"
+#include "wasp/binary/read.h"
+#include "wasp/binary/sections.h"
+
+namespace wasp::binary {
+
+template <typename F>
+auto StreamDecoderBase::TryRead(F&& read) -> ReadStatus {
+  SpanU8 data = window();
+  const u8* begin = data.begin();
+  if (is_final()) {
+    if (!read(&data)) {
+      return ReadStatus::Fail;
+    }
+    Consume(data.begin() - begin);
+    return ReadStatus::Ok;
+  }
+
+  if (data.size() < retry_size_) {
+    return ReadStatus::NeedMore;
+  }
+  size_t size = data.size();
+  const u8* end = data.end();
+  CtxState saved = SaveCtx();
+  ctx().truncated_at = nullptr;
+  errors_.BeginSpeculation();
+  if (!read(&data)) {
+    if (ctx().truncated_at != end) {
+      // The read didn't run out of data, so the item is malformed, and
+      // receiving the rest of it won't change that.
+      errors_.Commit();
+      return ReadStatus::Fail;
+    }
+    errors_.Rollback();
+    RestoreCtx(std::move(saved));
+    retry_size_ = size + size / 2 + 1;
+    return ReadStatus::NeedMore;
+  }
+  errors_.Commit();
+  Consume(data.begin() - begin);
+  return ReadStatus::Ok;
+}
+
+namespace visit {
+
+template <typename Visitor>
+StreamDecoder<Visitor>::StreamDecoder(Visitor& visitor,
+                                      const Features& features,
+                                      Errors& errors)
+    : StreamDecoderBase{features, errors}, visitor_{visitor} {}
+
+template <typename Visitor>
+Result StreamDecoder<Visitor>::Feed(SpanU8 chunk) {
+  assert(!finished_);
+  if (result_ == Result::Ok) {
+    Append(chunk);
+    Process();
+    Compact();
+  }
+  return result_;
+}
+
+template <typename Visitor>
+Result StreamDecoder<Visitor>::Finish() {
+  assert(!finished_);
+  finished_ = true;
+  if (result_ != Result::Ok) {
+    return result_;
+  }
+  Process();
+  if (result_ != Result::Ok) {
+    return result_;
+  }
+  if (in_section()) {
+    ReportTruncatedSection();
+  }
+  binary::EndModule(module_->data, ctx());
+  result_ = visitor_.EndModule(*module_);
+  Compact();
+  return result_;
+}
+
+template <typename Visitor>
+void StreamDecoder<Visitor>::Process() {
+  while (result_ == Result::Ok) {
+    switch (state_) {
+      case State::Header:
+        if (!ReadHeader()) {
+          return;
+        }
+        result_ = visitor_.BeginModule(*module_);
+        state_ = State::SectionHeader;
+        break;
+
+      case State::SectionHeader:
+        if (window().empty()) {
+          return;
+        }
+        switch (ReadSectionHeader()) {
+          case ReadStatus::Ok:
+            state_ = is_item_section() ? State::SectionCount
+                                       : State::WholeSection;
+            break;
+          case ReadStatus::NeedMore:
+            return;
+          case ReadStatus::Fail:
+            state_ = State::End;
+            return;
+        }
+        break;
+
+      case State::SectionCount:
+      case State::Items:
+        if (!ProcessItemSection()) {
+          return;
+        }
+        break;
+
+      case State::WholeSection:
+        if (!ProcessWholeSection()) {
+          return;
+        }
+        break;
+
+      case State::SkipSection:
+        Consume(window().size());
+        if (section_remaining_ != 0) {
+          return;
+        }
+        state_ = State::SectionHeader;
+        break;
+
+      case State::End:
+        return;
+    }
+  }
+}
+
+#define WASP_STREAM_SECTION(Name, T, desc)                           \
+  case SectionId::Name:                                              \
+    return ProcessItems<T>(                                          \
+        desc,                                                        \
+        [&](LazySection<T> sec) {                                    \
+          return visitor_.Begin##Name##Section(sec);                 \
+        },                                                           \
+        [&](const At<T>& item) { return visitor_.On##Name(item); },  \
+        [&](LazySection<T> sec) {                                    \
+          return visitor_.End##Name##Section(sec);                   \
+        });
+
+template <typename Visitor>
+bool StreamDecoder<Visitor>::ProcessItemSection() {
+  switch (section_id_) {
+    WASP_STREAM_SECTION(Type, DefinedType, "type section")
+    WASP_STREAM_SECTION(Import, Import, "import section")
+    WASP_STREAM_SECTION(Function, Function, "function section")
+    WASP_STREAM_SECTION(Table, Table, "table section")
+    WASP_STREAM_SECTION(Memory, Memory, "memory section")
+    WASP_STREAM_SECTION(Global, Global, "global section")
+    WASP_STREAM_SECTION(Event, Event, "event section")
+    WASP_STREAM_SECTION(Export, Export, "export section")
+    WASP_STREAM_SECTION(Element, ElementSegment, "element section")
+    WASP_STREAM_SECTION(Data, DataSegment, "data section")
+
+    case SectionId::Code:
+      return ProcessItems<Code>(
+          "code section",
+          [&](LazyCodeSection sec) { return visitor_.BeginCodeSection(sec); },
+          [&](const At<CodeView>& code) { return OnCode(code); },
+          [&](LazyCodeSection sec) { return visitor_.EndCodeSection(sec); });
+
+    default:
+      // Only the sections above are item sections.
+      assert(false);
+      return false;
+  }
+}
+
+#undef WASP_STREAM_SECTION
+
+template <typename Visitor>
+template <typename T, typename Begin, typename On, typename End>
+bool StreamDecoder<Visitor>::ProcessItems(string_view name,
+                                          Begin&& begin,
+                                          On&& on,
+                                          End&& end) {
+  if (state_ == State::SectionCount) {
+    if (ReadSectionCount() == ReadStatus::NeedMore) {
+      return false;
+    }
+    state_ = State::Items;
+
+    SpanU8 count_data = section_count_ ? section_count_->loc() : SpanU8{};
+    result_ = visitor_.OnSection(MakeKnownSection(count_data));
+    if (result_ == Result::Skip) {
+      result_ = Result::Ok;
+      state_ = State::SkipSection;
+      return true;
+    } else if (result_ == Result::Fail) {
+      return false;
+    }
+
+    result_ = begin(LazySection<T>{section_count_, SpanU8{}, name, ctx()});
+    if (result_ == Result::Skip) {
+      // If skipping this section, increment by the number of items specified
+      // in this section, as Visit() does.
+      Index count = section_count_ ? section_count_->value() : 0;
+      if constexpr (std::is_same_v<T, Function>) {
+        ctx().defined_function_count += count;
+      } else if constexpr (std::is_same_v<T, Code>) {
+        ctx().code_count += count;
+      } else if constexpr (std::is_same_v<T, DataSegment>) {
+        ctx().data_count += count;
+      }
+      result_ = Result::Ok;
+      state_ = State::SkipSection;
+      return true;
+    } else if (result_ == Result::Fail) {
+      return false;
+    }
+  }
+
+  // Function bodies are read as views, so they aren't allocated.
+  using Item = std::conditional_t<std::is_same_v<T, Code>, CodeView, T>;
+  while (section_remaining_ != 0) {
+    OptAt<Item> item;
+    auto status = TryRead([&](SpanU8* data) {
+      item = Read<Item>(data, ctx());
+      return item.has_value();
+    });
+    if (status == ReadStatus::NeedMore) {
+      return false;
+    } else if (status == ReadStatus::Fail) {
+      // As with LazySequence, a malformed item ends the sequence.
+      break;
+    }
+    ++item_count_;
+    if (on(*item) == Result::Fail) {
+      result_ = Result::Fail;
+      return false;
+    }
+  }
+
+  CheckItemCount(name);
+  if (end(LazySection<T>{section_count_, SpanU8{}, name, ctx()}) ==
+      Result::Fail) {
+    result_ = Result::Fail;
+    return false;
+  }
+  state_ = section_remaining_ == 0 ? State::SectionHeader : State::SkipSection;
+  return true;
+}
+
+template <typename Visitor>
+Result StreamDecoder<Visitor>::OnCode(const At<CodeView>& code) {
+  CodeCallbacks callbacks{code, ctx()};
+  auto result = callbacks.Begin(visitor_);
+  if (result != Result::Ok) {
+    return result;
+  }
+  for (auto&& instr : ReadExpression(*code->body, ctx())) {
+    if (visitor_.OnInstruction(instr) == Result::Fail) {
+      return Result::Fail;
+    }
+  }
+  binary::EndCode(code->body->data.last(0), ctx());
+  return callbacks.End(visitor_);
+}
+
+template <typename Visitor>
+bool StreamDecoder<Visitor>::ProcessWholeSection() {
+  SpanU8 data = window();
+  if (data.size() != section_remaining_) {
+    return false;
+  }
+  // The data stays valid until the buffer is compacted at the end of Feed.
+  Consume(data.size());
+  state_ = State::SectionHeader;
+
+  if (section_id_ == SectionId::Custom) {
+    SpanU8 rest = data;
+    auto name = ReadUtf8String(&rest, ctx(), "custom section name");
+    if (!name) {
+      // As with LazyModule, an unreadable section ends the module.
+      state_ = State::End;
+      return false;
+    }
+    result_ = visitor_.OnSection(
+        At{data, Section{At{data, CustomSection{*name, rest}}}});
+    if (result_ == Result::Skip) {
+      result_ = Result::Ok;
+    }
+    return result_ == Result::Ok;
+  }
+
+  result_ = visitor_.OnSection(MakeKnownSection(data));
+  if (result_ != Result::Ok) {
+    if (result_ == Result::Skip) {
+      result_ = Result::Ok;
+    }
+    return result_ == Result::Ok;
+  }
+
+  KnownSection known{At{data, section_id_}, data};
+  switch (section_id_) {
+    case SectionId::Start: {
+      auto opt = ReadStartSection(known, ctx());
+      result_ = visitor_.BeginStartSection(opt);
+      if (result_ != Result::Ok) {
+        break;
+      }
+      if (opt && visitor_.OnStart(*opt) == Result::Fail) {
+        result_ = Result::Fail;
+        break;
+      }
+      result_ = visitor_.EndStartSection(opt);
+      break;
+    }
+
+    case SectionId::DataCount: {
+      auto opt = ReadDataCountSection(known, ctx());
+      result_ = visitor_.BeginDataCountSection(opt);
+      if (result_ != Result::Ok) {
+        break;
+      }
+      if (opt && visitor_.OnDataCount(*opt) == Result::Fail) {
+        result_ = Result::Fail;
+        break;
+      }
+      result_ = visitor_.EndDataCountSection(opt);
+      break;
+    }
+
+    default:
+      break;
+  }
+  if (result_ == Result::Skip) {
+    result_ = Result::Ok;
+  }
+  return result_ == Result::Ok;
+}
+
+}  // namespace visit
+}  // namespace wasp::binary
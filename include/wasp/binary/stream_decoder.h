@@ -0,0 +1,233 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BINARY_STREAM_DECODER_H_
+#define WASP_BINARY_STREAM_DECODER_H_
+
+#include <array>
+#include <vector>
+
+#include "wasp/base/errors.h"
+#include "wasp/base/errors_buffer.h"
+#include "wasp/base/features.h"
+#include "wasp/base/optional.h"
+#include "wasp/base/span.h"
+#include "wasp/base/string_view.h"
+#include "wasp/base/types.h"
+#include "wasp/binary/lazy_module.h"
+#include "wasp/binary/lazy_sequence.h"
+#include "wasp/binary/read/read_ctx.h"
+#include "wasp/binary/types.h"
+#include "wasp/binary/visitor.h"
+
+namespace wasp::binary {
+
+// The part of StreamDecoder that doesn't depend on the visitor: it buffers the
+// incoming bytes and reads items from them once they are complete.
+class StreamDecoderBase : protected LazySequenceBase {
+ public:
+  StreamDecoderBase(const StreamDecoderBase&) = delete;
+  StreamDecoderBase& operator=(const StreamDecoderBase&) = delete;
+
+  // The number of bytes currently buffered, i.e. the part of the stream that
+  // has been fed, but not yet decoded.
+  size_t buffered_size() const { return buffer_.size() - pos_; }
+
+  // The offset in the stream of `ptr`, which must be in a location that the
+  // decoder has passed to the visitor or to Errors, during that call.
+  size_t stream_offset(const u8* ptr) const;
+
+ protected:
+  enum class State {
+    Header,         // Magic and version.
+    SectionHeader,  // Section id and length.
+    SectionCount,   // Item count of a section that holds a sequence of items.
+    Items,          // The items of that section.
+    WholeSection,   // Any other section, read once it has been fully received.
+    SkipSection,    // A section that isn't being visited.
+    End,            // No more sections can be read.
+  };
+
+  enum class ReadStatus { Ok, NeedMore, Fail };
+
+  explicit StreamDecoderBase(const Features&, Errors&);
+
+  ReadCtx& ctx() { return module_->ctx; }
+  bool in_section() const;
+
+  // The buffered bytes that can be read in the current state; in a section,
+  // this never extends past the end of the section.
+  SpanU8 window() const;
+
+  // Whether window() contains all the bytes that it ever will, so a read that
+  // fails is an error rather than a sign that more data is needed.
+  bool is_final() const;
+
+  void Append(SpanU8 chunk);
+  void Consume(size_t size);
+  // Drops the bytes that have been consumed. Any spans into the buffer are
+  // invalidated.
+  void Compact();
+
+  // Calls `read(SpanU8*)` on window(), consuming the bytes it reads if it
+  // succeeds. If the window isn't final, the read is speculative: if it fails
+  // because it ran out of data (see ReadCtx::truncated_at), its errors are
+  // dropped, ReadCtx is restored, and NeedMore is returned. Any other failure
+  // is an error whether or not more data arrives, so it is reported as Fail.
+  template <typename F>
+  ReadStatus TryRead(F&& read);
+
+  // Returns false until the header has been received, then creates module_.
+  bool ReadHeader();
+  ReadStatus ReadSectionHeader();
+  ReadStatus ReadSectionCount();
+  bool is_item_section() const;
+  At<Section> MakeKnownSection(SpanU8 data) const;
+  void CheckItemCount(string_view name);
+  void ReportTruncatedSection();
+
+  State state_ = State::Header;
+  bool finished_ = false;
+  optional<LazyModule> module_;
+
+  SectionId section_id_ = SectionId::Custom;
+  Index section_length_ = 0;
+  size_t section_remaining_ = 0;  // Section bytes not yet consumed.
+  OptAt<Index> section_count_;
+  Index item_count_ = 0;
+
+ private:
+  // Forwards errors to another Errors object, except during a speculative
+  // read, where they are buffered until it is known whether the read failed
+  // only because the item hasn't been fully received yet.
+  class SpeculativeErrors : public Errors {
+   public:
+    explicit SpeculativeErrors(Errors&);
+
+    bool HasError() const override { return errors_.HasError(); }
+
+    void BeginSpeculation();
+    void Commit();
+    void Rollback();
+
+   protected:
+    void HandlePushContext(Location loc, string_view desc) override;
+    void HandlePopContext() override;
+    void HandleOnError(Location loc, string_view message) override;
+
+   private:
+    Errors& errors_;
+    ErrorsBuffer buffer_;
+    bool speculating_ = false;
+  };
+
+  // The parts of ReadCtx that reading an item can change.
+  struct CtxState {
+    optional<SectionId> last_section_id;
+    Index defined_function_count;
+    optional<Index> declared_data_count;
+    Index code_count;
+    Index data_count;
+    u64 local_count;
+    std::vector<At<Opcode>> open_blocks;
+    bool seen_final_end;
+    u64 allocated_bytes;
+  };
+
+  CtxState SaveCtx();
+  void RestoreCtx(CtxState&&);
+
+  Features features_;
+  SpeculativeErrors errors_;
+  std::array<u8, 8> header_;
+  // The bytes of the section count, so they outlive the buffer.
+  std::array<u8, 5> count_bytes_;
+
+  // The stream offset of the section count, i.e. of count_bytes_[0].
+  size_t count_offset_ = 0;
+
+  std::vector<u8> buffer_;
+  // The stream offset of buffer_[0].
+  size_t buffer_offset_ = 0;
+  size_t pos_ = 0;
+  // After a speculative read fails, it isn't retried until the window is this
+  // large, so a large item isn't reread for every small chunk.
+  size_t retry_size_ = 0;
+};
+
+namespace visit {
+
+// Decodes a module that is received in chunks, calling the visitor as soon as
+// each item has been received, rather than waiting for the whole module as
+// Visit() does. Only the item currently being received is buffered, so the
+// memory used is bounded by the largest item (or custom, start or data count
+// section) rather than by the module size.
+//
+//   StreamDecoder decoder{visitor, features, errors};
+//   while (... read chunk ...) {
+//     if (decoder.Feed(chunk) != visit::Result::Ok) break;
+//   }
+//   visit::Result result = decoder.Finish();
+//
+// The visitor receives the same callbacks as with Visit(), with a few
+// differences since the module isn't available up front:
+//  * For sections that hold a sequence of items, OnSection and the
+//    Begin/End*Section callbacks receive only the section count; the
+//    section's sequence is empty, and the items are passed to On* as they
+//    arrive.
+//  * All locations (and any spans, such as a code body) point into the
+//    decoder's buffer, and are only valid until the callback returns. This
+//    includes the locations passed to Errors, so an Errors object that keeps
+//    them (e.g. to print them once decoding is done) must record
+//    stream_offset(loc.data()) instead of the location itself.
+//  * A malformed item is reported as soon as its malformed part has been
+//    received, except for an item that is cut short (e.g. a length that
+//    extends past the end of its section), which is reported once the rest
+//    of the section has been received.
+template <typename Visitor>
+class StreamDecoder : public StreamDecoderBase {
+ public:
+  explicit StreamDecoder(Visitor&, const Features&, Errors&);
+
+  // Decodes as much of the module as possible. Returns Fail if the visitor
+  // failed and Skip if it skipped the module; in either case the rest of the
+  // module can be dropped.
+  Result Feed(SpanU8 chunk);
+
+  // Must be called at the end of the stream. Reports an error if the module
+  // was truncated, then calls EndModule.
+  Result Finish();
+
+ private:
+  void Process();
+  bool ProcessItemSection();
+  bool ProcessWholeSection();
+
+  template <typename T, typename Begin, typename On, typename End>
+  bool ProcessItems(string_view name, Begin&&, On&&, End&&);
+
+  Result OnCode(const At<CodeView>&);
+
+  Visitor& visitor_;
+  Result result_ = Result::Ok;
+};
+
+}  // namespace visit
+}  // namespace wasp::binary
+
+#include "wasp/binary/stream_decoder-inl.h"
+
+#endif  // WASP_BINARY_STREAM_DECODER_H_
@@ -646,6 +646,15 @@ struct Code {
   At<Expression> body;
 };
 
+// A function body whose locals haven't been decoded into a vector, so reading
+// one doesn't allocate. `locals` is the encoded locals vector, including its
+// count; use ReadLocals (see lazy_locals.h) to iterate it, or ToCode to build
+// the Code.
+struct CodeView {
+  SpanU8 locals;
+  At<Expression> body;
+};
+
 struct UnpackedExpression {
   InstructionList instructions;
 };
@@ -715,6 +724,7 @@ struct Module {
   WASP_V(binary::BrTableImmediate, 2, targets, default_target)           \
   WASP_V(binary::CallIndirectImmediate, 2, index, table_index)           \
   WASP_V(binary::Code, 2, locals, body)                                  \
+  WASP_V(binary::CodeView, 2, locals, body)                              \
   WASP_V(binary::ConstantExpression, 1, instructions)                    \
   WASP_V(binary::CopyImmediate, 2, src_index, dst_index)                 \
   WASP_V(binary::CustomSection, 2, name, data)                           \
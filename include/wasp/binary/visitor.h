@@ -17,7 +17,11 @@
 #ifndef WASP_BINARY_VISITOR_H_
 #define WASP_BINARY_VISITOR_H_
 
+#include <type_traits>
+
+#include "wasp/base/optional.h"
 #include "wasp/binary/lazy_expression.h"
+#include "wasp/binary/lazy_locals.h"
 #include "wasp/binary/lazy_module.h"
 #include "wasp/binary/sections.h"
 
@@ -87,11 +91,12 @@ struct Visitor {
   Result OnDataCount(const At<DataCount>&) { return Result::Ok; }
   Result EndDataCountSection(DataCountSection) { return Result::Ok; }
 
-  // Section 10.
+  // Section 10. BeginCode and EndCode can take either an At<CodeView> or an
+  // At<Code>; see CodeCallbacks below.
   Result BeginCodeSection(LazyCodeSection) { return Result::Ok; }
-  Result BeginCode(const At<Code>&) { return Result::Ok; }
+  Result BeginCode(const At<CodeView>&) { return Result::Ok; }
   Result OnInstruction(const At<Instruction>&) { return Result::Ok; }
-  Result EndCode(const At<Code>&) { return Result::Ok; }
+  Result EndCode(const At<CodeView>&) { return Result::Ok; }
   Result EndCodeSection(LazyCodeSection) { return Result::Ok; }
 
   // Section 11.
@@ -116,13 +121,78 @@ struct SkipVisitor : Visitor {
   Result BeginElementSection(LazyElementSection) { return Result::Skip; }
   Result BeginDataCountSection(DataCountSection) { return Result::Skip; }
   Result BeginCodeSection(LazyCodeSection) { return Result::Skip; }
-  Result BeginCode(const At<Code>&) { return Result::Skip; }
+  Result BeginCode(const At<CodeView>&) { return Result::Skip; }
   Result BeginDataSection(LazyDataSection) { return Result::Skip; }
 };
 
 template <typename Visitor>
 Result Visit(LazyModule&, Visitor&);
 
+template <typename Visitor>
+using BeginCodeViewResult = decltype(
+    std::declval<Visitor&>().BeginCode(std::declval<const At<CodeView>&>()));
+
+template <typename Visitor>
+using EndCodeViewResult = decltype(
+    std::declval<Visitor&>().EndCode(std::declval<const At<CodeView>&>()));
+
+// Whether a visitor's BeginCode (or EndCode) takes an At<CodeView>.
+template <typename Visitor, typename = void>
+struct BeginCodeTakesView : std::false_type {};
+
+template <typename Visitor>
+struct BeginCodeTakesView<Visitor, std::void_t<BeginCodeViewResult<Visitor>>>
+    : std::true_type {};
+
+template <typename Visitor, typename = void>
+struct EndCodeTakesView : std::false_type {};
+
+template <typename Visitor>
+struct EndCodeTakesView<Visitor, std::void_t<EndCodeViewResult<Visitor>>>
+    : std::true_type {};
+
+// Calls a visitor's BeginCode and EndCode for one function body. A visitor
+// that takes an At<CodeView> gets the view, so its locals are never decoded
+// into a vector. Otherwise the Code is built from the view the first time a
+// visitor needs it, and shared by any later callbacks.
+class CodeCallbacks {
+ public:
+  explicit CodeCallbacks(const At<CodeView>& view, ReadCtx& ctx)
+      : view_{view}, ctx_{ctx} {}
+
+  template <typename Visitor>
+  Result Begin(Visitor& visitor) {
+    if constexpr (BeginCodeTakesView<Visitor>::value) {
+      return visitor.BeginCode(view_);
+    } else {
+      return code() ? visitor.BeginCode(*code_) : Result::Fail;
+    }
+  }
+
+  template <typename Visitor>
+  Result End(Visitor& visitor) {
+    if constexpr (EndCodeTakesView<Visitor>::value) {
+      return visitor.EndCode(view_);
+    } else {
+      return code() ? visitor.EndCode(*code_) : Result::Fail;
+    }
+  }
+
+ private:
+  bool code() {
+    if (!built_code_) {
+      code_ = ToCode(view_, ctx_);
+      built_code_ = true;
+    }
+    return code_.has_value();
+  }
+
+  const At<CodeView>& view_;
+  ReadCtx& ctx_;
+  OptAt<Code> code_;
+  bool built_code_ = false;
+};
+
 #define WASP_CHECK(x)      \
   if (x == Result::Fail) { \
     return Result::Fail;   \
@@ -215,14 +285,18 @@ inline Result Visit(LazyModule& module, Visitor& visitor) {
           WASP_IF_OK_ELSE_SKIP(
               visitor.BeginCodeSection(sec),
               {
-                for (const auto& code : sec.sequence) {
-                  WASP_IF_OK(visitor.BeginCode(code), {
+                // Read the bodies as views, so they aren't allocated.
+                LazyCodeViewSection views(sec.count, sec.sequence.data(),
+                                          sec.sequence.name(), module.ctx);
+                for (const auto& code : views.sequence) {
+                  CodeCallbacks callbacks(code, module.ctx);
+                  WASP_IF_OK(callbacks.Begin(visitor), {
                     for (auto&& instr :
                          ReadExpression(*code->body, module.ctx)) {
                       WASP_CHECK(visitor.OnInstruction(instr));
                     }
                     EndCode(code->body->data.last(0), module.ctx);
-                    WASP_CHECK(visitor.EndCode(code));
+                    WASP_CHECK(callbacks.End(visitor));
                   })
                 }
                 WASP_CHECK(visitor.EndCodeSection(sec));
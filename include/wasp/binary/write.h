@@ -17,11 +17,14 @@
 #ifndef WASP_BINARY_WRITE_H_
 #define WASP_BINARY_WRITE_H_
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <type_traits>
+#include <vector>
 
 #include "wasp/base/buffer.h"
 #include "wasp/base/macros.h"
@@ -40,42 +43,79 @@ Iterator Write(u8 value, Iterator out) {
   return out;
 }
 
-template <typename T, typename Iterator, typename Cond>
-Iterator WriteVarIntLoop(T value, Iterator out, Cond&& end_cond) {
-  do {
-    const u8 byte = value & VarInt<T>::kByteMask;
-    value >>= 7;
-    if (end_cond(value, byte)) {
-      out = Write(byte, out);
-      break;
-    } else {
-      out = Write(static_cast<u8>(byte | VarInt<T>::kExtendBit), out);
+// Returns the Buffer that a back_inserter appends to, so bytes can be added
+// to it in bulk rather than one at a time.
+inline Buffer& GetBuffer(std::back_insert_iterator<Buffer> out) {
+  struct Access : std::back_insert_iterator<Buffer> {
+    static Buffer* Get(const std::back_insert_iterator<Buffer>& out) {
+      return out.*&Access::container;
     }
-  } while (true);
+  };
+  return *Access::Get(out);
+}
+
+template <typename Iterator>
+Iterator WriteBytes(SpanU8 value, Iterator out) {
+  return std::copy(value.begin(), value.end(), out);
+}
+
+inline std::back_insert_iterator<Buffer> WriteBytes(
+    SpanU8 value,
+    std::back_insert_iterator<Buffer> out) {
+  Buffer& buffer = GetBuffer(out);
+  buffer.insert(buffer.end(), value.begin(), value.end());
   return out;
 }
 
-// Unsigned integers.
-template <typename T, typename Iterator>
-std::enable_if_t<!std::is_signed_v<T>, Iterator> WriteVarInt(T value,
-                                                             Iterator out) {
-  return WriteVarIntLoop(value, out,
-                         [](T value, u8 byte) { return value == 0; });
+// Returns the number of bits needed to represent `value`, and at least 1.
+inline int BitWidth(u64 value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return 64 - __builtin_clzll(value | 1);
+#else
+  int bits = 1;
+  while (value >>= 1) {
+    ++bits;
+  }
+  return bits;
+#endif
 }
 
-// Signed integers.
-template <typename T, typename Iterator>
-std::enable_if_t<std::is_signed_v<T>, Iterator> WriteVarInt(T value,
-                                                            Iterator out) {
-  if (value < 0) {
-    return WriteVarIntLoop(value, out, [](T value, u8 byte) {
-      return value == -1 && (byte & VarInt<T>::kSignBit) != 0;
-    });
+// Returns the number of bytes in the LEB128 encoding of `value`.
+template <typename T>
+int VarIntSize(T value) {
+  using V = VarInt<T>;
+  int bits;
+  if constexpr (std::is_signed_v<T>) {
+    // The bits that differ from the sign bit, plus the sign bit itself.
+    constexpr int kSignShift = sizeof(T) * 8 - 1;
+    bits = BitWidth(static_cast<u64>(value ^ (value >> kSignShift))) + 1;
   } else {
-    return WriteVarIntLoop(value, out, [](T value, u8 byte) {
-      return value == 0 && (byte & VarInt<T>::kSignBit) == 0;
-    });
+    bits = BitWidth(value);
+  }
+  return (bits + V::kBitsPerByte - 1) / V::kBitsPerByte;
+}
+
+// Encodes `value` as LEB128 into `bytes`, which must have room for
+// VarInt<T>::kMaxBytes bytes, and returns the size of the encoding. The bytes
+// past the encoding are unspecified. The size is computed up front, so the
+// loop has a fixed trip count and no data-dependent branches.
+template <typename T>
+int EncodeVarInt(T value, u8* bytes) {
+  using V = VarInt<T>;
+  const int size = VarIntSize(value);
+  for (int i = 0; i < V::kMaxBytes; ++i) {
+    const u8 extend = i + 1 < size ? V::kExtendBit : 0;
+    bytes[i] = static_cast<u8>(((value >> (i * V::kBitsPerByte)) &
+                                V::kByteMask) | extend);
   }
+  return size;
+}
+
+template <typename T, typename Iterator>
+Iterator WriteVarInt(T value, Iterator out) {
+  u8 bytes[VarInt<T>::kMaxBytes];
+  const int size = EncodeVarInt(value, bytes);
+  return WriteBytes(SpanU8(bytes, size), out);
 }
 
 template <typename Iterator>
@@ -182,11 +222,6 @@ Iterator Write(const Limits& limits, Iterator out) {
   return out;
 }
 
-template <typename Iterator>
-Iterator WriteBytes(SpanU8 value, Iterator out) {
-  return std::copy(value.begin(), value.end(), out);
-}
-
 template <typename Iterator>
 Iterator WriteLengthAndBytes(SpanU8 value, Iterator out) {
   assert(value.size() < std::numeric_limits<u32>::max());
@@ -239,6 +274,39 @@ OutputIterator WriteVector(InputIterator in_begin,
   return out;
 }
 
+// Appends a vector of indexes to `buffer`, where `get_index` returns the index
+// of each input item. The buffer is grown once to fit the largest possible
+// encoding, and each index is then encoded in place.
+template <typename InputIterator, typename GetIndex>
+void AppendIndexVector(InputIterator in_begin,
+                       InputIterator in_end,
+                       Buffer& buffer,
+                       GetIndex&& get_index) {
+  size_t count = std::distance(in_begin, in_end);
+  assert(count < std::numeric_limits<u32>::max());
+  size_t size = buffer.size();
+  buffer.resize(size + (count + 1) * VarInt<Index>::kMaxBytes);
+  u8* out = buffer.data() + size;
+  out += EncodeVarInt(static_cast<u32>(count), out);
+  for (auto it = in_begin; it != in_end; ++it) {
+    out += EncodeVarInt(get_index(*it), out);
+  }
+  buffer.resize(out - buffer.data());
+}
+
+template <typename Iterator>
+Iterator WriteIndexVector(const IndexList& value, Iterator out) {
+  return WriteVector(value.begin(), value.end(), out);
+}
+
+inline std::back_insert_iterator<Buffer> WriteIndexVector(
+    const IndexList& value,
+    std::back_insert_iterator<Buffer> out) {
+  AppendIndexVector(value.begin(), value.end(), GetBuffer(out),
+                    [](const At<Index>& index) { return index.value(); });
+  return out;
+}
+
 template <typename Iterator>
 Iterator Write(const StorageType& value, Iterator out) {
   if (value.is_packed_type()) {
@@ -262,7 +330,7 @@ Iterator Write(const ArrayType& value, Iterator out) {
 
 template <typename Iterator>
 Iterator Write(const BrTableImmediate& immediate, Iterator out) {
-  out = WriteVector(immediate.targets.begin(), immediate.targets.end(), out);
+  out = WriteIndexVector(immediate.targets, out);
   out = WriteIndex(immediate.default_target, out);
   return out;
 }
@@ -308,13 +376,19 @@ Iterator Write(const UnpackedExpression& value, Iterator out) {
   return Write(value.instructions, out);
 }
 
+// Writes the locals and expression of a function body, without its length.
+template <typename Iterator>
+Iterator WriteCodeBody(const UnpackedCode& value, Iterator out) {
+  out = WriteVector(value.locals.begin(), value.locals.end(), out);
+  out = Write(value.body, out);
+  return out;
+}
+
 template <typename Iterator>
 Iterator Write(const UnpackedCode& value, Iterator out) {
   // Write Code to a separate buffer, so we know its length.
   Buffer buffer;
-  auto code_out = std::back_inserter(buffer);
-  code_out = WriteVector(value.locals.begin(), value.locals.end(), code_out);
-  code_out = Write(value.body, code_out);
+  WriteCodeBody(value, std::back_inserter(buffer));
 
   // Then write that buffer to the real output.
   out = WriteLengthAndBytes(buffer, out);
@@ -393,7 +467,7 @@ Iterator Write(const ElementSegment& value, Iterator out) {
     if (!flags.is_legacy_active()) {
       out = Write(elements.kind, out);
     }
-    out = WriteVector(elements.list.begin(), elements.list.end(), out);
+    out = WriteIndexVector(elements.list, out);
   }
   return out;
 }
@@ -720,7 +794,15 @@ OutputIterator WriteKnownSection(SectionId section_id,
                                  OutputIterator out) {
   // Write to a separate buffer, so we know its length.
   Buffer buffer;
-  WriteVector(in_begin, in_end, std::back_inserter(buffer));
+  using T = typename std::iterator_traits<InputIterator>::value_type;
+  if constexpr (std::is_same_v<T, At<Function>>) {
+    // The function section is just a vector of type indexes.
+    AppendIndexVector(
+        in_begin, in_end, buffer,
+        [](const At<Function>& value) { return value->type_index.value(); });
+  } else {
+    WriteVector(in_begin, in_end, std::back_inserter(buffer));
+  }
 
   // Then write the section id, followed by the buffer to the real output.
   out = Write(section_id, out);
@@ -730,7 +812,7 @@ OutputIterator WriteKnownSection(SectionId section_id,
 
 template <typename Container, typename Iterator>
 Iterator WriteNonEmptyKnownSection(SectionId section_id,
-                                   Container container,
+                                   const Container& container,
                                    Iterator out) {
   if (!container.empty()) {
     out = WriteKnownSection(section_id, std::begin(container),
@@ -756,8 +838,13 @@ Iterator WriteNonEmptyKnownSection(SectionId section_id,
   return out;
 }
 
-template <typename Iterator>
-Iterator Write(const Module& value, Iterator out) {
+// Writes `value`, but calls `write_code_section(out)` to write the code section
+// instead of writing `value.codes`. This allows the code section to be written
+// from a representation other than UnpackedCode.
+template <typename Iterator, typename WriteCodeSection>
+Iterator WriteModule(const Module& value,
+                     Iterator out,
+                     WriteCodeSection&& write_code_section) {
   out = WriteBytes(encoding::Magic, out);
   out = WriteBytes(encoding::Version, out);
   out = WriteNonEmptyKnownSection(SectionId::Type, value.types, out);
@@ -771,11 +858,65 @@ Iterator Write(const Module& value, Iterator out) {
   out = WriteNonEmptyKnownSection(SectionId::Start, value.start, out);
   out = WriteNonEmptyKnownSection(SectionId::Element, value.element_segments, out);
   out = WriteNonEmptyKnownSection(SectionId::DataCount, value.data_count, out);
-  out = WriteNonEmptyKnownSection(SectionId::Code, value.codes, out);
+  out = write_code_section(out);
   out = WriteNonEmptyKnownSection(SectionId::Data, value.data_segments, out);
   return out;
 }
 
+template <typename Iterator>
+Iterator Write(const Module& value, Iterator out) {
+  return WriteModule(value, out, [&](Iterator out) {
+    return WriteNonEmptyKnownSection(SectionId::Code, value.codes, out);
+  });
+}
+
+// Called to append the function body with the given index (see WriteCodeBody)
+// to `code`. If more than one thread is used, it is called concurrently, and
+// `thread_index` can be used to select per-thread state.
+using EncodeCodeFunction =
+    std::function<void(u32 thread_index, Index code_index, Buffer& code)>;
+
+// Encodes `count` function bodies on `thread_count` threads (0 means one per
+// hardware thread). The bodies are encoded in contiguous shards, each body
+// prefixed by its length; concatenated in order, the shards are the contents
+// of the code section after its count. The result does not depend on the
+// thread count.
+auto EncodeCodeShards(Index count,
+                      u32 thread_count,
+                      const EncodeCodeFunction&) -> std::vector<Buffer>;
+
+// Writes the code section, given `count` function bodies that were encoded by
+// EncodeCodeShards. Nothing is written if there are no function bodies.
+template <typename Iterator>
+Iterator WriteEncodedCodeSection(Index count,
+                                 const std::vector<Buffer>& shards,
+                                 Iterator out) {
+  if (count == 0) {
+    return out;
+  }
+
+  u8 count_bytes[VarInt<Index>::kMaxBytes];
+  size_t length = EncodeVarInt(count, count_bytes);
+  SpanU8 count_span(count_bytes, length);
+  for (auto&& shard : shards) {
+    length += shard.size();
+  }
+  assert(length < std::numeric_limits<u32>::max());
+
+  out = Write(SectionId::Code, out);
+  out = Write(u32(length), out);
+  out = WriteBytes(count_span, out);
+  for (auto&& shard : shards) {
+    out = WriteBytes(shard, out);
+  }
+  return out;
+}
+
+// Writes `value` the same way as Write(const Module&, Iterator), but the
+// function bodies are encoded on `thread_count` threads (0 means one per
+// hardware thread). The result is identical.
+auto WriteModule(const Module& value, u32 thread_count) -> Buffer;
+
 }  // namespace wasp::binary
 
 #endif  // WASP_BINARY_WRITE_H_
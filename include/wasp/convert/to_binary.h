@@ -17,6 +17,7 @@
 #ifndef WASP_CONVERT_TO_BINARY_H_
 #define WASP_CONVERT_TO_BINARY_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -26,6 +27,7 @@
 #include "wasp/base/features.h"
 #include "wasp/base/optional.h"
 #include "wasp/binary/types.h"
+#include "wasp/text/desugar.h"
 #include "wasp/text/types.h"
 
 namespace wasp::convert {
@@ -134,6 +136,34 @@ auto ToBinary(BinCtx&, const At<text::Event>&) -> OptAt<binary::Event>;
 
 // Module
 auto ToBinary(BinCtx&, const At<text::Module>&) -> At<binary::Module>;
+auto ToBinary(BinCtx&, const text::DesugaredModule&) -> At<binary::Module>;
+
+// Encode a module directly to the binary format. The result is identical to
+// calling binary::Write on the result of ToBinary, but the function bodies are
+// never stored as a binary::Module; each body's instructions are converted and
+// written one at a time, straight into the code section.
+struct EncodeCallbacks {
+  // Called with the converted module, minus its code, before any function
+  // body is encoded.
+  std::function<void(const binary::Module&)> on_module;
+
+  // If set, each function body is converted to a binary::UnpackedCode and
+  // passed to `on_code` (e.g. to validate it) before it is written, along with
+  // its index in the code section. Only one function body per thread is
+  // converted at a time. If more than one thread is used, `on_code` is called
+  // concurrently, and `thread_index` can be used to select per-thread state.
+  std::function<void(u32 thread_index,
+                     Index code_index,
+                     const At<binary::UnpackedCode>&)>
+      on_code;
+};
+
+// Function bodies are encoded on `thread_count` threads (0 means one per
+// hardware thread); the output does not depend on the thread count.
+auto ToBinaryBytes(BinCtx&,
+                   const text::DesugaredModule&,
+                   const EncodeCallbacks& = {},
+                   u32 thread_count = 1) -> Buffer;
 
 }  // namespace wasp::convert
 
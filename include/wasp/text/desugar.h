@@ -17,11 +17,52 @@
 #ifndef WASP_TEXT_DESUGAR_H_
 #define WASP_TEXT_DESUGAR_H_
 
+#include <deque>
+#include <functional>
+#include <vector>
+
 #include "wasp/text/types.h"
 
 namespace wasp::text {
 
+// A desugared view of a module, which neither modifies nor copies the original
+// module. Items that don't need to change are referenced from the original
+// module, which must outlive the view. Only new items (e.g. an inline export
+// rewritten as an Export item) are owned by the view.
+//
+// NOTE: Items referenced from the original module may still have inline
+// exports, element segments or data segments. These are also available as
+// separate items in the view, so users of the view must ignore them.
+class DesugaredModule {
+ public:
+  using value_type = ModuleItem;
+  using ItemList = std::vector<std::reference_wrapper<const ModuleItem>>;
+  using const_iterator = ItemList::const_iterator;
+
+  DesugaredModule() = default;
+  DesugaredModule(DesugaredModule&&) = default;
+  DesugaredModule& operator=(DesugaredModule&&) = default;
+  DesugaredModule(const DesugaredModule&) = delete;
+  DesugaredModule& operator=(const DesugaredModule&) = delete;
+
+  const_iterator begin() const { return items_.begin(); }
+  const_iterator end() const { return items_.end(); }
+  size_t size() const { return items_.size(); }
+  bool empty() const { return items_.empty(); }
+  const ModuleItem& operator[](size_t index) const { return items_[index]; }
+
+ private:
+  friend DesugaredModule DesugarView(const Module&);
+
+  void AddShared(const ModuleItem&);
+  void AddOwned(ModuleItem);
+
+  ItemList items_;
+  std::deque<ModuleItem> owned_items_;  // std::deque has stable references.
+};
+
 void Desugar(Module&);
+DesugaredModule DesugarView(const Module&);
 
 }  // namespace wasp::text
 
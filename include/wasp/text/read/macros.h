@@ -17,12 +17,14 @@
 #ifndef WASP_TEXT_MACROS_H_
 #define WASP_TEXT_MACROS_H_
 
+#include <utility>
+
 #define WASP_TRY_READ(var, call) \
   auto opt_##var = call;         \
   if (!opt_##var) {              \
     return {};                   \
   }                              \
-  auto var = *opt_##var /* No semicolon. */
+  auto var = std::move(*opt_##var) /* No semicolon. */
 
 #define WASP_TRY(call) \
   if (!call) {         \
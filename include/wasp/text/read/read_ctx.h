@@ -21,6 +21,7 @@
 
 namespace wasp {
 
+class Arena;
 class Errors;
 
 namespace text {
@@ -34,6 +35,16 @@ struct ReadCtx {
   Features features;
   Errors& errors;
 
+  // If set, ReadModule, ReadSingleModule and ReadScript install this arena on
+  // the calling thread (see ArenaScope) while they run, so the lists of the
+  // AST that they build are allocated from it. The AST is destroyed as usual:
+  // each list's buffer goes back to the arena's free list for its size, and
+  // the arena's memory is returned to the heap, in large chunks, when the
+  // arena is destroyed. Lists allocated after reading (e.g. by copying the
+  // AST, or by Resolve growing a list) come from the heap. The arena must
+  // outlive the AST.
+  Arena* arena = nullptr;
+
   bool seen_non_import = false;
   bool seen_start = false;
 };
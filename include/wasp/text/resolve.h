@@ -17,6 +17,7 @@
 #ifndef WASP_TEXT_RESOLVE_H_
 #define WASP_TEXT_RESOLVE_H_
 
+#include "wasp/base/types.h"
 #include "wasp/text/types.h"
 
 namespace wasp {
@@ -33,6 +34,11 @@ class NameMap;
 void Resolve(Module&, Errors&);
 void Resolve(Script&, Errors&);
 
+// Resolve a Module, resolving function bodies on `thread_count` threads (0
+// means one per hardware thread). The result, including the order of errors,
+// is the same as Resolve(Module&, Errors&).
+void Resolve(Module&, Errors&, u32 thread_count);
+
 // The functions below are used to implement the API above, and not meant to be
 // called by most users. They are exposed here primarily for testing purposes.
 
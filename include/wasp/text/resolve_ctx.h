@@ -58,6 +58,8 @@ class FunctionTypeMap {
   Index Use(BoundFunctionType);
   // Returns the deferred defined types.
   auto EndModule() -> DefinedTypeList;
+  // Discards the deferred types, without defining them.
+  void ClearDeferred();
 
   Index Size() const;
   optional<FunctionType> Get(Index) const;
@@ -72,8 +74,17 @@ class FunctionTypeMap {
   List deferred_list_;
 };
 
+// A use of a function type that isn't explicitly defined. See
+// ResolveCtx::deferred_type_uses below.
+struct DeferredTypeUse {
+  OptAt<Var>* type_use;
+  FunctionType type;
+};
+
 struct ResolveCtx {
   explicit ResolveCtx(Errors&);
+  // Copy the context, but report errors to a different Errors object.
+  ResolveCtx(const ResolveCtx&, Errors&);
 
   void BeginModule();    // Reset all module-specific context.
   void BeginFunction();  // Reset all function-specific context.
@@ -81,6 +92,10 @@ struct ResolveCtx {
   void EndBlock();
   auto EndModule() -> DefinedTypeList;
 
+  // Sets `type_use` to the index of `type`, adding it to the deferred types if
+  // it isn't already defined.
+  void UseFunctionType(OptAt<Var>& type_use, const FunctionType& type);
+
   // Used for struct and array field names.
   auto NewFieldNameMap(Index) -> NameMap&;
   auto GetFieldNameMap(Index) -> NameMap*;
@@ -102,6 +117,12 @@ struct ResolveCtx {
   NameMap data_segment_names;
   FunctionTypeMap function_type_map;
 
+  // The index of a deferred type depends on the order in which the types are
+  // first used, so when function bodies are resolved in parallel, their uses
+  // of deferred types are recorded here (if non-null), and assigned their
+  // final indexes afterward, in module order.
+  std::vector<DeferredTypeUse>* deferred_type_uses = nullptr;
+
   // Function context.
   NameMap local_names;  // Includes params.
   NameMap label_names;
@@ -21,6 +21,7 @@
 #include <utility>
 
 #include "wasp/base/absl_hash_value_macros.h"
+#include "wasp/base/arena.h"
 #include "wasp/base/at.h"
 #include "wasp/base/operator_eq_ne_macros.h"
 #include "wasp/base/optional.h"
@@ -32,6 +33,12 @@
 
 namespace wasp::text {
 
+// The lists of the AST are ArenaVectors: each one is allocated from the arena
+// that ArenaScope has installed on the calling thread, or from the heap if
+// there is none. ReadModule, ReadSingleModule and ReadScript install
+// ReadCtx::arena while they run; other code uses the heap unless it installs
+// an arena itself.
+
 struct Var {
   bool is_index() const;
   bool is_name() const;
@@ -114,7 +121,7 @@ struct ValueType {
   variant<At<NumericType>, At<ReferenceType>, At<Rtt>> type;
 };
 
-using ValueTypeList = std::vector<At<ValueType>>;
+using ValueTypeList = ArenaVector<At<ValueType>>;
 
 struct StorageType {
   explicit StorageType(At<ValueType>);
@@ -131,10 +138,10 @@ struct StorageType {
   variant<At<ValueType>, At<PackedType>> type;
 };
 
-using VarList = std::vector<At<Var>>;
+using VarList = ArenaVector<At<Var>>;
 using BindVar = string_view;
 
-using TextList = std::vector<At<Text>>;
+using TextList = ArenaVector<At<Text>>;
 
 void AppendToBuffer(const TextList&, Buffer& buffer);
 
@@ -198,7 +205,7 @@ struct BoundValueType {
   At<ValueType> type;
 };
 
-using BoundValueTypeList = std::vector<At<BoundValueType>>;
+using BoundValueTypeList = ArenaVector<At<BoundValueType>>;
 
 struct LetImmediate {
   BlockImmediate block;
@@ -387,7 +394,7 @@ struct Instruction {
       immediate;
 };
 
-using InstructionList = std::vector<At<Instruction>>;
+using InstructionList = ArenaVector<At<Instruction>>;
 
 // Section 1: Type
 
@@ -405,7 +412,7 @@ struct FieldType {
   At<Mutability> mut;
 };
 
-using FieldTypeList = std::vector<At<FieldType>>;
+using FieldTypeList = ArenaVector<At<FieldType>>;
 
 struct StructType {
   FieldTypeList fields;
@@ -516,11 +523,11 @@ struct InlineExport {
   At<Text> name;
 };
 
-using InlineExportList = std::vector<At<InlineExport>>;
+using InlineExportList = ArenaVector<At<InlineExport>>;
 
 struct Export;
 
-using ExportList = std::vector<At<Export>>;
+using ExportList = ArenaVector<At<Export>>;
 
 struct Function {
   // Empty function.
@@ -564,7 +571,7 @@ struct ElementExpression {
   InstructionList instructions;
 };
 
-using ElementExpressionList = std::vector<At<ElementExpression>>;
+using ElementExpressionList = ArenaVector<At<ElementExpression>>;
 
 struct ElementListWithExpressions {
   At<ReferenceType> elemtype;
@@ -638,7 +645,7 @@ struct DataItem {
   variant<Text, NumericData> value;
 };
 
-using DataItemList = std::vector<At<DataItem>>;
+using DataItemList = ArenaVector<At<DataItem>>;
 
 struct Memory {
   // Defined memory.
@@ -846,7 +853,7 @@ struct ModuleItem {
           At<Event>> desc;
 };
 
-using Module = std::vector<ModuleItem>;
+using Module = ArenaVector<ModuleItem>;
 
 // Script
 
@@ -921,7 +928,7 @@ struct Const {
   variant<u32, u64, f32, f64, v128, RefNullConst, RefExternConst> value;
 };
 
-using ConstList = std::vector<At<Const>>;
+using ConstList = ArenaVector<At<Const>>;
 
 struct InvokeAction {
   OptAt<ModuleVar> module;
@@ -981,7 +988,7 @@ using ReturnResult = variant<u32,
                              RefExternConst,
                              RefExternResult,
                              RefFuncResult>;
-using ReturnResultList = std::vector<At<ReturnResult>>;
+using ReturnResultList = ArenaVector<At<ReturnResult>>;
 
 struct ReturnAssertion {
   At<Action> action;
@@ -1036,7 +1043,7 @@ struct Command {
   variant<ScriptModule, Register, Action, Assertion> contents;
 };
 
-using Script = std::vector<At<Command>>;
+using Script = ArenaVector<At<Command>>;
 
 #define WASP_TEXT_ENUMS(WASP_V)  \
   WASP_V(text::TokenType)        \
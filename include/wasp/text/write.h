@@ -119,9 +119,9 @@ Iterator WriteRange(WriteCtx& ctx,
   return out;
 }
 
-template <typename Iterator, typename T>
+template <typename Iterator, typename T, typename A>
 Iterator WriteVector(WriteCtx& ctx,
-                     const std::vector<T>& values,
+                     const std::vector<T, A>& values,
                      Iterator out) {
   return WriteRange(ctx, values.begin(), values.end(), out);
 }
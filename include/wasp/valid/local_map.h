@@ -25,9 +25,18 @@
 
 namespace wasp::valid {
 
+// The types of the locals of the function being validated, including its
+// parameters and any locals bound by `let`.
+//
+// While there are at most `dense_limit` locals, the type of each local is
+// stored in an array, so looking one up is O(1). Past that, the locals switch
+// to a run-length encoded form that is binary-searched, so a function with a
+// huge number of locals doesn't use a huge amount of memory.
 class LocalMap {
  public:
-  explicit LocalMap();
+  static constexpr Index kDefaultDenseLimit = 4096;
+
+  explicit LocalMap(Index dense_limit = kDefaultDenseLimit);
 
   void Reset();
 
@@ -52,14 +61,30 @@ class LocalMap {
   void Push();
   void Pop();
 
+  bool is_dense() const { return dense_; }
+
  private:
   using Pair = std::pair<binary::ValueType, Index>;
   using Pairs = std::vector<Pair>;
 
   bool CanAppend(Index count) const;
+  void AppendCompressed(Index count, binary::ValueType);
   void AdjustPartialSums(Pairs::iterator first, Index count);
+  void Compress();
+
+  Index dense_limit_;
+  bool dense_ = true;
+
+  // The dense form. Each let block's locals are stored after those of the
+  // enclosing block, starting at the offset in `let_starts_` (the function's
+  // locals start at 0). So appending, pushing and popping only change the end
+  // of the array, and the lookup only needs to account for let blocks when
+  // there are any.
+  std::vector<binary::ValueType> types_;
+  std::vector<Index> let_starts_;
 
-  // Index is a partial sum, so the vector can be binary-searched, e.g.
+  // The compressed form. Index is a partial sum, so the vector can be
+  // binary-searched, e.g.
   //
   //   {i32, i32, f32, f32, f32, i64}
   //
@@ -23,6 +23,7 @@
 
 #include "wasp/base/errors.h"
 #include "wasp/base/features.h"
+#include "wasp/base/resource_limits.h"
 #include "wasp/base/span.h"
 #include "wasp/base/string_view.h"
 #include "wasp/base/types.h"
@@ -90,6 +91,7 @@ struct ValidCtx {
 
   Features features;
   Errors* errors;
+  ResourceLimits limits;
 
   std::vector<binary::DefinedType> types;
   std::vector<binary::Function> functions;
@@ -0,0 +1,102 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_VALID_VALIDATION_CACHE_H_
+#define WASP_VALID_VALIDATION_CACHE_H_
+
+#include "wasp/base/at.h"
+#include "wasp/base/features.h"
+#include "wasp/base/hashmap.h"
+#include "wasp/base/optional.h"
+#include "wasp/base/sha256.h"
+#include "wasp/base/span.h"
+#include "wasp/base/string_view.h"
+#include "wasp/base/types.h"
+#include "wasp/binary/lazy_module.h"
+#include "wasp/binary/types.h"
+#include "wasp/valid/validate_visitor.h"
+
+namespace wasp {
+
+class Errors;
+
+namespace valid {
+
+// The set of modules and function bodies that are known to be valid, keyed
+// by a SHA-256 digest of their bytes (see CachingValidateVisitor). Only valid results
+// are cached, since invalid ones have to be validated again anyway to report
+// their errors.
+class ValidationCache {
+ public:
+  using Key = Sha256::Digest;
+
+  bool Contains(Key key) const { return keys_.count(key) != 0; }
+  void Insert(Key);
+
+  size_t size() const { return keys_.size(); }
+  // Whether any keys were inserted since the cache was loaded.
+  bool modified() const { return modified_; }
+
+  // Adds the keys stored in the given file. Returns false if the file can't
+  // be read or isn't a cache file, in which case no keys are added.
+  bool Load(string_view filename);
+  // Writes all keys to the given file, replacing it.
+  bool Save(string_view filename);
+
+ private:
+  flat_hash_set<Key> keys_;
+  bool modified_ = false;
+};
+
+// Validates a module the same way as ValidateVisitor, but skips modules and
+// function bodies that are in the cache, and adds the ones that are valid.
+//
+// A module is keyed by all of its bytes. A function body is keyed by its
+// bytes, its index, and the bytes of all the sections that precede the code
+// section (types, imports, functions, tables, globals, etc.), since they are
+// the context it is validated in. So if only a few bodies change, only those
+// are validated again. Both keys include the enabled features.
+struct CachingValidateVisitor : ValidateVisitor {
+  explicit CachingValidateVisitor(Features, Errors&, ValidationCache&);
+
+  // Returns Skip if the module is in the cache.
+  auto BeginModule(binary::LazyModule&) -> Result;
+  auto EndModule(binary::LazyModule&) -> Result;
+  auto OnSection(At<binary::Section>) -> Result;
+  // Returns Skip if the body is in the cache.
+  auto BeginCode(const At<binary::Code>&) -> Result;
+  auto EndCode(const At<binary::Code>&) -> Result;
+
+  ValidationCache& cache;
+  ValidationCache::Key module_key{};
+  // Hashes the context of the function bodies; each body's key is finished
+  // from a copy of it.
+  Sha256 context_hasher;
+  optional<ValidationCache::Key> code_key;
+  // The error count when the current body began, so it is only cached if it
+  // reported no errors itself.
+  size_t code_error_count = 0;
+
+  // The number of function bodies that were found in the cache, and that had
+  // to be validated.
+  Index cached_code_count = 0;
+  Index validated_code_count = 0;
+};
+
+}  // namespace valid
+}  // namespace wasp
+
+#endif  // WASP_VALID_VALIDATION_CACHE_H_
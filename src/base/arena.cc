@@ -0,0 +1,159 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/base/arena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace wasp {
+
+namespace {
+
+u8* AlignUp(u8* ptr, size_t align) {
+  auto addr = reinterpret_cast<uintptr_t>(ptr);
+  return reinterpret_cast<u8*>((addr + align - 1) & ~uintptr_t(align - 1));
+}
+
+size_t RoundUpSize(size_t size, size_t granule) {
+  return (std::max(size, size_t{1}) + granule - 1) & ~(granule - 1);
+}
+
+// Every block from ArenaAllocate is preceded by a header that holds its arena
+// (just before the block, so it can be found from the block's address). The
+// header is at least as large as the block's alignment, so the block stays
+// aligned.
+size_t HeaderSize(size_t align) {
+  return std::max(align, sizeof(Arena*));
+}
+
+Arena*& HeaderArena(void* ptr) {
+  return static_cast<Arena**>(ptr)[-1];
+}
+
+bool IsOverAligned(size_t align) {
+  return align > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+}
+
+}  // namespace
+
+Arena::Arena(size_t chunk_size)
+    : chunk_size_{chunk_size},
+      max_small_size_{chunk_size / 4 / kGranule * kGranule},
+      free_lists_(max_small_size_ / kGranule + 1) {}
+
+void* Arena::Allocate(size_t size, size_t align) {
+  assert(align != 0 && (align & (align - 1)) == 0);
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (is_large(size)) {
+    size_t chunk_size = size + align;
+    std::unique_ptr<u8[]> chunk{new u8[chunk_size]};
+    u8* result = AlignUp(chunk.get(), align);
+    large_.emplace(result, std::make_pair(std::move(chunk), chunk_size));
+    reserved_bytes_ += chunk_size;
+    return result;
+  }
+
+  size = RoundUpSize(size, kGranule);
+  align = std::max(align, kGranule);
+  FreeBlock*& free_list = free_lists_[size / kGranule];
+  if (free_list && align == kGranule) {
+    FreeBlock* result = free_list;
+    free_list = result->next;
+    return result;
+  }
+
+  u8* result = AlignUp(ptr_, align);
+  if (!ptr_ || result + size > end_) {
+    chunks_.emplace_back(new u8[chunk_size_]);
+    reserved_bytes_ += chunk_size_;
+    ptr_ = chunks_.back().get();
+    end_ = ptr_ + chunk_size_;
+    result = AlignUp(ptr_, align);
+  }
+  ptr_ = result + size;
+  return result;
+}
+
+void Arena::Deallocate(void* ptr, size_t size, size_t align) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (is_large(size)) {
+    auto iter = large_.find(ptr);
+    assert(iter != large_.end());
+    reserved_bytes_ -= iter->second.second;
+    large_.erase(iter);
+    return;
+  }
+
+  if (align > kGranule) {
+    return;
+  }
+  size = RoundUpSize(size, kGranule);
+  FreeBlock*& free_list = free_lists_[size / kGranule];
+  free_list = new (ptr) FreeBlock{free_list};
+}
+
+size_t Arena::reserved_bytes() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return reserved_bytes_;
+}
+
+ArenaScope::ArenaScope(Arena* arena) : previous_{Arena::current_} {
+  Arena::current_ = arena;
+}
+
+ArenaScope::~ArenaScope() {
+  Arena::current_ = previous_;
+}
+
+void* ArenaAllocate(size_t size, size_t align) {
+  Arena* arena = Arena::current();
+  size_t header_size = HeaderSize(align);
+  size_t block_align = std::max(align, alignof(Arena*));
+  void* block;
+  if (arena) {
+    block = arena->Allocate(header_size + size, block_align);
+  } else if (IsOverAligned(block_align)) {
+    block = ::operator new(header_size + size, std::align_val_t{block_align});
+  } else {
+    block = ::operator new(header_size + size);
+  }
+  void* result = static_cast<u8*>(block) + header_size;
+  HeaderArena(result) = arena;
+  return result;
+}
+
+void ArenaDeallocate(void* ptr, size_t size, size_t align) {
+  Arena* arena = HeaderArena(ptr);
+  size_t header_size = HeaderSize(align);
+  size_t block_align = std::max(align, alignof(Arena*));
+  void* block = static_cast<u8*>(ptr) - header_size;
+  if (arena) {
+    arena->Deallocate(block, header_size + size, block_align);
+  } else if (IsOverAligned(block_align)) {
+    ::operator delete(block, std::align_val_t{block_align});
+  } else {
+    ::operator delete(block);
+  }
+}
+
+Arena* GetArena(const void* ptr) {
+  return HeaderArena(const_cast<void*>(ptr));
+}
+
+}  // namespace wasp
@@ -37,16 +37,8 @@ void Features::EnableAll() {
 #undef WASP_V
 }
 
-void Features::UpdateDependencies(){
-  if (bits_ & GC) {
-    bits_ |= FunctionReferences;
-  }
-  if (bits_ & (FunctionReferences | Exceptions)) {
-    bits_ |= ReferenceTypes;
-  }
-  if (bits_ & (ReferenceTypes | Memory64)) {
-    bits_ |= BulkMemory;
-  }
+void Features::UpdateDependencies() {
+  bits_ = AddDependencies(bits_);
 }
 
 bool operator==(const Features& lhs, const Features& rhs) {
@@ -0,0 +1,156 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/base/sha256.h"
+
+#include <algorithm>
+
+namespace wasp {
+
+namespace {
+
+// The constants are from FIPS 180-4, section 4.2.2.
+constexpr u32 kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+u32 RotateRight(u32 x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+u32 LoadBigEndian(const u8* p) {
+  return (u32{p[0]} << 24) | (u32{p[1]} << 16) | (u32{p[2]} << 8) | p[3];
+}
+
+}  // namespace
+
+Sha256::Sha256()
+    : state_{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+             0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19} {}
+
+void Sha256::Update(SpanU8 data) {
+  length_ += data.size();
+  if (buffer_size_ != 0) {
+    size_t size = std::min(data.size(), buffer_.size() - buffer_size_);
+    std::copy_n(data.begin(), size, buffer_.begin() + buffer_size_);
+    buffer_size_ += size;
+    data.remove_prefix(size);
+    if (buffer_size_ != buffer_.size()) {
+      return;
+    }
+    ProcessBlock(buffer_.data());
+    buffer_size_ = 0;
+  }
+  for (; data.size() >= buffer_.size(); data.remove_prefix(buffer_.size())) {
+    ProcessBlock(data.data());
+  }
+  std::copy(data.begin(), data.end(), buffer_.begin());
+  buffer_size_ = data.size();
+}
+
+void Sha256::Update(u64 value) {
+  u8 bytes[8];
+  for (int i = 0; i < 8; ++i) {
+    bytes[i] = static_cast<u8>(value >> (i * 8));
+  }
+  Update(SpanU8{bytes});
+}
+
+auto Sha256::Finish() -> Digest {
+  // Pad with 0x80, then zeroes, then the length in bits (big-endian), to a
+  // multiple of the block size.
+  u64 bit_length = length_ * 8;
+  buffer_[buffer_size_++] = 0x80;
+  if (buffer_size_ > buffer_.size() - 8) {
+    std::fill(buffer_.begin() + buffer_size_, buffer_.end(), 0);
+    ProcessBlock(buffer_.data());
+    buffer_size_ = 0;
+  }
+  std::fill(buffer_.begin() + buffer_size_, buffer_.end() - 8, 0);
+  for (int i = 0; i < 8; ++i) {
+    buffer_[buffer_.size() - 1 - i] = static_cast<u8>(bit_length >> (i * 8));
+  }
+  ProcessBlock(buffer_.data());
+
+  Digest result;
+  for (size_t i = 0; i < state_.size(); ++i) {
+    result[i * 4] = static_cast<u8>(state_[i] >> 24);
+    result[i * 4 + 1] = static_cast<u8>(state_[i] >> 16);
+    result[i * 4 + 2] = static_cast<u8>(state_[i] >> 8);
+    result[i * 4 + 3] = static_cast<u8>(state_[i]);
+  }
+  return result;
+}
+
+// static
+auto Sha256::Hash(SpanU8 data) -> Digest {
+  Sha256 sha;
+  sha.Update(data);
+  return sha.Finish();
+}
+
+void Sha256::ProcessBlock(const u8* block) {
+  u32 w[64];
+  for (int i = 0; i < 16; ++i) {
+    w[i] = LoadBigEndian(block + i * 4);
+  }
+  for (int i = 16; i < 64; ++i) {
+    u32 s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^
+             (w[i - 15] >> 3);
+    u32 s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^
+             (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  u32 a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+  u32 e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+  for (int i = 0; i < 64; ++i) {
+    u32 s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+    u32 ch = (e & f) ^ (~e & g);
+    u32 t1 = h + s1 + ch + kRoundConstants[i] + w[i];
+    u32 s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+    u32 maj = (a & b) ^ (a & c) ^ (b & c);
+    u32 t2 = s0 + maj;
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  state_[0] += a;
+  state_[1] += b;
+  state_[2] += c;
+  state_[3] += d;
+  state_[4] += e;
+  state_[5] += f;
+  state_[6] += g;
+  state_[7] += h;
+}
+
+}  // namespace wasp
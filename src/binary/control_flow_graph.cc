@@ -0,0 +1,371 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/control_flow_graph.h"
+
+#include <cassert>
+
+#include "wasp/base/at.h"
+#include "wasp/base/concat.h"
+#include "wasp/base/errors.h"
+#include "wasp/binary/lazy_expression.h"
+#include "wasp/binary/read/read_ctx.h"
+
+namespace wasp::binary {
+
+namespace {
+
+struct Label {
+  Opcode opcode;
+  BasicBlockId parent;
+  BasicBlockId br;
+  BasicBlockId next;
+};
+
+// Whether an instruction only affects the structure of the body, so a block
+// with nothing else can be removed.
+bool IsStructuralInstruction(Opcode opcode) {
+  return opcode == Opcode::Block || opcode == Opcode::Else ||
+         opcode == Opcode::End || opcode == Opcode::Br;
+}
+
+class Builder {
+ public:
+  explicit Builder(SpanU8 body, ReadCtx&);
+
+  ControlFlowGraph Build();
+
+ private:
+  struct Block {
+    u32 begin = 0;
+    u32 end = 0;
+    bool has_code = false;
+    // The target of the first edge added to this block, which is where
+    // control goes if the block is removed.
+    BasicBlockId first_target = kInvalidBasicBlockId;
+    bool has_edge = false;
+  };
+
+  struct Edge {
+    BasicBlockId from;
+    ControlFlowEdge edge;
+  };
+
+  void DoInstruction(const At<Instruction>&, u32 prev_offset, u32 offset);
+  void PushLabel(Opcode, BasicBlockId br, BasicBlockId next);
+  Label PopLabel();
+  BasicBlockId NewBlock();
+  void StartBlock(BasicBlockId, u32 offset);
+  void EndBlock(u32 offset);
+  void MarkUnreachable(u32 offset);
+  void AddEdge(BasicBlockId from,
+               BasicBlockId to,
+               ControlFlowEdgeKind,
+               Index case_index = 0);
+  void Br(const At<Index>& depth, ControlFlowEdgeKind, Index case_index = 0);
+  void ForwardEmptyBlocks(std::vector<BasicBlockId>& forward) const;
+  ControlFlowGraph Compact() const;
+
+  SpanU8 body_;
+  ReadCtx& ctx_;
+  std::vector<Label> labels_;
+  std::vector<Block> blocks_;
+  std::vector<Edge> edges_;
+  BasicBlockId start_ = kInvalidBasicBlockId;
+  BasicBlockId current_ = kInvalidBasicBlockId;
+};
+
+Builder::Builder(SpanU8 body, ReadCtx& ctx) : body_{body}, ctx_{ctx} {}
+
+ControlFlowGraph Builder::Build() {
+  PushLabel(Opcode::Return, kInvalidBasicBlockId, kInvalidBasicBlockId);
+  start_ = NewBlock();
+  StartBlock(start_, 0);
+
+  u32 prev_offset = 0;
+  auto instrs = ReadExpression(body_, ctx_);
+  for (auto it = instrs.begin(), end = instrs.end(); it != end; ++it) {
+    u32 offset = static_cast<u32>(it.data().data() - body_.data());
+    DoInstruction(*it, prev_offset, offset);
+    prev_offset = offset;
+  }
+  if (current_ != kInvalidBasicBlockId) {
+    // The body is missing its final `end`.
+    EndBlock(static_cast<u32>(body_.size()));
+  }
+  return Compact();
+}
+
+void Builder::DoInstruction(const At<Instruction>& instr,
+                            u32 prev_offset,
+                            u32 offset) {
+  // Each instruction belongs to the block that is current before it, except
+  // `loop`, which starts its own block.
+  if (instr->opcode != Opcode::Loop &&
+      !IsStructuralInstruction(instr->opcode) &&
+      current_ != kInvalidBasicBlockId) {
+    blocks_[current_].has_code = true;
+  }
+
+  switch (instr->opcode) {
+    case Opcode::Unreachable:
+      MarkUnreachable(offset);
+      break;
+
+    case Opcode::Block: {
+      auto next = NewBlock();
+      PushLabel(instr->opcode, next, next);
+      break;
+    }
+
+    case Opcode::Loop: {
+      auto loop = NewBlock();
+      auto next = NewBlock();
+      AddEdge(current_, loop, ControlFlowEdgeKind::Unconditional);
+      PushLabel(instr->opcode, loop, next);
+      StartBlock(loop, prev_offset);
+      blocks_[loop].has_code = true;
+      break;
+    }
+
+    case Opcode::If: {
+      auto true_ = NewBlock();
+      auto next = NewBlock();
+      AddEdge(current_, true_, ControlFlowEdgeKind::True);
+      PushLabel(instr->opcode, next, next);
+      StartBlock(true_, offset);
+      break;
+    }
+
+    case Opcode::Else: {
+      if (labels_.size() <= 1) {
+        break;
+      }
+      auto top = PopLabel();
+      AddEdge(current_, top.next, ControlFlowEdgeKind::Unconditional);
+      auto false_ = NewBlock();
+      AddEdge(top.parent, false_, ControlFlowEdgeKind::False);
+      PushLabel(instr->opcode, top.next, top.next);
+      StartBlock(false_, offset);
+      break;
+    }
+
+    case Opcode::End: {
+      if (labels_.empty()) {
+        break;
+      }
+      auto top = PopLabel();
+      AddEdge(current_, top.next, ControlFlowEdgeKind::Unconditional);
+      if (top.opcode == Opcode::If) {
+        AddEdge(top.parent, top.next, ControlFlowEdgeKind::False);
+      }
+      StartBlock(top.next, offset);
+      break;
+    }
+
+    case Opcode::Br:
+      Br(instr->index_immediate(), ControlFlowEdgeKind::Unconditional);
+      MarkUnreachable(offset);
+      break;
+
+    case Opcode::BrIf: {
+      Br(instr->index_immediate(), ControlFlowEdgeKind::True);
+      auto next = NewBlock();
+      AddEdge(current_, next, ControlFlowEdgeKind::False);
+      StartBlock(next, offset);
+      break;
+    }
+
+    case Opcode::BrTable: {
+      const auto& immediate = instr->br_table_immediate();
+      Index case_index = 0;
+      for (const auto& target : immediate->targets) {
+        Br(target, ControlFlowEdgeKind::Case, case_index++);
+      }
+      Br(immediate->default_target, ControlFlowEdgeKind::Default);
+      MarkUnreachable(offset);
+      break;
+    }
+
+    case Opcode::Return:
+    case Opcode::ReturnCall:
+    case Opcode::ReturnCallIndirect:
+      MarkUnreachable(offset);
+      break;
+
+    default:
+      break;
+  }
+}
+
+void Builder::PushLabel(Opcode opcode, BasicBlockId br, BasicBlockId next) {
+  labels_.push_back({opcode, current_, br, next});
+}
+
+Label Builder::PopLabel() {
+  assert(!labels_.empty());
+  Label top = labels_.back();
+  labels_.pop_back();
+  return top;
+}
+
+BasicBlockId Builder::NewBlock() {
+  blocks_.emplace_back();
+  return static_cast<BasicBlockId>(blocks_.size() - 1);
+}
+
+void Builder::StartBlock(BasicBlockId id, u32 offset) {
+  if (current_ != kInvalidBasicBlockId) {
+    EndBlock(offset);
+  }
+  current_ = id;
+  if (current_ != kInvalidBasicBlockId) {
+    blocks_[current_].begin = offset;
+    blocks_[current_].end = offset;
+  }
+}
+
+void Builder::EndBlock(u32 offset) {
+  blocks_[current_].end = offset;
+}
+
+void Builder::MarkUnreachable(u32 offset) {
+  StartBlock(NewBlock(), offset);
+}
+
+void Builder::AddEdge(BasicBlockId from,
+                      BasicBlockId to,
+                      ControlFlowEdgeKind kind,
+                      Index case_index) {
+  if (from == kInvalidBasicBlockId) {
+    return;
+  }
+  auto& block = blocks_[from];
+  if (!block.has_edge) {
+    block.first_target = to;
+    block.has_edge = true;
+  }
+  edges_.push_back({from, {to, kind, case_index}});
+}
+
+void Builder::Br(const At<Index>& depth,
+                 ControlFlowEdgeKind kind,
+                 Index case_index) {
+  if (*depth < labels_.size()) {
+    AddEdge(current_, labels_[labels_.size() - *depth - 1].br, kind,
+            case_index);
+  } else {
+    ctx_.errors.OnError(depth.loc(),
+                        concat("Invalid branch depth: ", *depth));
+  }
+}
+
+void Builder::ForwardEmptyBlocks(std::vector<BasicBlockId>& forward) const {
+  // Map each block to itself if it has code, or otherwise to the first block
+  // with code that it leads to (or kInvalidBasicBlockId). Each chain of empty
+  // blocks is only walked once.
+  enum class State : u8 { Unvisited, Visiting, Done };
+  std::vector<State> states(blocks_.size(), State::Unvisited);
+  forward.assign(blocks_.size(), kInvalidBasicBlockId);
+  std::vector<BasicBlockId> chain;
+  for (BasicBlockId id = 0; id < blocks_.size(); ++id) {
+    if (states[id] == State::Done) {
+      continue;
+    }
+    chain.clear();
+    BasicBlockId next = id;
+    while (next != kInvalidBasicBlockId && states[next] == State::Unvisited &&
+           !blocks_[next].has_code) {
+      states[next] = State::Visiting;
+      chain.push_back(next);
+      next = blocks_[next].first_target;
+    }
+
+    BasicBlockId result = kInvalidBasicBlockId;
+    if (next != kInvalidBasicBlockId) {
+      if (blocks_[next].has_code) {
+        result = next;
+        forward[next] = next;
+        states[next] = State::Done;
+      } else if (states[next] == State::Done) {
+        result = forward[next];
+      }
+      // Otherwise the chain is a cycle of empty blocks, which never reaches
+      // any code.
+    }
+    for (auto empty : chain) {
+      forward[empty] = result;
+      states[empty] = State::Done;
+    }
+  }
+}
+
+ControlFlowGraph Builder::Compact() const {
+  std::vector<BasicBlockId> forward;
+  ForwardEmptyBlocks(forward);
+
+  ControlFlowGraph cfg;
+  std::vector<BasicBlockId> new_ids(blocks_.size(), kInvalidBasicBlockId);
+  for (BasicBlockId id = 0; id < blocks_.size(); ++id) {
+    if (blocks_[id].has_code) {
+      new_ids[id] = static_cast<BasicBlockId>(cfg.blocks.size());
+      cfg.blocks.push_back({blocks_[id].begin, blocks_[id].end});
+    }
+  }
+  auto map_id = [&](BasicBlockId id) {
+    if (id == kInvalidBasicBlockId) {
+      return kInvalidBasicBlockId;
+    }
+    id = forward[id];
+    return id == kInvalidBasicBlockId ? id : new_ids[id];
+  };
+  cfg.start = map_id(start_);
+
+  // Count the edges of each block, then place them, keeping their order.
+  cfg.edge_offsets.assign(cfg.blocks.size() + 1, 0);
+  for (const auto& edge : edges_) {
+    if (blocks_[edge.from].has_code) {
+      cfg.edge_offsets[new_ids[edge.from] + 1]++;
+    }
+  }
+  for (size_t i = 1; i < cfg.edge_offsets.size(); ++i) {
+    cfg.edge_offsets[i] += cfg.edge_offsets[i - 1];
+  }
+  cfg.edges.resize(cfg.edge_offsets.back());
+  std::vector<u32> cursors(cfg.edge_offsets.begin(),
+                           cfg.edge_offsets.end() - 1);
+  for (const auto& edge : edges_) {
+    if (blocks_[edge.from].has_code) {
+      ControlFlowEdge result = edge.edge;
+      result.target = map_id(result.target);
+      cfg.edges[cursors[new_ids[edge.from]]++] = result;
+    }
+  }
+  return cfg;
+}
+
+}  // namespace
+
+auto BuildControlFlowGraph(const Code& code, ReadCtx& ctx)
+    -> ControlFlowGraph {
+  return BuildControlFlowGraph(code.body->data, ctx);
+}
+
+auto BuildControlFlowGraph(SpanU8 body, ReadCtx& ctx) -> ControlFlowGraph {
+  return Builder{body, ctx}.Build();
+}
+
+}  // namespace wasp::binary
@@ -254,21 +254,25 @@ optional<::wasp::Null> Null::Decode(u8 val) {
   }
 }
 
-// static
-bool Opcode::IsPrefixByte(u8 code, const Features& features) {
+namespace {
+
+// The opcode decoders are templated on their features, so they can be
+// instantiated both for a Features value and for a FixedFeatures set.
+template <typename F>
+constexpr bool IsPrefixByte(u8 code, const F& features) {
   switch (code) {
-    case GcPrefix:
+    case Opcode::GcPrefix:
       return features.gc_enabled();
 
-    case MiscPrefix:
+    case Opcode::MiscPrefix:
       return features.saturating_float_to_int_enabled() ||
              features.bulk_memory_enabled() ||
              features.reference_types_enabled();
 
-    case SimdPrefix:
+    case Opcode::SimdPrefix:
       return features.simd_enabled();
 
-    case ThreadsPrefix:
+    case Opcode::ThreadsPrefix:
       return features.threads_enabled();
 
     default:
@@ -276,28 +280,8 @@ bool Opcode::IsPrefixByte(u8 code, const Features& features) {
   }
 }
 
-// static
-EncodedOpcode Opcode::Encode(::wasp::Opcode decoded) {
-  switch (decoded) {
-#define WASP_V(prefix, code, Name, str) \
-  case ::wasp::Opcode::Name:            \
-    return {code, {}};
-#define WASP_FEATURE_V(prefix, code, Name, str, feature) \
-  WASP_V(prefix, code, Name, str)
-#define WASP_PREFIX_V(prefix, code, Name, str, feature) \
-  case ::wasp::Opcode::Name:                            \
-    return {prefix, code};
-#include "wasp/base/inc/opcode.inc"
-#undef WASP_V
-#undef WASP_FEATURE_V
-#undef WASP_PREFIX_V
-    default:
-      WASP_UNREACHABLE();
-  }
-}
-
-// static
-optional<::wasp::Opcode> Opcode::Decode(u8 code, const Features& features) {
+template <typename F>
+constexpr optional<::wasp::Opcode> DecodeOpcode(u8 code, const F& features) {
   switch (code) {
 #define WASP_V(prefix, code, Name, str) \
   case code:                            \
@@ -323,10 +307,10 @@ constexpr u64 MakePrefixCode(u8 prefix, u32 code) {
   return (u64{prefix} << 32) | code;
 }
 
-// static
-optional<::wasp::Opcode> Opcode::Decode(u8 prefix,
-                                        u32 code,
-                                        const Features& features) {
+template <typename F>
+constexpr optional<::wasp::Opcode> DecodeOpcode(u8 prefix,
+                                                u32 code,
+                                                const F& features) {
   switch (MakePrefixCode(prefix, code)) {
 #define WASP_V(...) /* Invalid. */
 #define WASP_FEATURE_V(...) /* Invalid. */
@@ -346,6 +330,137 @@ optional<::wasp::Opcode> Opcode::Decode(u8 prefix,
   return nullopt;
 }
 
+// Every prefixed opcode has a code that fits in a byte, so the prefixed
+// opcodes can be looked up in a table too.
+#define WASP_V(...) /* Not prefixed. */
+#define WASP_FEATURE_V(...) /* Not prefixed. */
+#define WASP_PREFIX_V(prefix, code, Name, str, feature) \
+  static_assert(prefix >= Opcode::GcPrefix &&           \
+                prefix <= Opcode::ThreadsPrefix && code < 256);
+#include "wasp/base/inc/opcode.inc"
+#undef WASP_V
+#undef WASP_FEATURE_V
+#undef WASP_PREFIX_V
+
+// The opcodes that are valid with a fixed set of features, computed at
+// compile time. Each entry is the opcode plus one, or zero if the code isn't a
+// valid opcode.
+template <Features::Bits kBits>
+struct OpcodeTable {
+  static constexpr int kPrefixCount =
+      Opcode::ThreadsPrefix - Opcode::GcPrefix + 1;
+
+  constexpr OpcodeTable() {
+    constexpr FixedFeatures<kBits> features{};
+    for (int code = 0; code < 256; ++code) {
+      is_prefix[code] = IsPrefixByte(code, features);
+      codes[code] = Entry(DecodeOpcode(code, features));
+      for (int prefix = 0; prefix < kPrefixCount; ++prefix) {
+        prefix_codes[prefix][code] =
+            Entry(DecodeOpcode(Opcode::GcPrefix + prefix, code, features));
+      }
+    }
+  }
+
+  static constexpr u16 Entry(optional<::wasp::Opcode> opcode) {
+    return opcode ? static_cast<u16>(*opcode) + 1 : 0;
+  }
+
+  static optional<::wasp::Opcode> ToOpcode(u16 entry) {
+    if (entry == 0) {
+      return nullopt;
+    }
+    return static_cast<::wasp::Opcode>(entry - 1);
+  }
+
+  optional<::wasp::Opcode> Decode(u8 code) const {
+    return ToOpcode(codes[code]);
+  }
+
+  optional<::wasp::Opcode> Decode(u8 prefix, u32 code) const {
+    u32 index = prefix - Opcode::GcPrefix;
+    if (index >= kPrefixCount || code >= 256) {
+      return nullopt;
+    }
+    return ToOpcode(prefix_codes[index][code]);
+  }
+
+  bool is_prefix[256] = {};
+  u16 codes[256] = {};
+  u16 prefix_codes[kPrefixCount][256] = {};
+};
+
+// Tables for the feature sets that are used most often, i.e. the defaults
+// and all features. Other feature sets use the switches above.
+constexpr OpcodeTable<kDefaultFeatureBits> kDefaultOpcodeTable;
+constexpr OpcodeTable<kAllFeatureBits> kAllOpcodeTable;
+
+}  // namespace
+
+// static
+bool Opcode::IsPrefixByte(u8 code, const Features& features) {
+  switch (features.bits()) {
+    case kDefaultFeatureBits:
+      return kDefaultOpcodeTable.is_prefix[code];
+
+    case kAllFeatureBits:
+      return kAllOpcodeTable.is_prefix[code];
+
+    default:
+      return encoding::IsPrefixByte(code, features);
+  }
+}
+
+// static
+EncodedOpcode Opcode::Encode(::wasp::Opcode decoded) {
+  switch (decoded) {
+#define WASP_V(prefix, code, Name, str) \
+  case ::wasp::Opcode::Name:            \
+    return {code, {}};
+#define WASP_FEATURE_V(prefix, code, Name, str, feature) \
+  WASP_V(prefix, code, Name, str)
+#define WASP_PREFIX_V(prefix, code, Name, str, feature) \
+  case ::wasp::Opcode::Name:                            \
+    return {prefix, code};
+#include "wasp/base/inc/opcode.inc"
+#undef WASP_V
+#undef WASP_FEATURE_V
+#undef WASP_PREFIX_V
+    default:
+      WASP_UNREACHABLE();
+  }
+}
+
+// static
+optional<::wasp::Opcode> Opcode::Decode(u8 code, const Features& features) {
+  switch (features.bits()) {
+    case kDefaultFeatureBits:
+      return kDefaultOpcodeTable.Decode(code);
+
+    case kAllFeatureBits:
+      return kAllOpcodeTable.Decode(code);
+
+    default:
+      return DecodeOpcode(code, features);
+  }
+}
+
+// static
+optional<::wasp::Opcode> Opcode::Decode(u8 prefix,
+                                        u32 code,
+                                        const Features& features) {
+  switch (features.bits()) {
+    case kDefaultFeatureBits:
+      return kDefaultOpcodeTable.Decode(prefix, code);
+
+    case kAllFeatureBits:
+      return kAllOpcodeTable.Decode(prefix, code);
+
+    default:
+      return DecodeOpcode(prefix, code, features);
+  }
+}
+
 // static
 bool RefType::Is(u8 val) {
   return val == Ref || val == RefNull;
@@ -419,6 +419,11 @@ std::ostream& operator<<(std::ostream& os, const ::wasp::binary::Code& self) {
   return os << "{locals " << self.locals << ", body " << self.body << "}";
 }
 
+std::ostream& operator<<(std::ostream& os,
+                         const ::wasp::binary::CodeView& self) {
+  return os << "{locals " << self.locals << ", body " << self.body << "}";
+}
+
 std::ostream& operator<<(std::ostream& os,
                          const ::wasp::binary::DataSegment& self) {
   os << "{init " << self.init << ", mode ";
@@ -0,0 +1,41 @@
+//
+// Copyright 2018 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/lazy_locals.h"
+
+#include <utility>
+
+#include "wasp/base/errors_context_guard.h"
+#include "wasp/binary/read/macros.h"
+#include "wasp/binary/read/read_ctx.h"
+#include "wasp/binary/read/read_vector.h"
+
+namespace wasp::binary {
+
+LazyLocals ReadLocals(const CodeView& view, ReadCtx& ctx) {
+  ctx.local_count = 0;
+  return LazyLocals{view.locals, "locals vector", ctx};
+}
+
+OptAt<Code> ToCode(const At<CodeView>& view, ReadCtx& ctx) {
+  ErrorsContextGuard error_guard{ctx.errors, view.loc(), "code"};
+  SpanU8 data = view->locals;
+  ctx.local_count = 0;
+  WASP_TRY_READ(locals, ReadVector<Locals>(&data, ctx, "locals vector"));
+  return At{view.loc(), Code{std::move(locals), view->body}};
+}
+
+}  // namespace wasp::binary
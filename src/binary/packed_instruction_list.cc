@@ -0,0 +1,384 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/packed_instruction_list.h"
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+#include "wasp/base/macros.h"
+
+namespace wasp::binary {
+
+namespace {
+
+// How a BlockType is stored in Record::hi.
+enum : u32 {
+  kBlockTypeVoid,
+  kBlockTypeNumeric,  // lo is the NumericType.
+  kBlockTypeIndex,    // lo is the type index.
+  kBlockTypeOther,    // lo is an index into others_.
+};
+
+// How a HeapType is stored in Record::hi.
+enum : u32 {
+  kHeapTypeKind,   // lo is the HeapKind.
+  kHeapTypeIndex,  // lo is the type index.
+};
+
+template <typename T>
+u64 ToBits(T value) {
+  static_assert(sizeof(T) <= sizeof(u64));
+  u64 bits = 0;
+  memcpy(&bits, &value, sizeof(T));
+  return bits;
+}
+
+template <typename T>
+T FromBits(u64 bits) {
+  T value;
+  memcpy(&value, &bits, sizeof(T));
+  return value;
+}
+
+u32 ToU32(size_t value) {
+  assert(value <= std::numeric_limits<u32>::max());
+  return static_cast<u32>(value);
+}
+
+}  // namespace
+
+PackedInstructionList::PackedInstructionList(const InstructionList& instrs) {
+  reserve(instrs.size());
+  for (auto&& instr : instrs) {
+    push_back(instr);
+  }
+}
+
+void PackedInstructionList::push_back(const Instruction& instr) {
+  Record record{instr.opcode, static_cast<u8>(instr.kind()), 0, 0};
+  auto set_u64 = [&](u64 bits) {
+    record.lo = static_cast<u32>(bits);
+    record.hi = static_cast<u32>(bits >> 32);
+  };
+
+  switch (instr.kind()) {
+    case InstructionKind::None:
+      break;
+
+    case InstructionKind::S32:
+      record.lo = static_cast<u32>(*instr.s32_immediate());
+      break;
+
+    case InstructionKind::S64:
+      set_u64(ToBits(*instr.s64_immediate()));
+      break;
+
+    case InstructionKind::F32:
+      set_u64(ToBits(*instr.f32_immediate()));
+      break;
+
+    case InstructionKind::F64:
+      set_u64(ToBits(*instr.f64_immediate()));
+      break;
+
+    case InstructionKind::V128:
+      record.lo = ToU32(v128s_.size());
+      v128s_.push_back(*instr.v128_immediate());
+      break;
+
+    case InstructionKind::Shuffle:
+      record.lo = ToU32(v128s_.size());
+      v128s_.push_back(v128{*instr.shuffle_immediate()});
+      break;
+
+    case InstructionKind::Index:
+      record.lo = *instr.index_immediate();
+      break;
+
+    case InstructionKind::BlockType: {
+      auto&& block_type = *instr.block_type_immediate();
+      if (block_type.is_void()) {
+        record.hi = kBlockTypeVoid;
+      } else if (block_type.is_index()) {
+        record.hi = kBlockTypeIndex;
+        record.lo = *block_type.index();
+      } else if (block_type.value_type()->is_numeric_type()) {
+        record.hi = kBlockTypeNumeric;
+        record.lo = static_cast<u32>(*block_type.value_type()->numeric_type());
+      } else {
+        record.hi = kBlockTypeOther;
+        record.lo = AddOther(instr);
+      }
+      break;
+    }
+
+    case InstructionKind::BrOnExn: {
+      auto&& immediate = *instr.br_on_exn_immediate();
+      record.lo = *immediate.target;
+      record.hi = *immediate.event_index;
+      break;
+    }
+
+    case InstructionKind::BrTable: {
+      auto&& immediate = *instr.br_table_immediate();
+      record.lo = ToU32(indexes_.size());
+      record.hi = ToU32(immediate.targets.size());
+      for (auto&& target : immediate.targets) {
+        indexes_.push_back(*target);
+      }
+      indexes_.push_back(*immediate.default_target);
+      break;
+    }
+
+    case InstructionKind::CallIndirect: {
+      auto&& immediate = *instr.call_indirect_immediate();
+      record.lo = *immediate.index;
+      record.hi = *immediate.table_index;
+      break;
+    }
+
+    case InstructionKind::Copy: {
+      auto&& immediate = *instr.copy_immediate();
+      record.lo = *immediate.dst_index;
+      record.hi = *immediate.src_index;
+      break;
+    }
+
+    case InstructionKind::Init: {
+      auto&& immediate = *instr.init_immediate();
+      record.lo = *immediate.segment_index;
+      record.hi = *immediate.dst_index;
+      break;
+    }
+
+    case InstructionKind::MemArg: {
+      auto&& immediate = *instr.mem_arg_immediate();
+      record.lo = *immediate.align_log2;
+      record.hi = *immediate.offset;
+      break;
+    }
+
+    case InstructionKind::HeapType: {
+      auto&& heap_type = *instr.heap_type_immediate();
+      if (heap_type.is_heap_kind()) {
+        record.hi = kHeapTypeKind;
+        record.lo = static_cast<u32>(*heap_type.heap_kind());
+      } else {
+        record.hi = kHeapTypeIndex;
+        record.lo = *heap_type.index();
+      }
+      break;
+    }
+
+    case InstructionKind::Select: {
+      auto&& immediate = *instr.select_immediate();
+      record.lo = ToU32(value_types_.size());
+      record.hi = ToU32(immediate.size());
+      value_types_.insert(value_types_.end(), immediate.begin(),
+                          immediate.end());
+      break;
+    }
+
+    case InstructionKind::SimdLane:
+      record.lo = *instr.simd_lane_immediate();
+      break;
+
+    case InstructionKind::FuncBind:
+      record.lo = *instr.func_bind_immediate()->index;
+      break;
+
+    case InstructionKind::StructField: {
+      auto&& immediate = *instr.struct_field_immediate();
+      record.lo = *immediate.struct_;
+      record.hi = *immediate.field;
+      break;
+    }
+
+    case InstructionKind::Let:
+    case InstructionKind::BrOnCast:
+    case InstructionKind::HeapType2:
+    case InstructionKind::RttSub:
+      record.lo = AddOther(instr);
+      break;
+  }
+  records_.push_back(record);
+}
+
+void PackedInstructionList::reserve(size_t size) {
+  records_.reserve(size);
+}
+
+void PackedInstructionList::clear() {
+  records_.clear();
+  indexes_.clear();
+  value_types_.clear();
+  v128s_.clear();
+  others_.clear();
+}
+
+Instruction PackedInstructionList::operator[](size_t index) const {
+  const Record& record = records_[index];
+  At<Opcode> opcode{record.opcode};
+  u64 bits = (u64{record.hi} << 32) | record.lo;
+
+  switch (static_cast<InstructionKind>(record.kind)) {
+    case InstructionKind::None:
+      return Instruction{opcode};
+
+    case InstructionKind::S32:
+      return Instruction{opcode, At{static_cast<s32>(record.lo)}};
+
+    case InstructionKind::S64:
+      return Instruction{opcode, At{FromBits<s64>(bits)}};
+
+    case InstructionKind::F32:
+      return Instruction{opcode, At{FromBits<f32>(bits)}};
+
+    case InstructionKind::F64:
+      return Instruction{opcode, At{FromBits<f64>(bits)}};
+
+    case InstructionKind::V128:
+      return Instruction{opcode, At{v128s_[record.lo]}};
+
+    case InstructionKind::Shuffle:
+      return Instruction{
+          opcode, At{ShuffleImmediate{v128s_[record.lo].as<u8x16>()}}};
+
+    case InstructionKind::Index:
+      return Instruction{opcode, At{Index{record.lo}}};
+
+    case InstructionKind::BlockType:
+      switch (record.hi) {
+        case kBlockTypeVoid:
+          return Instruction{opcode, At{BlockType{At{VoidType{}}}}};
+        case kBlockTypeNumeric:
+          return Instruction{
+              opcode,
+              At{BlockType{At{ValueType{
+                  At{static_cast<NumericType>(record.lo)}}}}}};
+        case kBlockTypeIndex:
+          return Instruction{opcode, At{BlockType{At{Index{record.lo}}}}};
+        default:
+          return others_[record.lo];
+      }
+
+    case InstructionKind::BrOnExn:
+      return Instruction{opcode, At{BrOnExnImmediate{record.lo, record.hi}}};
+
+    case InstructionKind::BrTable: {
+      IndexList targets(indexes_.begin() + record.lo,
+                        indexes_.begin() + record.lo + record.hi);
+      return Instruction{
+          opcode, At{BrTableImmediate{std::move(targets),
+                                      indexes_[record.lo + record.hi]}}};
+    }
+
+    case InstructionKind::CallIndirect:
+      return Instruction{opcode,
+                         At{CallIndirectImmediate{record.lo, record.hi}}};
+
+    case InstructionKind::Copy:
+      return Instruction{opcode, At{CopyImmediate{record.lo, record.hi}}};
+
+    case InstructionKind::Init:
+      return Instruction{opcode, At{InitImmediate{record.lo, record.hi}}};
+
+    case InstructionKind::MemArg:
+      return Instruction{opcode, At{MemArgImmediate{record.lo, record.hi}}};
+
+    case InstructionKind::HeapType:
+      if (record.hi == kHeapTypeKind) {
+        return Instruction{
+            opcode, At{HeapType{At{static_cast<HeapKind>(record.lo)}}}};
+      }
+      return Instruction{opcode, At{HeapType{At{Index{record.lo}}}}};
+
+    case InstructionKind::Select:
+      return Instruction{
+          opcode,
+          At{SelectImmediate(value_types_.begin() + record.lo,
+                             value_types_.begin() + record.lo + record.hi)}};
+
+    case InstructionKind::SimdLane:
+      return Instruction{opcode,
+                         At{static_cast<SimdLaneImmediate>(record.lo)}};
+
+    case InstructionKind::FuncBind:
+      return Instruction{opcode, At{FuncBindImmediate{record.lo}}};
+
+    case InstructionKind::StructField:
+      return Instruction{opcode,
+                         At{StructFieldImmediate{record.lo, record.hi}}};
+
+    case InstructionKind::Let:
+    case InstructionKind::BrOnCast:
+    case InstructionKind::HeapType2:
+    case InstructionKind::RttSub:
+      return others_[record.lo];
+  }
+  WASP_UNREACHABLE();
+}
+
+InstructionList PackedInstructionList::ToInstructionList() const {
+  InstructionList result;
+  result.reserve(size());
+  for (size_t i = 0; i < size(); ++i) {
+    result.push_back((*this)[i]);
+  }
+  return result;
+}
+
+size_t PackedInstructionList::memory_size() const {
+  size_t result = records_.capacity() * sizeof(Record) +
+                  indexes_.capacity() * sizeof(Index) +
+                  value_types_.capacity() * sizeof(At<ValueType>) +
+                  v128s_.capacity() * sizeof(v128) +
+                  others_.capacity() * sizeof(Instruction);
+  for (auto&& instr : others_) {
+    if (instr.has_let_immediate()) {
+      result += instr.let_immediate()->locals.capacity() * sizeof(At<Locals>);
+    }
+  }
+  return result;
+}
+
+u32 PackedInstructionList::AddOther(const Instruction& instr) {
+  u32 index = ToU32(others_.size());
+  others_.push_back(instr);
+  return index;
+}
+
+bool operator==(const PackedInstructionList& lhs,
+                const PackedInstructionList& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    if (lhs[i] != rhs[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool operator!=(const PackedInstructionList& lhs,
+                const PackedInstructionList& rhs) {
+  return !(lhs == rhs);
+}
+
+}  // namespace wasp::binary
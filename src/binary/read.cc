@@ -17,7 +17,6 @@
 #include "wasp/binary/read.h"
 
 #include <cassert>
-#include <limits>
 
 #include "wasp/base/errors.h"
 #include "wasp/base/errors_context_guard.h"
@@ -90,7 +89,8 @@ OptAt<BrTableImmediate> Read(SpanU8* data,
                              Tag<BrTableImmediate>) {
   ErrorsContextGuard error_guard{ctx.errors, *data, "br_table"};
   LocationGuard guard{data};
-  WASP_TRY_READ(targets, ReadVector<Index>(data, ctx, "targets"));
+  WASP_TRY_READ(targets, ReadVector<Index>(data, ctx, "targets",
+                                           ctx.limits.max_br_table_targets));
   WASP_TRY_READ(default_target, ReadIndex(data, ctx, "default target"));
   return At{guard.range(data),
             BrTableImmediate{std::move(targets), default_target}};
@@ -98,6 +98,7 @@ OptAt<BrTableImmediate> Read(SpanU8* data,
 
 OptAt<SpanU8> ReadBytes(SpanU8* data, span_extent_t N, ReadCtx& ctx) {
   if (data->size() < N) {
+    ctx.truncated_at = data->end();
     ctx.errors.OnError(*data, concat("Unable to read ", N, " bytes"));
     return nullopt;
   }
@@ -147,6 +148,7 @@ OptAt<Index> ReadCheckLength(SpanU8* data,
   // There should be at least one byte per count, so if the data is smaller
   // than that, the module must be malformed.
   if (count > data->size()) {
+    ctx.truncated_at = data->end();
     ctx.errors.OnError(
         count.loc(),
         concat(error_name, " extends past end: ", count, " > ", data->size()));
@@ -169,6 +171,22 @@ OptAt<Code> Read(SpanU8* data, ReadCtx& ctx, Tag<Code>) {
   return At{guard.range(data), Code{std::move(locals), expression}};
 }
 
+OptAt<CodeView> Read(SpanU8* data, ReadCtx& ctx, Tag<CodeView>) {
+  ErrorsContextGuard error_guard{ctx.errors, *data, "code"};
+  LocationGuard guard{data};
+  ctx.code_count++;
+  ctx.local_count = 0;
+  WASP_TRY_READ(body_size, ReadLength(data, ctx));
+  WASP_TRY_READ(body, ReadBytes(data, body_size, ctx));
+  const u8* locals_begin = body->begin();
+  if (!SkipVector<Locals>(&*body, ctx, "locals vector")) {
+    return nullopt;
+  }
+  auto expression = At{body, Expression{*body}};
+  return At{guard.range(data),
+            CodeView{MakeSpan(locals_begin, body->begin()), expression}};
+}
+
 OptAt<ConstantExpression> Read(SpanU8* data,
                                ReadCtx& ctx,
                                Tag<ConstantExpression>) {
@@ -278,8 +296,11 @@ OptAt<ElementExpression> Read(SpanU8* data,
   Features new_features;
   new_features.enable_reference_types();
   ReadCtx new_context{new_features, ctx.errors};
+  new_context.limits = ctx.limits;
+  new_context.allocated_bytes = ctx.allocated_bytes;
 
   WASP_TRY_READ(instrs, Read<InstructionList>(data, new_context));
+  ctx.allocated_bytes = new_context.allocated_bytes;
   return At{instrs.loc(), ElementExpression{*instrs}};
 }
 
@@ -464,6 +485,11 @@ OptAt<Function> Read(SpanU8* data, ReadCtx& ctx, Tag<Function>) {
   ErrorsContextGuard error_guard{ctx.errors, *data, "function"};
   LocationGuard guard{data};
   ctx.defined_function_count++;
+  if (ctx.defined_function_count > ctx.limits.max_functions) {
+    ctx.errors.OnError(*data, concat("Too many functions; max is ",
+                                     ctx.limits.max_functions));
+    return nullopt;
+  }
   WASP_TRY_READ(type_index, ReadIndex(data, ctx, "type index"));
   return At{guard.range(data), Function{type_index}};
 }
@@ -578,6 +604,17 @@ bool RequireDataCountSection(ReadCtx& ctx, const At<Opcode>& opcode) {
   return true;
 }
 
+bool PushOpenBlock(ReadCtx& ctx, const At<Opcode>& opcode) {
+  if (ctx.open_blocks.size() >= ctx.limits.max_block_depth) {
+    ctx.errors.OnError(opcode.loc(),
+                       concat("Too many nested blocks; max is ",
+                              ctx.limits.max_block_depth));
+    return false;
+  }
+  ctx.open_blocks.push_back(opcode);
+  return true;
+}
+
 OptAt<Instruction> Read(SpanU8* data, ReadCtx& ctx, Tag<Instruction>) {
   LocationGuard guard{data};
   WASP_TRY_READ(opcode, Read<Opcode>(data, ctx));
@@ -953,7 +990,9 @@ OptAt<Instruction> Read(SpanU8* data, ReadCtx& ctx, Tag<Instruction>) {
     case Opcode::If:
     case Opcode::Try: {
       WASP_TRY_READ(type, Read<BlockType>(data, ctx));
-      ctx.open_blocks.push_back(opcode);
+      if (!PushOpenBlock(ctx, opcode)) {
+        return nullopt;
+      }
       return At{guard.range(data), Instruction{opcode, type}};
     }
 
@@ -1227,7 +1266,9 @@ OptAt<Instruction> Read(SpanU8* data, ReadCtx& ctx, Tag<Instruction>) {
     // Let immediate.
     case Opcode::Let: {
       WASP_TRY_READ(immediate, Read<LetImmediate>(data, ctx));
-      ctx.open_blocks.push_back(opcode);
+      if (!PushOpenBlock(ctx, opcode)) {
+        return nullopt;
+      }
       return At{guard.range(data), Instruction{opcode, immediate}};
     }
 
@@ -1285,6 +1326,9 @@ OptAt<InstructionList> Read(SpanU8* data, ReadCtx& ctx, Tag<InstructionList>) {
     if (ctx.seen_final_end) {
       break;
     }
+    if (!ctx.Allocate(instr.loc(), sizeof(instr))) {
+      return nullopt;
+    }
     instrs.push_back(instr);
   }
   return At{guard.range(data), instrs};
@@ -1331,7 +1375,8 @@ OptAt<Locals> Read(SpanU8* data, ReadCtx& ctx, Tag<Locals>) {
   WASP_TRY_READ(count, ReadIndex(data, ctx, "count"));
 
   ctx.local_count += count;
-  if (ctx.local_count > std::numeric_limits<u32>::max()) {
+  // max_locals is at most the largest u32, so this also catches overflow.
+  if (ctx.local_count > ctx.limits.max_locals) {
     ctx.errors.OnError(count.loc(),
                        concat("Too many locals: ", ctx.local_count));
     return nullopt;
@@ -1548,6 +1593,7 @@ OptAt<u32> Read(SpanU8* data, ReadCtx& ctx, Tag<u32>) {
 
 auto PeekU8(SpanU8* data, ReadCtx& ctx) -> OptAt<u8> {
   if (data->size() < 1) {
+    ctx.truncated_at = data->end();
     ctx.errors.OnError(*data, "Unable to read u8");
     return nullopt;
   }
@@ -16,6 +16,9 @@
 
 #include "wasp/binary/read/read_ctx.h"
 
+#include "wasp/base/concat.h"
+#include "wasp/base/errors.h"
+
 namespace wasp::binary {
 
 ReadCtx::ReadCtx(Errors& errors) : errors(errors) {}
@@ -29,6 +32,19 @@ void ReadCtx::Reset() {
   declared_data_count.reset();
   code_count = 0;
   data_count = 0;
+  allocated_bytes = 0;
+  truncated_at = nullptr;
+}
+
+bool ReadCtx::Allocate(Location loc, u64 size) {
+  if (size > limits.max_allocated_bytes - allocated_bytes) {
+    errors.OnError(loc, concat("Allocation of ", size, " bytes exceeds limit; ",
+                               allocated_bytes, " of ",
+                               limits.max_allocated_bytes, " bytes used"));
+    return false;
+  }
+  allocated_bytes += size;
+  return true;
 }
 
 }  // namespace wasp::binary
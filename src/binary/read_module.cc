@@ -16,18 +16,84 @@
 
 #include "wasp/binary/read.h"
 
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "wasp/base/errors_buffer.h"
 #include "wasp/base/errors_context_guard.h"
+#include "wasp/base/parallel.h"
+#include "wasp/binary/lazy_expression.h"
 #include "wasp/binary/lazy_module.h"
 #include "wasp/binary/read/location_guard.h"
 #include "wasp/binary/read/macros.h"
+#include "wasp/binary/sequence_range.h"
 #include "wasp/binary/visitor.h"
 
 namespace wasp::binary {
 
 using visit::Result;
 
-struct EagerModuleVisitor : visit::Visitor {
-  explicit EagerModuleVisitor(Module& module) : module{module} {}
+namespace {
+
+// Instructions average a little under two bytes, so this is a cheap guess at
+// how many instructions a body has, to avoid regrowing the vector.
+size_t InstructionCountHint(const Code& code) {
+  return code.body->data.size() / 2;
+}
+
+// A range of the code section that is read on its own thread. The errors are
+// buffered, so they can be reported in order once all ranges are read.
+struct CodeRange {
+  std::vector<At<UnpackedCode>> codes;
+  ErrorsBuffer errors;
+  // Where a function body couldn't be read, if one couldn't. As with
+  // LazySequence, the rest of the section is not read.
+  const u8* failed_pos = nullptr;
+};
+
+// `section_end` is the end of the code section. Each body is read from the
+// rest of the section rather than the rest of the range, so the locations of
+// errors and their contexts are the same as when reading sequentially.
+void ReadCodeRange(const SequenceRange& range,
+                   const u8* section_end,
+                   const ReadCtx& module_ctx,
+                   Index first_code_index,
+                   CodeRange& out) {
+  ReadCtx ctx{module_ctx.features, out.errors};
+  ctx.limits = module_ctx.limits;
+  ctx.defined_function_count = module_ctx.defined_function_count;
+  ctx.declared_data_count = module_ctx.declared_data_count;
+  ctx.code_count = first_code_index + range.first_index;
+
+  out.codes.reserve(range.count);
+  SpanU8 data = MakeSpan(range.data.begin(), section_end);
+  while (data.begin() != range.data.end()) {
+    const u8* pos = data.begin();
+    auto opt_code = Read<Code>(&data, ctx);
+    if (!opt_code) {
+      out.failed_pos = pos;
+      break;
+    }
+    const At<Code>& code = *opt_code;
+    UnpackedCode unpacked{code->locals, {}};
+    auto& instructions = unpacked.body.instructions;
+    instructions.reserve(InstructionCountHint(*code));
+    for (auto&& instr : ReadExpression(*code->body, ctx)) {
+      instructions.push_back(instr);
+    }
+    EndCode(code->body->data.last(0), ctx);
+    out.codes.push_back(At{code.loc(), std::move(unpacked)});
+  }
+}
+
+}  // namespace
+
+// LazySequenceBase is used to report count mismatches the same way
+// LazySequence does.
+struct EagerModuleVisitor : visit::Visitor, LazySequenceBase {
+  explicit EagerModuleVisitor(Module& module, u32 thread_count)
+      : module{module}, thread_count{thread_count} {}
 
   auto OnType(const At<DefinedType>& type) -> Result {
     module.types.push_back(type);
@@ -84,8 +150,75 @@ struct EagerModuleVisitor : visit::Visitor {
     return Result::Ok;
   }
 
+  auto BeginCodeSection(LazyCodeSection sec) -> Result {
+    ReadCtx& ctx = sec.sequence.ctx();
+    // The allocation limit is checked against a running total, so it can
+    // only be checked in order.
+    if (thread_count == 1 || !sec.count ||
+        ctx.limits.max_allocated_bytes !=
+            std::numeric_limits<u64>::max()) {
+      return Result::Ok;
+    }
+    ReadCodeSectionParallel(sec);
+    // The section is skipped, so Visit adds its count to code_count; adjust
+    // code_count so it ends up the same as when reading sequentially.
+    ctx.code_count -= sec.count->value();
+    return Result::Skip;
+  }
+
+  void ReadCodeSectionParallel(const LazyCodeSection& sec) {
+    ReadCtx& ctx = sec.sequence.ctx();
+    SpanU8 data = sec.sequence.data();
+
+    // Errors found while splitting are dropped; the same errors are reported
+    // below, by reading the body where the split stopped.
+    ErrorsBuffer split_errors;
+    ReadCtx split_ctx{ctx.features, split_errors};
+    auto ranges = SplitSequence(LazySequence<Code>{data, split_ctx},
+                                thread_count * 4);
+
+    std::vector<CodeRange> results(ranges.size());
+    Index first_code_index = ctx.code_count;
+    ParallelFor(ranges.size(), thread_count, [&](u32, size_t i) {
+      ReadCodeRange(ranges[i], data.end(), ctx, first_code_index, results[i]);
+    });
+
+    // Assemble the bodies and report the errors in order, stopping at the
+    // first body that couldn't be read, as reading sequentially does.
+    Index count = 0;
+    const u8* end_pos = data.begin();
+    const u8* failed_pos = nullptr;
+    for (size_t i = 0; i < ranges.size() && !failed_pos; ++i) {
+      auto& result = results[i];
+      result.errors.ReplayTo(ctx.errors);
+      count += static_cast<Index>(result.codes.size());
+      for (auto& code : result.codes) {
+        module.codes.push_back(std::move(code));
+      }
+      failed_pos = result.failed_pos;
+      end_pos = ranges[i].data.end();
+    }
+    if (!failed_pos && end_pos != data.end()) {
+      ctx.code_count = first_code_index + count;
+      SpanU8 rest = MakeSpan(end_pos, data.end());
+      Read<Code>(&rest, ctx);
+      failed_pos = end_pos;
+    }
+    // Read<Code> counts a body before reading it, so one that couldn't be
+    // read is counted too.
+    ctx.code_count = first_code_index + count + (failed_pos ? 1 : 0);
+
+    auto expected_count = sec.sequence.expected_count();
+    if (expected_count && count != *expected_count) {
+      const u8* pos = failed_pos ? failed_pos : data.end();
+      OnCountError(ctx.errors, MakeSpan(pos, data.end()),
+                   sec.sequence.name(), *expected_count, count);
+    }
+  }
+
   auto BeginCode(const At<Code>& code) -> Result {
     module.codes.push_back(At{code.loc(), UnpackedCode{code->locals, {}}});
+    module.codes.back()->body.instructions.reserve(InstructionCountHint(*code));
     return Result::Ok;
   }
 
@@ -100,9 +233,11 @@ struct EagerModuleVisitor : visit::Visitor {
   }
 
   Module& module;
+  u32 thread_count;
 };
 
-auto ReadModule(SpanU8 data, ReadCtx& ctx) -> optional<Module> {
+auto ReadModule(SpanU8 data, ReadCtx& ctx, u32 thread_count)
+    -> optional<Module> {
   ErrorsContextGuard error_guard{ctx.errors, data, "module"};
   LazyModule lazy_module{data, ctx.features, ctx.errors};
   if (!(lazy_module.magic.has_value() && lazy_module.version.has_value())) {
@@ -110,7 +245,7 @@ auto ReadModule(SpanU8 data, ReadCtx& ctx) -> optional<Module> {
   }
 
   Module module;
-  EagerModuleVisitor visitor{module};
+  EagerModuleVisitor visitor{module, GetThreadCount(thread_count)};
   if (Visit(lazy_module, visitor) == Result::Fail || ctx.errors.HasError()) {
     return nullopt;
   }
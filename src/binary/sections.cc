@@ -29,6 +29,15 @@ auto ReadCodeSection(KnownSection sec, ReadCtx& ctx) -> LazyCodeSection {
   return ReadCodeSection(sec.data, ctx);
 }
 
+auto ReadCodeViewSection(SpanU8 data, ReadCtx& ctx) -> LazyCodeViewSection {
+  return LazyCodeViewSection{data, "code section", ctx};
+}
+
+auto ReadCodeViewSection(KnownSection sec, ReadCtx& ctx)
+    -> LazyCodeViewSection {
+  return ReadCodeViewSection(sec.data, ctx);
+}
+
 auto ReadDataSection(SpanU8 data, ReadCtx& ctx) -> LazyDataSection {
   return LazyDataSection{data, "data section", ctx};
 }
@@ -0,0 +1,110 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/sequence_range.h"
+
+#include <cassert>
+
+#include "wasp/binary/read.h"
+
+namespace wasp::binary {
+
+namespace {
+
+// Reads past one item of a sequence, without decoding it.
+using SkipItemFunc = bool (*)(SpanU8*, ReadCtx&);
+
+bool SkipLengthPrefixed(SpanU8* data, ReadCtx& ctx) {
+  auto length = ReadLength(data, ctx);
+  return length && ReadBytes(data, *length, ctx);
+}
+
+// Subsections start with a one byte id. The id isn't validated here, since it
+// doesn't affect the framing.
+bool SkipSubsection(SpanU8* data, ReadCtx& ctx) {
+  return Read<u8>(data, ctx) && SkipLengthPrefixed(data, ctx);
+}
+
+// Used to report count mismatches the same way LazySequence does.
+struct Splitter : LazySequenceBase {
+  template <typename T>
+  static auto Split(const LazySequence<T>& sequence,
+                    Index max_count,
+                    SkipItemFunc skip) -> SequenceRangeList {
+    assert(max_count > 0);
+    SpanU8 data = sequence.data();
+    ReadCtx& ctx = sequence.ctx();
+    const u8* const begin = data.begin();
+    const size_t size = data.size();
+
+    SequenceRangeList result;
+    const u8* range_begin = begin;
+    Index range_first_index = 0;
+    Index index = 0;
+    auto close_range = [&]() {
+      result.push_back(SequenceRange{MakeSpan(range_begin, data.begin()),
+                                     range_first_index,
+                                     index - range_first_index});
+      range_begin = data.begin();
+      range_first_index = index;
+    };
+
+    while (!data.empty()) {
+      if (!skip(&data, ctx)) {
+        break;
+      }
+      ++index;
+      // Close the current range once it reaches its share of the bytes.
+      size_t offset = data.begin() - begin;
+      if (offset >= size * (result.size() + 1) / max_count) {
+        close_range();
+      }
+    }
+    if (index != range_first_index) {
+      close_range();
+    }
+
+    auto expected_count = sequence.expected_count();
+    if (expected_count && index != *expected_count) {
+      OnCountError(ctx.errors, data, sequence.name(), *expected_count, index);
+    }
+    return result;
+  }
+};
+
+}  // namespace
+
+auto SplitSequence(const LazySequence<Code>& sequence, Index max_count)
+    -> SequenceRangeList {
+  return Splitter::Split(sequence, max_count, SkipLengthPrefixed);
+}
+
+auto SplitSequence(const LazySequence<CodeView>& sequence, Index max_count)
+    -> SequenceRangeList {
+  return Splitter::Split(sequence, max_count, SkipLengthPrefixed);
+}
+
+auto SplitSequence(const LazySequence<NameSubsection>& sequence,
+                   Index max_count) -> SequenceRangeList {
+  return Splitter::Split(sequence, max_count, SkipSubsection);
+}
+
+auto SplitSequence(const LazySequence<LinkingSubsection>& sequence,
+                   Index max_count) -> SequenceRangeList {
+  return Splitter::Split(sequence, max_count, SkipSubsection);
+}
+
+}  // namespace wasp::binary
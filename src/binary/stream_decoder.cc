@@ -0,0 +1,268 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/stream_decoder.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "wasp/base/concat.h"
+#include "wasp/base/errors_context_guard.h"
+#include "wasp/binary/formatters.h"
+#include "wasp/binary/read.h"
+
+namespace wasp::binary {
+
+StreamDecoderBase::SpeculativeErrors::SpeculativeErrors(Errors& errors)
+    : errors_{errors} {}
+
+void StreamDecoderBase::SpeculativeErrors::BeginSpeculation() {
+  assert(!speculating_);
+  speculating_ = true;
+}
+
+void StreamDecoderBase::SpeculativeErrors::Commit() {
+  assert(speculating_);
+  speculating_ = false;
+  buffer_.ReplayTo(errors_);
+  buffer_.Clear();
+}
+
+void StreamDecoderBase::SpeculativeErrors::Rollback() {
+  assert(speculating_);
+  speculating_ = false;
+  buffer_.Clear();
+}
+
+void StreamDecoderBase::SpeculativeErrors::HandlePushContext(
+    Location loc,
+    string_view desc) {
+  if (speculating_) {
+    buffer_.PushContext(loc, desc);
+  } else {
+    errors_.PushContext(loc, desc);
+  }
+}
+
+void StreamDecoderBase::SpeculativeErrors::HandlePopContext() {
+  if (speculating_) {
+    buffer_.PopContext();
+  } else {
+    errors_.PopContext();
+  }
+}
+
+void StreamDecoderBase::SpeculativeErrors::HandleOnError(Location loc,
+                                                         string_view message) {
+  if (speculating_) {
+    buffer_.OnError(loc, message);
+  } else {
+    errors_.OnError(loc, message);
+  }
+}
+
+StreamDecoderBase::StreamDecoderBase(const Features& features, Errors& errors)
+    : features_{features}, errors_{errors} {}
+
+size_t StreamDecoderBase::stream_offset(const u8* ptr) const {
+  auto in = [&](const u8* begin, size_t size) {
+    return ptr >= begin && ptr <= begin + size;
+  };
+  if (in(header_.data(), header_.size())) {
+    return ptr - header_.data();
+  } else if (in(count_bytes_.data(), count_bytes_.size())) {
+    return count_offset_ + (ptr - count_bytes_.data());
+  }
+  assert(in(buffer_.data(), buffer_.size()));
+  return buffer_offset_ + (ptr - buffer_.data());
+}
+
+bool StreamDecoderBase::in_section() const {
+  switch (state_) {
+    case State::SectionCount:
+    case State::Items:
+    case State::WholeSection:
+    case State::SkipSection:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+SpanU8 StreamDecoderBase::window() const {
+  SpanU8 data{buffer_.data() + pos_, buffer_.size() - pos_};
+  if (in_section() && data.size() > section_remaining_) {
+    data = data.first(section_remaining_);
+  }
+  return data;
+}
+
+bool StreamDecoderBase::is_final() const {
+  if (in_section()) {
+    return buffered_size() >= section_remaining_;
+  }
+  return finished_;
+}
+
+void StreamDecoderBase::Append(SpanU8 chunk) {
+  buffer_.insert(buffer_.end(), chunk.begin(), chunk.end());
+}
+
+void StreamDecoderBase::Consume(size_t size) {
+  assert(size <= buffered_size());
+  pos_ += size;
+  if (in_section()) {
+    assert(size <= section_remaining_);
+    section_remaining_ -= size;
+  }
+  retry_size_ = 0;
+}
+
+void StreamDecoderBase::Compact() {
+  buffer_.erase(buffer_.begin(), buffer_.begin() + pos_);
+  buffer_offset_ += pos_;
+  pos_ = 0;
+}
+
+auto StreamDecoderBase::SaveCtx() -> CtxState {
+  auto& ctx = this->ctx();
+  return CtxState{ctx.last_section_id,     ctx.defined_function_count,
+                  ctx.declared_data_count, ctx.code_count,
+                  ctx.data_count,          ctx.local_count,
+                  ctx.open_blocks,         ctx.seen_final_end,
+                  ctx.allocated_bytes};
+}
+
+void StreamDecoderBase::RestoreCtx(CtxState&& state) {
+  auto& ctx = this->ctx();
+  ctx.last_section_id = state.last_section_id;
+  ctx.defined_function_count = state.defined_function_count;
+  ctx.declared_data_count = state.declared_data_count;
+  ctx.code_count = state.code_count;
+  ctx.data_count = state.data_count;
+  ctx.local_count = state.local_count;
+  ctx.open_blocks = std::move(state.open_blocks);
+  ctx.seen_final_end = state.seen_final_end;
+  ctx.allocated_bytes = state.allocated_bytes;
+}
+
+bool StreamDecoderBase::ReadHeader() {
+  SpanU8 data = window();
+  if (data.size() < header_.size() && !finished_) {
+    return false;
+  }
+  size_t size = std::min(data.size(), header_.size());
+  std::copy_n(data.begin(), size, header_.begin());
+  Consume(size);
+  // LazyModule reads (and checks) the magic and version.
+  module_.emplace(SpanU8{header_.data(), size}, features_, errors_);
+  return true;
+}
+
+auto StreamDecoderBase::ReadSectionHeader() -> ReadStatus {
+  OptAt<SectionId> id;
+  OptAt<Index> length;
+  auto status = TryRead([&](SpanU8* data) {
+    ErrorsContextGuard guard{ctx().errors, *data, "section"};
+    id = Read<SectionId>(data, ctx());
+    if (!id) {
+      return false;
+    }
+    // Unlike ReadLength, the length can't be checked against the size of the
+    // data, since the rest of the section hasn't necessarily been received.
+    length = ReadIndex(data, ctx(), "length");
+    return length.has_value();
+  });
+  if (status != ReadStatus::Ok) {
+    return status;
+  }
+
+  if (**id != SectionId::Custom) {
+    auto& ctx = this->ctx();
+    if (ctx.last_section_id && *ctx.last_section_id >= **id) {
+      ctx.errors.OnError(
+          id->loc(), concat("Section out of order: ", *id,
+                            " cannot occur after ", *ctx.last_section_id));
+    }
+    ctx.last_section_id = **id;
+  }
+
+  section_id_ = **id;
+  section_length_ = **length;
+  section_remaining_ = **length;
+  section_count_ = nullopt;
+  item_count_ = 0;
+  return ReadStatus::Ok;
+}
+
+auto StreamDecoderBase::ReadSectionCount() -> ReadStatus {
+  OptAt<Index> count;
+  auto status = TryRead([&](SpanU8* data) {
+    count = ReadIndex(data, ctx(), "count");
+    return count.has_value();
+  });
+  if (status != ReadStatus::Ok) {
+    return status;
+  }
+
+  // There should be at least one byte per count; see ReadCheckLength.
+  if (count->value() > section_remaining_) {
+    ctx().errors.OnError(count->loc(),
+                         concat("Count extends past end: ", count->value(),
+                                " > ", section_remaining_));
+    return ReadStatus::Ok;
+  }
+
+  SpanU8 count_data = count->loc();
+  assert(count_data.size() <= count_bytes_.size());
+  count_offset_ = stream_offset(count_data.data());
+  std::copy(count_data.begin(), count_data.end(), count_bytes_.begin());
+  section_count_ =
+      At{SpanU8{count_bytes_.data(), count_data.size()}, count->value()};
+  return ReadStatus::Ok;
+}
+
+bool StreamDecoderBase::is_item_section() const {
+  switch (section_id_) {
+    case SectionId::Custom:
+    case SectionId::Start:
+    case SectionId::DataCount:
+      return false;
+
+    default:
+      return true;
+  }
+}
+
+At<Section> StreamDecoderBase::MakeKnownSection(SpanU8 data) const {
+  return At{data, Section{At{data, KnownSection{At{data, section_id_}, data}}}};
+}
+
+void StreamDecoderBase::CheckItemCount(string_view name) {
+  if (section_count_ && item_count_ != section_count_->value()) {
+    OnCountError(ctx().errors, window(), name, section_count_->value(),
+                 item_count_);
+  }
+}
+
+void StreamDecoderBase::ReportTruncatedSection() {
+  size_t received = section_length_ - section_remaining_ + buffered_size();
+  ctx().errors.OnError(window(), concat("Length extends past end: ",
+                                        section_length_, " > ", received));
+}
+
+}  // namespace wasp::binary
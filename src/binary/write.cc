@@ -0,0 +1,69 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/write.h"
+
+#include <algorithm>
+
+#include "wasp/base/parallel.h"
+
+namespace wasp::binary {
+
+auto EncodeCodeShards(Index count,
+                      u32 thread_count,
+                      const EncodeCodeFunction& encode)
+    -> std::vector<Buffer> {
+  // There are a few shards per thread, to balance the load when function sizes
+  // vary.
+  thread_count = GetThreadCount(thread_count);
+  Index shard_count =
+      thread_count == 1 ? 1 : std::min(count, thread_count * 4);
+  std::vector<Buffer> shards(shard_count);
+
+  // Each body is written to its thread's scratch buffer first, so its length
+  // is known. The buffers are reused, so each only grows to the size of the
+  // largest body it holds.
+  std::vector<Buffer> scratch(thread_count);
+
+  ParallelFor(shard_count, thread_count, [&](u32 thread_index, size_t shard) {
+    Index begin = static_cast<Index>(u64{count} * shard / shard_count);
+    Index end = static_cast<Index>(u64{count} * (shard + 1) / shard_count);
+    Buffer& code = scratch[thread_index];
+    auto out = std::back_inserter(shards[shard]);
+    for (Index index = begin; index < end; ++index) {
+      code.clear();
+      encode(thread_index, index, code);
+      out = WriteLengthAndBytes(code, out);
+    }
+  });
+  return shards;
+}
+
+auto WriteModule(const Module& value, u32 thread_count) -> Buffer {
+  Index count = static_cast<Index>(value.codes.size());
+  auto shards = EncodeCodeShards(
+      count, thread_count, [&](u32 thread_index, Index index, Buffer& code) {
+        WriteCodeBody(*value.codes[index], std::back_inserter(code));
+      });
+
+  Buffer result;
+  WriteModule(value, std::back_inserter(result), [&](auto out) {
+    return WriteEncodedCodeSection(count, shards, out);
+  });
+  return result;
+}
+
+}  // namespace wasp::binary
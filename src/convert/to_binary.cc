@@ -17,7 +17,9 @@
 #include "wasp/convert/to_binary.h"
 
 #include <cassert>
+#include <utility>
 
+#include "wasp/base/parallel.h"
 #include "wasp/binary/encoding.h"
 #include "wasp/binary/write.h"
 
@@ -26,7 +28,7 @@ namespace wasp::convert {
 BinCtx::BinCtx(const Features& features) : features{features} {}
 
 string_view BinCtx::Add(std::string str) {
-  strings.push_back(std::make_unique<std::string>(str));
+  strings.push_back(std::make_unique<std::string>(std::move(str)));
   return string_view{*strings.back()};
 }
 
@@ -747,11 +749,18 @@ auto ToBinaryCode(BinCtx& ctx, const At<text::Function>& value)
 
 // Section 11: Data
 auto ToBinary(BinCtx& ctx, const At<text::DataItemList>& value) -> SpanU8 {
+  // Reserve the whole segment up front, so each item is unescaped or copied
+  // directly into its final place.
+  u32 size = 0;
+  for (auto&& data_item : *value) {
+    size += data_item->byte_size();
+  }
   Buffer buffer;
+  buffer.reserve(size);
   for (auto&& data_item : *value) {
     data_item->AppendToBuffer(buffer);
   }
-  return ctx.Add(buffer);
+  return ctx.Add(std::move(buffer));
 }
 
 auto ToBinary(BinCtx& ctx, const At<text::DataSegment>& value)
@@ -784,8 +793,17 @@ auto ToBinary(BinCtx& ctx, const At<text::Event>& value)
 }
 
 // Module
-auto ToBinary(BinCtx& ctx, const At<text::Module>& value)
-    -> At<binary::Module> {
+using TextFunctionList = std::vector<const At<text::Function>*>;
+
+// Shared by the text::Module and text::DesugaredModule overloads below;
+// `items` must produce `const text::ModuleItem&`. If `code_functions` is
+// non-null, the defined functions are appended to it instead of being
+// converted to `result.codes`.
+template <typename Items>
+auto ToBinaryModule(BinCtx& ctx,
+                    const Items& items,
+                    TextFunctionList* code_functions = nullptr)
+    -> binary::Module {
   binary::Module result;
 
   auto push_back_opt = [](auto& vec, auto&& item) {
@@ -794,7 +812,7 @@ auto ToBinary(BinCtx& ctx, const At<text::Module>& value)
     }
   };
 
-  for (auto&& item : *value) {
+  for (const text::ModuleItem& item : items) {
     switch (item.kind()) {
       case text::ModuleItemKind::DefinedType:
         result.types.push_back(ToBinary(ctx, item.defined_type()));
@@ -807,7 +825,11 @@ auto ToBinary(BinCtx& ctx, const At<text::Module>& value)
       case text::ModuleItemKind::Function: {
         auto&& function = item.function();
         push_back_opt(result.functions, ToBinary(ctx, function));
-        push_back_opt(result.codes, ToBinaryCode(ctx, function));
+        if (!code_functions) {
+          push_back_opt(result.codes, ToBinaryCode(ctx, function));
+        } else if (!function->import) {
+          code_functions->push_back(&function);
+        }
         break;
       }
 
@@ -852,7 +874,74 @@ auto ToBinary(BinCtx& ctx, const At<text::Module>& value)
         break;
     }
   }
-  return At{value.loc(), result};
+  return result;
+}
+
+auto ToBinary(BinCtx& ctx, const At<text::Module>& value)
+    -> At<binary::Module> {
+  return At{value.loc(), ToBinaryModule(ctx, *value)};
+}
+
+auto ToBinary(BinCtx& ctx, const text::DesugaredModule& value)
+    -> At<binary::Module> {
+  return ToBinaryModule(ctx, value);
+}
+
+// Writes a function body, without its length, to `code`.
+void EncodeCode(BinCtx& ctx,
+                const EncodeCallbacks& callbacks,
+                u32 thread_index,
+                const TextFunctionList& functions,
+                Index index,
+                Buffer& code) {
+  auto&& function = *functions[index];
+  auto code_out = std::back_inserter(code);
+  if (callbacks.on_code) {
+    auto unpacked = *ToBinaryCode(ctx, function);
+    callbacks.on_code(thread_index, index, unpacked);
+    binary::WriteCodeBody(*unpacked, code_out);
+  } else {
+    auto locals = ToBinaryLocalsList(ctx, function->locals);
+    code_out = binary::WriteVector(locals->begin(), locals->end(), code_out);
+    for (auto&& instr : function->instructions) {
+      code_out = binary::Write(*ToBinary(ctx, instr), code_out);
+    }
+  }
+}
+
+auto ToBinaryBytes(BinCtx& ctx,
+                   const text::DesugaredModule& value,
+                   const EncodeCallbacks& callbacks,
+                   u32 thread_count) -> Buffer {
+  TextFunctionList functions;
+  binary::Module module = ToBinaryModule(ctx, value, &functions);
+  if (callbacks.on_module) {
+    callbacks.on_module(module);
+  }
+
+  thread_count = GetThreadCount(thread_count);
+  std::vector<BinCtx> thread_ctxs;
+  if (thread_count > 1) {
+    for (u32 i = 0; i < thread_count; ++i) {
+      thread_ctxs.emplace_back(ctx.features);
+    }
+  }
+
+  Index function_count = static_cast<Index>(functions.size());
+  auto shards = binary::EncodeCodeShards(
+      function_count, thread_count,
+      [&](u32 thread_index, Index index, Buffer& code) {
+        BinCtx& thread_ctx =
+            thread_ctxs.empty() ? ctx : thread_ctxs[thread_index];
+        EncodeCode(thread_ctx, callbacks, thread_index, functions, index,
+                   code);
+      });
+
+  Buffer result;
+  binary::WriteModule(module, std::back_inserter(result), [&](auto out) {
+    return binary::WriteEncodedCodeSection(function_count, shards, out);
+  });
+  return result;
 }
 
 }  // namespace wasp::convert
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <utility>
 
 namespace wasp::text {
 
@@ -32,89 +33,128 @@ struct DesugarCtx {
   ModuleItemList new_items;
 };
 
-void ReplaceImportOpt(ModuleItem& item, const OptAt<Import>& import_opt){
+auto ToImportItem(const OptAt<Import>& import_opt) -> optional<ModuleItem> {
   if (import_opt) {
-    item = ModuleItem{*import_opt};
+    return ModuleItem{*import_opt};
   }
+  return nullopt;
 }
 
 template <typename T>
-void AppendExports(ModuleItemList& items, At<T>& value, Index this_index) {
+void AppendExports(ModuleItemList& items,
+                   const At<T>& value,
+                   Index this_index) {
   for (auto & export_: value->ToExports(this_index)) {
     items.push_back(ModuleItem{std::move(export_)});
   }
-  value->exports.clear();
 }
 
-void Desugar(Module& module) {
-  DesugarCtx ctx;
-
-  for (auto&& item : module) {
-    switch (item.kind()) {
-      case ModuleItemKind::Import: {
-        auto import = item.import();
-        switch (import->kind()) {
-          case ExternalKind::Function: ctx.function_count++; break;
-          case ExternalKind::Table: ctx.table_count++; break;
-          case ExternalKind::Memory: ctx.memory_count++; break;
-          case ExternalKind::Global: ctx.global_count++; break;
-          case ExternalKind::Event: ctx.event_count++; break;
-        }
-        break;
+// Appends any new items that `item` desugars into to `ctx.new_items`. Returns
+// the item that should replace `item`, if any (e.g. an Import item for an
+// inline import).
+auto DesugarItem(DesugarCtx& ctx, const ModuleItem& item)
+    -> optional<ModuleItem> {
+  switch (item.kind()) {
+    case ModuleItemKind::Import: {
+      auto import = item.import();
+      switch (import->kind()) {
+        case ExternalKind::Function: ctx.function_count++; break;
+        case ExternalKind::Table: ctx.table_count++; break;
+        case ExternalKind::Memory: ctx.memory_count++; break;
+        case ExternalKind::Global: ctx.global_count++; break;
+        case ExternalKind::Event: ctx.event_count++; break;
       }
+      return nullopt;
+    }
 
-      case ModuleItemKind::Function: {
-        auto& function = item.function();
-        AppendExports(ctx.new_items, function, ctx.function_count);
-        ReplaceImportOpt(item, function->ToImport());
-        ctx.function_count++;
-        break;
-      }
+    case ModuleItemKind::Function: {
+      auto& function = item.function();
+      AppendExports(ctx.new_items, function, ctx.function_count);
+      ctx.function_count++;
+      return ToImportItem(function->ToImport());
+    }
 
-      case ModuleItemKind::Table: {
-        auto& table = item.table();
-        auto segment_opt = table->ToElementSegment(ctx.table_count);
-        if (segment_opt) {
-          ctx.new_items.push_back(ModuleItem{*segment_opt});
-          table->elements = nullopt;
-        }
-        AppendExports(ctx.new_items, table, ctx.table_count);
-        ReplaceImportOpt(item, table->ToImport());
-        ctx.table_count++;
-        break;
+    case ModuleItemKind::Table: {
+      auto& table = item.table();
+      auto segment_opt = table->ToElementSegment(ctx.table_count);
+      if (segment_opt) {
+        ctx.new_items.push_back(ModuleItem{*segment_opt});
       }
+      AppendExports(ctx.new_items, table, ctx.table_count);
+      ctx.table_count++;
+      return ToImportItem(table->ToImport());
+    }
 
-      case ModuleItemKind::Memory: {
-        auto& memory = item.memory();
-        auto segment_opt = memory->ToDataSegment(ctx.memory_count);
-        if (segment_opt) {
-          ctx.new_items.push_back(ModuleItem{*segment_opt});
-          memory->data = nullopt;
-        }
-        AppendExports(ctx.new_items, memory, ctx.memory_count);
-        ReplaceImportOpt(item, memory->ToImport());
-        ctx.memory_count++;
-        break;
+    case ModuleItemKind::Memory: {
+      auto& memory = item.memory();
+      auto segment_opt = memory->ToDataSegment(ctx.memory_count);
+      if (segment_opt) {
+        ctx.new_items.push_back(ModuleItem{*segment_opt});
       }
+      AppendExports(ctx.new_items, memory, ctx.memory_count);
+      ctx.memory_count++;
+      return ToImportItem(memory->ToImport());
+    }
 
-      case ModuleItemKind::Global: {
-        auto& global = item.global();
-        AppendExports(ctx.new_items, global, ctx.global_count);
-        ReplaceImportOpt(item, global->ToImport());
-        ctx.global_count++;
-        break;
-      }
+    case ModuleItemKind::Global: {
+      auto& global = item.global();
+      AppendExports(ctx.new_items, global, ctx.global_count);
+      ctx.global_count++;
+      return ToImportItem(global->ToImport());
+    }
 
-      case ModuleItemKind::Event: {
-        auto& event = item.event();
-        AppendExports(ctx.new_items, event, ctx.event_count);
-        ReplaceImportOpt(item, event->ToImport());
-        ctx.event_count++;
-        break;
-      }
+    case ModuleItemKind::Event: {
+      auto& event = item.event();
+      AppendExports(ctx.new_items, event, ctx.event_count);
+      ctx.event_count++;
+      return ToImportItem(event->ToImport());
+    }
+
+    default:
+      return nullopt;
+  }
+}
+
+// Removes the inline exports and segments of `item`, since DesugarItem has
+// already turned them into new items.
+void RemoveInlineItems(ModuleItem& item) {
+  switch (item.kind()) {
+    case ModuleItemKind::Function:
+      item.function()->exports.clear();
+      break;
+
+    case ModuleItemKind::Table:
+      item.table()->elements = nullopt;
+      item.table()->exports.clear();
+      break;
+
+    case ModuleItemKind::Memory:
+      item.memory()->data = nullopt;
+      item.memory()->exports.clear();
+      break;
+
+    case ModuleItemKind::Global:
+      item.global()->exports.clear();
+      break;
+
+    case ModuleItemKind::Event:
+      item.event()->exports.clear();
+      break;
+
+    default:
+      break;
+  }
+}
 
-      default:
-        break;
+void Desugar(Module& module) {
+  DesugarCtx ctx;
+
+  for (auto&& item : module) {
+    auto replacement = DesugarItem(ctx, item);
+    if (replacement) {
+      item = std::move(*replacement);
+    } else {
+      RemoveInlineItems(item);
     }
   }
 
@@ -122,4 +162,32 @@ void Desugar(Module& module) {
                 std::make_move_iterator(ctx.new_items.end()));
 }
 
+void DesugaredModule::AddShared(const ModuleItem& item) {
+  items_.push_back(std::cref(item));
+}
+
+void DesugaredModule::AddOwned(ModuleItem item) {
+  owned_items_.push_back(std::move(item));
+  items_.push_back(std::cref(owned_items_.back()));
+}
+
+DesugaredModule DesugarView(const Module& module) {
+  DesugarCtx ctx;
+  DesugaredModule result;
+
+  for (auto&& item : module) {
+    auto replacement = DesugarItem(ctx, item);
+    if (replacement) {
+      result.AddOwned(std::move(*replacement));
+    } else {
+      result.AddShared(item);
+    }
+  }
+
+  for (auto&& item : ctx.new_items) {
+    result.AddOwned(std::move(item));
+  }
+  return result;
+}
+
 }  // namespace wasp::text
@@ -18,6 +18,7 @@
 import argparse
 import collections
 import os
+import random
 import sys
 
 SOURCE_DIR = os.path.dirname(os.path.abspath(__file__))
@@ -28,6 +29,33 @@ class Error(Exception):
     pass
 
 
+# Keywords that are only the start of a longer token, so they can't be found
+# by looking up the whole token. They are matched by their first character.
+PREFIX_KEYWORDS = {
+    ('TokenType::AlignEqNat',):
+        'LexNameEqNum(data, "{key}", TokenType::AlignEqNat)',
+    ('TokenType::OffsetEqNat',):
+        'LexNameEqNum(data, "{key}", TokenType::OffsetEqNat)',
+    ('TokenType::Float', 'LiteralKind::NanPayload'): 'LexNan(data)',
+}
+
+# Keywords are zero-padded to this size in the generated table.
+MAX_KEYWORD_SIZE = 32
+BUCKET_BITS = 8
+SLOT_BITS = 10
+MASK64 = (1 << 64) - 1
+
+
+def HashKeyword(key, multipliers):
+    """Must match HashKeyword in the generated code."""
+    data = key.encode('ascii').ljust(MAX_KEYWORD_SIZE, b'\0')
+    w0, w1, w2, w3 = (int.from_bytes(data[i:i + 8], 'little')
+                      for i in range(0, MAX_KEYWORD_SIZE, 8))
+    k0, k1, k2 = multipliers
+    h = (w0 * k0 + w1 * k1 + (w2 ^ w3) * k2) & MASK64
+    return h ^ (h >> 32)
+
+
 class Runner(object):
 
     def __init__(self, filename, options):
@@ -49,56 +77,143 @@ class Runner(object):
         if self.options.output:
             with open(self.options.output, 'w') as output_file:
                 self.output_file = output_file
-                self.Emit(self.keys)
+                self.Emit()
         else:
             self.output_file = sys.stdout
-            self.Emit(self.keys)
+            self.Emit()
         self.output_file = None
 
-    def DistinctChars(self, keys, index):
-        distinct = collections.defaultdict(list)
-        for key in keys:
-            assert(index <= len(key))
-            if index < len(key):
-                distinct[key[index]].append(key)
-            else:
-                distinct['\0'].append(key)
-        return len(distinct), index, distinct
-
-    def Emit(self, keys, indent=''):
-        min_length = min(len(key) for key in keys)
-        _, index, distinct = max(self.DistinctChars(keys, i)
-                                 for i in range(min_length + 1))
-        self.Print(indent, 'switch (PeekChar(data, {})) {{'.format(index))
-        has_default = False
-        for char in sorted(distinct.keys()):
-            subkeys = distinct[char]
-            if char == '\0':
-                has_default = True
-                self.Print(indent, "  default:", end='')
-            else:
-                self.Print(indent, "  case '{}':".format(char), end='')
-
-            if len(subkeys) == 1:
-                key = subkeys[0]
-                values = tuple(self.values[key])
-                if values[0] in ('TokenType::AlignEqNat',
-                                 'TokenType::OffsetEqNat'):
-                  self.Print('', ' return LexNameEqNum(data, "{}", {});'.format(
-                             key, values[0]))
-                elif values == ('TokenType::Float', 'LiteralKind::NanPayload'):
-                  self.Print('', ' return LexNan(data);')
+    def BuildTable(self, keys):
+        """Finds a perfect hash for `keys`, using "hash and displace": the top
+        bits of the hash pick a bucket, and the bucket's displacement is xor'd
+        with the low bits of the hash to give the slot. Returns the hash
+        multipliers, the displacement of each bucket and the key index in each
+        slot (or None)."""
+        slot_count = 1 << SLOT_BITS
+        slot_mask = slot_count - 1
+        rng = random.Random(0)
+        for _ in range(1000):
+            multipliers = tuple(rng.getrandbits(64) | 1 for _ in range(3))
+            buckets = collections.defaultdict(list)
+            for index, key in enumerate(keys):
+                h = HashKeyword(key, multipliers)
+                buckets[h >> (64 - BUCKET_BITS)].append((h & slot_mask, index))
+
+            # Keys in the same bucket are only separable if their slots differ.
+            if any(len(set(slot for slot, _ in bucket)) != len(bucket)
+                   for bucket in buckets.values()):
+                continue
+
+            slots = [None] * slot_count
+            displacements = [0] * (1 << BUCKET_BITS)
+            ok = True
+            # Place the largest buckets first, while the table is empty.
+            for bucket_index in sorted(buckets, key=lambda b: -len(buckets[b])):
+                bucket = buckets[bucket_index]
+                for displacement in range(slot_count):
+                    if all(slots[slot ^ displacement] is None
+                           for slot, _ in bucket):
+                        break
                 else:
-                  self.Print('', ' return LexKeyword(data, "{}", {});'.format(
-                             key, ', '.join(values)))
+                    ok = False
+                    break
+                displacements[bucket_index] = displacement
+                for slot, index in bucket:
+                    slots[slot ^ displacement] = index
+            if ok:
+                return multipliers, displacements, slots
+        raise Error('Unable to find a perfect hash for the keywords.')
+
+    def KeywordInitializer(self, key):
+        values = self.values[key]
+        tt, kind, value, features = None, 'None', '0', '0'
+        for v in values:
+            enum, _ = v.split('::')
+            if enum == 'TokenType':
+                tt = v
+            elif enum == 'Features':
+                features = v
             else:
-                self.Print()
-                self.Emit(subkeys, indent + '    ')
-
-        if not has_default:
-            self.Print(indent, '  default: break;')
-        self.Print(indent, '}')
-        self.Print(indent, 'break;')
+                kind, value = enum, 'u32({})'.format(v)
+        if tt is None:
+            # The token type is implied by the immediate.
+            tt = {'Opcode': 'TokenType::BareInstr'}.get(kind,
+                                                       'TokenType::' + kind)
+        return '{{{}, KeywordKind::{}, {}, {}}}'.format(tt, kind, value,
+                                                        features)
+
+    def Emit(self):
+        prefix_keys = []
+        keys = []
+        for key in self.keys:
+            if len(key) > MAX_KEYWORD_SIZE:
+                raise Error('Keyword "{}" is too long.'.format(key))
+            if tuple(self.values[key]) in PREFIX_KEYWORDS:
+                prefix_keys.append(key)
+            else:
+                keys.append(key)
+
+        multipliers, displacements, slots = self.BuildTable(keys)
+
+        self.Print('// Generated by src/text/gen-keywords.py from '
+                   'src/text/keywords.txt.')
+        self.Print('// DO NOT EDIT.')
+        self.Print()
+        self.Print('constexpr span_extent_t kMaxKeywordSize = {};'.format(
+                   MAX_KEYWORD_SIZE))
+        self.Print('constexpr int kKeywordBucketBits = {};'.format(
+                   BUCKET_BITS))
+        self.Print('constexpr u64 kKeywordSlotMask = {};'.format(
+                   (1 << SLOT_BITS) - 1))
+        self.Print('constexpr u16 kNoKeyword = 0xffff;')
+        self.Print('constexpr span_extent_t kKeywordWords = {};'.format(
+                   MAX_KEYWORD_SIZE // 8))
+        self.Print()
+        self.Print('// `word` is the zero-padded keyword, as little-endian '
+                   'words.')
+        self.Print('inline u64 HashKeyword(const u64* word) {')
+        self.Print('  u64 h = word[0] * {:#x}u + word[1] * {:#x}u +'.format(
+                   multipliers[0], multipliers[1]))
+        self.Print('          (word[2] ^ word[3]) * {:#x}u;'.format(
+                   multipliers[2]))
+        self.Print('  return h ^ (h >> 32);')
+        self.Print('}')
+        self.Print()
+        self.EmitArray('const u16 kKeywordDisplacements[]',
+                       [str(d) for d in displacements])
+        self.EmitArray('const u16 kKeywordSlots[]',
+                       ['kNoKeyword' if s is None else str(s) for s in slots])
+        self.Print('const char kKeywordNames[][kMaxKeywordSize] = {')
+        for key in keys:
+            self.Print('    "{}",'.format(key))
+        self.Print('};')
+        self.Print()
+        self.Print('const Keyword kKeywords[] = {')
+        for key in keys:
+            self.Print('    {},'.format(self.KeywordInitializer(key)))
+        self.Print('};')
+        self.Print()
+
+        self.Print('auto LexPrefixKeyword(SpanU8* data) -> Token {')
+        self.Print('  switch (PeekChar(data)) {')
+        first_chars = set()
+        for key in sorted(prefix_keys):
+            if key[0] in first_chars:
+                raise Error('Prefix keywords must start with distinct '
+                            'characters.')
+            first_chars.add(key[0])
+            lex = PREFIX_KEYWORDS[tuple(self.values[key])].format(key=key)
+            self.Print("    case '{}': return {};".format(key[0], lex))
+        self.Print('    default: return LexReserved(data);')
+        self.Print('  }')
+        self.Print('}')
+
+    def EmitArray(self, decl, items, per_line=12):
+        self.Print(decl + ' = {')
+        for i in range(0, len(items), per_line):
+            self.Print('    ' + ', '.join(items[i:i + per_line]) + ',')
+        self.Print('};')
+        self.Print()
 
     def Print(self, indent='', line='', end=None):
         print('{}{}'.format(indent, line), end=end, file=self.output_file)
@@ -1,2031 +1,1348 @@
-switch (PeekChar(data, 2)) {
-  default:
-    switch (PeekChar(data, 1)) {
-      case '8': return LexKeyword(data, "i8", PackedType::I8);
-      case 'f': return LexKeyword(data, "if", TokenType::BlockInstr, Opcode::If);
-      case 'q': return LexKeyword(data, "eq", TokenType::HeapKind, HeapKind::Eq);
-      case 'r': return LexKeyword(data, "br", TokenType::VarInstr, Opcode::Br);
-      default: break;
-    }
-    break;
-  case '1':
-    switch (PeekChar(data, 3)) {
-      default: return LexKeyword(data, "i31", TokenType::HeapKind, HeapKind::I31);
-      case '.':
-        switch (PeekChar(data, 7)) {
-          default: return LexKeyword(data, "i31.new", Opcode::I31New, Features::GC);
-          case '_':
-            switch (PeekChar(data, 8)) {
-              case 's': return LexKeyword(data, "i31.get_s", Opcode::I31GetS, Features::GC);
-              case 'u': return LexKeyword(data, "i31.get_u", Opcode::I31GetU, Features::GC);
-              default: break;
-            }
-            break;
-        }
-        break;
-      case 'r': return LexKeyword(data, "i31ref", ReferenceKind::I31ref);
-    }
-    break;
-  case '2':
-    switch (PeekChar(data, 3)) {
-      default:
-        switch (PeekChar(data, 0)) {
-          case 'f': return LexKeyword(data, "f32", NumericType::F32);
-          case 'i': return LexKeyword(data, "i32", NumericType::I32);
-          default: break;
-        }
-        break;
-      case '.':
-        switch (PeekChar(data, 6)) {
-          default:
-            switch (PeekChar(data, 4)) {
-              case 'e':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f32.eq", Opcode::F32Eq);
-                  case 'i': return LexKeyword(data, "i32.eq", Opcode::I32Eq);
-                  default: break;
-                }
-                break;
-              case 'g':
-                switch (PeekChar(data, 5)) {
-                  case 'e': return LexKeyword(data, "f32.ge", Opcode::F32Ge);
-                  case 't': return LexKeyword(data, "f32.gt", Opcode::F32Gt);
-                  default: break;
-                }
-                break;
-              case 'l':
-                switch (PeekChar(data, 5)) {
-                  case 'e': return LexKeyword(data, "f32.le", Opcode::F32Le);
-                  case 't': return LexKeyword(data, "f32.lt", Opcode::F32Lt);
-                  default: break;
-                }
-                break;
-              case 'n':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f32.ne", Opcode::F32Ne);
-                  case 'i': return LexKeyword(data, "i32.ne", Opcode::I32Ne);
-                  default: break;
-                }
-                break;
-              case 'o': return LexKeyword(data, "i32.or", Opcode::I32Or);
-              default: break;
-            }
-            break;
-          case '_':
-            switch (PeekChar(data, 7)) {
-              case 's':
-                switch (PeekChar(data, 5)) {
-                  case 'e':
-                    switch (PeekChar(data, 4)) {
-                      case 'g': return LexKeyword(data, "i32.ge_s", Opcode::I32GeS);
-                      case 'l': return LexKeyword(data, "i32.le_s", Opcode::I32LeS);
-                      default: break;
-                    }
-                    break;
-                  case 't':
-                    switch (PeekChar(data, 4)) {
-                      case 'g': return LexKeyword(data, "i32.gt_s", Opcode::I32GtS);
-                      case 'l': return LexKeyword(data, "i32.lt_s", Opcode::I32LtS);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-              case 'u':
-                switch (PeekChar(data, 5)) {
-                  case 'e':
-                    switch (PeekChar(data, 4)) {
-                      case 'g': return LexKeyword(data, "i32.ge_u", Opcode::I32GeU);
-                      case 'l': return LexKeyword(data, "i32.le_u", Opcode::I32LeU);
-                      default: break;
-                    }
-                    break;
-                  case 't':
-                    switch (PeekChar(data, 4)) {
-                      case 'g': return LexKeyword(data, "i32.gt_u", Opcode::I32GtU);
-                      case 'l': return LexKeyword(data, "i32.lt_u", Opcode::I32LtU);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-              default: break;
-            }
-            break;
-          case 'a':
-            switch (PeekChar(data, 8)) {
-              default:
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f32.load", TokenType::MemoryInstr, Opcode::F32Load);
-                  case 'i': return LexKeyword(data, "i32.load", TokenType::MemoryInstr, Opcode::I32Load);
-                  default: break;
-                }
-                break;
-              case '/': return LexKeyword(data, "i32.wrap/i64", Opcode::I32WrapI64);
-              case '1':
-                switch (PeekChar(data, 11)) {
-                  case 's': return LexKeyword(data, "i32.load16_s", TokenType::MemoryInstr, Opcode::I32Load16S);
-                  case 'u': return LexKeyword(data, "i32.load16_u", TokenType::MemoryInstr, Opcode::I32Load16U);
-                  default: break;
-                }
-                break;
-              case '8':
-                switch (PeekChar(data, 10)) {
-                  case 's': return LexKeyword(data, "i32.load8_s", TokenType::MemoryInstr, Opcode::I32Load8S);
-                  case 'u': return LexKeyword(data, "i32.load8_u", TokenType::MemoryInstr, Opcode::I32Load8U);
-                  default: break;
-                }
-                break;
-              case '_': return LexKeyword(data, "i32.wrap_i64", Opcode::I32WrapI64);
-              case 'e': return LexKeyword(data, "f32.nearest", Opcode::F32Nearest);
-            }
-            break;
-          case 'b':
-            switch (PeekChar(data, 0)) {
-              case 'f': return LexKeyword(data, "f32.sub", Opcode::F32Sub);
-              case 'i': return LexKeyword(data, "i32.sub", Opcode::I32Sub);
-              default: break;
-            }
-            break;
-          case 'd':
-            switch (PeekChar(data, 5)) {
-              case 'd':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f32.add", Opcode::F32Add);
-                  case 'i': return LexKeyword(data, "i32.add", Opcode::I32Add);
-                  default: break;
-                }
-                break;
-              case 'n': return LexKeyword(data, "i32.and", Opcode::I32And);
-              default: break;
-            }
-            break;
-          case 'g': return LexKeyword(data, "f32.neg", Opcode::F32Neg);
-          case 'i':
-            switch (PeekChar(data, 8)) {
-              default: return LexKeyword(data, "f32.ceil", Opcode::F32Ceil);
-              case 't':
-                switch (PeekChar(data, 16)) {
-                  case 'f':
-                    switch (PeekChar(data, 15)) {
-                      case '/': return LexKeyword(data, "i32.reinterpret/f32", Opcode::I32ReinterpretF32);
-                      case '_': return LexKeyword(data, "i32.reinterpret_f32", Opcode::I32ReinterpretF32);
-                      default: break;
-                    }
-                    break;
-                  case 'i':
-                    switch (PeekChar(data, 15)) {
-                      case '/': return LexKeyword(data, "f32.reinterpret/i32", Opcode::F32ReinterpretI32);
-                      case '_': return LexKeyword(data, "f32.reinterpret_i32", Opcode::F32ReinterpretI32);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-            }
-            break;
-          case 'l':
-            switch (PeekChar(data, 5)) {
-              case 'h': return LexKeyword(data, "i32.shl", Opcode::I32Shl);
-              case 'u':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f32.mul", Opcode::F32Mul);
-                  case 'i': return LexKeyword(data, "i32.mul", Opcode::I32Mul);
-                  default: break;
-                }
-                break;
-              default: break;
-            }
-            break;
-          case 'm':
-            switch (PeekChar(data, 8)) {
-              case 's': return LexKeyword(data, "i32.rem_s", Opcode::I32RemS);
-              case 't':
-                switch (PeekChar(data, 10)) {
-                  case '/': return LexKeyword(data, "f32.demote/f64", Opcode::F32DemoteF64);
-                  case '_': return LexKeyword(data, "f32.demote_f64", Opcode::F32DemoteF64);
-                  default: break;
-                }
-                break;
-              case 'u': return LexKeyword(data, "i32.rem_u", Opcode::I32RemU);
-              default: break;
-            }
-            break;
-          case 'n':
-            switch (PeekChar(data, 7)) {
-              default: return LexKeyword(data, "f32.min", Opcode::F32Min);
-              case 's':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f32.const", TokenType::F32ConstInstr, Opcode::F32Const);
-                  case 'i': return LexKeyword(data, "i32.const", TokenType::I32ConstInstr, Opcode::I32Const);
-                  default: break;
-                }
-                break;
-              case 'v':
-                switch (PeekChar(data, 16)) {
-                  case '2':
-                    switch (PeekChar(data, 12)) {
-                      case 's': return LexKeyword(data, "f32.convert_s/i32", Opcode::F32ConvertI32S);
-                      case 'u': return LexKeyword(data, "f32.convert_u/i32", Opcode::F32ConvertI32U);
-                      default: break;
-                    }
-                    break;
-                  case '4':
-                    switch (PeekChar(data, 12)) {
-                      case 's': return LexKeyword(data, "f32.convert_s/i64", Opcode::F32ConvertI64S);
-                      case 'u': return LexKeyword(data, "f32.convert_u/i64", Opcode::F32ConvertI64U);
-                      default: break;
-                    }
-                    break;
-                  case 's':
-                    switch (PeekChar(data, 14)) {
-                      case '2': return LexKeyword(data, "f32.convert_i32_s", Opcode::F32ConvertI32S);
-                      case '4': return LexKeyword(data, "f32.convert_i64_s", Opcode::F32ConvertI64S);
-                      default: break;
-                    }
-                    break;
-                  case 'u':
-                    switch (PeekChar(data, 14)) {
-                      case '2': return LexKeyword(data, "f32.convert_i32_u", Opcode::F32ConvertI32U);
-                      case '4': return LexKeyword(data, "f32.convert_i64_u", Opcode::F32ConvertI64U);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-            }
-            break;
-          case 'o':
-            switch (PeekChar(data, 9)) {
-              default:
-                switch (PeekChar(data, 8)) {
-                  case 'e':
-                    switch (PeekChar(data, 0)) {
-                      case 'f': return LexKeyword(data, "f32.store", TokenType::MemoryInstr, Opcode::F32Store);
-                      case 'i': return LexKeyword(data, "i32.store", TokenType::MemoryInstr, Opcode::I32Store);
-                      default: break;
-                    }
-                    break;
-                  case 'r': return LexKeyword(data, "f32.floor", Opcode::F32Floor);
-                  default: break;
-                }
-                break;
-              case '1': return LexKeyword(data, "i32.store16", TokenType::MemoryInstr, Opcode::I32Store16);
-              case '8': return LexKeyword(data, "i32.store8", TokenType::MemoryInstr, Opcode::I32Store8);
-              case 'c':
-                switch (PeekChar(data, 15)) {
-                  default: return LexKeyword(data, "i32.atomic.load", TokenType::MemoryInstr, Opcode::I32AtomicLoad, Features::Threads);
-                  case '.':
-                    switch (PeekChar(data, 17)) {
-                      case 'c': return LexKeyword(data, "i32.atomic.rmw8.xchg_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw8XchgU, Features::Threads);
-                      case 'd': return LexKeyword(data, "i32.atomic.rmw8.add_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw8AddU, Features::Threads);
-                      case 'm': return LexKeyword(data, "i32.atomic.rmw8.cmpxchg_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw8CmpxchgU, Features::Threads);
-                      case 'n': return LexKeyword(data, "i32.atomic.rmw8.and_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw8AndU, Features::Threads);
-                      case 'o': return LexKeyword(data, "i32.atomic.rmw8.xor_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw8XorU, Features::Threads);
-                      case 'r': return LexKeyword(data, "i32.atomic.rmw8.or_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw8OrU, Features::Threads);
-                      case 'u': return LexKeyword(data, "i32.atomic.rmw8.sub_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw8SubU, Features::Threads);
-                      default: break;
-                    }
-                    break;
-                  case '1': return LexKeyword(data, "i32.atomic.load16_u", TokenType::MemoryInstr, Opcode::I32AtomicLoad16U, Features::Threads);
-                  case '6':
-                    switch (PeekChar(data, 18)) {
-                      case 'c': return LexKeyword(data, "i32.atomic.rmw16.xchg_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw16XchgU, Features::Threads);
-                      case 'd': return LexKeyword(data, "i32.atomic.rmw16.add_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw16AddU, Features::Threads);
-                      case 'm': return LexKeyword(data, "i32.atomic.rmw16.cmpxchg_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw16CmpxchgU, Features::Threads);
-                      case 'n': return LexKeyword(data, "i32.atomic.rmw16.and_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw16AndU, Features::Threads);
-                      case 'o': return LexKeyword(data, "i32.atomic.rmw16.xor_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw16XorU, Features::Threads);
-                      case 'r': return LexKeyword(data, "i32.atomic.rmw16.or_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw16OrU, Features::Threads);
-                      case 'u': return LexKeyword(data, "i32.atomic.rmw16.sub_u", TokenType::MemoryInstr, Opcode::I32AtomicRmw16SubU, Features::Threads);
-                      default: break;
-                    }
-                    break;
-                  case '8': return LexKeyword(data, "i32.atomic.load8_u", TokenType::MemoryInstr, Opcode::I32AtomicLoad8U, Features::Threads);
-                  case 'a':
-                    switch (PeekChar(data, 16)) {
-                      case 'd': return LexKeyword(data, "i32.atomic.rmw.add", TokenType::MemoryInstr, Opcode::I32AtomicRmwAdd, Features::Threads);
-                      case 'n': return LexKeyword(data, "i32.atomic.rmw.and", TokenType::MemoryInstr, Opcode::I32AtomicRmwAnd, Features::Threads);
-                      default: break;
-                    }
-                    break;
-                  case 'c': return LexKeyword(data, "i32.atomic.rmw.cmpxchg", TokenType::MemoryInstr, Opcode::I32AtomicRmwCmpxchg, Features::Threads);
-                  case 'e':
-                    switch (PeekChar(data, 16)) {
-                      default: return LexKeyword(data, "i32.atomic.store", TokenType::MemoryInstr, Opcode::I32AtomicStore, Features::Threads);
-                      case '1': return LexKeyword(data, "i32.atomic.store16", TokenType::MemoryInstr, Opcode::I32AtomicStore16, Features::Threads);
-                      case '8': return LexKeyword(data, "i32.atomic.store8", TokenType::MemoryInstr, Opcode::I32AtomicStore8, Features::Threads);
-                    }
-                    break;
-                  case 'o': return LexKeyword(data, "i32.atomic.rmw.or", TokenType::MemoryInstr, Opcode::I32AtomicRmwOr, Features::Threads);
-                  case 's': return LexKeyword(data, "i32.atomic.rmw.sub", TokenType::MemoryInstr, Opcode::I32AtomicRmwSub, Features::Threads);
-                  case 'x':
-                    switch (PeekChar(data, 18)) {
-                      default: return LexKeyword(data, "i32.atomic.rmw.xor", TokenType::MemoryInstr, Opcode::I32AtomicRmwXor, Features::Threads);
-                      case 'g': return LexKeyword(data, "i32.atomic.rmw.xchg", TokenType::MemoryInstr, Opcode::I32AtomicRmwXchg, Features::Threads);
-                    }
-                    break;
-                }
-                break;
-            }
-            break;
-          case 'p':
-            switch (PeekChar(data, 10)) {
-              default: return LexKeyword(data, "i32.popcnt", Opcode::I32Popcnt);
-              case 'g': return LexKeyword(data, "f32.copysign", Opcode::F32Copysign);
-            }
-            break;
-          case 'r':
-            switch (PeekChar(data, 7)) {
-              default: return LexKeyword(data, "i32.xor", Opcode::I32Xor);
-              case '_':
-                switch (PeekChar(data, 8)) {
-                  case 's': return LexKeyword(data, "i32.shr_s", Opcode::I32ShrS);
-                  case 'u': return LexKeyword(data, "i32.shr_u", Opcode::I32ShrU);
-                  default: break;
-                }
-                break;
-              case 't': return LexKeyword(data, "f32.sqrt", Opcode::F32Sqrt);
-            }
-            break;
-          case 's': return LexKeyword(data, "f32.abs", Opcode::F32Abs);
-          case 't':
-            switch (PeekChar(data, 7)) {
-              case 'e':
-                switch (PeekChar(data, 13)) {
-                  default: return LexKeyword(data, "i32.extend8_s", Opcode::I32Extend8S, Features::SignExtension);
-                  case 's': return LexKeyword(data, "i32.extend16_s", Opcode::I32Extend16S, Features::SignExtension);
-                }
-                break;
-              case 'l': return LexKeyword(data, "i32.rotl", Opcode::I32Rotl);
-              case 'r': return LexKeyword(data, "i32.rotr", Opcode::I32Rotr);
-              default: break;
-            }
-            break;
-          case 'u':
-            switch (PeekChar(data, 9)) {
-              default: return LexKeyword(data, "f32.trunc", Opcode::F32Trunc);
-              case '_':
-                switch (PeekChar(data, 14)) {
-                  case '2':
-                    switch (PeekChar(data, 10)) {
-                      case 's': return LexKeyword(data, "i32.trunc_s/f32", Opcode::I32TruncF32S);
-                      case 'u': return LexKeyword(data, "i32.trunc_u/f32", Opcode::I32TruncF32U);
-                      default: break;
-                    }
-                    break;
-                  case '4':
-                    switch (PeekChar(data, 10)) {
-                      case 's': return LexKeyword(data, "i32.trunc_s/f64", Opcode::I32TruncF64S);
-                      case 'u': return LexKeyword(data, "i32.trunc_u/f64", Opcode::I32TruncF64U);
-                      default: break;
-                    }
-                    break;
-                  case 'f':
-                    switch (PeekChar(data, 18)) {
-                      case 's':
-                        switch (PeekChar(data, 16)) {
-                          case '2': return LexKeyword(data, "i32.trunc_sat_f32_s", Opcode::I32TruncSatF32S, Features::SaturatingFloatToInt);
-                          case '4': return LexKeyword(data, "i32.trunc_sat_f64_s", Opcode::I32TruncSatF64S, Features::SaturatingFloatToInt);
-                          default: break;
-                        }
-                        break;
-                      case 'u':
-                        switch (PeekChar(data, 16)) {
-                          case '2': return LexKeyword(data, "i32.trunc_sat_f32_u", Opcode::I32TruncSatF32U, Features::SaturatingFloatToInt);
-                          case '4': return LexKeyword(data, "i32.trunc_sat_f64_u", Opcode::I32TruncSatF64U, Features::SaturatingFloatToInt);
-                          default: break;
-                        }
-                        break;
-                      default: break;
-                    }
-                    break;
-                  case 's':
-                    switch (PeekChar(data, 12)) {
-                      case '2': return LexKeyword(data, "i32.trunc_f32_s", Opcode::I32TruncF32S);
-                      case '4': return LexKeyword(data, "i32.trunc_f64_s", Opcode::I32TruncF64S);
-                      default: break;
-                    }
-                    break;
-                  case 't':
-                    switch (PeekChar(data, 18)) {
-                      case '2':
-                        switch (PeekChar(data, 10)) {
-                          case 's': return LexKeyword(data, "i32.trunc_s:sat/f32", Opcode::I32TruncSatF32S, Features::SaturatingFloatToInt);
-                          case 'u': return LexKeyword(data, "i32.trunc_u:sat/f32", Opcode::I32TruncSatF32U, Features::SaturatingFloatToInt);
-                          default: break;
-                        }
-                        break;
-                      case '4':
-                        switch (PeekChar(data, 10)) {
-                          case 's': return LexKeyword(data, "i32.trunc_s:sat/f64", Opcode::I32TruncSatF64S, Features::SaturatingFloatToInt);
-                          case 'u': return LexKeyword(data, "i32.trunc_u:sat/f64", Opcode::I32TruncSatF64U, Features::SaturatingFloatToInt);
-                          default: break;
-                        }
-                        break;
-                      default: break;
-                    }
-                    break;
-                  case 'u':
-                    switch (PeekChar(data, 12)) {
-                      case '2': return LexKeyword(data, "i32.trunc_f32_u", Opcode::I32TruncF32U);
-                      case '4': return LexKeyword(data, "i32.trunc_f64_u", Opcode::I32TruncF64U);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-            }
-            break;
-          case 'v':
-            switch (PeekChar(data, 7)) {
-              default: return LexKeyword(data, "f32.div", Opcode::F32Div);
-              case '_':
-                switch (PeekChar(data, 8)) {
-                  case 's': return LexKeyword(data, "i32.div_s", Opcode::I32DivS);
-                  case 'u': return LexKeyword(data, "i32.div_u", Opcode::I32DivU);
-                  default: break;
-                }
-                break;
-            }
-            break;
-          case 'x': return LexKeyword(data, "f32.max", Opcode::F32Max);
-          case 'z':
-            switch (PeekChar(data, 5)) {
-              case 'l': return LexKeyword(data, "i32.clz", Opcode::I32Clz);
-              case 'q': return LexKeyword(data, "i32.eqz", Opcode::I32Eqz);
-              case 't': return LexKeyword(data, "i32.ctz", Opcode::I32Ctz);
-              default: break;
-            }
-            break;
-        }
-        break;
-      case '8':
-        switch (PeekChar(data, 4)) {
-          default: return LexKeyword(data, "v128", NumericType::V128);
-          case '.':
-            switch (PeekChar(data, 5)) {
-              case 'a':
-                switch (PeekChar(data, 8)) {
-                  default: return LexKeyword(data, "v128.and", Opcode::V128And, Features::Simd);
-                  case 'n': return LexKeyword(data, "v128.andnot", Opcode::V128Andnot, Features::Simd);
-                }
-                break;
-              case 'b': return LexKeyword(data, "v128.bitselect", Opcode::V128BitSelect, Features::Simd);
-              case 'c': return LexKeyword(data, "v128.const", TokenType::SimdConstInstr, Opcode::V128Const, Features::Simd);
-              case 'l':
-                switch (PeekChar(data, 9)) {
-                  default: return LexKeyword(data, "v128.load", TokenType::MemoryInstr, Opcode::V128Load, Features::Simd);
-                  case '1':
-                    switch (PeekChar(data, 14)) {
-                      case 'l': return LexKeyword(data, "v128.load16_splat", TokenType::MemoryInstr, Opcode::V128Load16Splat, Features::Simd);
-                      case 's': return LexKeyword(data, "v128.load16x4_s", TokenType::MemoryInstr, Opcode::V128Load16X4S, Features::Simd);
-                      case 'u': return LexKeyword(data, "v128.load16x4_u", TokenType::MemoryInstr, Opcode::V128Load16X4U, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case '3':
-                    switch (PeekChar(data, 14)) {
-                      case 'l': return LexKeyword(data, "v128.load32_splat", TokenType::MemoryInstr, Opcode::V128Load32Splat, Features::Simd);
-                      case 'r': return LexKeyword(data, "v128.load32_zero", TokenType::MemoryInstr, Opcode::V128Load32Zero, Features::Simd);
-                      case 's': return LexKeyword(data, "v128.load32x2_s", TokenType::MemoryInstr, Opcode::V128Load32X2S, Features::Simd);
-                      case 'u': return LexKeyword(data, "v128.load32x2_u", TokenType::MemoryInstr, Opcode::V128Load32X2U, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case '6':
-                    switch (PeekChar(data, 16)) {
-                      default: return LexKeyword(data, "v128.load64_zero", TokenType::MemoryInstr, Opcode::V128Load64Zero, Features::Simd);
-                      case 't': return LexKeyword(data, "v128.load64_splat", TokenType::MemoryInstr, Opcode::V128Load64Splat, Features::Simd);
-                    }
-                    break;
-                  case '8':
-                    switch (PeekChar(data, 13)) {
-                      case 'l': return LexKeyword(data, "v128.load8_splat", TokenType::MemoryInstr, Opcode::V128Load8Splat, Features::Simd);
-                      case 's': return LexKeyword(data, "v128.load8x8_s", TokenType::MemoryInstr, Opcode::V128Load8X8S, Features::Simd);
-                      case 'u': return LexKeyword(data, "v128.load8x8_u", TokenType::MemoryInstr, Opcode::V128Load8X8U, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                }
-                break;
-              case 'n': return LexKeyword(data, "v128.not", Opcode::V128Not, Features::Simd);
-              case 'o': return LexKeyword(data, "v128.or", Opcode::V128Or, Features::Simd);
-              case 's': return LexKeyword(data, "v128.store", TokenType::MemoryInstr, Opcode::V128Store, Features::Simd);
-              case 'x': return LexKeyword(data, "v128.xor", Opcode::V128Xor, Features::Simd);
-              default: break;
-            }
-            break;
-        }
-        break;
-      case 'x':
-        switch (PeekChar(data, 5)) {
-          default:
-            switch (PeekChar(data, 0)) {
-              case 'f': return LexKeyword(data, "f32x4", SimdShape::F32X4);
-              case 'i': return LexKeyword(data, "i32x4", SimdShape::I32X4);
-              default: break;
-            }
-            break;
-          case '.':
-            switch (PeekChar(data, 8)) {
-              default:
-                switch (PeekChar(data, 6)) {
-                  case 'e':
-                    switch (PeekChar(data, 0)) {
-                      case 'f': return LexKeyword(data, "f32x4.eq", Opcode::F32X4Eq, Features::Simd);
-                      case 'i': return LexKeyword(data, "i32x4.eq", Opcode::I32X4Eq, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 'g':
-                    switch (PeekChar(data, 7)) {
-                      case 'e': return LexKeyword(data, "f32x4.ge", Opcode::F32X4Ge, Features::Simd);
-                      case 't': return LexKeyword(data, "f32x4.gt", Opcode::F32X4Gt, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 'l':
-                    switch (PeekChar(data, 7)) {
-                      case 'e': return LexKeyword(data, "f32x4.le", Opcode::F32X4Le, Features::Simd);
-                      case 't': return LexKeyword(data, "f32x4.lt", Opcode::F32X4Lt, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 'n':
-                    switch (PeekChar(data, 0)) {
-                      case 'f': return LexKeyword(data, "f32x4.ne", Opcode::F32X4Ne, Features::Simd);
-                      case 'i': return LexKeyword(data, "i32x4.ne", Opcode::I32X4Ne, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-              case '_':
-                switch (PeekChar(data, 9)) {
-                  case 's':
-                    switch (PeekChar(data, 7)) {
-                      case 'e':
-                        switch (PeekChar(data, 6)) {
-                          case 'g': return LexKeyword(data, "i32x4.ge_s", Opcode::I32X4GeS, Features::Simd);
-                          case 'l': return LexKeyword(data, "i32x4.le_s", Opcode::I32X4LeS, Features::Simd);
-                          default: break;
-                        }
-                        break;
-                      case 't':
-                        switch (PeekChar(data, 6)) {
-                          case 'g': return LexKeyword(data, "i32x4.gt_s", Opcode::I32X4GtS, Features::Simd);
-                          case 'l': return LexKeyword(data, "i32x4.lt_s", Opcode::I32X4LtS, Features::Simd);
-                          default: break;
-                        }
-                        break;
-                      default: break;
-                    }
-                    break;
-                  case 'u':
-                    switch (PeekChar(data, 7)) {
-                      case 'e':
-                        switch (PeekChar(data, 6)) {
-                          case 'g': return LexKeyword(data, "i32x4.ge_u", Opcode::I32X4GeU, Features::Simd);
-                          case 'l': return LexKeyword(data, "i32x4.le_u", Opcode::I32X4LeU, Features::Simd);
-                          default: break;
-                        }
-                        break;
-                      case 't':
-                        switch (PeekChar(data, 6)) {
-                          case 'g': return LexKeyword(data, "i32x4.gt_u", Opcode::I32X4GtU, Features::Simd);
-                          case 'l': return LexKeyword(data, "i32x4.lt_u", Opcode::I32X4LtU, Features::Simd);
-                          default: break;
-                        }
-                        break;
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-              case 'a':
-                switch (PeekChar(data, 10)) {
-                  default: return LexKeyword(data, "f32x4.pmax", Opcode::F32X4Pmax, Features::Simd);
-                  case 'e': return LexKeyword(data, "f32x4.nearest", Opcode::F32X4Nearest, Features::Simd);
-                }
-                break;
-              case 'b':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f32x4.sub", Opcode::F32X4Sub, Features::Simd);
-                  case 'i': return LexKeyword(data, "i32x4.sub", Opcode::I32X4Sub, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'd':
-                switch (PeekChar(data, 9)) {
-                  default:
-                    switch (PeekChar(data, 0)) {
-                      case 'f': return LexKeyword(data, "f32x4.add", Opcode::F32X4Add, Features::Simd);
-                      case 'i': return LexKeyword(data, "i32x4.add", Opcode::I32X4Add, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 'e':
-                    switch (PeekChar(data, 23)) {
-                      default:
-                        switch (PeekChar(data, 22)) {
-                          case 's': return LexKeyword(data, "i32x4.widen_low_i16x8_s", Opcode::I32X4WidenLowI16X8S, Features::Simd);
-                          case 'u': return LexKeyword(data, "i32x4.widen_low_i16x8_u", Opcode::I32X4WidenLowI16X8U, Features::Simd);
-                          default: break;
-                        }
-                        break;
-                      case 's': return LexKeyword(data, "i32x4.widen_high_i16x8_s", Opcode::I32X4WidenHighI16X8S, Features::Simd);
-                      case 'u': return LexKeyword(data, "i32x4.widen_high_i16x8_u", Opcode::I32X4WidenHighI16X8U, Features::Simd);
-                    }
-                    break;
-                }
-                break;
-              case 'g':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f32x4.neg", Opcode::F32X4Neg, Features::Simd);
-                  case 'i': return LexKeyword(data, "i32x4.neg", Opcode::I32X4Neg, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'i':
-                switch (PeekChar(data, 9)) {
-                  case 'l': return LexKeyword(data, "f32x4.ceil", Opcode::F32X4Ceil, Features::Simd);
-                  case 'n': return LexKeyword(data, "f32x4.pmin", Opcode::F32X4Pmin, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'l':
-                switch (PeekChar(data, 7)) {
-                  case 'h': return LexKeyword(data, "i32x4.shl", Opcode::I32X4Shl, Features::Simd);
-                  case 'l': return LexKeyword(data, "i32x4.all_true", Opcode::I32X4AllTrue, Features::Simd);
-                  case 'p':
-                    switch (PeekChar(data, 0)) {
-                      case 'f': return LexKeyword(data, "f32x4.splat", Opcode::F32X4Splat, Features::Simd);
-                      case 'i': return LexKeyword(data, "i32x4.splat", Opcode::I32X4Splat, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 'u':
-                    switch (PeekChar(data, 0)) {
-                      case 'f': return LexKeyword(data, "f32x4.mul", Opcode::F32X4Mul, Features::Simd);
-                      case 'i': return LexKeyword(data, "i32x4.mul", Opcode::I32X4Mul, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-              case 'n':
-                switch (PeekChar(data, 9)) {
-                  default: return LexKeyword(data, "f32x4.min", Opcode::F32X4Min, Features::Simd);
-                  case '_':
-                    switch (PeekChar(data, 10)) {
-                      case 's': return LexKeyword(data, "i32x4.min_s", Opcode::I32X4MinS, Features::Simd);
-                      case 'u': return LexKeyword(data, "i32x4.min_u", Opcode::I32X4MinU, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 'v':
-                    switch (PeekChar(data, 20)) {
-                      case 's': return LexKeyword(data, "f32x4.convert_i32x4_s", Opcode::F32X4ConvertI32X4S, Features::Simd);
-                      case 'u': return LexKeyword(data, "f32x4.convert_i32x4_u", Opcode::F32X4ConvertI32X4U, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                }
-                break;
-              case 'o': return LexKeyword(data, "f32x4.floor", Opcode::F32X4Floor, Features::Simd);
-              case 'p':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f32x4.replace_lane", TokenType::SimdLaneInstr, Opcode::F32X4ReplaceLane, Features::Simd);
-                  case 'i': return LexKeyword(data, "i32x4.replace_lane", TokenType::SimdLaneInstr, Opcode::I32X4ReplaceLane, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'r':
-                switch (PeekChar(data, 10)) {
-                  default: return LexKeyword(data, "f32x4.sqrt", Opcode::F32X4Sqrt, Features::Simd);
-                  case 's': return LexKeyword(data, "i32x4.shr_s", Opcode::I32X4ShrS, Features::Simd);
-                  case 'u': return LexKeyword(data, "i32x4.shr_u", Opcode::I32X4ShrU, Features::Simd);
-                }
-                break;
-              case 's':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f32x4.abs", Opcode::F32X4Abs, Features::Simd);
-                  case 'i': return LexKeyword(data, "i32x4.abs", Opcode::I32X4Abs, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 't':
-                switch (PeekChar(data, 13)) {
-                  default: return LexKeyword(data, "i32x4.bitmask", Opcode::I32X4Bitmask, Features::Simd);
-                  case '_':
-                    switch (PeekChar(data, 0)) {
-                      case 'f': return LexKeyword(data, "f32x4.extract_lane", TokenType::SimdLaneInstr, Opcode::F32X4ExtractLane, Features::Simd);
-                      case 'i': return LexKeyword(data, "i32x4.extract_lane", TokenType::SimdLaneInstr, Opcode::I32X4ExtractLane, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 'x': return LexKeyword(data, "i32x4.dot_i16x8_s", Opcode::I32X4DotI16X8S, Features::Simd);
-                }
-                break;
-              case 'u':
-                switch (PeekChar(data, 11)) {
-                  default: return LexKeyword(data, "f32x4.trunc", Opcode::F32X4Trunc, Features::Simd);
-                  case '_':
-                    switch (PeekChar(data, 22)) {
-                      case 's': return LexKeyword(data, "i32x4.trunc_sat_f32x4_s", Opcode::I32X4TruncSatF32X4S, Features::Simd);
-                      case 'u': return LexKeyword(data, "i32x4.trunc_sat_f32x4_u", Opcode::I32X4TruncSatF32X4U, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                }
-                break;
-              case 'v': return LexKeyword(data, "f32x4.div", Opcode::F32X4Div, Features::Simd);
-              case 'x':
-                switch (PeekChar(data, 9)) {
-                  default: return LexKeyword(data, "f32x4.max", Opcode::F32X4Max, Features::Simd);
-                  case '_':
-                    switch (PeekChar(data, 10)) {
-                      case 's': return LexKeyword(data, "i32x4.max_s", Opcode::I32X4MaxS, Features::Simd);
-                      case 'u': return LexKeyword(data, "i32x4.max_u", Opcode::I32X4MaxU, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                }
-                break;
-              case 'y': return LexKeyword(data, "i32x4.any_true", Opcode::I32X4AnyTrue, Features::Simd);
-            }
-            break;
-        }
-        break;
-    }
-    break;
-  case '4':
-    switch (PeekChar(data, 3)) {
-      default:
-        switch (PeekChar(data, 0)) {
-          case 'f': return LexKeyword(data, "f64", NumericType::F64);
-          case 'i': return LexKeyword(data, "i64", NumericType::I64);
-          default: break;
-        }
-        break;
-      case '.':
-        switch (PeekChar(data, 6)) {
-          default:
-            switch (PeekChar(data, 4)) {
-              case 'e':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f64.eq", Opcode::F64Eq);
-                  case 'i': return LexKeyword(data, "i64.eq", Opcode::I64Eq);
-                  default: break;
-                }
-                break;
-              case 'g':
-                switch (PeekChar(data, 5)) {
-                  case 'e': return LexKeyword(data, "f64.ge", Opcode::F64Ge);
-                  case 't': return LexKeyword(data, "f64.gt", Opcode::F64Gt);
-                  default: break;
-                }
-                break;
-              case 'l':
-                switch (PeekChar(data, 5)) {
-                  case 'e': return LexKeyword(data, "f64.le", Opcode::F64Le);
-                  case 't': return LexKeyword(data, "f64.lt", Opcode::F64Lt);
-                  default: break;
-                }
-                break;
-              case 'n':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f64.ne", Opcode::F64Ne);
-                  case 'i': return LexKeyword(data, "i64.ne", Opcode::I64Ne);
-                  default: break;
-                }
-                break;
-              case 'o': return LexKeyword(data, "i64.or", Opcode::I64Or);
-              default: break;
-            }
-            break;
-          case '_':
-            switch (PeekChar(data, 7)) {
-              case 's':
-                switch (PeekChar(data, 5)) {
-                  case 'e':
-                    switch (PeekChar(data, 4)) {
-                      case 'g': return LexKeyword(data, "i64.ge_s", Opcode::I64GeS);
-                      case 'l': return LexKeyword(data, "i64.le_s", Opcode::I64LeS);
-                      default: break;
-                    }
-                    break;
-                  case 't':
-                    switch (PeekChar(data, 4)) {
-                      case 'g': return LexKeyword(data, "i64.gt_s", Opcode::I64GtS);
-                      case 'l': return LexKeyword(data, "i64.lt_s", Opcode::I64LtS);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-              case 'u':
-                switch (PeekChar(data, 5)) {
-                  case 'e':
-                    switch (PeekChar(data, 4)) {
-                      case 'g': return LexKeyword(data, "i64.ge_u", Opcode::I64GeU);
-                      case 'l': return LexKeyword(data, "i64.le_u", Opcode::I64LeU);
-                      default: break;
-                    }
-                    break;
-                  case 't':
-                    switch (PeekChar(data, 4)) {
-                      case 'g': return LexKeyword(data, "i64.gt_u", Opcode::I64GtU);
-                      case 'l': return LexKeyword(data, "i64.lt_u", Opcode::I64LtU);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-              default: break;
-            }
-            break;
-          case 'a':
-            switch (PeekChar(data, 8)) {
-              default:
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f64.load", TokenType::MemoryInstr, Opcode::F64Load);
-                  case 'i': return LexKeyword(data, "i64.load", TokenType::MemoryInstr, Opcode::I64Load);
-                  default: break;
-                }
-                break;
-              case '1':
-                switch (PeekChar(data, 11)) {
-                  case 's': return LexKeyword(data, "i64.load16_s", TokenType::MemoryInstr, Opcode::I64Load16S);
-                  case 'u': return LexKeyword(data, "i64.load16_u", TokenType::MemoryInstr, Opcode::I64Load16U);
-                  default: break;
-                }
-                break;
-              case '3':
-                switch (PeekChar(data, 11)) {
-                  case 's': return LexKeyword(data, "i64.load32_s", TokenType::MemoryInstr, Opcode::I64Load32S);
-                  case 'u': return LexKeyword(data, "i64.load32_u", TokenType::MemoryInstr, Opcode::I64Load32U);
-                  default: break;
-                }
-                break;
-              case '8':
-                switch (PeekChar(data, 10)) {
-                  case 's': return LexKeyword(data, "i64.load8_s", TokenType::MemoryInstr, Opcode::I64Load8S);
-                  case 'u': return LexKeyword(data, "i64.load8_u", TokenType::MemoryInstr, Opcode::I64Load8U);
-                  default: break;
-                }
-                break;
-              case 'e': return LexKeyword(data, "f64.nearest", Opcode::F64Nearest);
-            }
-            break;
-          case 'b':
-            switch (PeekChar(data, 0)) {
-              case 'f': return LexKeyword(data, "f64.sub", Opcode::F64Sub);
-              case 'i': return LexKeyword(data, "i64.sub", Opcode::I64Sub);
-              default: break;
-            }
-            break;
-          case 'd':
-            switch (PeekChar(data, 5)) {
-              case 'd':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f64.add", Opcode::F64Add);
-                  case 'i': return LexKeyword(data, "i64.add", Opcode::I64Add);
-                  default: break;
-                }
-                break;
-              case 'n': return LexKeyword(data, "i64.and", Opcode::I64And);
-              default: break;
-            }
-            break;
-          case 'g': return LexKeyword(data, "f64.neg", Opcode::F64Neg);
-          case 'i':
-            switch (PeekChar(data, 8)) {
-              default: return LexKeyword(data, "f64.ceil", Opcode::F64Ceil);
-              case 't':
-                switch (PeekChar(data, 16)) {
-                  case 'f':
-                    switch (PeekChar(data, 15)) {
-                      case '/': return LexKeyword(data, "i64.reinterpret/f64", Opcode::I64ReinterpretF64);
-                      case '_': return LexKeyword(data, "i64.reinterpret_f64", Opcode::I64ReinterpretF64);
-                      default: break;
-                    }
-                    break;
-                  case 'i':
-                    switch (PeekChar(data, 15)) {
-                      case '/': return LexKeyword(data, "f64.reinterpret/i64", Opcode::F64ReinterpretI64);
-                      case '_': return LexKeyword(data, "f64.reinterpret_i64", Opcode::F64ReinterpretI64);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-            }
-            break;
-          case 'l':
-            switch (PeekChar(data, 5)) {
-              case 'h': return LexKeyword(data, "i64.shl", Opcode::I64Shl);
-              case 'u':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f64.mul", Opcode::F64Mul);
-                  case 'i': return LexKeyword(data, "i64.mul", Opcode::I64Mul);
-                  default: break;
-                }
-                break;
-              default: break;
-            }
-            break;
-          case 'm':
-            switch (PeekChar(data, 8)) {
-              case 's': return LexKeyword(data, "i64.rem_s", Opcode::I64RemS);
-              case 'u': return LexKeyword(data, "i64.rem_u", Opcode::I64RemU);
-              default: break;
-            }
-            break;
-          case 'n':
-            switch (PeekChar(data, 7)) {
-              default: return LexKeyword(data, "f64.min", Opcode::F64Min);
-              case 's':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f64.const", TokenType::F64ConstInstr, Opcode::F64Const);
-                  case 'i': return LexKeyword(data, "i64.const", TokenType::I64ConstInstr, Opcode::I64Const);
-                  default: break;
-                }
-                break;
-              case 'v':
-                switch (PeekChar(data, 16)) {
-                  case '2':
-                    switch (PeekChar(data, 12)) {
-                      case 's': return LexKeyword(data, "f64.convert_s/i32", Opcode::F64ConvertI32S);
-                      case 'u': return LexKeyword(data, "f64.convert_u/i32", Opcode::F64ConvertI32U);
-                      default: break;
-                    }
-                    break;
-                  case '4':
-                    switch (PeekChar(data, 12)) {
-                      case 's': return LexKeyword(data, "f64.convert_s/i64", Opcode::F64ConvertI64S);
-                      case 'u': return LexKeyword(data, "f64.convert_u/i64", Opcode::F64ConvertI64U);
-                      default: break;
-                    }
-                    break;
-                  case 's':
-                    switch (PeekChar(data, 14)) {
-                      case '2': return LexKeyword(data, "f64.convert_i32_s", Opcode::F64ConvertI32S);
-                      case '4': return LexKeyword(data, "f64.convert_i64_s", Opcode::F64ConvertI64S);
-                      default: break;
-                    }
-                    break;
-                  case 'u':
-                    switch (PeekChar(data, 14)) {
-                      case '2': return LexKeyword(data, "f64.convert_i32_u", Opcode::F64ConvertI32U);
-                      case '4': return LexKeyword(data, "f64.convert_i64_u", Opcode::F64ConvertI64U);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-            }
-            break;
-          case 'o':
-            switch (PeekChar(data, 9)) {
-              default:
-                switch (PeekChar(data, 8)) {
-                  case 'e':
-                    switch (PeekChar(data, 0)) {
-                      case 'f': return LexKeyword(data, "f64.store", TokenType::MemoryInstr, Opcode::F64Store);
-                      case 'i': return LexKeyword(data, "i64.store", TokenType::MemoryInstr, Opcode::I64Store);
-                      default: break;
-                    }
-                    break;
-                  case 'r': return LexKeyword(data, "f64.floor", Opcode::F64Floor);
-                  default: break;
-                }
-                break;
-              case '1': return LexKeyword(data, "i64.store16", TokenType::MemoryInstr, Opcode::I64Store16);
-              case '3': return LexKeyword(data, "i64.store32", TokenType::MemoryInstr, Opcode::I64Store32);
-              case '8': return LexKeyword(data, "i64.store8", TokenType::MemoryInstr, Opcode::I64Store8);
-              case 'c':
-                switch (PeekChar(data, 15)) {
-                  default: return LexKeyword(data, "i64.atomic.load", TokenType::MemoryInstr, Opcode::I64AtomicLoad, Features::Threads);
-                  case '.':
-                    switch (PeekChar(data, 17)) {
-                      case 'c': return LexKeyword(data, "i64.atomic.rmw8.xchg_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw8XchgU, Features::Threads);
-                      case 'd': return LexKeyword(data, "i64.atomic.rmw8.add_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw8AddU, Features::Threads);
-                      case 'm': return LexKeyword(data, "i64.atomic.rmw8.cmpxchg_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw8CmpxchgU, Features::Threads);
-                      case 'n': return LexKeyword(data, "i64.atomic.rmw8.and_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw8AndU, Features::Threads);
-                      case 'o': return LexKeyword(data, "i64.atomic.rmw8.xor_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw8XorU, Features::Threads);
-                      case 'r': return LexKeyword(data, "i64.atomic.rmw8.or_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw8OrU, Features::Threads);
-                      case 'u': return LexKeyword(data, "i64.atomic.rmw8.sub_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw8SubU, Features::Threads);
-                      default: break;
-                    }
-                    break;
-                  case '1': return LexKeyword(data, "i64.atomic.load16_u", TokenType::MemoryInstr, Opcode::I64AtomicLoad16U, Features::Threads);
-                  case '2':
-                    switch (PeekChar(data, 18)) {
-                      case 'c': return LexKeyword(data, "i64.atomic.rmw32.xchg_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw32XchgU, Features::Threads);
-                      case 'd': return LexKeyword(data, "i64.atomic.rmw32.add_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw32AddU, Features::Threads);
-                      case 'm': return LexKeyword(data, "i64.atomic.rmw32.cmpxchg_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw32CmpxchgU, Features::Threads);
-                      case 'n': return LexKeyword(data, "i64.atomic.rmw32.and_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw32AndU, Features::Threads);
-                      case 'o': return LexKeyword(data, "i64.atomic.rmw32.xor_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw32XorU, Features::Threads);
-                      case 'r': return LexKeyword(data, "i64.atomic.rmw32.or_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw32OrU, Features::Threads);
-                      case 'u': return LexKeyword(data, "i64.atomic.rmw32.sub_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw32SubU, Features::Threads);
-                      default: break;
-                    }
-                    break;
-                  case '3': return LexKeyword(data, "i64.atomic.load32_u", TokenType::MemoryInstr, Opcode::I64AtomicLoad32U, Features::Threads);
-                  case '6':
-                    switch (PeekChar(data, 18)) {
-                      case 'c': return LexKeyword(data, "i64.atomic.rmw16.xchg_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw16XchgU, Features::Threads);
-                      case 'd': return LexKeyword(data, "i64.atomic.rmw16.add_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw16AddU, Features::Threads);
-                      case 'm': return LexKeyword(data, "i64.atomic.rmw16.cmpxchg_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw16CmpxchgU, Features::Threads);
-                      case 'n': return LexKeyword(data, "i64.atomic.rmw16.and_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw16AndU, Features::Threads);
-                      case 'o': return LexKeyword(data, "i64.atomic.rmw16.xor_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw16XorU, Features::Threads);
-                      case 'r': return LexKeyword(data, "i64.atomic.rmw16.or_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw16OrU, Features::Threads);
-                      case 'u': return LexKeyword(data, "i64.atomic.rmw16.sub_u", TokenType::MemoryInstr, Opcode::I64AtomicRmw16SubU, Features::Threads);
-                      default: break;
-                    }
-                    break;
-                  case '8': return LexKeyword(data, "i64.atomic.load8_u", TokenType::MemoryInstr, Opcode::I64AtomicLoad8U, Features::Threads);
-                  case 'a':
-                    switch (PeekChar(data, 16)) {
-                      case 'd': return LexKeyword(data, "i64.atomic.rmw.add", TokenType::MemoryInstr, Opcode::I64AtomicRmwAdd, Features::Threads);
-                      case 'n': return LexKeyword(data, "i64.atomic.rmw.and", TokenType::MemoryInstr, Opcode::I64AtomicRmwAnd, Features::Threads);
-                      default: break;
-                    }
-                    break;
-                  case 'c': return LexKeyword(data, "i64.atomic.rmw.cmpxchg", TokenType::MemoryInstr, Opcode::I64AtomicRmwCmpxchg, Features::Threads);
-                  case 'e':
-                    switch (PeekChar(data, 16)) {
-                      default: return LexKeyword(data, "i64.atomic.store", TokenType::MemoryInstr, Opcode::I64AtomicStore, Features::Threads);
-                      case '1': return LexKeyword(data, "i64.atomic.store16", TokenType::MemoryInstr, Opcode::I64AtomicStore16, Features::Threads);
-                      case '3': return LexKeyword(data, "i64.atomic.store32", TokenType::MemoryInstr, Opcode::I64AtomicStore32, Features::Threads);
-                      case '8': return LexKeyword(data, "i64.atomic.store8", TokenType::MemoryInstr, Opcode::I64AtomicStore8, Features::Threads);
-                    }
-                    break;
-                  case 'o': return LexKeyword(data, "i64.atomic.rmw.or", TokenType::MemoryInstr, Opcode::I64AtomicRmwOr, Features::Threads);
-                  case 's': return LexKeyword(data, "i64.atomic.rmw.sub", TokenType::MemoryInstr, Opcode::I64AtomicRmwSub, Features::Threads);
-                  case 'x':
-                    switch (PeekChar(data, 18)) {
-                      default: return LexKeyword(data, "i64.atomic.rmw.xor", TokenType::MemoryInstr, Opcode::I64AtomicRmwXor, Features::Threads);
-                      case 'g': return LexKeyword(data, "i64.atomic.rmw.xchg", TokenType::MemoryInstr, Opcode::I64AtomicRmwXchg, Features::Threads);
-                    }
-                    break;
-                }
-                break;
-              case 't':
-                switch (PeekChar(data, 11)) {
-                  case '/': return LexKeyword(data, "f64.promote/f32", Opcode::F64PromoteF32);
-                  case '_': return LexKeyword(data, "f64.promote_f32", Opcode::F64PromoteF32);
-                  default: break;
-                }
-                break;
-            }
-            break;
-          case 'p':
-            switch (PeekChar(data, 10)) {
-              default: return LexKeyword(data, "i64.popcnt", Opcode::I64Popcnt);
-              case 'g': return LexKeyword(data, "f64.copysign", Opcode::F64Copysign);
-            }
-            break;
-          case 'r':
-            switch (PeekChar(data, 7)) {
-              default: return LexKeyword(data, "i64.xor", Opcode::I64Xor);
-              case '_':
-                switch (PeekChar(data, 8)) {
-                  case 's': return LexKeyword(data, "i64.shr_s", Opcode::I64ShrS);
-                  case 'u': return LexKeyword(data, "i64.shr_u", Opcode::I64ShrU);
-                  default: break;
-                }
-                break;
-              case 't': return LexKeyword(data, "f64.sqrt", Opcode::F64Sqrt);
-            }
-            break;
-          case 's': return LexKeyword(data, "f64.abs", Opcode::F64Abs);
-          case 't':
-            switch (PeekChar(data, 7)) {
-              case 'e':
-                switch (PeekChar(data, 11)) {
-                  case '2': return LexKeyword(data, "i64.extend32_s", Opcode::I64Extend32S, Features::SignExtension);
-                  case '6': return LexKeyword(data, "i64.extend16_s", Opcode::I64Extend16S, Features::SignExtension);
-                  case '_': return LexKeyword(data, "i64.extend8_s", Opcode::I64Extend8S, Features::SignExtension);
-                  case 'i':
-                    switch (PeekChar(data, 15)) {
-                      case 's': return LexKeyword(data, "i64.extend_i32_s", Opcode::I64ExtendI32S);
-                      case 'u': return LexKeyword(data, "i64.extend_i32_u", Opcode::I64ExtendI32U);
-                      default: break;
-                    }
-                    break;
-                  case 's': return LexKeyword(data, "i64.extend_s/i32", Opcode::I64ExtendI32S);
-                  case 'u': return LexKeyword(data, "i64.extend_u/i32", Opcode::I64ExtendI32U);
-                  default: break;
-                }
-                break;
-              case 'l': return LexKeyword(data, "i64.rotl", Opcode::I64Rotl);
-              case 'r': return LexKeyword(data, "i64.rotr", Opcode::I64Rotr);
-              default: break;
-            }
-            break;
-          case 'u':
-            switch (PeekChar(data, 9)) {
-              default: return LexKeyword(data, "f64.trunc", Opcode::F64Trunc);
-              case '_':
-                switch (PeekChar(data, 14)) {
-                  case '2':
-                    switch (PeekChar(data, 10)) {
-                      case 's': return LexKeyword(data, "i64.trunc_s/f32", Opcode::I64TruncF32S);
-                      case 'u': return LexKeyword(data, "i64.trunc_u/f32", Opcode::I64TruncF32U);
-                      default: break;
-                    }
-                    break;
-                  case '4':
-                    switch (PeekChar(data, 10)) {
-                      case 's': return LexKeyword(data, "i64.trunc_s/f64", Opcode::I64TruncF64S);
-                      case 'u': return LexKeyword(data, "i64.trunc_u/f64", Opcode::I64TruncF64U);
-                      default: break;
-                    }
-                    break;
-                  case 'f':
-                    switch (PeekChar(data, 18)) {
-                      case 's':
-                        switch (PeekChar(data, 16)) {
-                          case '2': return LexKeyword(data, "i64.trunc_sat_f32_s", Opcode::I64TruncSatF32S, Features::SaturatingFloatToInt);
-                          case '4': return LexKeyword(data, "i64.trunc_sat_f64_s", Opcode::I64TruncSatF64S, Features::SaturatingFloatToInt);
-                          default: break;
-                        }
-                        break;
-                      case 'u':
-                        switch (PeekChar(data, 16)) {
-                          case '2': return LexKeyword(data, "i64.trunc_sat_f32_u", Opcode::I64TruncSatF32U, Features::SaturatingFloatToInt);
-                          case '4': return LexKeyword(data, "i64.trunc_sat_f64_u", Opcode::I64TruncSatF64U, Features::SaturatingFloatToInt);
-                          default: break;
-                        }
-                        break;
-                      default: break;
-                    }
-                    break;
-                  case 's':
-                    switch (PeekChar(data, 12)) {
-                      case '2': return LexKeyword(data, "i64.trunc_f32_s", Opcode::I64TruncF32S);
-                      case '4': return LexKeyword(data, "i64.trunc_f64_s", Opcode::I64TruncF64S);
-                      default: break;
-                    }
-                    break;
-                  case 't':
-                    switch (PeekChar(data, 18)) {
-                      case '2':
-                        switch (PeekChar(data, 10)) {
-                          case 's': return LexKeyword(data, "i64.trunc_s:sat/f32", Opcode::I64TruncSatF32S, Features::SaturatingFloatToInt);
-                          case 'u': return LexKeyword(data, "i64.trunc_u:sat/f32", Opcode::I64TruncSatF32U, Features::SaturatingFloatToInt);
-                          default: break;
-                        }
-                        break;
-                      case '4':
-                        switch (PeekChar(data, 10)) {
-                          case 's': return LexKeyword(data, "i64.trunc_s:sat/f64", Opcode::I64TruncSatF64S, Features::SaturatingFloatToInt);
-                          case 'u': return LexKeyword(data, "i64.trunc_u:sat/f64", Opcode::I64TruncSatF64U, Features::SaturatingFloatToInt);
-                          default: break;
-                        }
-                        break;
-                      default: break;
-                    }
-                    break;
-                  case 'u':
-                    switch (PeekChar(data, 12)) {
-                      case '2': return LexKeyword(data, "i64.trunc_f32_u", Opcode::I64TruncF32U);
-                      case '4': return LexKeyword(data, "i64.trunc_f64_u", Opcode::I64TruncF64U);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-            }
-            break;
-          case 'v':
-            switch (PeekChar(data, 7)) {
-              default: return LexKeyword(data, "f64.div", Opcode::F64Div);
-              case '_':
-                switch (PeekChar(data, 8)) {
-                  case 's': return LexKeyword(data, "i64.div_s", Opcode::I64DivS);
-                  case 'u': return LexKeyword(data, "i64.div_u", Opcode::I64DivU);
-                  default: break;
-                }
-                break;
-            }
-            break;
-          case 'x': return LexKeyword(data, "f64.max", Opcode::F64Max);
-          case 'z':
-            switch (PeekChar(data, 5)) {
-              case 'l': return LexKeyword(data, "i64.clz", Opcode::I64Clz);
-              case 'q': return LexKeyword(data, "i64.eqz", Opcode::I64Eqz);
-              case 't': return LexKeyword(data, "i64.ctz", Opcode::I64Ctz);
-              default: break;
-            }
-            break;
-        }
-        break;
-      case 'x':
-        switch (PeekChar(data, 5)) {
-          default:
-            switch (PeekChar(data, 0)) {
-              case 'f': return LexKeyword(data, "f64x2", SimdShape::F64X2);
-              case 'i': return LexKeyword(data, "i64x2", SimdShape::I64X2);
-              default: break;
-            }
-            break;
-          case '.':
-            switch (PeekChar(data, 8)) {
-              default:
-                switch (PeekChar(data, 6)) {
-                  case 'e': return LexKeyword(data, "f64x2.eq", Opcode::F64X2Eq, Features::Simd);
-                  case 'g':
-                    switch (PeekChar(data, 7)) {
-                      case 'e': return LexKeyword(data, "f64x2.ge", Opcode::F64X2Ge, Features::Simd);
-                      case 't': return LexKeyword(data, "f64x2.gt", Opcode::F64X2Gt, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 'l':
-                    switch (PeekChar(data, 7)) {
-                      case 'e': return LexKeyword(data, "f64x2.le", Opcode::F64X2Le, Features::Simd);
-                      case 't': return LexKeyword(data, "f64x2.lt", Opcode::F64X2Lt, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 'n': return LexKeyword(data, "f64x2.ne", Opcode::F64X2Ne, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'a':
-                switch (PeekChar(data, 10)) {
-                  default: return LexKeyword(data, "f64x2.pmax", Opcode::F64X2Pmax, Features::Simd);
-                  case 'e': return LexKeyword(data, "f64x2.nearest", Opcode::F64X2Nearest, Features::Simd);
-                }
-                break;
-              case 'b':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f64x2.sub", Opcode::F64X2Sub, Features::Simd);
-                  case 'i': return LexKeyword(data, "i64x2.sub", Opcode::I64X2Sub, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'd':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f64x2.add", Opcode::F64X2Add, Features::Simd);
-                  case 'i': return LexKeyword(data, "i64x2.add", Opcode::I64X2Add, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'g':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f64x2.neg", Opcode::F64X2Neg, Features::Simd);
-                  case 'i': return LexKeyword(data, "i64x2.neg", Opcode::I64X2Neg, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'i':
-                switch (PeekChar(data, 9)) {
-                  case 'l': return LexKeyword(data, "f64x2.ceil", Opcode::F64X2Ceil, Features::Simd);
-                  case 'n': return LexKeyword(data, "f64x2.pmin", Opcode::F64X2Pmin, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'l':
-                switch (PeekChar(data, 7)) {
-                  case 'h': return LexKeyword(data, "i64x2.shl", Opcode::I64X2Shl, Features::Simd);
-                  case 'p':
-                    switch (PeekChar(data, 0)) {
-                      case 'f': return LexKeyword(data, "f64x2.splat", Opcode::F64X2Splat, Features::Simd);
-                      case 'i': return LexKeyword(data, "i64x2.splat", Opcode::I64X2Splat, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 'u':
-                    switch (PeekChar(data, 0)) {
-                      case 'f': return LexKeyword(data, "f64x2.mul", Opcode::F64X2Mul, Features::Simd);
-                      case 'i': return LexKeyword(data, "i64x2.mul", Opcode::I64X2Mul, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-              case 'n': return LexKeyword(data, "f64x2.min", Opcode::F64X2Min, Features::Simd);
-              case 'o': return LexKeyword(data, "f64x2.floor", Opcode::F64X2Floor, Features::Simd);
-              case 'p':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f64x2.replace_lane", TokenType::SimdLaneInstr, Opcode::F64X2ReplaceLane, Features::Simd);
-                  case 'i': return LexKeyword(data, "i64x2.replace_lane", TokenType::SimdLaneInstr, Opcode::I64X2ReplaceLane, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'r':
-                switch (PeekChar(data, 10)) {
-                  default: return LexKeyword(data, "f64x2.sqrt", Opcode::F64X2Sqrt, Features::Simd);
-                  case 's': return LexKeyword(data, "i64x2.shr_s", Opcode::I64X2ShrS, Features::Simd);
-                  case 'u': return LexKeyword(data, "i64x2.shr_u", Opcode::I64X2ShrU, Features::Simd);
-                }
-                break;
-              case 's': return LexKeyword(data, "f64x2.abs", Opcode::F64X2Abs, Features::Simd);
-              case 't':
-                switch (PeekChar(data, 0)) {
-                  case 'f': return LexKeyword(data, "f64x2.extract_lane", TokenType::SimdLaneInstr, Opcode::F64X2ExtractLane, Features::Simd);
-                  case 'i': return LexKeyword(data, "i64x2.extract_lane", TokenType::SimdLaneInstr, Opcode::I64X2ExtractLane, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'u': return LexKeyword(data, "f64x2.trunc", Opcode::F64X2Trunc, Features::Simd);
-              case 'v': return LexKeyword(data, "f64x2.div", Opcode::F64X2Div, Features::Simd);
-              case 'x': return LexKeyword(data, "f64x2.max", Opcode::F64X2Max, Features::Simd);
-            }
-            break;
-        }
-        break;
-    }
-    break;
-  case '6':
-    switch (PeekChar(data, 3)) {
-      default: return LexKeyword(data, "i16", PackedType::I16);
-      case 'x':
-        switch (PeekChar(data, 5)) {
-          default: return LexKeyword(data, "i16x8", SimdShape::I16X8);
-          case '.':
-            switch (PeekChar(data, 7)) {
-              case 'a':
-                switch (PeekChar(data, 10)) {
-                  case 'o':
-                    switch (PeekChar(data, 19)) {
-                      case 's': return LexKeyword(data, "i16x8.narrow_i32x4_s", Opcode::I16X8NarrowI32X4S, Features::Simd);
-                      case 'u': return LexKeyword(data, "i16x8.narrow_i32x4_u", Opcode::I16X8NarrowI32X4U, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 's': return LexKeyword(data, "i16x8.max_s", Opcode::I16X8MaxS, Features::Simd);
-                  case 'u': return LexKeyword(data, "i16x8.max_u", Opcode::I16X8MaxU, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'b': return LexKeyword(data, "i16x8.abs", Opcode::I16X8Abs, Features::Simd);
-              case 'd':
-                switch (PeekChar(data, 9)) {
-                  default: return LexKeyword(data, "i16x8.add", Opcode::I16X8Add, Features::Simd);
-                  case '_':
-                    switch (PeekChar(data, 14)) {
-                      case 's': return LexKeyword(data, "i16x8.add_sat_s", Opcode::I16X8AddSatS, Features::Simd);
-                      case 'u': return LexKeyword(data, "i16x8.add_sat_u", Opcode::I16X8AddSatU, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                }
-                break;
-              case 'e':
-                switch (PeekChar(data, 8)) {
-                  default: return LexKeyword(data, "i16x8.ne", Opcode::I16X8Ne, Features::Simd);
-                  case '_':
-                    switch (PeekChar(data, 9)) {
-                      case 's':
-                        switch (PeekChar(data, 6)) {
-                          case 'g': return LexKeyword(data, "i16x8.ge_s", Opcode::I16X8GeS, Features::Simd);
-                          case 'l': return LexKeyword(data, "i16x8.le_s", Opcode::I16X8LeS, Features::Simd);
-                          default: break;
-                        }
-                        break;
-                      case 'u':
-                        switch (PeekChar(data, 6)) {
-                          case 'g': return LexKeyword(data, "i16x8.ge_u", Opcode::I16X8GeU, Features::Simd);
-                          case 'l': return LexKeyword(data, "i16x8.le_u", Opcode::I16X8LeU, Features::Simd);
-                          default: break;
-                        }
-                        break;
-                      default: break;
-                    }
-                    break;
-                  case 'g': return LexKeyword(data, "i16x8.neg", Opcode::I16X8Neg, Features::Simd);
-                  case 'p': return LexKeyword(data, "i16x8.replace_lane", TokenType::SimdLaneInstr, Opcode::I16X8ReplaceLane, Features::Simd);
-                }
-                break;
-              case 'h':
-                switch (PeekChar(data, 9)) {
-                  default: return LexKeyword(data, "i16x8.shl", Opcode::I16X8Shl, Features::Simd);
-                  case '_':
-                    switch (PeekChar(data, 10)) {
-                      case 's': return LexKeyword(data, "i16x8.shr_s", Opcode::I16X8ShrS, Features::Simd);
-                      case 'u': return LexKeyword(data, "i16x8.shr_u", Opcode::I16X8ShrU, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                }
-                break;
-              case 'i':
-                switch (PeekChar(data, 10)) {
-                  case 'a': return LexKeyword(data, "i16x8.bitmask", Opcode::I16X8Bitmask, Features::Simd);
-                  case 'n':
-                    switch (PeekChar(data, 23)) {
-                      default:
-                        switch (PeekChar(data, 22)) {
-                          case 's': return LexKeyword(data, "i16x8.widen_low_i8x16_s", Opcode::I16X8WidenLowI8X16S, Features::Simd);
-                          case 'u': return LexKeyword(data, "i16x8.widen_low_i8x16_u", Opcode::I16X8WidenLowI8X16U, Features::Simd);
-                          default: break;
-                        }
-                        break;
-                      case 's': return LexKeyword(data, "i16x8.widen_high_i8x16_s", Opcode::I16X8WidenHighI8X16S, Features::Simd);
-                      case 'u': return LexKeyword(data, "i16x8.widen_high_i8x16_u", Opcode::I16X8WidenHighI8X16U, Features::Simd);
-                    }
-                    break;
-                  case 's': return LexKeyword(data, "i16x8.min_s", Opcode::I16X8MinS, Features::Simd);
-                  case 'u': return LexKeyword(data, "i16x8.min_u", Opcode::I16X8MinU, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 'l': return LexKeyword(data, "i16x8.all_true", Opcode::I16X8AllTrue, Features::Simd);
-              case 'n': return LexKeyword(data, "i16x8.any_true", Opcode::I16X8AnyTrue, Features::Simd);
-              case 'p': return LexKeyword(data, "i16x8.splat", Opcode::I16X8Splat, Features::Simd);
-              case 'q': return LexKeyword(data, "i16x8.eq", Opcode::I16X8Eq, Features::Simd);
-              case 't':
-                switch (PeekChar(data, 9)) {
-                  case 's':
-                    switch (PeekChar(data, 6)) {
-                      case 'g': return LexKeyword(data, "i16x8.gt_s", Opcode::I16X8GtS, Features::Simd);
-                      case 'l': return LexKeyword(data, "i16x8.lt_s", Opcode::I16X8LtS, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 'u':
-                    switch (PeekChar(data, 6)) {
-                      case 'g': return LexKeyword(data, "i16x8.gt_u", Opcode::I16X8GtU, Features::Simd);
-                      case 'l': return LexKeyword(data, "i16x8.lt_u", Opcode::I16X8LtU, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-              case 'u':
-                switch (PeekChar(data, 9)) {
-                  default:
-                    switch (PeekChar(data, 8)) {
-                      case 'b': return LexKeyword(data, "i16x8.sub", Opcode::I16X8Sub, Features::Simd);
-                      case 'l': return LexKeyword(data, "i16x8.mul", Opcode::I16X8Mul, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case '_':
-                    switch (PeekChar(data, 14)) {
-                      case 's': return LexKeyword(data, "i16x8.sub_sat_s", Opcode::I16X8SubSatS, Features::Simd);
-                      case 'u': return LexKeyword(data, "i16x8.sub_sat_u", Opcode::I16X8SubSatU, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                }
-                break;
-              case 'v': return LexKeyword(data, "i16x8.avgr_u", Opcode::I16X8AvgrU, Features::Simd);
-              case 'x':
-                switch (PeekChar(data, 19)) {
-                  case 's': return LexKeyword(data, "i16x8.extract_lane_s", TokenType::SimdLaneInstr, Opcode::I16X8ExtractLaneS, Features::Simd);
-                  case 'u': return LexKeyword(data, "i16x8.extract_lane_u", TokenType::SimdLaneInstr, Opcode::I16X8ExtractLaneU, Features::Simd);
-                  default: break;
-                }
-                break;
-              default: break;
-            }
-            break;
-        }
-        break;
-    }
-    break;
-  case '_':
-    switch (PeekChar(data, 5)) {
-      default: return LexKeyword(data, "br_if", TokenType::VarInstr, Opcode::BrIf);
-      case '_':
-        switch (PeekChar(data, 9)) {
-          default: return LexKeyword(data, "br_on_exn", TokenType::BrOnExnInstr, Opcode::BrOnExn, Features::Exceptions);
-          case 'l': return LexKeyword(data, "br_on_null", TokenType::VarInstr, Opcode::BrOnNull, Features::FunctionReferences);
-          case 't': return LexKeyword(data, "br_on_cast", TokenType::BrOnCastInstr, Opcode::BrOnCast, Features::GC);
-        }
-        break;
-      case 'b': return LexKeyword(data, "br_table", TokenType::BrTableInstr, Opcode::BrTable);
-    }
-    break;
-  case 'a':
-    switch (PeekChar(data, 5)) {
-      default: return LexKeyword(data, "start", TokenType::Start);
-      case 'd': return LexKeyword(data, "shared", TokenType::Shared);
-    }
-    break;
-  case 'b':
-    switch (PeekChar(data, 5)) {
-      default: return LexKeyword(data, "table", TokenType::Table);
-      case '.':
-        switch (PeekChar(data, 9)) {
-          default:
-            switch (PeekChar(data, 6)) {
-              case 'g': return LexKeyword(data, "table.get", TokenType::VarInstr, Opcode::TableGet, Features::ReferenceTypes);
-              case 's': return LexKeyword(data, "table.set", TokenType::VarInstr, Opcode::TableSet, Features::ReferenceTypes);
-              default: break;
-            }
-            break;
-          case 'e': return LexKeyword(data, "table.size", TokenType::VarInstr, Opcode::TableSize, Features::ReferenceTypes);
-          case 'l': return LexKeyword(data, "table.fill", TokenType::VarInstr, Opcode::TableFill, Features::ReferenceTypes);
-          case 't': return LexKeyword(data, "table.init", TokenType::TableInitInstr, Opcode::TableInit, Features::BulkMemory);
-          case 'w': return LexKeyword(data, "table.grow", TokenType::VarInstr, Opcode::TableGrow, Features::ReferenceTypes);
-          case 'y': return LexKeyword(data, "table.copy", TokenType::TableCopyInstr, Opcode::TableCopy, Features::BulkMemory);
-        }
-        break;
-    }
-    break;
-  case 'c':
-    switch (PeekChar(data, 5)) {
-      default: return LexKeyword(data, "local", TokenType::Local);
-      case '.':
-        switch (PeekChar(data, 6)) {
-          case 'g': return LexKeyword(data, "local.get", TokenType::VarInstr, Opcode::LocalGet);
-          case 's': return LexKeyword(data, "local.set", TokenType::VarInstr, Opcode::LocalSet);
-          case 't': return LexKeyword(data, "local.tee", TokenType::VarInstr, Opcode::LocalTee);
-          default: break;
-        }
-        break;
-      case 'r': return LexKeyword(data, "declare", TokenType::Declare);
-    }
-    break;
-  case 'd':
-    switch (PeekChar(data, 3)) {
-      default: return LexKeyword(data, "end", TokenType::End, Opcode::End);
-      case 'u': return LexKeyword(data, "module", TokenType::Module);
-    }
-    break;
-  case 'e':
-    switch (PeekChar(data, 1)) {
-      case 'e': return LexKeyword(data, "tee_local", TokenType::VarInstr, Opcode::LocalTee);
-      case 'h': return LexKeyword(data, "then", TokenType::Then);
-      case 'i': return LexKeyword(data, "field", TokenType::Field);
-      case 'l':
-        switch (PeekChar(data, 4)) {
-          default: return LexKeyword(data, "elem", TokenType::Elem);
-          case '.': return LexKeyword(data, "elem.drop", TokenType::VarInstr, Opcode::ElemDrop, Features::BulkMemory);
-        }
-        break;
-      case 't': return LexKeyword(data, "item", TokenType::Item);
-      case 'v': return LexKeyword(data, "event", TokenType::Event);
-      default: break;
-    }
-    break;
-  case 'f':
-    switch (PeekChar(data, 3)) {
-      default:
-        switch (PeekChar(data, 1)) {
-          case 'e': return LexKeyword(data, "ref", TokenType::Ref);
-          case 'n': return LexKeyword(data, "inf", TokenType::Float, LiteralKind::Infinity);
-          default: break;
-        }
-        break;
-      case '.':
-        switch (PeekChar(data, 4)) {
-          case 'a': return LexKeyword(data, "ref.as_non_null", Opcode::RefAsNonNull, Features::FunctionReferences);
-          case 'c': return LexKeyword(data, "ref.cast", TokenType::HeapType2Instr, Opcode::RefCast, Features::GC);
-          case 'e':
-            switch (PeekChar(data, 6)) {
-              default: return LexKeyword(data, "ref.eq", Opcode::RefEq, Features::GC);
-              case 't': return LexKeyword(data, "ref.extern", TokenType::RefExtern);
-            }
-            break;
-          case 'f': return LexKeyword(data, "ref.func", TokenType::RefFuncInstr, Opcode::RefFunc, Features::ReferenceTypes);
-          case 'i': return LexKeyword(data, "ref.is_null", Opcode::RefIsNull, Features::ReferenceTypes);
-          case 'n': return LexKeyword(data, "ref.null", TokenType::RefNullInstr, Opcode::RefNull, Features::ReferenceTypes);
-          case 't': return LexKeyword(data, "ref.test", TokenType::HeapType2Instr, Opcode::RefTest, Features::GC);
-          default: break;
-        }
-        break;
-      case 's':
-        switch (PeekChar(data, 6)) {
-          default: return LexKeyword(data, "offset", TokenType::Offset);
-          case '=': return LexNameEqNum(data, "offset=", TokenType::OffsetEqNat);
-        }
-        break;
-    }
-    break;
-  case 'g': return LexKeyword(data, "register", TokenType::Register);
-  case 'i': return LexNameEqNum(data, "align=", TokenType::AlignEqNat);
-  case 'l':
-    switch (PeekChar(data, 4)) {
-      default:
-        switch (PeekChar(data, 1)) {
-          case 'a': return LexKeyword(data, "call", TokenType::VarInstr, Opcode::Call);
-          case 'u': return LexKeyword(data, "null", TokenType::Null);
-          default: break;
-        }
-        break;
-      case '_':
-        switch (PeekChar(data, 8)) {
-          default: return LexKeyword(data, "call_ref", Opcode::CallRef, Features::FunctionReferences);
-          case 'i': return LexKeyword(data, "call_indirect", TokenType::CallIndirectInstr, Opcode::CallIndirect);
-        }
-        break;
-      case 'c': return LexKeyword(data, "select", TokenType::SelectInstr, Opcode::Select);
-    }
-    break;
-  case 'm':
-    switch (PeekChar(data, 6)) {
-      default: return LexKeyword(data, "memory", TokenType::Memory);
-      case '.':
-        switch (PeekChar(data, 10)) {
-          case 'e': return LexKeyword(data, "memory.size", Opcode::MemorySize);
-          case 'l': return LexKeyword(data, "memory.fill", Opcode::MemoryFill, Features::BulkMemory);
-          case 'm':
-            switch (PeekChar(data, 19)) {
-              case '2': return LexKeyword(data, "memory.atomic.wait32", TokenType::MemoryInstr, Opcode::MemoryAtomicWait32, Features::Threads);
-              case '4': return LexKeyword(data, "memory.atomic.wait64", TokenType::MemoryInstr, Opcode::MemoryAtomicWait64, Features::Threads);
-              case 'y': return LexKeyword(data, "memory.atomic.notify", TokenType::MemoryInstr, Opcode::MemoryAtomicNotify, Features::Threads);
-              default: break;
-            }
-            break;
-          case 't': return LexKeyword(data, "memory.init", TokenType::MemoryInitInstr, Opcode::MemoryInit, Features::BulkMemory);
-          case 'w': return LexKeyword(data, "memory.grow", Opcode::MemoryGrow);
-          case 'y': return LexKeyword(data, "memory.copy", TokenType::MemoryCopyInstr, Opcode::MemoryCopy, Features::BulkMemory);
-          default: break;
-        }
-        break;
-    }
-    break;
-  case 'n':
-    switch (PeekChar(data, 3)) {
-      default:
-        switch (PeekChar(data, 1)) {
-          case 'a': return LexKeyword(data, "nan", TokenType::Float, LiteralKind::Nan);
-          case 'x': return LexKeyword(data, "exn", TokenType::HeapKind, HeapKind::Exn);
-          default: break;
-        }
-        break;
-      case ':':
-        switch (PeekChar(data, 6)) {
-          default: return LexNan(data);
-          case 'i': return LexKeyword(data, "nan:arithmetic", TokenType::NanArithmetic);
-          case 'n': return LexKeyword(data, "nan:canonical", TokenType::NanCanonical);
-        }
-        break;
-      case 'a': return LexKeyword(data, "binary", TokenType::Binary);
-      case 'c':
-        switch (PeekChar(data, 4)) {
-          default: return LexKeyword(data, "func", TokenType::Func, HeapKind::Func);
-          case '.': return LexKeyword(data, "func.bind", TokenType::FuncBindInstr, Opcode::FuncBind, Features::FunctionReferences);
-          case 'r': return LexKeyword(data, "funcref", ReferenceKind::Funcref);
-        }
-        break;
-      case 'r': return LexKeyword(data, "exnref", ReferenceKind::Exnref);
-    }
-    break;
-  case 'o':
-    switch (PeekChar(data, 4)) {
-      default:
-        switch (PeekChar(data, 1)) {
-          case 'o': return LexKeyword(data, "loop", TokenType::BlockInstr, Opcode::Loop);
-          case 'r': return LexKeyword(data, "drop", Opcode::Drop);
-          default: break;
-        }
-        break;
-      case '_': return LexKeyword(data, "grow_memory", Opcode::MemoryGrow);
-      case 'a':
-        switch (PeekChar(data, 6)) {
-          default: return LexKeyword(data, "global", TokenType::Global);
-          case '.':
-            switch (PeekChar(data, 7)) {
-              case 'g': return LexKeyword(data, "global.get", TokenType::VarInstr, Opcode::GlobalGet);
-              case 's': return LexKeyword(data, "global.set", TokenType::VarInstr, Opcode::GlobalSet);
-              default: break;
-            }
-            break;
-        }
-        break;
-      case 'e': return LexKeyword(data, "quote", TokenType::Quote);
-      case 'k': return LexKeyword(data, "block", TokenType::BlockInstr, Opcode::Block);
-    }
-    break;
-  case 'p':
-    switch (PeekChar(data, 1)) {
-      case 'm': return LexKeyword(data, "import", TokenType::Import);
-      case 'o': return LexKeyword(data, "nop", Opcode::Nop);
-      case 'x': return LexKeyword(data, "export", TokenType::Export);
-      case 'y': return LexKeyword(data, "type", TokenType::Type);
-      default: break;
-    }
-    break;
-  case 'r':
-    switch (PeekChar(data, 4)) {
-      case 'a': return LexKeyword(data, "unreachable", Opcode::Unreachable);
-      case 'c':
-        switch (PeekChar(data, 6)) {
-          default: return LexKeyword(data, "struct", TokenType::Struct);
-          case '.':
-            switch (PeekChar(data, 7)) {
-              case 'g':
-                switch (PeekChar(data, 10)) {
-                  default: return LexKeyword(data, "struct.get", TokenType::StructFieldInstr, Opcode::StructGet, Features::GC);
-                  case '_':
-                    switch (PeekChar(data, 11)) {
-                      case 's': return LexKeyword(data, "struct.get_s", TokenType::StructFieldInstr, Opcode::StructGetS, Features::GC);
-                      case 'u': return LexKeyword(data, "struct.get_u", TokenType::StructFieldInstr, Opcode::StructGetU, Features::GC);
-                      default: break;
-                    }
-                    break;
-                }
-                break;
-              case 'n':
-                switch (PeekChar(data, 19)) {
-                  default: return LexKeyword(data, "struct.new_with_rtt", TokenType::VarInstr, Opcode::StructNewWithRtt, Features::GC);
-                  case 'w': return LexKeyword(data, "struct.new_default_with_rtt", TokenType::VarInstr, Opcode::StructNewDefaultWithRtt, Features::GC);
-                }
-                break;
-              case 's': return LexKeyword(data, "struct.set", TokenType::StructFieldInstr, Opcode::StructSet, Features::GC);
-              default: break;
-            }
-            break;
-        }
-        break;
-      case 'e': return LexKeyword(data, "current_memory", Opcode::MemorySize);
-      case 'f': return LexKeyword(data, "eqref", ReferenceKind::Eqref);
-      case 'm': return LexKeyword(data, "param", TokenType::Param);
-      case 'w': return LexKeyword(data, "throw", TokenType::VarInstr, Opcode::Throw, Features::Exceptions);
-      case 'y':
-        switch (PeekChar(data, 5)) {
-          default: return LexKeyword(data, "array", TokenType::Array);
-          case '.':
-            switch (PeekChar(data, 6)) {
-              case 'g':
-                switch (PeekChar(data, 9)) {
-                  default: return LexKeyword(data, "array.get", TokenType::VarInstr, Opcode::ArrayGet, Features::GC);
-                  case '_':
-                    switch (PeekChar(data, 10)) {
-                      case 's': return LexKeyword(data, "array.get_s", TokenType::VarInstr, Opcode::ArrayGetS, Features::GC);
-                      case 'u': return LexKeyword(data, "array.get_u", TokenType::VarInstr, Opcode::ArrayGetU, Features::GC);
-                      default: break;
-                    }
-                    break;
-                }
-                break;
-              case 'l': return LexKeyword(data, "array.len", TokenType::VarInstr, Opcode::ArrayLen, Features::GC);
-              case 'n':
-                switch (PeekChar(data, 18)) {
-                  default: return LexKeyword(data, "array.new_with_rtt", TokenType::VarInstr, Opcode::ArrayNewWithRtt, Features::GC);
-                  case 'w': return LexKeyword(data, "array.new_default_with_rtt", TokenType::VarInstr, Opcode::ArrayNewDefaultWithRtt, Features::GC);
-                }
-                break;
-              case 's': return LexKeyword(data, "array.set", TokenType::VarInstr, Opcode::ArraySet, Features::GC);
-              default: break;
-            }
-            break;
-        }
-        break;
-      default: break;
-    }
-    break;
-  case 's':
-    switch (PeekChar(data, 4)) {
-      default: return LexKeyword(data, "else", TokenType::Else, Opcode::Else);
-      case 'l': return LexKeyword(data, "result", TokenType::Result);
-      case 'r':
-        switch (PeekChar(data, 11)) {
-          default: return LexKeyword(data, "assert_trap", TokenType::AssertTrap);
-          case 'l': return LexKeyword(data, "assert_invalid", TokenType::AssertInvalid);
-          case 'n': return LexKeyword(data, "assert_unlinkable", TokenType::AssertUnlinkable);
-          case 'o': return LexKeyword(data, "assert_malformed", TokenType::AssertMalformed);
-          case 'r': return LexKeyword(data, "assert_return", TokenType::AssertReturn);
-          case 'u': return LexKeyword(data, "assert_exhaustion", TokenType::AssertExhaustion);
-        }
-        break;
-    }
-    break;
-  case 't':
-    switch (PeekChar(data, 3)) {
-      default:
-        switch (PeekChar(data, 0)) {
-          case 'g': return LexKeyword(data, "get", TokenType::Get);
-          case 'l': return LexKeyword(data, "let", TokenType::LetInstr, Opcode::Let, Features::FunctionReferences);
-          case 'm': return LexKeyword(data, "mut", TokenType::Mut);
-          case 'r': return LexKeyword(data, "rtt", TokenType::Rtt);
-          default: break;
-        }
-        break;
-      case '.':
-        switch (PeekChar(data, 7)) {
-          default: return LexKeyword(data, "rtt.sub", TokenType::RttSubInstr, Opcode::RttSub, Features::GC);
-          case 'o': return LexKeyword(data, "rtt.canon", TokenType::HeapTypeInstr, Opcode::RttCanon, Features::GC);
-        }
-        break;
-      case '_':
-        switch (PeekChar(data, 9)) {
-          default:
-            switch (PeekChar(data, 0)) {
-              case 'g': return LexKeyword(data, "get_local", TokenType::VarInstr, Opcode::LocalGet);
-              case 's': return LexKeyword(data, "set_local", TokenType::VarInstr, Opcode::LocalSet);
-              default: break;
-            }
-            break;
-          case 'l':
-            switch (PeekChar(data, 0)) {
-              case 'g': return LexKeyword(data, "get_global", TokenType::VarInstr, Opcode::GlobalGet);
-              case 's': return LexKeyword(data, "set_global", TokenType::VarInstr, Opcode::GlobalSet);
-              default: break;
-            }
-            break;
-        }
-        break;
-      case 'a':
-        switch (PeekChar(data, 4)) {
-          default: return LexKeyword(data, "data", TokenType::Data);
-          case '.': return LexKeyword(data, "data.drop", TokenType::VarInstr, Opcode::DataDrop, Features::BulkMemory);
-        }
-        break;
-      case 'c': return LexKeyword(data, "catch", TokenType::Catch, Opcode::Catch);
-      case 'e':
-        switch (PeekChar(data, 6)) {
-          default: return LexKeyword(data, "extern", TokenType::HeapKind, HeapKind::Extern);
-          case 'r': return LexKeyword(data, "externref", ReferenceKind::Externref);
-        }
-        break;
-      case 'h': return LexKeyword(data, "rethrow", Opcode::Rethrow, Features::Exceptions);
-      case 'u':
-        switch (PeekChar(data, 6)) {
-          default: return LexKeyword(data, "return", Opcode::Return);
-          case '_':
-            switch (PeekChar(data, 11)) {
-              default: return LexKeyword(data, "return_call", TokenType::VarInstr, Opcode::ReturnCall, Features::TailCall);
-              case '_':
-                switch (PeekChar(data, 15)) {
-                  default: return LexKeyword(data, "return_call_ref", Opcode::ReturnCallRef, Features::FunctionReferences);
-                  case 'i': return LexKeyword(data, "return_call_indirect", TokenType::CallIndirectInstr, Opcode::ReturnCallIndirect, Features::TailCall);
-                }
-                break;
-            }
-            break;
-        }
-        break;
-    }
-    break;
-  case 'v': return LexKeyword(data, "invoke", TokenType::Invoke);
-  case 'x':
-    switch (PeekChar(data, 5)) {
-      default: return LexKeyword(data, "i8x16", SimdShape::I8X16);
-      case '.':
-        switch (PeekChar(data, 8)) {
-          default:
-            switch (PeekChar(data, 7)) {
-              case 'e': return LexKeyword(data, "i8x16.ne", Opcode::I8X16Ne, Features::Simd);
-              case 'q': return LexKeyword(data, "i8x16.eq", Opcode::I8X16Eq, Features::Simd);
-              default: break;
-            }
-            break;
-          case '_':
-            switch (PeekChar(data, 9)) {
-              case 's':
-                switch (PeekChar(data, 7)) {
-                  case 'e':
-                    switch (PeekChar(data, 6)) {
-                      case 'g': return LexKeyword(data, "i8x16.ge_s", Opcode::I8X16GeS, Features::Simd);
-                      case 'l': return LexKeyword(data, "i8x16.le_s", Opcode::I8X16LeS, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 't':
-                    switch (PeekChar(data, 6)) {
-                      case 'g': return LexKeyword(data, "i8x16.gt_s", Opcode::I8X16GtS, Features::Simd);
-                      case 'l': return LexKeyword(data, "i8x16.lt_s", Opcode::I8X16LtS, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-              case 'u':
-                switch (PeekChar(data, 7)) {
-                  case 'e':
-                    switch (PeekChar(data, 6)) {
-                      case 'g': return LexKeyword(data, "i8x16.ge_u", Opcode::I8X16GeU, Features::Simd);
-                      case 'l': return LexKeyword(data, "i8x16.le_u", Opcode::I8X16LeU, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  case 't':
-                    switch (PeekChar(data, 6)) {
-                      case 'g': return LexKeyword(data, "i8x16.gt_u", Opcode::I8X16GtU, Features::Simd);
-                      case 'l': return LexKeyword(data, "i8x16.lt_u", Opcode::I8X16LtU, Features::Simd);
-                      default: break;
-                    }
-                    break;
-                  default: break;
-                }
-                break;
-              default: break;
-            }
-            break;
-          case 'b':
-            switch (PeekChar(data, 9)) {
-              default: return LexKeyword(data, "i8x16.sub", Opcode::I8X16Sub, Features::Simd);
-              case '_':
-                switch (PeekChar(data, 14)) {
-                  case 's': return LexKeyword(data, "i8x16.sub_sat_s", Opcode::I8X16SubSatS, Features::Simd);
-                  case 'u': return LexKeyword(data, "i8x16.sub_sat_u", Opcode::I8X16SubSatU, Features::Simd);
-                  default: break;
-                }
-                break;
-            }
-            break;
-          case 'd':
-            switch (PeekChar(data, 9)) {
-              default: return LexKeyword(data, "i8x16.add", Opcode::I8X16Add, Features::Simd);
-              case '_':
-                switch (PeekChar(data, 14)) {
-                  case 's': return LexKeyword(data, "i8x16.add_sat_s", Opcode::I8X16AddSatS, Features::Simd);
-                  case 'u': return LexKeyword(data, "i8x16.add_sat_u", Opcode::I8X16AddSatU, Features::Simd);
-                  default: break;
-                }
-                break;
-            }
-            break;
-          case 'g':
-            switch (PeekChar(data, 9)) {
-              default: return LexKeyword(data, "i8x16.neg", Opcode::I8X16Neg, Features::Simd);
-              case 'r': return LexKeyword(data, "i8x16.avgr_u", Opcode::I8X16AvgrU, Features::Simd);
-            }
-            break;
-          case 'i': return LexKeyword(data, "i8x16.swizzle", Opcode::I8X16Swizzle, Features::Simd);
-          case 'l':
-            switch (PeekChar(data, 9)) {
-              default: return LexKeyword(data, "i8x16.shl", Opcode::I8X16Shl, Features::Simd);
-              case '_': return LexKeyword(data, "i8x16.all_true", Opcode::I8X16AllTrue, Features::Simd);
-              case 'a': return LexKeyword(data, "i8x16.splat", Opcode::I8X16Splat, Features::Simd);
-            }
-            break;
-          case 'n':
-            switch (PeekChar(data, 10)) {
-              case 's': return LexKeyword(data, "i8x16.min_s", Opcode::I8X16MinS, Features::Simd);
-              case 'u': return LexKeyword(data, "i8x16.min_u", Opcode::I8X16MinU, Features::Simd);
-              default: break;
-            }
-            break;
-          case 'p': return LexKeyword(data, "i8x16.replace_lane", TokenType::SimdLaneInstr, Opcode::I8X16ReplaceLane, Features::Simd);
-          case 'r':
-            switch (PeekChar(data, 10)) {
-              case 'o':
-                switch (PeekChar(data, 19)) {
-                  case 's': return LexKeyword(data, "i8x16.narrow_i16x8_s", Opcode::I8X16NarrowI16X8S, Features::Simd);
-                  case 'u': return LexKeyword(data, "i8x16.narrow_i16x8_u", Opcode::I8X16NarrowI16X8U, Features::Simd);
-                  default: break;
-                }
-                break;
-              case 's': return LexKeyword(data, "i8x16.shr_s", Opcode::I8X16ShrS, Features::Simd);
-              case 'u': return LexKeyword(data, "i8x16.shr_u", Opcode::I8X16ShrU, Features::Simd);
-              default: break;
-            }
-            break;
-          case 's': return LexKeyword(data, "i8x16.abs", Opcode::I8X16Abs, Features::Simd);
-          case 't':
-            switch (PeekChar(data, 13)) {
-              default: return LexKeyword(data, "i8x16.bitmask", Opcode::I8X16Bitmask, Features::Simd);
-              case '_':
-                switch (PeekChar(data, 19)) {
-                  case 's': return LexKeyword(data, "i8x16.extract_lane_s", TokenType::SimdLaneInstr, Opcode::I8X16ExtractLaneS, Features::Simd);
-                  case 'u': return LexKeyword(data, "i8x16.extract_lane_u", TokenType::SimdLaneInstr, Opcode::I8X16ExtractLaneU, Features::Simd);
-                  default: break;
-                }
-                break;
-            }
-            break;
-          case 'u': return LexKeyword(data, "i8x16.shuffle", TokenType::SimdShuffleInstr, Opcode::I8X16Shuffle, Features::Simd);
-          case 'x':
-            switch (PeekChar(data, 10)) {
-              case 's': return LexKeyword(data, "i8x16.max_s", Opcode::I8X16MaxS, Features::Simd);
-              case 'u': return LexKeyword(data, "i8x16.max_u", Opcode::I8X16MaxU, Features::Simd);
-              default: break;
-            }
-            break;
-          case 'y': return LexKeyword(data, "i8x16.any_true", Opcode::I8X16AnyTrue, Features::Simd);
-        }
-        break;
-    }
-    break;
-  case 'y':
-    switch (PeekChar(data, 3)) {
-      default:
-        switch (PeekChar(data, 1)) {
-          case 'n': return LexKeyword(data, "any", TokenType::HeapKind, HeapKind::Any);
-          case 'r': return LexKeyword(data, "try", TokenType::BlockInstr, Opcode::Try, Features::Exceptions);
-          default: break;
-        }
-        break;
-      case 'f': return LexKeyword(data, "anyfunc", ReferenceKind::Funcref);
-      case 'r': return LexKeyword(data, "anyref", ReferenceKind::Anyref);
-    }
-    break;
+// Generated by src/text/gen-keywords.py from src/text/keywords.txt.
+// DO NOT EDIT.
+
+constexpr span_extent_t kMaxKeywordSize = 32;
+constexpr int kKeywordBucketBits = 8;
+constexpr u64 kKeywordSlotMask = 1023;
+constexpr u16 kNoKeyword = 0xffff;
+constexpr span_extent_t kKeywordWords = 4;
+
+// `word` is the zero-padded keyword, as little-endian words.
+inline u64 HashKeyword(const u64* word) {
+  u64 h = word[0] * 0x629f6fbed82c07cdu + word[1] * 0xe3e70682c2094cadu +
+          (word[2] ^ word[3]) * 0xa5d2f346baa9455u;
+  return h ^ (h >> 32);
+}
+
+const u16 kKeywordDisplacements[] = {
+    0, 4, 0, 8, 0, 0, 0, 0, 1, 1, 0, 0,
+    0, 0, 1, 0, 0, 0, 3, 1, 2, 3, 8, 0,
+    3, 0, 0, 0, 2, 2, 3, 0, 4, 16, 6, 0,
+    8, 0, 5, 0, 1, 1, 0, 3, 5, 0, 3, 0,
+    9, 4, 8, 1, 0, 0, 12, 0, 1, 0, 1, 4,
+    5, 2, 0, 0, 11, 7, 0, 0, 0, 1, 2, 0,
+    7, 1, 1, 3, 0, 4, 0, 2, 2, 0, 10, 0,
+    0, 7, 5, 0, 6, 0, 2, 0, 1, 0, 3, 2,
+    1, 0, 16, 7, 17, 3, 0, 6, 4, 0, 1, 1,
+    16, 2, 4, 7, 0, 0, 1, 0, 3, 1, 2, 0,
+    1, 1, 0, 1, 6, 0, 1, 0, 0, 5, 2, 0,
+    4, 0, 3, 0, 6, 0, 16, 0, 4, 0, 3, 0,
+    0, 3, 5, 2, 2, 0, 5, 0, 2, 7, 2, 0,
+    0, 1, 2, 4, 0, 5, 0, 0, 0, 14, 0, 0,
+    8, 1, 2, 0, 1, 0, 9, 0, 3, 6, 6, 8,
+    4, 0, 0, 4, 8, 2, 2, 1, 0, 2, 0, 8,
+    0, 8, 1, 0, 1, 1, 0, 0, 11, 0, 2, 11,
+    24, 13, 2, 0, 0, 0, 2, 2, 1, 2, 0, 2,
+    12, 0, 4, 0, 0, 1, 0, 0, 0, 18, 3, 0,
+    2, 1, 8, 4, 0, 0, 5, 0, 12, 1, 1, 2,
+    0, 2, 0, 2, 4, 0, 1, 8, 0, 2, 3, 1,
+    1, 6, 9, 1,
+};
+
+const u16 kKeywordSlots[] = {
+    kNoKeyword, kNoKeyword, 558, kNoKeyword, 38, 315, kNoKeyword, kNoKeyword, 580, kNoKeyword, kNoKeyword, kNoKeyword,
+    kNoKeyword, kNoKeyword, 391, 352, 532, 361, kNoKeyword, kNoKeyword, 381, 473, kNoKeyword, kNoKeyword,
+    291, kNoKeyword, kNoKeyword, 372, kNoKeyword, 472, 373, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword,
+    kNoKeyword, kNoKeyword, kNoKeyword, 108, 577, kNoKeyword, 167, 293, 309, kNoKeyword, kNoKeyword, 366,
+    199, 302, kNoKeyword, kNoKeyword, 400, kNoKeyword, 498, 300, 296, 59, 510, kNoKeyword,
+    298, 453, 589, 50, kNoKeyword, kNoKeyword, 257, 447, kNoKeyword, 4, 356, kNoKeyword,
+    kNoKeyword, kNoKeyword, 28, 409, kNoKeyword, 601, 89, 408, kNoKeyword, kNoKeyword, 499, kNoKeyword,
+    kNoKeyword, kNoKeyword, 448, 74, 331, 551, kNoKeyword, 338, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword,
+    513, kNoKeyword, 561, kNoKeyword, 232, 172, 173, 191, kNoKeyword, 52, 157, 362,
+    kNoKeyword, 219, 40, 364, 256, kNoKeyword, 142, kNoKeyword, kNoKeyword, 106, 451, kNoKeyword,
+    kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 276, 53, kNoKeyword, 555, 19,
+    kNoKeyword, kNoKeyword, kNoKeyword, 150, kNoKeyword, 410, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword,
+    266, 317, 103, 469, 316, 572, 396, 425, 16, kNoKeyword, kNoKeyword, 432,
+    397, kNoKeyword, 413, kNoKeyword, 374, 301, 375, kNoKeyword, 2, 188, 295, 299,
+    kNoKeyword, kNoKeyword, 529, kNoKeyword, kNoKeyword, 297, 518, 418, 233, kNoKeyword, kNoKeyword, kNoKeyword,
+    471, kNoKeyword, kNoKeyword, kNoKeyword, 420, kNoKeyword, 122, 55, 417, 121, 438, 485,
+    kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 259, 162, 260, 363, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword,
+    221, 45, kNoKeyword, 12, 539, kNoKeyword, 547, 205, kNoKeyword, 151, 548, kNoKeyword,
+    550, kNoKeyword, 113, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 114, kNoKeyword, kNoKeyword, 422, kNoKeyword,
+    285, 164, 120, 465, 119, 118, 117, 158, 171, 182, 180, 176,
+    18, 324, kNoKeyword, 1, kNoKeyword, kNoKeyword, 495, 421, 288, 515, kNoKeyword, kNoKeyword,
+    522, 178, 470, 525, kNoKeyword, kNoKeyword, 556, 330, kNoKeyword, 71, 100, 11,
+    335, kNoKeyword, 342, 456, kNoKeyword, 337, kNoKeyword, 429, 542, 211, kNoKeyword, 585,
+    kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 72, kNoKeyword, 537, 587, 430, 590, 393,
+    149, kNoKeyword, 497, kNoKeyword, kNoKeyword, 69, 287, kNoKeyword, 22, 78, 220, 514,
+    kNoKeyword, 493, 215, kNoKeyword, kNoKeyword, kNoKeyword, 346, 235, 455, 246, kNoKeyword, 519,
+    489, 60, 314, 9, kNoKeyword, kNoKeyword, kNoKeyword, 129, 170, 593, 267, 339,
+    332, 231, 126, 196, 264, 419, 95, 212, kNoKeyword, 426, 416, kNoKeyword,
+    275, 504, 369, 357, 207, 553, kNoKeyword, kNoKeyword, kNoKeyword, 564, kNoKeyword, 390,
+    111, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 521, 581, 395, kNoKeyword, 217, 43, 132,
+    392, 326, 569, 39, 536, 353, kNoKeyword, kNoKeyword, 423, 597, 104, 535,
+    kNoKeyword, 486, 563, 459, kNoKeyword, kNoKeyword, 570, 323, kNoKeyword, 262, 159, kNoKeyword,
+    34, kNoKeyword, kNoKeyword, 265, 484, 479, 345, 578, 294, 582, 88, 189,
+    166, 70, 165, 186, kNoKeyword, kNoKeyword, kNoKeyword, 47, 389, kNoKeyword, 303, kNoKeyword,
+    kNoKeyword, 94, kNoKeyword, kNoKeyword, 496, 254, 598, 68, 379, 378, 145, 93,
+    185, 27, 377, 376, 85, 84, 83, 31, 79, 82, 340, 333,
+    kNoKeyword, 512, 509, 26, 492, 261, kNoKeyword, kNoKeyword, 380, 92, 127, 586,
+    153, 152, 125, 91, 253, 365, 460, 526, 289, 252, 306, 250,
+    29, 399, 32, 251, kNoKeyword, 559, 183, 488, 224, 184, 15, 24,
+    328, 14, 523, kNoKeyword, 143, 116, kNoKeyword, 568, 75, 90, 155, 67,
+    304, 516, 134, 148, 97, 128, 123, 576, 146, 138, 140, 594,
+    271, 137, 541, 223, 305, 133, kNoKeyword, kNoKeyword, 213, 163, 242, 482,
+    kNoKeyword, 139, kNoKeyword, kNoKeyword, kNoKeyword, 147, kNoKeyword, kNoKeyword, 402, 382, 51, kNoKeyword,
+    kNoKeyword, 98, 503, 540, kNoKeyword, 243, 450, 206, kNoKeyword, 505, kNoKeyword, 596,
+    kNoKeyword, 42, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 272, kNoKeyword, 3, 168, 131, 599,
+    kNoKeyword, kNoKeyword, 107, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 592, 343, 449, 230, 234,
+    336, 226, 87, 490, 322, 279, 280, 263, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword,
+    kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 57, 58, kNoKeyword, 238, 415, kNoKeyword, kNoKeyword, kNoKeyword,
+    kNoKeyword, 574, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 124, 573, kNoKeyword, 487, kNoKeyword, kNoKeyword,
+    341, 334, kNoKeyword, kNoKeyword, 20, kNoKeyword, kNoKeyword, kNoKeyword, 506, kNoKeyword, kNoKeyword, 520,
+    kNoKeyword, 5, 8, 405, kNoKeyword, kNoKeyword, 218, kNoKeyword, 508, 130, 428, kNoKeyword,
+    204, 546, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 478, kNoKeyword, kNoKeyword, 37, kNoKeyword, kNoKeyword,
+    kNoKeyword, 359, 370, kNoKeyword, kNoKeyword, 255, 169, 307, 216, 385, kNoKeyword, 524,
+    311, kNoKeyword, kNoKeyword, 466, 144, kNoKeyword, 160, 161, 477, kNoKeyword, kNoKeyword, 354,
+    136, kNoKeyword, 239, 187, 241, kNoKeyword, 77, 193, kNoKeyword, 49, kNoKeyword, 600,
+    384, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 65, 66, kNoKeyword, kNoKeyword, kNoKeyword, 96,
+    468, 387, 290, 388, kNoKeyword, 240, kNoKeyword, 313, 281, 109, kNoKeyword, 401,
+    567, 544, 208, 545, 268, 461, 46, kNoKeyword, kNoKeyword, kNoKeyword, 269, 404,
+    kNoKeyword, 312, kNoKeyword, 192, 190, 284, kNoKeyword, kNoKeyword, 41, 194, 434, kNoKeyword,
+    414, 575, 248, 249, 318, 61, 62, kNoKeyword, kNoKeyword, 64, 319, 63,
+    kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 115,
+    557, 355, 424, kNoKeyword, kNoKeyword, kNoKeyword, 25, kNoKeyword, kNoKeyword, kNoKeyword, 454, 436,
+    kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 583, kNoKeyword, kNoKeyword, 102, 325, 494, 394, 195,
+    36, 566, 310, kNoKeyword, 562, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 549, kNoKeyword, kNoKeyword,
+    320, 579, 321, 282, 227, 101, 403, 367, 247, 543, 560, 237,
+    368, 595, 225, 286, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 210,
+    464, 135, kNoKeyword, 327, kNoKeyword, kNoKeyword, 105, kNoKeyword, 13, 274, kNoKeyword, 591,
+    349, 371, kNoKeyword, kNoKeyword, kNoKeyword, 347, kNoKeyword, 360, 245, 244, 530, kNoKeyword,
+    kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 10, kNoKeyword, kNoKeyword, kNoKeyword, 56, kNoKeyword, kNoKeyword, kNoKeyword,
+    kNoKeyword, 174, 48, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 344, 30, 554, 457, kNoKeyword,
+    kNoKeyword, 81, 273, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 209, 197, kNoKeyword, 203, 54,
+    141, 202, 35, 198, kNoKeyword, 511, 23, 398, 467, 452, 481, kNoKeyword,
+    440, 179, kNoKeyword, 277, 446, 435, 44, 6, 181, 308, 175, 177,
+    483, 444, 442, 278, kNoKeyword, 458, 110, kNoKeyword, kNoKeyword, 17, kNoKeyword, kNoKeyword,
+    kNoKeyword, 270, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 517, kNoKeyword, kNoKeyword,
+    552, 427, kNoKeyword, kNoKeyword, 502, 527, 406, 86, kNoKeyword, 533, 229, 407,
+    kNoKeyword, kNoKeyword, 329, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 7,
+    kNoKeyword, kNoKeyword, kNoKeyword, 358, 21, kNoKeyword, 386, 156, 222, 99, 80, 228,
+    431, 0, 383, 351, kNoKeyword, kNoKeyword, 292, 501, kNoKeyword, 200, 201, 571,
+    kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 33, kNoKeyword, 480, 236, kNoKeyword, 214,
+    kNoKeyword, 348, kNoKeyword, 476, kNoKeyword, kNoKeyword, 258, 350, kNoKeyword, 412, kNoKeyword, 475,
+    kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 462, kNoKeyword, 463, 565, 588, kNoKeyword, kNoKeyword,
+    112, kNoKeyword, 73, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 538, 528, 411, 531,
+    kNoKeyword, 534, 437, 500, 283, 443, 491, 439, 507, 154, 584, 445,
+    kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword, 76, kNoKeyword, kNoKeyword, 433, 441, 474, kNoKeyword, kNoKeyword,
+    kNoKeyword, kNoKeyword, kNoKeyword, kNoKeyword,
+};
+
+const char kKeywordNames[][kMaxKeywordSize] = {
+    "any",
+    "anyref",
+    "array",
+    "array.new_with_rtt",
+    "array.new_default_with_rtt",
+    "array.get",
+    "array.get_s",
+    "array.get_u",
+    "array.set",
+    "array.len",
+    "assert_exhaustion",
+    "assert_invalid",
+    "assert_malformed",
+    "assert_return",
+    "assert_trap",
+    "assert_unlinkable",
+    "binary",
+    "block",
+    "br_if",
+    "br_on_exn",
+    "br_on_null",
+    "br_table",
+    "br",
+    "call_indirect",
+    "call",
+    "call_ref",
+    "catch",
+    "data.drop",
+    "data",
+    "declare",
+    "drop",
+    "elem.drop",
+    "elem",
+    "else",
+    "end",
+    "eq",
+    "eqref",
+    "event",
+    "exnref",
+    "exn",
+    "export",
+    "externref",
+    "extern",
+    "f32.abs",
+    "f32.add",
+    "f32.ceil",
+    "f32.const",
+    "f32.convert_i32_s",
+    "f32.convert_i32_u",
+    "f32.convert_i64_s",
+    "f32.convert_i64_u",
+    "f32.copysign",
+    "f32.demote_f64",
+    "f32.div",
+    "f32.eq",
+    "f32.floor",
+    "f32.ge",
+    "f32.gt",
+    "f32.le",
+    "f32.load",
+    "f32.lt",
+    "f32.max",
+    "f32.min",
+    "f32.mul",
+    "f32.nearest",
+    "f32.neg",
+    "f32.ne",
+    "f32.reinterpret_i32",
+    "f32.sqrt",
+    "f32.store",
+    "f32.sub",
+    "f32.trunc",
+    "f32",
+    "f32x4.abs",
+    "f32x4.add",
+    "f32x4.ceil",
+    "f32x4.convert_i32x4_s",
+    "f32x4.convert_i32x4_u",
+    "f32x4.div",
+    "f32x4.eq",
+    "f32x4.extract_lane",
+    "f32x4.floor",
+    "f32x4.ge",
+    "f32x4.gt",
+    "f32x4.le",
+    "f32x4.lt",
+    "f32x4.max",
+    "f32x4.min",
+    "f32x4.mul",
+    "f32x4.nearest",
+    "f32x4.neg",
+    "f32x4.ne",
+    "f32x4.pmax",
+    "f32x4.pmin",
+    "f32x4.replace_lane",
+    "f32x4.splat",
+    "f32x4.sqrt",
+    "f32x4.sub",
+    "f32x4.trunc",
+    "f32x4",
+    "f64.abs",
+    "f64.add",
+    "f64.ceil",
+    "f64.const",
+    "f64.convert_i32_s",
+    "f64.convert_i32_u",
+    "f64.convert_i64_s",
+    "f64.convert_i64_u",
+    "f64.copysign",
+    "f64.div",
+    "f64.eq",
+    "f64.floor",
+    "f64.ge",
+    "f64.gt",
+    "f64.le",
+    "f64.load",
+    "f64.lt",
+    "f64.max",
+    "f64.min",
+    "f64.mul",
+    "f64.nearest",
+    "f64.neg",
+    "f64.ne",
+    "f64.promote_f32",
+    "f64.reinterpret_i64",
+    "f64.sqrt",
+    "f64.store",
+    "f64.sub",
+    "f64.trunc",
+    "f64",
+    "f64x2.abs",
+    "f64x2.add",
+    "f64x2.ceil",
+    "f64x2.div",
+    "f64x2.eq",
+    "f64x2.extract_lane",
+    "f64x2.floor",
+    "f64x2.ge",
+    "f64x2.gt",
+    "f64x2.le",
+    "f64x2.lt",
+    "f64x2.max",
+    "f64x2.min",
+    "f64x2.mul",
+    "f64x2.nearest",
+    "f64x2.neg",
+    "f64x2.ne",
+    "f64x2.pmax",
+    "f64x2.pmin",
+    "f64x2.replace_lane",
+    "f64x2.splat",
+    "f64x2.sqrt",
+    "f64x2.sub",
+    "f64x2.trunc",
+    "f64x2",
+    "field",
+    "funcref",
+    "func",
+    "func.bind",
+    "get",
+    "global.get",
+    "global.set",
+    "global",
+    "i16",
+    "i16x8.abs",
+    "i16x8.add_sat_s",
+    "i16x8.add_sat_u",
+    "i16x8.add",
+    "i16x8.all_true",
+    "i16x8.any_true",
+    "i16x8.avgr_u",
+    "i16x8.bitmask",
+    "i16x8.eq",
+    "i16x8.extract_lane_s",
+    "i16x8.extract_lane_u",
+    "i16x8.ge_s",
+    "i16x8.ge_u",
+    "i16x8.gt_s",
+    "i16x8.gt_u",
+    "i16x8.le_s",
+    "i16x8.le_u",
+    "i16x8.lt_s",
+    "i16x8.lt_u",
+    "i16x8.max_s",
+    "i16x8.max_u",
+    "i16x8.min_s",
+    "i16x8.min_u",
+    "i16x8.mul",
+    "i16x8.narrow_i32x4_s",
+    "i16x8.narrow_i32x4_u",
+    "i16x8.neg",
+    "i16x8.ne",
+    "i16x8.replace_lane",
+    "i16x8.shl",
+    "i16x8.shr_s",
+    "i16x8.shr_u",
+    "i16x8.splat",
+    "i16x8.sub_sat_s",
+    "i16x8.sub_sat_u",
+    "i16x8.sub",
+    "i16x8.widen_high_i8x16_s",
+    "i16x8.widen_high_i8x16_u",
+    "i16x8.widen_low_i8x16_s",
+    "i16x8.widen_low_i8x16_u",
+    "i16x8",
+    "i31",
+    "i31ref",
+    "i31.new",
+    "i31.get_s",
+    "i31.get_u",
+    "i32.add",
+    "i32.and",
+    "i32.atomic.load16_u",
+    "i32.atomic.load8_u",
+    "i32.atomic.load",
+    "i32.atomic.rmw16.add_u",
+    "i32.atomic.rmw16.and_u",
+    "i32.atomic.rmw16.cmpxchg_u",
+    "i32.atomic.rmw16.or_u",
+    "i32.atomic.rmw16.sub_u",
+    "i32.atomic.rmw16.xchg_u",
+    "i32.atomic.rmw16.xor_u",
+    "i32.atomic.rmw8.add_u",
+    "i32.atomic.rmw8.and_u",
+    "i32.atomic.rmw8.cmpxchg_u",
+    "i32.atomic.rmw8.or_u",
+    "i32.atomic.rmw8.sub_u",
+    "i32.atomic.rmw8.xchg_u",
+    "i32.atomic.rmw8.xor_u",
+    "i32.atomic.rmw.add",
+    "i32.atomic.rmw.and",
+    "i32.atomic.rmw.cmpxchg",
+    "i32.atomic.rmw.or",
+    "i32.atomic.rmw.sub",
+    "i32.atomic.rmw.xchg",
+    "i32.atomic.rmw.xor",
+    "i32.atomic.store16",
+    "i32.atomic.store8",
+    "i32.atomic.store",
+    "i32.clz",
+    "i32.const",
+    "i32.ctz",
+    "i32.div_s",
+    "i32.div_u",
+    "i32.eq",
+    "i32.eqz",
+    "i32.extend16_s",
+    "i32.extend8_s",
+    "i32.ge_s",
+    "i32.ge_u",
+    "i32.gt_s",
+    "i32.gt_u",
+    "i32.le_s",
+    "i32.le_u",
+    "i32.load16_s",
+    "i32.load16_u",
+    "i32.load8_s",
+    "i32.load8_u",
+    "i32.load",
+    "i32.lt_s",
+    "i32.lt_u",
+    "i32.mul",
+    "i32.ne",
+    "i32.or",
+    "i32.popcnt",
+    "i32.reinterpret_f32",
+    "i32.rem_s",
+    "i32.rem_u",
+    "i32.rotl",
+    "i32.rotr",
+    "i32.shl",
+    "i32.shr_s",
+    "i32.shr_u",
+    "i32.store16",
+    "i32.store8",
+    "i32.store",
+    "i32.sub",
+    "i32.trunc_f32_s",
+    "i32.trunc_f32_u",
+    "i32.trunc_f64_s",
+    "i32.trunc_f64_u",
+    "i32.trunc_sat_f32_s",
+    "i32.trunc_sat_f32_u",
+    "i32.trunc_sat_f64_s",
+    "i32.trunc_sat_f64_u",
+    "i32",
+    "i32.wrap_i64",
+    "i32x4.abs",
+    "i32x4.add",
+    "i32x4.all_true",
+    "i32x4.any_true",
+    "i32x4.bitmask",
+    "i32x4.dot_i16x8_s",
+    "i32x4.eq",
+    "i32x4.extract_lane",
+    "i32x4.ge_s",
+    "i32x4.ge_u",
+    "i32x4.gt_s",
+    "i32x4.gt_u",
+    "i32x4.le_s",
+    "i32x4.le_u",
+    "i32x4.lt_s",
+    "i32x4.lt_u",
+    "i32x4.max_s",
+    "i32x4.max_u",
+    "i32x4.min_s",
+    "i32x4.min_u",
+    "i32x4.mul",
+    "i32x4.neg",
+    "i32x4.ne",
+    "i32x4.replace_lane",
+    "i32x4.shl",
+    "i32x4.shr_s",
+    "i32x4.shr_u",
+    "i32x4.splat",
+    "i32x4.sub",
+    "i32x4.trunc_sat_f32x4_s",
+    "i32x4.trunc_sat_f32x4_u",
+    "i32x4.widen_high_i16x8_s",
+    "i32x4.widen_high_i16x8_u",
+    "i32x4.widen_low_i16x8_s",
+    "i32x4.widen_low_i16x8_u",
+    "i32x4",
+    "i32.xor",
+    "i64.add",
+    "i64.and",
+    "i64.atomic.load16_u",
+    "i64.atomic.load32_u",
+    "i64.atomic.load8_u",
+    "i64.atomic.load",
+    "i64.atomic.rmw16.add_u",
+    "i64.atomic.rmw16.and_u",
+    "i64.atomic.rmw16.cmpxchg_u",
+    "i64.atomic.rmw16.or_u",
+    "i64.atomic.rmw16.sub_u",
+    "i64.atomic.rmw16.xchg_u",
+    "i64.atomic.rmw16.xor_u",
+    "i64.atomic.rmw32.add_u",
+    "i64.atomic.rmw32.and_u",
+    "i64.atomic.rmw32.cmpxchg_u",
+    "i64.atomic.rmw32.or_u",
+    "i64.atomic.rmw32.sub_u",
+    "i64.atomic.rmw32.xchg_u",
+    "i64.atomic.rmw32.xor_u",
+    "i64.atomic.rmw8.add_u",
+    "i64.atomic.rmw8.and_u",
+    "i64.atomic.rmw8.cmpxchg_u",
+    "i64.atomic.rmw8.or_u",
+    "i64.atomic.rmw8.sub_u",
+    "i64.atomic.rmw8.xchg_u",
+    "i64.atomic.rmw8.xor_u",
+    "i64.atomic.rmw.add",
+    "i64.atomic.rmw.and",
+    "i64.atomic.rmw.cmpxchg",
+    "i64.atomic.rmw.or",
+    "i64.atomic.rmw.sub",
+    "i64.atomic.rmw.xchg",
+    "i64.atomic.rmw.xor",
+    "i64.atomic.store16",
+    "i64.atomic.store32",
+    "i64.atomic.store8",
+    "i64.atomic.store",
+    "i64.clz",
+    "i64.const",
+    "i64.ctz",
+    "i64.div_s",
+    "i64.div_u",
+    "i64.eq",
+    "i64.eqz",
+    "i64.extend16_s",
+    "i64.extend32_s",
+    "i64.extend8_s",
+    "i64.extend_i32_s",
+    "i64.extend_i32_u",
+    "i64.ge_s",
+    "i64.ge_u",
+    "i64.gt_s",
+    "i64.gt_u",
+    "i64.le_s",
+    "i64.le_u",
+    "i64.load16_s",
+    "i64.load16_u",
+    "i64.load32_s",
+    "i64.load32_u",
+    "i64.load8_s",
+    "i64.load8_u",
+    "i64.load",
+    "i64.lt_s",
+    "i64.lt_u",
+    "i64.mul",
+    "i64.ne",
+    "i64.or",
+    "i64.popcnt",
+    "i64.reinterpret_f64",
+    "i64.rem_s",
+    "i64.rem_u",
+    "i64.rotl",
+    "i64.rotr",
+    "i64.shl",
+    "i64.shr_s",
+    "i64.shr_u",
+    "i64.store16",
+    "i64.store32",
+    "i64.store8",
+    "i64.store",
+    "i64.sub",
+    "i64.trunc_f32_s",
+    "i64.trunc_f32_u",
+    "i64.trunc_f64_s",
+    "i64.trunc_f64_u",
+    "i64.trunc_sat_f32_s",
+    "i64.trunc_sat_f32_u",
+    "i64.trunc_sat_f64_s",
+    "i64.trunc_sat_f64_u",
+    "i64",
+    "i64x2.add",
+    "i64x2.extract_lane",
+    "i64x2.mul",
+    "i64x2.neg",
+    "i64x2.replace_lane",
+    "i64x2.shl",
+    "i64x2.shr_s",
+    "i64x2.shr_u",
+    "i64x2.splat",
+    "i64x2.sub",
+    "i64x2",
+    "i64.xor",
+    "i8",
+    "i8x16.abs",
+    "i8x16.add_sat_s",
+    "i8x16.add_sat_u",
+    "i8x16.add",
+    "i8x16.all_true",
+    "i8x16.any_true",
+    "i8x16.avgr_u",
+    "i8x16.bitmask",
+    "i8x16.eq",
+    "i8x16.extract_lane_s",
+    "i8x16.extract_lane_u",
+    "i8x16.ge_s",
+    "i8x16.ge_u",
+    "i8x16.gt_s",
+    "i8x16.gt_u",
+    "i8x16.le_s",
+    "i8x16.le_u",
+    "i8x16.lt_s",
+    "i8x16.lt_u",
+    "i8x16.max_s",
+    "i8x16.max_u",
+    "i8x16.min_s",
+    "i8x16.min_u",
+    "i8x16.narrow_i16x8_s",
+    "i8x16.narrow_i16x8_u",
+    "i8x16.neg",
+    "i8x16.ne",
+    "i8x16.replace_lane",
+    "i8x16.shl",
+    "i8x16.shr_s",
+    "i8x16.shr_u",
+    "i8x16.shuffle",
+    "i8x16.splat",
+    "i8x16.sub",
+    "i8x16.sub_sat_s",
+    "i8x16.sub_sat_u",
+    "i8x16.swizzle",
+    "i8x16",
+    "if",
+    "import",
+    "inf",
+    "invoke",
+    "item",
+    "let",
+    "local.get",
+    "local.set",
+    "local.tee",
+    "local",
+    "loop",
+    "memory.atomic.notify",
+    "memory.atomic.wait32",
+    "memory.atomic.wait64",
+    "memory.copy",
+    "memory.fill",
+    "memory.grow",
+    "memory.init",
+    "memory.size",
+    "memory",
+    "module",
+    "mut",
+    "nan",
+    "nan:arithmetic",
+    "nan:canonical",
+    "nop",
+    "null",
+    "offset",
+    "param",
+    "quote",
+    "ref",
+    "ref.as_non_null",
+    "ref.cast",
+    "ref.eq",
+    "ref.extern",
+    "ref.func",
+    "ref.is_null",
+    "ref.null",
+    "ref.test",
+    "register",
+    "result",
+    "rethrow",
+    "return_call_indirect",
+    "return_call",
+    "return_call_ref",
+    "return",
+    "rtt",
+    "rtt.canon",
+    "rtt.sub",
+    "br_on_cast",
+    "select",
+    "shared",
+    "start",
+    "struct",
+    "struct.new_with_rtt",
+    "struct.new_default_with_rtt",
+    "struct.get",
+    "struct.get_s",
+    "struct.get_u",
+    "struct.set",
+    "table.copy",
+    "table.fill",
+    "table.get",
+    "table.grow",
+    "table.init",
+    "table.set",
+    "table.size",
+    "table",
+    "then",
+    "throw",
+    "try",
+    "type",
+    "unreachable",
+    "v128.andnot",
+    "v128.and",
+    "v128.bitselect",
+    "v128.const",
+    "v128.load16_splat",
+    "v128.load16x4_s",
+    "v128.load16x4_u",
+    "v128.load32_splat",
+    "v128.load32x2_s",
+    "v128.load32x2_u",
+    "v128.load32_zero",
+    "v128.load64_splat",
+    "v128.load64_zero",
+    "v128.load8_splat",
+    "v128.load8x8_s",
+    "v128.load8x8_u",
+    "v128.load",
+    "v128.not",
+    "v128",
+    "v128.or",
+    "v128.store",
+    "v128.xor",
+    "anyfunc",
+    "current_memory",
+    "f32.convert_s/i32",
+    "f32.convert_s/i64",
+    "f32.convert_u/i32",
+    "f32.convert_u/i64",
+    "f32.demote/f64",
+    "f32.reinterpret/i32",
+    "f64.convert_s/i32",
+    "f64.convert_s/i64",
+    "f64.convert_u/i32",
+    "f64.convert_u/i64",
+    "f64.promote/f32",
+    "f64.reinterpret/i64",
+    "get_global",
+    "get_local",
+    "grow_memory",
+    "i32.reinterpret/f32",
+    "i32.trunc_s/f32",
+    "i32.trunc_s/f64",
+    "i32.trunc_s:sat/f32",
+    "i32.trunc_s:sat/f64",
+    "i32.trunc_u/f32",
+    "i32.trunc_u/f64",
+    "i32.trunc_u:sat/f32",
+    "i32.trunc_u:sat/f64",
+    "i32.wrap/i64",
+    "i64.extend_s/i32",
+    "i64.extend_u/i32",
+    "i64.reinterpret/f64",
+    "i64.trunc_s/f32",
+    "i64.trunc_s/f64",
+    "i64.trunc_s:sat/f32",
+    "i64.trunc_s:sat/f64",
+    "i64.trunc_u/f32",
+    "i64.trunc_u/f64",
+    "i64.trunc_u:sat/f32",
+    "i64.trunc_u:sat/f64",
+    "set_global",
+    "set_local",
+    "tee_local",
+};
+
+const Keyword kKeywords[] = {
+    {TokenType::HeapKind, KeywordKind::HeapKind, u32(HeapKind::Any), 0},
+    {TokenType::ReferenceKind, KeywordKind::ReferenceKind, u32(ReferenceKind::Anyref), 0},
+    {TokenType::Array, KeywordKind::None, 0, 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::ArrayNewWithRtt), Features::GC},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::ArrayNewDefaultWithRtt), Features::GC},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::ArrayGet), Features::GC},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::ArrayGetS), Features::GC},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::ArrayGetU), Features::GC},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::ArraySet), Features::GC},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::ArrayLen), Features::GC},
+    {TokenType::AssertExhaustion, KeywordKind::None, 0, 0},
+    {TokenType::AssertInvalid, KeywordKind::None, 0, 0},
+    {TokenType::AssertMalformed, KeywordKind::None, 0, 0},
+    {TokenType::AssertReturn, KeywordKind::None, 0, 0},
+    {TokenType::AssertTrap, KeywordKind::None, 0, 0},
+    {TokenType::AssertUnlinkable, KeywordKind::None, 0, 0},
+    {TokenType::Binary, KeywordKind::None, 0, 0},
+    {TokenType::BlockInstr, KeywordKind::Opcode, u32(Opcode::Block), 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::BrIf), 0},
+    {TokenType::BrOnExnInstr, KeywordKind::Opcode, u32(Opcode::BrOnExn), Features::Exceptions},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::BrOnNull), Features::FunctionReferences},
+    {TokenType::BrTableInstr, KeywordKind::Opcode, u32(Opcode::BrTable), 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::Br), 0},
+    {TokenType::CallIndirectInstr, KeywordKind::Opcode, u32(Opcode::CallIndirect), 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::Call), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::CallRef), Features::FunctionReferences},
+    {TokenType::Catch, KeywordKind::Opcode, u32(Opcode::Catch), 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::DataDrop), Features::BulkMemory},
+    {TokenType::Data, KeywordKind::None, 0, 0},
+    {TokenType::Declare, KeywordKind::None, 0, 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::Drop), 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::ElemDrop), Features::BulkMemory},
+    {TokenType::Elem, KeywordKind::None, 0, 0},
+    {TokenType::Else, KeywordKind::Opcode, u32(Opcode::Else), 0},
+    {TokenType::End, KeywordKind::Opcode, u32(Opcode::End), 0},
+    {TokenType::HeapKind, KeywordKind::HeapKind, u32(HeapKind::Eq), 0},
+    {TokenType::ReferenceKind, KeywordKind::ReferenceKind, u32(ReferenceKind::Eqref), 0},
+    {TokenType::Event, KeywordKind::None, 0, 0},
+    {TokenType::ReferenceKind, KeywordKind::ReferenceKind, u32(ReferenceKind::Exnref), 0},
+    {TokenType::HeapKind, KeywordKind::HeapKind, u32(HeapKind::Exn), 0},
+    {TokenType::Export, KeywordKind::None, 0, 0},
+    {TokenType::ReferenceKind, KeywordKind::ReferenceKind, u32(ReferenceKind::Externref), 0},
+    {TokenType::HeapKind, KeywordKind::HeapKind, u32(HeapKind::Extern), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Abs), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Add), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Ceil), 0},
+    {TokenType::F32ConstInstr, KeywordKind::Opcode, u32(Opcode::F32Const), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32ConvertI32S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32ConvertI32U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32ConvertI64S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32ConvertI64U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Copysign), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32DemoteF64), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Div), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Eq), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Floor), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Ge), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Gt), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Le), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::F32Load), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Lt), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Max), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Min), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Mul), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Nearest), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Neg), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Ne), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32ReinterpretI32), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Sqrt), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::F32Store), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Sub), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32Trunc), 0},
+    {TokenType::NumericType, KeywordKind::NumericType, u32(NumericType::F32), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Abs), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Add), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Ceil), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4ConvertI32X4S), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4ConvertI32X4U), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Div), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Eq), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::F32X4ExtractLane), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Floor), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Ge), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Gt), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Le), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Lt), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Max), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Min), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Mul), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Nearest), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Neg), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Ne), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Pmax), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Pmin), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::F32X4ReplaceLane), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Splat), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Sqrt), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Sub), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32X4Trunc), Features::Simd},
+    {TokenType::SimdShape, KeywordKind::SimdShape, u32(SimdShape::F32X4), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Abs), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Add), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Ceil), 0},
+    {TokenType::F64ConstInstr, KeywordKind::Opcode, u32(Opcode::F64Const), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64ConvertI32S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64ConvertI32U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64ConvertI64S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64ConvertI64U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Copysign), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Div), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Eq), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Floor), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Ge), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Gt), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Le), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::F64Load), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Lt), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Max), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Min), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Mul), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Nearest), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Neg), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Ne), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64PromoteF32), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64ReinterpretI64), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Sqrt), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::F64Store), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Sub), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64Trunc), 0},
+    {TokenType::NumericType, KeywordKind::NumericType, u32(NumericType::F64), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Abs), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Add), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Ceil), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Div), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Eq), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::F64X2ExtractLane), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Floor), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Ge), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Gt), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Le), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Lt), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Max), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Min), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Mul), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Nearest), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Neg), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Ne), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Pmax), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Pmin), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::F64X2ReplaceLane), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Splat), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Sqrt), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Sub), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64X2Trunc), Features::Simd},
+    {TokenType::SimdShape, KeywordKind::SimdShape, u32(SimdShape::F64X2), 0},
+    {TokenType::Field, KeywordKind::None, 0, 0},
+    {TokenType::ReferenceKind, KeywordKind::ReferenceKind, u32(ReferenceKind::Funcref), 0},
+    {TokenType::Func, KeywordKind::HeapKind, u32(HeapKind::Func), 0},
+    {TokenType::FuncBindInstr, KeywordKind::Opcode, u32(Opcode::FuncBind), Features::FunctionReferences},
+    {TokenType::Get, KeywordKind::None, 0, 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::GlobalGet), 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::GlobalSet), 0},
+    {TokenType::Global, KeywordKind::None, 0, 0},
+    {TokenType::PackedType, KeywordKind::PackedType, u32(PackedType::I16), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8Abs), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8AddSatS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8AddSatU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8Add), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8AllTrue), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8AnyTrue), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8AvgrU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8Bitmask), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8Eq), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::I16X8ExtractLaneS), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::I16X8ExtractLaneU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8GeS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8GeU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8GtS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8GtU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8LeS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8LeU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8LtS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8LtU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8MaxS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8MaxU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8MinS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8MinU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8Mul), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8NarrowI32X4S), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8NarrowI32X4U), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8Neg), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8Ne), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::I16X8ReplaceLane), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8Shl), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8ShrS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8ShrU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8Splat), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8SubSatS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8SubSatU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8Sub), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8WidenHighI8X16S), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8WidenHighI8X16U), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8WidenLowI8X16S), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I16X8WidenLowI8X16U), Features::Simd},
+    {TokenType::SimdShape, KeywordKind::SimdShape, u32(SimdShape::I16X8), 0},
+    {TokenType::HeapKind, KeywordKind::HeapKind, u32(HeapKind::I31), 0},
+    {TokenType::ReferenceKind, KeywordKind::ReferenceKind, u32(ReferenceKind::I31ref), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I31New), Features::GC},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I31GetS), Features::GC},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I31GetU), Features::GC},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Add), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32And), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicLoad16U), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicLoad8U), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicLoad), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw16AddU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw16AndU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw16CmpxchgU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw16OrU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw16SubU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw16XchgU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw16XorU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw8AddU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw8AndU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw8CmpxchgU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw8OrU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw8SubU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw8XchgU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmw8XorU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmwAdd), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmwAnd), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmwCmpxchg), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmwOr), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmwSub), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmwXchg), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicRmwXor), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicStore16), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicStore8), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32AtomicStore), Features::Threads},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Clz), 0},
+    {TokenType::I32ConstInstr, KeywordKind::Opcode, u32(Opcode::I32Const), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Ctz), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32DivS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32DivU), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Eq), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Eqz), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Extend16S), Features::SignExtension},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Extend8S), Features::SignExtension},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32GeS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32GeU), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32GtS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32GtU), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32LeS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32LeU), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32Load16S), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32Load16U), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32Load8S), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32Load8U), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32Load), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32LtS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32LtU), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Mul), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Ne), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Or), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Popcnt), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32ReinterpretF32), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32RemS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32RemU), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Rotl), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Rotr), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Shl), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32ShrS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32ShrU), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32Store16), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32Store8), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I32Store), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Sub), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncF32S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncF32U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncF64S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncF64U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncSatF32S), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncSatF32U), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncSatF64S), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncSatF64U), Features::SaturatingFloatToInt},
+    {TokenType::NumericType, KeywordKind::NumericType, u32(NumericType::I32), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32WrapI64), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4Abs), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4Add), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4AllTrue), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4AnyTrue), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4Bitmask), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4DotI16X8S), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4Eq), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::I32X4ExtractLane), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4GeS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4GeU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4GtS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4GtU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4LeS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4LeU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4LtS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4LtU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4MaxS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4MaxU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4MinS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4MinU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4Mul), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4Neg), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4Ne), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::I32X4ReplaceLane), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4Shl), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4ShrS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4ShrU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4Splat), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4Sub), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4TruncSatF32X4S), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4TruncSatF32X4U), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4WidenHighI16X8S), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4WidenHighI16X8U), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4WidenLowI16X8S), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32X4WidenLowI16X8U), Features::Simd},
+    {TokenType::SimdShape, KeywordKind::SimdShape, u32(SimdShape::I32X4), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32Xor), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Add), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64And), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicLoad16U), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicLoad32U), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicLoad8U), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicLoad), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw16AddU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw16AndU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw16CmpxchgU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw16OrU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw16SubU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw16XchgU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw16XorU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw32AddU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw32AndU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw32CmpxchgU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw32OrU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw32SubU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw32XchgU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw32XorU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw8AddU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw8AndU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw8CmpxchgU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw8OrU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw8SubU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw8XchgU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmw8XorU), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmwAdd), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmwAnd), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmwCmpxchg), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmwOr), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmwSub), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmwXchg), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicRmwXor), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicStore16), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicStore32), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicStore8), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64AtomicStore), Features::Threads},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Clz), 0},
+    {TokenType::I64ConstInstr, KeywordKind::Opcode, u32(Opcode::I64Const), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Ctz), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64DivS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64DivU), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Eq), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Eqz), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Extend16S), Features::SignExtension},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Extend32S), Features::SignExtension},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Extend8S), Features::SignExtension},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64ExtendI32S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64ExtendI32U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64GeS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64GeU), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64GtS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64GtU), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64LeS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64LeU), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64Load16S), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64Load16U), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64Load32S), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64Load32U), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64Load8S), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64Load8U), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64Load), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64LtS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64LtU), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Mul), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Ne), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Or), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Popcnt), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64ReinterpretF64), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64RemS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64RemU), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Rotl), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Rotr), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Shl), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64ShrS), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64ShrU), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64Store16), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64Store32), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64Store8), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::I64Store), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Sub), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncF32S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncF32U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncF64S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncF64U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncSatF32S), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncSatF32U), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncSatF64S), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncSatF64U), Features::SaturatingFloatToInt},
+    {TokenType::NumericType, KeywordKind::NumericType, u32(NumericType::I64), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64X2Add), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::I64X2ExtractLane), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64X2Mul), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64X2Neg), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::I64X2ReplaceLane), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64X2Shl), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64X2ShrS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64X2ShrU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64X2Splat), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64X2Sub), Features::Simd},
+    {TokenType::SimdShape, KeywordKind::SimdShape, u32(SimdShape::I64X2), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64Xor), 0},
+    {TokenType::PackedType, KeywordKind::PackedType, u32(PackedType::I8), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16Abs), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16AddSatS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16AddSatU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16Add), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16AllTrue), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16AnyTrue), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16AvgrU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16Bitmask), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16Eq), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::I8X16ExtractLaneS), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::I8X16ExtractLaneU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16GeS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16GeU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16GtS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16GtU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16LeS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16LeU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16LtS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16LtU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16MaxS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16MaxU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16MinS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16MinU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16NarrowI16X8S), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16NarrowI16X8U), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16Neg), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16Ne), Features::Simd},
+    {TokenType::SimdLaneInstr, KeywordKind::Opcode, u32(Opcode::I8X16ReplaceLane), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16Shl), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16ShrS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16ShrU), Features::Simd},
+    {TokenType::SimdShuffleInstr, KeywordKind::Opcode, u32(Opcode::I8X16Shuffle), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16Splat), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16Sub), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16SubSatS), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16SubSatU), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I8X16Swizzle), Features::Simd},
+    {TokenType::SimdShape, KeywordKind::SimdShape, u32(SimdShape::I8X16), 0},
+    {TokenType::BlockInstr, KeywordKind::Opcode, u32(Opcode::If), 0},
+    {TokenType::Import, KeywordKind::None, 0, 0},
+    {TokenType::Float, KeywordKind::LiteralKind, u32(LiteralKind::Infinity), 0},
+    {TokenType::Invoke, KeywordKind::None, 0, 0},
+    {TokenType::Item, KeywordKind::None, 0, 0},
+    {TokenType::LetInstr, KeywordKind::Opcode, u32(Opcode::Let), Features::FunctionReferences},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::LocalGet), 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::LocalSet), 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::LocalTee), 0},
+    {TokenType::Local, KeywordKind::None, 0, 0},
+    {TokenType::BlockInstr, KeywordKind::Opcode, u32(Opcode::Loop), 0},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::MemoryAtomicNotify), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::MemoryAtomicWait32), Features::Threads},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::MemoryAtomicWait64), Features::Threads},
+    {TokenType::MemoryCopyInstr, KeywordKind::Opcode, u32(Opcode::MemoryCopy), Features::BulkMemory},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::MemoryFill), Features::BulkMemory},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::MemoryGrow), 0},
+    {TokenType::MemoryInitInstr, KeywordKind::Opcode, u32(Opcode::MemoryInit), Features::BulkMemory},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::MemorySize), 0},
+    {TokenType::Memory, KeywordKind::None, 0, 0},
+    {TokenType::Module, KeywordKind::None, 0, 0},
+    {TokenType::Mut, KeywordKind::None, 0, 0},
+    {TokenType::Float, KeywordKind::LiteralKind, u32(LiteralKind::Nan), 0},
+    {TokenType::NanArithmetic, KeywordKind::None, 0, 0},
+    {TokenType::NanCanonical, KeywordKind::None, 0, 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::Nop), 0},
+    {TokenType::Null, KeywordKind::None, 0, 0},
+    {TokenType::Offset, KeywordKind::None, 0, 0},
+    {TokenType::Param, KeywordKind::None, 0, 0},
+    {TokenType::Quote, KeywordKind::None, 0, 0},
+    {TokenType::Ref, KeywordKind::None, 0, 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::RefAsNonNull), Features::FunctionReferences},
+    {TokenType::HeapType2Instr, KeywordKind::Opcode, u32(Opcode::RefCast), Features::GC},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::RefEq), Features::GC},
+    {TokenType::RefExtern, KeywordKind::None, 0, 0},
+    {TokenType::RefFuncInstr, KeywordKind::Opcode, u32(Opcode::RefFunc), Features::ReferenceTypes},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::RefIsNull), Features::ReferenceTypes},
+    {TokenType::RefNullInstr, KeywordKind::Opcode, u32(Opcode::RefNull), Features::ReferenceTypes},
+    {TokenType::HeapType2Instr, KeywordKind::Opcode, u32(Opcode::RefTest), Features::GC},
+    {TokenType::Register, KeywordKind::None, 0, 0},
+    {TokenType::Result, KeywordKind::None, 0, 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::Rethrow), Features::Exceptions},
+    {TokenType::CallIndirectInstr, KeywordKind::Opcode, u32(Opcode::ReturnCallIndirect), Features::TailCall},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::ReturnCall), Features::TailCall},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::ReturnCallRef), Features::FunctionReferences},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::Return), 0},
+    {TokenType::Rtt, KeywordKind::None, 0, 0},
+    {TokenType::HeapTypeInstr, KeywordKind::Opcode, u32(Opcode::RttCanon), Features::GC},
+    {TokenType::RttSubInstr, KeywordKind::Opcode, u32(Opcode::RttSub), Features::GC},
+    {TokenType::BrOnCastInstr, KeywordKind::Opcode, u32(Opcode::BrOnCast), Features::GC},
+    {TokenType::SelectInstr, KeywordKind::Opcode, u32(Opcode::Select), 0},
+    {TokenType::Shared, KeywordKind::None, 0, 0},
+    {TokenType::Start, KeywordKind::None, 0, 0},
+    {TokenType::Struct, KeywordKind::None, 0, 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::StructNewWithRtt), Features::GC},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::StructNewDefaultWithRtt), Features::GC},
+    {TokenType::StructFieldInstr, KeywordKind::Opcode, u32(Opcode::StructGet), Features::GC},
+    {TokenType::StructFieldInstr, KeywordKind::Opcode, u32(Opcode::StructGetS), Features::GC},
+    {TokenType::StructFieldInstr, KeywordKind::Opcode, u32(Opcode::StructGetU), Features::GC},
+    {TokenType::StructFieldInstr, KeywordKind::Opcode, u32(Opcode::StructSet), Features::GC},
+    {TokenType::TableCopyInstr, KeywordKind::Opcode, u32(Opcode::TableCopy), Features::BulkMemory},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::TableFill), Features::ReferenceTypes},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::TableGet), Features::ReferenceTypes},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::TableGrow), Features::ReferenceTypes},
+    {TokenType::TableInitInstr, KeywordKind::Opcode, u32(Opcode::TableInit), Features::BulkMemory},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::TableSet), Features::ReferenceTypes},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::TableSize), Features::ReferenceTypes},
+    {TokenType::Table, KeywordKind::None, 0, 0},
+    {TokenType::Then, KeywordKind::None, 0, 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::Throw), Features::Exceptions},
+    {TokenType::BlockInstr, KeywordKind::Opcode, u32(Opcode::Try), Features::Exceptions},
+    {TokenType::Type, KeywordKind::None, 0, 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::Unreachable), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::V128Andnot), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::V128And), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::V128BitSelect), Features::Simd},
+    {TokenType::SimdConstInstr, KeywordKind::Opcode, u32(Opcode::V128Const), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load16Splat), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load16X4S), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load16X4U), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load32Splat), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load32X2S), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load32X2U), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load32Zero), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load64Splat), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load64Zero), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load8Splat), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load8X8S), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load8X8U), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Load), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::V128Not), Features::Simd},
+    {TokenType::NumericType, KeywordKind::NumericType, u32(NumericType::V128), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::V128Or), Features::Simd},
+    {TokenType::MemoryInstr, KeywordKind::Opcode, u32(Opcode::V128Store), Features::Simd},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::V128Xor), Features::Simd},
+    {TokenType::ReferenceKind, KeywordKind::ReferenceKind, u32(ReferenceKind::Funcref), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::MemorySize), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32ConvertI32S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32ConvertI64S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32ConvertI32U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32ConvertI64U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32DemoteF64), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F32ReinterpretI32), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64ConvertI32S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64ConvertI64S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64ConvertI32U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64ConvertI64U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64PromoteF32), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::F64ReinterpretI64), 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::GlobalGet), 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::LocalGet), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::MemoryGrow), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32ReinterpretF32), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncF32S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncF64S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncSatF32S), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncSatF64S), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncF32U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncF64U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncSatF32U), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32TruncSatF64U), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I32WrapI64), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64ExtendI32S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64ExtendI32U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64ReinterpretF64), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncF32S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncF64S), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncSatF32S), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncSatF64S), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncF32U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncF64U), 0},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncSatF32U), Features::SaturatingFloatToInt},
+    {TokenType::BareInstr, KeywordKind::Opcode, u32(Opcode::I64TruncSatF64U), Features::SaturatingFloatToInt},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::GlobalSet), 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::LocalSet), 0},
+    {TokenType::VarInstr, KeywordKind::Opcode, u32(Opcode::LocalTee), 0},
+};
+
+auto LexPrefixKeyword(SpanU8* data) -> Token {
+  switch (PeekChar(data)) {
+    case 'a': return LexNameEqNum(data, "align=", TokenType::AlignEqNat);
+    case 'n': return LexNan(data);
+    case 'o': return LexNameEqNum(data, "offset=", TokenType::OffsetEqNat);
+    default: return LexReserved(data);
+  }
 }
-break;
@@ -16,7 +16,11 @@
 
 #include "wasp/text/read/lex.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+
+#include "wasp/base/macros.h"
 
 namespace wasp::text {
 
@@ -249,7 +253,7 @@ auto LexInf(SpanU8* data) -> Token {
   if (MatchString(data, "inf") && NoTrailingReservedChars(data)) {
     return Token(guard.loc(), TokenType::Float, LiteralInfo::Infinity(sign));
   }
-  return LexReserved(data);
+  return LexReserved(guard.Reset());
 }
 
 auto LexNan(SpanU8* data) -> Token {
@@ -267,7 +271,7 @@ auto LexNan(SpanU8* data) -> Token {
       return Token(guard.loc(), TokenType::Float, LiteralInfo::Nan(sign));
     }
   }
-  return LexReserved(data);
+  return LexReserved(guard.Reset());
 }
 
 auto LexNumber(SpanU8* data, TokenType tt) -> Token {
@@ -423,84 +427,104 @@ auto LexWhitespace(SpanU8* data) -> Token {
   }
 }
 
-auto LexKeyword(SpanU8* data, string_view sv, TokenType tt) -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), tt);
-  }
-  return LexReserved(guard.Reset());
-}
-
-auto LexKeyword(SpanU8* data, string_view sv, Opcode o, Features::Bits f = 0)
-    -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), TokenType::BareInstr, OpcodeInfo{o, Features{f}});
-  }
-  return LexReserved(guard.Reset());
-}
-
-auto LexKeyword(SpanU8* data,
-                string_view sv,
-                TokenType tt,
-                Opcode o,
-                Features::Bits f = 0) -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), tt, OpcodeInfo{o, Features{f}});
-  }
-  return LexReserved(guard.Reset());
-}
+// The immediate of a keyword token, if any. Each is stored as a u32 in
+// Keyword::value.
+enum class KeywordKind : u8 {
+  None,
+  Opcode,
+  NumericType,
+  ReferenceKind,
+  HeapKind,
+  PackedType,
+  LiteralKind,
+  SimdShape,
+};
 
-auto LexKeyword(SpanU8* data, string_view sv, NumericType nt) -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), TokenType::NumericType, nt);
-  }
-  return LexReserved(guard.Reset());
-}
+struct Keyword {
+  TokenType type;
+  KeywordKind kind;
+  u32 value;
+  Features::Bits features;
+};
 
-auto LexKeyword(SpanU8* data, string_view sv, ReferenceKind rk) -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), TokenType::ReferenceKind, rk);
-  }
-  return LexReserved(guard.Reset());
+// Always little-endian, to match the hash computed by gen-keywords.py.
+u64 ReadU64(const u8* p) {
+  u64 result;
+  std::memcpy(&result, p, sizeof(result));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  result = __builtin_bswap64(result);
+#endif
+  return result;
 }
 
-auto LexKeyword(SpanU8* data, string_view sv, TokenType tt, HeapKind hk)
-    -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), tt, hk);
-  }
-  return LexReserved(guard.Reset());
+auto MakeKeywordToken(Location loc, const Keyword& keyword) -> Token {
+  switch (keyword.kind) {
+    case KeywordKind::None:
+      return Token(loc, keyword.type);
+    case KeywordKind::Opcode:
+      return Token(loc, keyword.type,
+                   OpcodeInfo{Opcode(keyword.value),
+                              Features{keyword.features}});
+    case KeywordKind::NumericType:
+      return Token(loc, keyword.type, NumericType(keyword.value));
+    case KeywordKind::ReferenceKind:
+      return Token(loc, keyword.type, ReferenceKind(keyword.value));
+    case KeywordKind::HeapKind:
+      return Token(loc, keyword.type, HeapKind(keyword.value));
+    case KeywordKind::PackedType:
+      return Token(loc, keyword.type, PackedType(keyword.value));
+    case KeywordKind::LiteralKind:
+      return Token(loc, keyword.type,
+                   LiteralInfo{LiteralKind(keyword.value)});
+    case KeywordKind::SimdShape:
+      return Token(loc, keyword.type, SimdShape(keyword.value));
+  }
+  WASP_UNREACHABLE();
 }
 
-auto LexKeyword(SpanU8* data, string_view sv, PackedType pt) -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), TokenType::PackedType, pt);
-  }
-  return LexReserved(guard.Reset());
-}
+#include "src/text/keywords-inl.cc"
 
-auto LexKeyword(SpanU8* data, string_view sv, TokenType tt, LiteralKind lk)
-    -> Token {
+auto LexKeyword(SpanU8* data) -> Token {
   MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), tt, LiteralInfo{lk});
-  }
-  return LexReserved(guard.Reset());
-}
+  // A keyword is always a whole run of reserved characters.
+  span_extent_t size = 0;
+  while (IsReserved(PeekChar(data, size))) {
+    ++size;
+  }
+  if (size <= kMaxKeywordSize) {
+    // Load the run 8 bytes at a time, masking off the bytes past its end, so
+    // it can be hashed and compared with the only keyword it could be without
+    // copying it. Near the end of the data, copy it to a padded buffer first.
+    u8 padded[kMaxKeywordSize] = {};
+    const u8* p = data->data();
+    if (data->size() < kMaxKeywordSize) {
+      std::copy_n(p, size, padded);
+      p = padded;
+    }
+    u64 word[kKeywordWords];
+    for (span_extent_t i = 0; i < kKeywordWords; ++i) {
+      span_extent_t bytes = size > i * 8 ? size - i * 8 : 0;
+      u64 mask = bytes >= 8 ? ~u64{0} : (u64{1} << (bytes * 8)) - 1;
+      word[i] = ReadU64(p + i * 8) & mask;
+    }
 
-auto LexKeyword(SpanU8* data, string_view sv, SimdShape ss)
-    -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), TokenType::SimdShape, ss);
+    u64 hash = HashKeyword(word);
+    u64 bucket = hash >> (64 - kKeywordBucketBits);
+    u64 slot = (hash ^ kKeywordDisplacements[bucket]) & kKeywordSlotMask;
+    u16 index = kKeywordSlots[slot];
+    if (index != kNoKeyword) {
+      const u8* name = reinterpret_cast<const u8*>(kKeywordNames[index]);
+      u64 diff = 0;
+      for (span_extent_t i = 0; i < kKeywordWords; ++i) {
+        diff |= ReadU64(name + i * 8) ^ word[i];
+      }
+      if (diff == 0) {
+        data->remove_prefix(size);
+        return MakeKeywordToken(guard.loc(), kKeywords[index]);
+      }
+    }
   }
-  return LexReserved(guard.Reset());
+  return LexPrefixKeyword(data);
 }
 
 }  // namespace
@@ -594,7 +618,10 @@ auto Lex(SpanU8* data) -> Token {
       return LexId(data);
 
     default:
-#include "src/text/keywords-inl.cc"
+      if (IsReserved(PeekChar(data))) {
+        return LexKeyword(data);
+      }
+      break;
   }
   if (IsReserved(PeekChar(data))) {
     return LexReserved(data);
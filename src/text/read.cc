@@ -21,7 +21,9 @@
 #include <iterator>
 #include <numeric>
 #include <type_traits>
+#include <utility>
 
+#include "wasp/base/arena.h"
 #include "wasp/base/concat.h"
 #include "wasp/base/errors.h"
 #include "wasp/base/utf8.h"
@@ -625,15 +627,22 @@ auto ReadFunction(Tokenizer& tokenizer, ReadCtx& ctx) -> OptAt<Function> {
 
   if (!import_opt) {
     WASP_TRY_READ(locals_, ReadLocalList(tokenizer, ctx));
-    locals = locals_;
+    locals = std::move(locals_);
     WASP_TRY(ReadInstructionList(tokenizer, ctx, instructions));
     WASP_TRY(ReadRparAsEndInstruction(tokenizer, ctx, instructions));
   } else {
     WASP_TRY(Expect(tokenizer, ctx, TokenType::Rpar));
   }
 
-  return At{guard.loc(), Function{FunctionDesc{name, type_use, type}, locals,
-                                  instructions, import_opt, exports}};
+  // Build the function in place, rather than with the Function constructors,
+  // which copy the lists.
+  Function function;
+  function.desc = FunctionDesc{name, type_use, type};
+  function.locals = std::move(locals);
+  function.instructions = std::move(instructions);
+  function.import = import_opt;
+  function.exports = std::move(exports);
+  return At{guard.loc(), std::move(function)};
 }
 
 // Section 4: Table
@@ -1294,7 +1303,7 @@ auto ReadElementExpressionList(Tokenizer& tokenizer, ReadCtx& ctx)
   ElementExpressionList result;
   while (IsElementExpression(tokenizer)) {
     WASP_TRY_READ(expression, ReadElementExpression(tokenizer, ctx));
-    result.push_back(expression);
+    result.push_back(std::move(expression));
   }
   return result;
 }
@@ -1949,7 +1958,7 @@ bool ReadInstruction(Tokenizer& tokenizer,
   auto token = tokenizer.Peek();
   if (IsPlainInstruction(token)) {
     WASP_TRY_READ(instruction, ReadPlainInstruction(tokenizer, ctx));
-    instructions.push_back(instruction);
+    instructions.push_back(std::move(instruction));
   } else if (IsBlockInstruction(token)) {
     WASP_TRY(ReadBlockInstruction(tokenizer, ctx, instructions));
   } else if (IsLetInstruction(token)) {
@@ -1994,7 +2003,7 @@ bool ReadExpression(Tokenizer& tokenizer,
     WASP_TRY_READ(plain, ReadPlainInstruction(tokenizer, ctx));
     // Reorder the instructions, so `(A (B) (C))` becomes `(B) (C) (A)`.
     WASP_TRY(ReadExpressionList(tokenizer, ctx, instructions));
-    instructions.push_back(plain);
+    instructions.push_back(std::move(plain));
     WASP_TRY(Expect(tokenizer, ctx, TokenType::Rpar));
   } else if (IsBlockInstruction(token)) {
     LocationGuard guard{tokenizer};
@@ -2005,7 +2014,7 @@ bool ReadExpression(Tokenizer& tokenizer,
     switch (token.opcode()) {
       case Opcode::Block:
       case Opcode::Loop:
-        instructions.push_back(block_instr);
+        instructions.push_back(std::move(block_instr));
         WASP_TRY(ReadInstructionList(tokenizer, ctx, instructions));
         break;
 
@@ -2015,7 +2024,7 @@ bool ReadExpression(Tokenizer& tokenizer,
         WASP_TRY(ReadExpressionList(tokenizer, ctx, instructions));
 
         // The `if` instruction must come after the condition.
-        instructions.push_back(block_instr);
+        instructions.push_back(std::move(block_instr));
 
         // Read then block.
         WASP_TRY(ExpectLpar(tokenizer, ctx, TokenType::Then));
@@ -2036,7 +2045,7 @@ bool ReadExpression(Tokenizer& tokenizer,
           ctx.errors.OnError(token.loc, "try instruction not allowed");
           return false;
         }
-        instructions.push_back(block_instr);
+        instructions.push_back(std::move(block_instr));
         WASP_TRY(ReadInstructionList(tokenizer, ctx, instructions));
 
         // Read catch block.
@@ -2189,57 +2198,57 @@ auto ReadModuleItem(Tokenizer& tokenizer, ReadCtx& ctx) -> OptAt<ModuleItem> {
   switch (token.type) {
     case TokenType::Type: {
       WASP_TRY_READ(item, ReadDefinedType(tokenizer, ctx));
-      return At{item.loc(), ModuleItem{*item}};
+      return At{item.loc(), ModuleItem{std::move(*item)}};
     }
 
     case TokenType::Import: {
       WASP_TRY_READ(item, ReadImport(tokenizer, ctx));
-      return At{item.loc(), ModuleItem{*item}};
+      return At{item.loc(), ModuleItem{std::move(*item)}};
     }
 
     case TokenType::Func: {
       WASP_TRY_READ(item, ReadFunction(tokenizer, ctx));
-      return At{item.loc(), ModuleItem{*item}};
+      return At{item.loc(), ModuleItem{std::move(*item)}};
     }
 
     case TokenType::Table: {
       WASP_TRY_READ(item, ReadTable(tokenizer, ctx));
-      return At{item.loc(), ModuleItem{*item}};
+      return At{item.loc(), ModuleItem{std::move(*item)}};
     }
 
     case TokenType::Memory: {
       WASP_TRY_READ(item, ReadMemory(tokenizer, ctx));
-      return At{item.loc(), ModuleItem{*item}};
+      return At{item.loc(), ModuleItem{std::move(*item)}};
     }
 
     case TokenType::Global: {
       WASP_TRY_READ(item, ReadGlobal(tokenizer, ctx));
-      return At{item.loc(), ModuleItem{*item}};
+      return At{item.loc(), ModuleItem{std::move(*item)}};
     }
 
     case TokenType::Export: {
       WASP_TRY_READ(item, ReadExport(tokenizer, ctx));
-      return At{item.loc(), ModuleItem{*item}};
+      return At{item.loc(), ModuleItem{std::move(*item)}};
     }
 
     case TokenType::Start: {
       WASP_TRY_READ(item, ReadStart(tokenizer, ctx));
-      return At{item.loc(), ModuleItem{*item}};
+      return At{item.loc(), ModuleItem{std::move(*item)}};
     }
 
     case TokenType::Elem: {
       WASP_TRY_READ(item, ReadElementSegment(tokenizer, ctx));
-      return At{item.loc(), ModuleItem{*item}};
+      return At{item.loc(), ModuleItem{std::move(*item)}};
     }
 
     case TokenType::Data: {
       WASP_TRY_READ(item, ReadDataSegment(tokenizer, ctx));
-      return At{item.loc(), ModuleItem{*item}};
+      return At{item.loc(), ModuleItem{std::move(*item)}};
     }
 
     case TokenType::Event: {
       WASP_TRY_READ(item, ReadEvent(tokenizer, ctx));
-      return At{item.loc(), ModuleItem{*item}};
+      return At{item.loc(), ModuleItem{std::move(*item)}};
     }
 
     default:
@@ -2254,16 +2263,18 @@ auto ReadModuleItem(Tokenizer& tokenizer, ReadCtx& ctx) -> OptAt<ModuleItem> {
 }
 
 auto ReadModule(Tokenizer& tokenizer, ReadCtx& ctx) -> optional<Module> {
+  ArenaScope scope{ctx.arena};
   ctx.BeginModule();
   Module module;
   while (IsModuleItem(tokenizer)) {
     WASP_TRY_READ(item, ReadModuleItem(tokenizer, ctx));
-    module.push_back(item);
+    module.push_back(std::move(*item));
   }
   return module;
 }
 
 auto ReadSingleModule(Tokenizer& tokenizer, ReadCtx& ctx) -> optional<Module> {
+  ArenaScope scope{ctx.arena};
   // Check whether it's wrapped in (module... )
   bool in_module = false;
   if (tokenizer.MatchLpar(TokenType::Module).has_value()) {
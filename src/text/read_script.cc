@@ -17,7 +17,9 @@
 #include "wasp/text/read.h"
 
 #include <type_traits>
+#include <utility>
 
+#include "wasp/base/arena.h"
 #include "wasp/base/concat.h"
 #include "wasp/base/errors.h"
 #include "wasp/text/formatters.h"
@@ -576,10 +578,11 @@ auto ReadCommand(Tokenizer& tokenizer, ReadCtx& ctx) -> OptAt<Command> {
 }
 
 auto ReadScript(Tokenizer& tokenizer, ReadCtx& ctx) -> optional<Script> {
+  ArenaScope scope{ctx.arena};
   Script result;
   while (IsCommand(tokenizer)) {
     WASP_TRY_READ(command, ReadCommand(tokenizer, ctx));
-    result.push_back(command);
+    result.push_back(std::move(command));
   }
   return result;
 }
@@ -17,8 +17,12 @@
 #include "wasp/text/resolve.h"
 
 #include <cassert>
+#include <memory>
+#include <vector>
 
 #include "wasp/base/errors.h"
+#include "wasp/base/errors_buffer.h"
+#include "wasp/base/parallel.h"
 #include "wasp/text/formatters.h"
 #include "wasp/text/resolve_ctx.h"
 
@@ -212,6 +216,113 @@ void Resolve(Module& module, Errors& errors) {
   Resolve(ctx, module);
 }
 
+namespace {
+
+bool IsDeferredTypeIndex(const OptAt<Var>& type_use, Index type_count) {
+  return type_use && type_use->value().is_index() &&
+         type_use->value().index() >= type_count;
+}
+
+bool IsDeferredTypeIndex(const BlockImmediate& immediate, Index type_count) {
+  return IsDeferredTypeIndex(immediate.type.type_use, type_count);
+}
+
+// Whether the function refers to an implicitly defined (deferred) function
+// type by index, e.g. `(type 10)` where there are only 10 defined types.
+bool UsesDeferredTypeIndex(const Function& function, Index type_count) {
+  if (IsDeferredTypeIndex(function.desc.type_use, type_count)) {
+    return true;
+  }
+  for (const auto& instr : function.instructions) {
+    if ((instr->has_block_immediate() &&
+         IsDeferredTypeIndex(*instr->block_immediate(), type_count)) ||
+        (instr->has_call_indirect_immediate() &&
+         IsDeferredTypeIndex(instr->call_indirect_immediate()->type.type_use,
+                             type_count)) ||
+        (instr->has_func_bind_immediate() &&
+         IsDeferredTypeIndex(instr->func_bind_immediate()->type_use,
+                             type_count)) ||
+        (instr->has_let_immediate() &&
+         IsDeferredTypeIndex(instr->let_immediate()->block, type_count))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+void Resolve(Module& module, Errors& errors, u32 thread_count) {
+  thread_count = GetThreadCount(thread_count);
+  if (thread_count == 1) {
+    return Resolve(module, errors);
+  }
+
+  ResolveCtx ctx{errors};
+  ctx.BeginModule();
+  DefineTypes(ctx, module);
+  Define(ctx, module);
+
+  // Once all names are defined, each function can be resolved independently,
+  // using a copy of the module context per thread. Each function's errors and
+  // deferred type uses are recorded, to be replayed in module order below.
+  //
+  // A worker only knows about the deferred types used by the function it is
+  // resolving, so it can't resolve a type use that refers to a deferred type
+  // by index. That is rare, so such a module is resolved serially instead.
+  // This is checked before anything is resolved, since resolving modifies the
+  // module.
+  std::vector<Function*> functions;
+  for (auto& item : module) {
+    if (item.is_function()) {
+      if (UsesDeferredTypeIndex(item.function().value(),
+                                ctx.function_type_map.Size())) {
+        return Resolve(module, errors);
+      }
+      functions.push_back(&item.function().value());
+    }
+  }
+
+  struct FunctionResult {
+    ErrorsBuffer errors;
+    std::vector<DeferredTypeUse> deferred_type_uses;
+  };
+  std::vector<FunctionResult> results(functions.size());
+  std::vector<ErrorsBuffer> thread_errors(thread_count);
+  std::vector<std::unique_ptr<ResolveCtx>> thread_ctxs(thread_count);
+  for (u32 i = 0; i < thread_count; ++i) {
+    thread_ctxs[i] = std::make_unique<ResolveCtx>(ctx, thread_errors[i]);
+  }
+
+  ParallelFor(functions.size(), thread_count,
+              [&](u32 thread_index, size_t index) {
+                auto& thread_ctx = *thread_ctxs[thread_index];
+                auto& result = results[index];
+                thread_ctx.function_type_map.ClearDeferred();
+                thread_ctx.deferred_type_uses = &result.deferred_type_uses;
+                Resolve(thread_ctx, *functions[index]);
+                thread_errors[thread_index].ReplayTo(result.errors);
+                thread_errors[thread_index].Clear();
+              });
+
+  size_t function_index = 0;
+  for (auto& item : module) {
+    if (item.is_function()) {
+      auto& result = results[function_index++];
+      result.errors.ReplayTo(errors);
+      for (auto& use : result.deferred_type_uses) {
+        ctx.UseFunctionType(*use.type_use, use.type);
+      }
+    } else {
+      Resolve(ctx, item);
+    }
+  }
+  auto deferred_types = ctx.EndModule();
+  for (auto& defined_type : deferred_types) {
+    module.push_back(ModuleItem{defined_type});
+  }
+}
+
 void Resolve(Script& script, Errors& errors) {
   ResolveCtx ctx{errors};
   Resolve(ctx, script);
@@ -322,8 +433,7 @@ void Resolve(ResolveCtx& ctx, FunctionTypeUse& function_type_use) {
       }
     }
   } else {
-    auto index = ctx.function_type_map.Use(type);
-    type_use = Var{index};
+    ctx.UseFunctionType(type_use, type);
   }
 }
 
@@ -375,8 +485,7 @@ void Resolve(ResolveCtx& ctx,
       }
     }
   } else {
-    auto index = ctx.function_type_map.Use(type);
-    type_use = Var{index};
+    ctx.UseFunctionType(type_use, ToFunctionType(type.value()));
   }
 
   Define(ctx, type->params, ctx.local_names);
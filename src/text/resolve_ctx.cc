@@ -26,6 +26,23 @@ namespace wasp::text {
 
 ResolveCtx::ResolveCtx(Errors& errors) : errors{errors} {}
 
+ResolveCtx::ResolveCtx(const ResolveCtx& other, Errors& errors)
+    : errors{errors},
+      module_names{other.module_names},
+      type_names{other.type_names},
+      field_names{other.field_names},
+      function_names{other.function_names},
+      table_names{other.table_names},
+      memory_names{other.memory_names},
+      global_names{other.global_names},
+      event_names{other.event_names},
+      element_segment_names{other.element_segment_names},
+      data_segment_names{other.data_segment_names},
+      function_type_map{other.function_type_map},
+      local_names{other.local_names},
+      label_names{other.label_names},
+      blocks{other.blocks} {}
+
 void ResolveCtx::BeginModule() {
   type_names.Reset();
   field_names.clear();
@@ -68,6 +85,15 @@ auto ResolveCtx::EndModule() -> DefinedTypeList {
   return function_type_map.EndModule();
 }
 
+void ResolveCtx::UseFunctionType(OptAt<Var>& type_use,
+                                 const FunctionType& type) {
+  auto index = function_type_map.Use(type);
+  if (deferred_type_uses && index >= function_type_map.Size()) {
+    deferred_type_uses->push_back(DeferredTypeUse{&type_use, type});
+  }
+  type_use = Var{index};
+}
+
 auto ResolveCtx::NewFieldNameMap(Index index) -> NameMap& {
   auto [iter, ok] = field_names.emplace(index, NameMap{});
   assert(ok);
@@ -125,6 +151,10 @@ auto FunctionTypeMap::EndModule() -> DefinedTypeList {
   return defined_types;
 }
 
+void FunctionTypeMap::ClearDeferred() {
+  deferred_list_.clear();
+}
+
 Index FunctionTypeMap::Size() const {
   return static_cast<Index>(list_.size());
 }
@@ -17,11 +17,12 @@
 #include "wasp/text/read/token.h"
 
 #include <cassert>
+#include <cstring>
 
 namespace wasp::text {
 
 void Text::AppendToBuffer(Buffer& buffer) const {
-  static const char kHexDigit[256] = {
+  static const u8 kHexDigit[256] = {
       /*00*/ 0, 0,  0,  0,  0,  0,  0,  0, 0, 0, 0, 0, 0, 0, 0, 0,
       /*10*/ 0, 0,  0,  0,  0,  0,  0,  0, 0, 0, 0, 0, 0, 0, 0, 0,
       /*20*/ 0, 0,  0,  0,  0,  0,  0,  0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -32,35 +33,38 @@ void Text::AppendToBuffer(Buffer& buffer) const {
       // The rest are zero.
   };
 
-  buffer.reserve(buffer.size() + byte_size);
-
   // Remove surrounding quotes.
   assert(text.size() >= 2 && text[0] == '"' && text[text.size() - 1] == '"');
-  string_view input = text.substr(1, text.size() - 2);
-
-  // Unescape characters.
-  for (auto p = input.begin(), end = input.end(); p < end; ++p) {
-    char c = *p;
-    if (c == '\\') {
-      c = *++p;
-      switch (c) {
-        case 't': buffer.push_back('\t'); break;
-        case 'n': buffer.push_back('\n'); break;
-        case 'r': buffer.push_back('\r'); break;
-
-        case '"':
-        case '\'':
-        case '\\':
-          buffer.push_back(c);
-          break;
-
-        default:
-          // Must be a "\xx" hexadecimal sequence.
-          buffer.push_back((kHexDigit[int(c)] << 4) | kHexDigit[int(*++p)]);
-          break;
-      }
-    } else {
-      buffer.push_back(c);
+  auto* p = reinterpret_cast<const u8*>(text.data()) + 1;
+  auto* end = p + text.size() - 2;
+
+  // Copy the runs between escapes in bulk.
+  buffer.reserve(buffer.size() + byte_size);
+  while (p < end) {
+    auto* escape = static_cast<const u8*>(std::memchr(p, '\\', end - p));
+    if (escape == nullptr) {
+      buffer.insert(buffer.end(), p, end);
+      break;
+    }
+    buffer.insert(buffer.end(), p, escape);
+
+    p = escape + 1;
+    u8 c = *p++;
+    switch (c) {
+      case 't': buffer.push_back('\t'); break;
+      case 'n': buffer.push_back('\n'); break;
+      case 'r': buffer.push_back('\r'); break;
+
+      case '"':
+      case '\'':
+      case '\\':
+        buffer.push_back(c);
+        break;
+
+      default:
+        // Must be a "\xx" hexadecimal sequence.
+        buffer.push_back((kHexDigit[c] << 4) | kHexDigit[*p++]);
+        break;
     }
   }
 }
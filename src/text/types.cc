@@ -26,6 +26,11 @@
 namespace wasp::text {
 
 void AppendToBuffer(const TextList& text_list, Buffer& buffer) {
+  size_t size = buffer.size();
+  for (auto&& text : text_list) {
+    size += text->byte_size;
+  }
+  buffer.reserve(size);
   for (auto&& text : text_list) {
     text->AppendToBuffer(buffer);
   }
@@ -178,7 +178,7 @@ void Tool::CalculateCallGraph() {
     if (section->is_known()) {
       auto known = section->known();
       if (known->id == SectionId::Code) {
-        auto section = ReadCodeSection(known, module.ctx);
+        auto section = ReadCodeViewSection(known, module.ctx);
         for (auto code : enumerate(section.sequence, imported_function_count)) {
           for (const auto& instr :
                ReadExpression(code.value->body, module.ctx)) {
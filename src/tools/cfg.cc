@@ -15,7 +15,6 @@
 //
 
 #include <algorithm>
-#include <cassert>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -28,12 +27,16 @@
 #include "src/tools/binary_errors.h"
 #include "wasp/base/concat.h"
 #include "wasp/base/enumerate.h"
+#include "wasp/base/errors_buffer.h"
+#include "wasp/base/errors_nop.h"
 #include "wasp/base/features.h"
 #include "wasp/base/file.h"
 #include "wasp/base/formatters.h"
 #include "wasp/base/optional.h"
+#include "wasp/base/parallel.h"
 #include "wasp/base/str_to_u32.h"
 #include "wasp/base/string_view.h"
+#include "wasp/binary/control_flow_graph.h"
 #include "wasp/binary/formatters.h"
 #include "wasp/binary/lazy_expression.h"
 #include "wasp/binary/lazy_module.h"
@@ -52,61 +55,37 @@ struct Options {
   Features features;
   string_view function;
   string_view output_filename;
+  bool all = false;
+  u32 threads = 0;
 };
 
-using BBID = u32;
-constexpr BBID InvalidBBID = ~0;
+// Aggregate statistics for the control-flow graphs of several functions.
+struct Stats {
+  Stats& operator+=(const Stats&);
 
-struct Successor {
-  std::string name;
-  BBID bbid;
-};
-
-struct BasicBlock {
-  bool empty() const { return code.empty(); }
-
-  SpanU8 code;
-  std::vector<Successor> successors;
-};
-
-struct Label {
-  Opcode opcode;
-  BBID parent;
-  BBID br;
-  BBID next;
+  u64 functions = 0;
+  u64 blocks = 0;
+  u64 edges = 0;
 };
 
 struct Tool {
   explicit Tool(SpanU8 data, Options);
 
   int Run();
+  int RunAll();
   void DoPrepass();
   optional<Index> GetFunctionIndex();
-  optional<Code> GetCode(Index);
-  void CalculateCFG(Code);
-  void RemoveEmptyBasicBlocks();
-  void WriteDotFile();
-
-  void PushLabel(Opcode, BBID br, BBID next);
-  Label PopLabel();
-  BBID NewBasicBlock();
-  BasicBlock& GetBasicBlock(BBID);
-  void StartBasicBlock(BBID, const u8*);
-  void EndBasicBlock(const u8*);
-  void MarkUnreachable(const u8*);
-  void AddSuccessor(BBID, const std::string& name = std::string{});
-  void AddSuccessor(BBID, BBID, const std::string& name = std::string{});
-  void Br(Index, const std::string& name = std::string{});
+  optional<CodeView> GetCode(Index);
+  void WriteDotFile(const ControlFlowGraph&, SpanU8 body);
+
+  std::ostream* OpenOutput(std::ofstream&);
 
   BinaryErrors errors;
   Options options;
   LazyModule module;
   std::map<string_view, Index> name_to_function;
   Index imported_function_count = 0;
-  std::vector<Label> labels;
-  std::vector<BasicBlock> cfg;
-  BBID start_bbid = InvalidBBID;
-  BBID current_bbid = InvalidBBID;
+  u32 thread_count;
 };
 
 int Main(span<const string_view> args) {
@@ -122,6 +101,15 @@ int Main(span<const string_view> args) {
            [&](string_view arg) { options.output_filename = arg; })
       .Add('f', "--function", "<func>", "generate CFG for <func>",
            [&](string_view arg) { options.function = arg; })
+      .Add('a', "--all",
+           "generate CFGs for all functions and print statistics instead "
+           "of a DOT file",
+           [&]() { options.all = true; })
+      .Add('j', "--jobs", "<int>",
+           "number of threads to use with --all (default: all cores)",
+           [&](string_view arg) {
+             options.threads = StrToU32(arg).value_or(0);
+           })
       .Add("<filename>", "input wasm file", [&](string_view arg) {
         if (filename.empty()) {
           filename = arg;
@@ -136,7 +124,7 @@ int Main(span<const string_view> args) {
     parser.PrintHelpAndExit(1);
   }
 
-  if (options.function.empty()) {
+  if (options.function.empty() && !options.all) {
     Format(&std::cerr, "No function given.\n");
     parser.PrintHelpAndExit(1);
   }
@@ -154,13 +142,25 @@ int Main(span<const string_view> args) {
   return result;
 }
 
+Stats& Stats::operator+=(const Stats& other) {
+  functions += other.functions;
+  blocks += other.blocks;
+  edges += other.edges;
+  return *this;
+}
+
 Tool::Tool(SpanU8 data, Options options)
     : errors{data},
       options{options},
-      module{ReadLazyModule(data, options.features, errors)} {}
+      module{ReadLazyModule(data, options.features, errors)},
+      thread_count{GetThreadCount(options.threads)} {}
 
 int Tool::Run() {
   DoPrepass();
+  if (options.all) {
+    return RunAll();
+  }
+
   auto index_opt = GetFunctionIndex();
   if (!index_opt) {
     Format(&std::cerr, "Unknown function %s\n", options.function);
@@ -171,9 +171,54 @@ int Tool::Run() {
     Format(&std::cerr, "Invalid function index %d\n", *index_opt);
     return 1;
   }
-  CalculateCFG(*code_opt);
-  RemoveEmptyBasicBlocks();
-  WriteDotFile();
+  auto cfg = BuildControlFlowGraph(code_opt->body->data, module.ctx);
+  WriteDotFile(cfg, code_opt->body->data);
+  return 0;
+}
+
+int Tool::RunAll() {
+  // Reading the code section only finds the extent of each body, so it is
+  // cheap to do up front. The bodies are read when their CFG is built.
+  std::vector<CodeView> codes;
+  for (auto section : module.sections) {
+    if (section->is_known() && section->known()->id == SectionId::Code) {
+      for (auto code :
+           ReadCodeViewSection(section->known(), module.ctx).sequence) {
+        codes.push_back(*code);
+      }
+    }
+  }
+
+  // Each function's errors are buffered, and reported in function order
+  // below, so the output doesn't depend on how the functions were scheduled.
+  std::vector<ErrorsBuffer> function_errors(codes.size());
+  std::vector<Stats> thread_stats(thread_count);
+
+  ParallelFor(codes.size(), thread_count, [&](u32 thread, size_t i) {
+    ReadCtx ctx{module.ctx.features, function_errors[i]};
+    ctx.declared_data_count = module.ctx.declared_data_count;
+    auto cfg = BuildControlFlowGraph(codes[i].body->data, ctx);
+    auto& stats = thread_stats[thread];
+    stats.functions++;
+    stats.blocks += cfg.blocks.size();
+    stats.edges += cfg.edges.size();
+  });
+
+  for (const auto& buffer : function_errors) {
+    buffer.ReplayTo(errors);
+  }
+
+  Stats stats;
+  for (const auto& thread_stat : thread_stats) {
+    stats += thread_stat;
+  }
+
+  std::ofstream fstream;
+  std::ostream* stream = OpenOutput(fstream);
+  Format(stream, "functions: %d\n", stats.functions);
+  Format(stream, "blocks: %d\n", stats.blocks);
+  Format(stream, "edges: %d\n", stats.edges);
+  stream->flush();
   return 0;
 }
 
@@ -195,12 +240,12 @@ optional<Index> Tool::GetFunctionIndex() {
   return StrToU32(options.function);
 }
 
-optional<Code> Tool::GetCode(Index find_index) {
+optional<CodeView> Tool::GetCode(Index find_index) {
   for (auto section : module.sections) {
     if (section->is_known()) {
       auto known = section->known();
       if (known->id == SectionId::Code) {
-        auto section = ReadCodeSection(known, module.ctx);
+        auto section = ReadCodeViewSection(known, module.ctx);
         for (auto code : enumerate(section.sequence, imported_function_count)) {
           if (code.index == find_index) {
             return code.value;
@@ -212,148 +257,14 @@ optional<Code> Tool::GetCode(Index find_index) {
   return nullopt;
 }
 
-void Tool::CalculateCFG(Code code) {
-  const u8* ptr = code.body->data.data();
-  PushLabel(Opcode::Return, InvalidBBID, InvalidBBID);
-  start_bbid = NewBasicBlock();
-  StartBasicBlock(start_bbid, ptr);
-
-  const u8* prev_ptr = ptr;
-  auto instrs = ReadExpression(code.body, module.ctx);
-  for (auto it = instrs.begin(), end = instrs.end(); it != end;
-       ++it, prev_ptr = ptr) {
-    const auto& instr = *it;
-    ptr = it.data().data();
-    switch (instr->opcode) {
-      case Opcode::Unreachable:
-        MarkUnreachable(ptr);
-        break;
-
-      case Opcode::Block: {
-        auto next = NewBasicBlock();
-        PushLabel(instr->opcode, next, next);
-        break;
-      }
-
-      case Opcode::Loop: {
-        auto loop = NewBasicBlock();
-        auto next = NewBasicBlock();
-        AddSuccessor(loop);
-        PushLabel(instr->opcode, loop, next);
-        StartBasicBlock(loop, prev_ptr);
-        break;
-      }
-
-      case Opcode::If: {
-        auto true_ = NewBasicBlock();
-        auto next = NewBasicBlock();
-        AddSuccessor(true_, "T");
-        PushLabel(instr->opcode, next, next);
-        StartBasicBlock(true_, ptr);
-        break;
-      }
-
-      case Opcode::Else: {
-        auto top = PopLabel();
-        AddSuccessor(top.next);
-        auto false_ = NewBasicBlock();
-        AddSuccessor(top.parent, false_, "F");
-        PushLabel(instr->opcode, top.next, top.next);
-        StartBasicBlock(false_, ptr);
-        break;
-      }
-
-      case Opcode::End: {
-        auto top = PopLabel();
-        AddSuccessor(top.next);
-        if (top.opcode == Opcode::If) {
-          AddSuccessor(top.parent, top.next, "F");
-        }
-        StartBasicBlock(top.next, ptr);
-        break;
-      }
-
-      case Opcode::Br:
-        Br(instr->index_immediate());
-        MarkUnreachable(ptr);
-        break;
-
-      case Opcode::BrIf: {
-        Br(instr->index_immediate(), "T");
-        auto next = NewBasicBlock();
-        AddSuccessor(next, "F");
-        StartBasicBlock(next, ptr);
-        break;
-      }
-
-      case Opcode::BrTable: {
-        const auto& immediate = instr->br_table_immediate();
-        u32 value = 0;
-        for (const auto& target : immediate->targets) {
-          Br(target, StrFormat("%d", value++));
-        }
-        Br(immediate->default_target, "default");
-        MarkUnreachable(ptr);
-        break;
-      }
-
-      case Opcode::Return:
-      case Opcode::ReturnCall:
-      case Opcode::ReturnCallIndirect:
-        MarkUnreachable(ptr);
-        break;
-
-      default:
-        break;
-    }
-  }
-}
-
-void Tool::RemoveEmptyBasicBlocks() {
-  std::map<BBID, BBID> empty_map;
-  // Map each empty bb to its successor.
-  for (const auto& bb: enumerate(cfg)) {
-    if (bb.value.empty()) {
-      BBID next = bb.value.successors.empty() ? InvalidBBID
-                                              : bb.value.successors[0].bbid;
-      empty_map.emplace(bb.index, next);
-    }
-  }
-
-  for (auto& pair: empty_map) {
-    // Follow the chain of empty bbs to the first non-empty one (or
-    // InvalidBBID).
-    BBID last = pair.second;
-    auto it = empty_map.find(last);
-    if (it != empty_map.end()) {
-      while (it != empty_map.end()) {
-        last = it->second;
-        it = empty_map.find(last);
-      }
-
-      // Replace all successors in the chain with `last`.
-      BBID next = pair.second;
-      pair.second = last;
-      it = empty_map.find(next);
-      while (it != empty_map.end()) {
-        next = it->second;
-        it->second = last;
-        it = empty_map.find(next);
-      }
-    }
-  }
-
-  // Update all non-empty bbs that have empty successors.
-  for (auto& bb: cfg) {
-    if (!bb.empty()) {
-      for (auto& succ: bb.successors) {
-        auto it = empty_map.find(succ.bbid);
-        if (it != empty_map.end()) {
-          succ.bbid = it->second;
-        }
-      }
+std::ostream* Tool::OpenOutput(std::ofstream& fstream) {
+  if (!options.output_filename.empty()) {
+    fstream = std::ofstream{std::string{options.output_filename}};
+    if (fstream) {
+      return &fstream;
     }
   }
+  return &std::cout;
 }
 
 bool IsExtraneousInstruction(const At<Instruction>& instr) {
@@ -362,85 +273,101 @@ bool IsExtraneousInstruction(const At<Instruction>& instr) {
          opcode == Opcode::End || opcode == Opcode::Br;
 }
 
-void Tool::WriteDotFile() {
+// The DOT port name of an edge, or the empty string for an edge that doesn't
+// need one.
+std::string EdgeName(const ControlFlowEdge& edge) {
+  switch (edge.kind) {
+    case ControlFlowEdgeKind::Unconditional:
+      return std::string{};
+    case ControlFlowEdgeKind::True:
+      return "T";
+    case ControlFlowEdgeKind::False:
+      return "F";
+    case ControlFlowEdgeKind::Case:
+      return StrFormat("%d", edge.case_index);
+    case ControlFlowEdgeKind::Default:
+      return "default";
+  }
+  return std::string{};
+}
+
+void Tool::WriteDotFile(const ControlFlowGraph& cfg, SpanU8 body) {
   const int kMaxSuccessors = 64;
 
   std::ofstream fstream;
-  std::ostream* stream = &std::cout;
-  if (!options.output_filename.empty()) {
-    fstream = std::ofstream{std::string{options.output_filename}};
-    if (fstream) {
-      stream = &fstream;
-    }
-  }
+  std::ostream* stream = OpenOutput(fstream);
 
   Format(stream, "strict digraph {\n");
 
+  // Each block is read on its own, so the body's structure can't be checked
+  // (e.g. the block before an `else` ends with it); any errors were already
+  // reported when the graph was built.
+  ErrorsNop errors_nop;
+  ReadCtx block_ctx{module.ctx.features, errors_nop};
+
   // Write nodes.
-  for (const auto& bb: enumerate(cfg)) {
-    if (!bb.value.empty()) {
-      auto colspan = std::max<int>(
-          1, std::min<int>(static_cast<int>(bb.value.successors.size()), kMaxSuccessors));
-      Format(stream,
-             "  %d [shape=none;margin=0;label=<"
-             "<TABLE BORDER=\"1\" CELLBORDER=\"1\" CELLSPACING=\"0\"><TR>"
-             "<TD BORDER=\"0\" ALIGN=\"LEFT\" COLSPAN=\"%d\">",
-             bb.index, colspan);
-      auto instrs = ReadExpression(bb.value.code, module.ctx);
-      for (const auto& instr: instrs) {
-        if (IsExtraneousInstruction(instr)) {
-          continue;
-        } else if (instr->opcode == Opcode::BrTable) {
-          Format(stream, "%s...", concat(instr->opcode));
-        } else {
-          Format(stream, "%s", concat(*instr));
-        }
-        Format(stream, "<BR ALIGN=\"LEFT\"/>");
+  for (BasicBlockId id = 0; id < cfg.blocks.size(); ++id) {
+    auto successors = cfg.successors(id);
+    auto colspan = std::max<int>(
+        1, std::min<int>(static_cast<int>(successors.size()), kMaxSuccessors));
+    Format(stream,
+           "  %d [shape=none;margin=0;label=<"
+           "<TABLE BORDER=\"1\" CELLBORDER=\"1\" CELLSPACING=\"0\"><TR>"
+           "<TD BORDER=\"0\" ALIGN=\"LEFT\" COLSPAN=\"%d\">",
+           id, colspan);
+    auto instrs = ReadExpression(cfg.code(body, id), block_ctx);
+    for (const auto& instr: instrs) {
+      if (IsExtraneousInstruction(instr)) {
+        continue;
+      } else if (instr->opcode == Opcode::BrTable) {
+        Format(stream, "%s...", concat(instr->opcode));
+      } else {
+        Format(stream, "%s", concat(*instr));
       }
-      Format(stream, "</TD></TR>");
-      // Add ports.
-      if (bb.value.successors.size() > 1) {
-        Format(stream, "<TR>");
-        string_view sides = "T";
-        for (const auto& succ: enumerate(bb.value.successors)) {
-          if (succ.index < kMaxSuccessors) {
-            assert(!succ.value.name.empty());
-            Format(stream, "<TD PORT=\"%s\" SIDES=\"%s\">%s</TD>",
-                  succ.value.name, sides, succ.value.name);
-          } else {
-            Format(stream, "<TD PORT=\"trunc\" SIDES=\"TL\">...</TD>");
-            break;
-          }
-          sides = "TL";
+      Format(stream, "<BR ALIGN=\"LEFT\"/>");
+    }
+    Format(stream, "</TD></TR>");
+    // Add ports.
+    if (successors.size() > 1) {
+      Format(stream, "<TR>");
+      string_view sides = "T";
+      for (const auto& succ: enumerate(successors)) {
+        if (succ.index < kMaxSuccessors) {
+          auto name = EdgeName(succ.value);
+          Format(stream, "<TD PORT=\"%s\" SIDES=\"%s\">%s</TD>", name, sides,
+                 name);
+        } else {
+          Format(stream, "<TD PORT=\"trunc\" SIDES=\"TL\">...</TD>");
+          break;
         }
-        Format(stream, "</TR>");
+        sides = "TL";
       }
-      Format(stream, "</TABLE>>]\n");
+      Format(stream, "</TR>");
     }
+    Format(stream, "</TABLE>>]\n");
   }
 
   // Write edges.
-  Format(stream, "  start -> %d\n", start_bbid);
-  for (const auto& bb: enumerate(cfg)) {
-    if (!bb.value.empty()) {
-      for (const auto& succ : enumerate(bb.value.successors)) {
-        if (succ.value.bbid == InvalidBBID) {
-          Format(stream, "  %d -> end", bb.index);
-        } else {
-          Format(stream, "  %d", bb.index);
-          if (!succ.value.name.empty()) {
-            if (succ.index < kMaxSuccessors) {
-              Format(stream, ":%s", succ.value.name);
-            } else {
-              Format(stream, ":trunc");
-            }
-          }
-          Format(stream, " -> %d", succ.value.bbid);
-          if (succ.index >= kMaxSuccessors && !succ.value.name.empty()) {
-            Format(stream, " [headlabel=\"%s\"]", succ.value.name);
+  Format(stream, "  start -> %d\n", cfg.start);
+  for (BasicBlockId id = 0; id < cfg.blocks.size(); ++id) {
+    for (const auto& succ : enumerate(cfg.successors(id))) {
+      if (succ.value.target == kInvalidBasicBlockId) {
+        Format(stream, "  %d -> end\n", id);
+      } else {
+        auto name = EdgeName(succ.value);
+        Format(stream, "  %d", id);
+        if (!name.empty()) {
+          if (succ.index < kMaxSuccessors) {
+            Format(stream, ":%s", name);
+          } else {
+            Format(stream, ":trunc");
           }
-          Format(stream, "\n");
         }
+        Format(stream, " -> %d", succ.value.target);
+        if (succ.index >= kMaxSuccessors && !name.empty()) {
+          Format(stream, " [headlabel=\"%s\"]", name);
+        }
+        Format(stream, "\n");
       }
     }
   }
@@ -449,66 +376,4 @@ void Tool::WriteDotFile() {
   stream->flush();
 }
 
-void Tool::PushLabel(Opcode opcode, BBID br, BBID next) {
-  labels.push_back({opcode, current_bbid, br, next});
-}
-
-Label Tool::PopLabel() {
-  assert(!labels.empty());
-  Label top = labels.back();
-  labels.pop_back();
-  return top;
-}
-
-BBID Tool::NewBasicBlock() {
-  cfg.emplace_back();
-  return static_cast<BBID>(cfg.size() - 1);
-}
-
-BasicBlock& Tool::GetBasicBlock(BBID bbid) {
-  assert(bbid < cfg.size());
-  return cfg[bbid];
-}
-
-void Tool::StartBasicBlock(BBID bbid, const u8* start) {
-  if (current_bbid != InvalidBBID) {
-    EndBasicBlock(start);
-  }
-  current_bbid = bbid;
-  if (current_bbid != InvalidBBID) {
-    GetBasicBlock(current_bbid).code = MakeSpan(start, start);
-  }
-}
-
-void Tool::EndBasicBlock(const u8* end) {
-  auto& bb = GetBasicBlock(current_bbid);
-  const u8* start = bb.code.data();
-  bb.code = MakeSpan(start, end);
-
-  auto instrs = ReadExpression(bb.code, module.ctx);
-  if (std::all_of(instrs.begin(), instrs.end(), IsExtraneousInstruction)) {
-    bb.code = SpanU8{};
-  }
-}
-
-void Tool::MarkUnreachable(const u8* ptr) {
-  StartBasicBlock(NewBasicBlock(), ptr);
-}
-
-void Tool::AddSuccessor(BBID bbid, const std::string& name) {
-  AddSuccessor(current_bbid, bbid, name);
-}
-
-void Tool::AddSuccessor(BBID from, BBID to, const std::string& name) {
-  GetBasicBlock(from).successors.push_back({name, to});
-}
-
-void Tool::Br(Index index, const std::string& name) {
-  if (index < labels.size()) {
-    AddSuccessor(labels[labels.size() - index - 1].br, name);
-  } else {
-    Format(&std::cerr, "Invalid branch depth: %d\n", index);
-  }
-}
-
 }  // namespace wasp::tools::cfg
@@ -14,12 +14,15 @@
 // limitations under the License.
 //
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <iostream>
 #include <map>
-#include <set>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/strings/str_format.h"
 
@@ -27,15 +30,18 @@
 #include "src/tools/binary_errors.h"
 #include "wasp/base/concat.h"
 #include "wasp/base/enumerate.h"
+#include "wasp/base/errors_buffer.h"
 #include "wasp/base/errors_nop.h"
 #include "wasp/base/features.h"
 #include "wasp/base/file.h"
 #include "wasp/base/formatters.h"
 #include "wasp/base/optional.h"
+#include "wasp/base/parallel.h"
 #include "wasp/base/str_to_u32.h"
 #include "wasp/base/string_view.h"
 #include "wasp/binary/formatters.h"
 #include "wasp/binary/lazy_expression.h"
+#include "wasp/binary/lazy_locals.h"
 #include "wasp/binary/lazy_module.h"
 #include "wasp/binary/lazy_module_utils.h"
 #include "wasp/binary/name_section/sections.h"
@@ -54,6 +60,8 @@ struct Options {
   Features features;
   string_view function;
   string_view output_filename;
+  bool all = false;
+  u32 threads = 0;
 };
 
 using BBID = u32;
@@ -75,7 +83,10 @@ struct Value {
 
 struct Block {
   std::vector<BBID> preds;
-  std::map<VarID, ValueID> incomplete_phis;
+  // The current definition of each variable in this block, indexed by VarID.
+  // InvalidValueID if the variable hasn't been defined (yet).
+  ValueIDs defs;
+  std::vector<std::pair<VarID, ValueID>> incomplete_phis;
   size_t value_count;
   bool is_loop_header;
   bool sealed;
@@ -90,19 +101,53 @@ struct Label {
   bool unreachable;
 };
 
+// Aggregate statistics for the data-flow graphs of several functions.
+struct Stats {
+  Stats& operator+=(const Stats&);
+
+  u64 functions = 0;
+  u64 blocks = 0;
+  u64 values = 0;
+  u64 phis = 0;
+  u64 edges = 0;
+};
+
 struct Tool {
   explicit Tool(SpanU8 data, Options);
 
   int Run();
+  int RunAll();
   void DoPrepass();
   optional<Index> GetFunctionIndex();
-  optional<FunctionType> GetFunctionType(Index);
-  optional<Code> GetCode(Index);
-  void CalculateDFG(const FunctionType&, Code);
+  optional<FunctionType> GetFunctionType(Index) const;
+  optional<CodeView> GetCode(Index);
+
+  std::ostream* OpenOutput(std::ofstream&);
+
+  BinaryErrors errors;
+  Options options;
+  LazyModule module;
+  std::vector<DefinedType> defined_types;
+  std::vector<Function> functions;
+  std::map<string_view, Index> name_to_function;
+  Index imported_function_count = 0;
+  u32 thread_count;
+};
+
+// The data-flow graph of one function. The tool is only read, so the graphs
+// of several functions can be built at once, each with its own ReadCtx and
+// log.
+struct DFG {
+  explicit DFG(const Tool&, ReadCtx&, std::ostream& log);
+
+  void Calculate(const FunctionType&, CodeView);
   void DoInstruction(const Instruction&);
   optional<ValueID> GetTrivialPhiOperand(ValueID);
   void RemoveTrivialPhis();
-  void WriteDotFile();
+  bool ShouldDisplay(ValueID, const std::vector<bool>& has_users) const;
+  std::vector<bool> GetHasUsers() const;
+  Stats GetStats() const;
+  void WriteDotFile(std::ostream&);
 
   static size_t BlockTypeToValueCount(BlockType);
 
@@ -124,6 +169,7 @@ struct Tool {
 
   size_t GetStackSize() const;
   Value& GetValue(ValueID);
+  const Value& GetValue(ValueID) const;
   void CopyValues(size_t count, ValueIDs& out);
   void ForwardValues(const Label&, BBID target);
   void PushValue(ValueID);
@@ -140,17 +186,13 @@ struct Tool {
   ValueID AddPhiOperands(VarID, ValueID);
   void SealBlock(BBID);
 
-  BinaryErrors errors;
-  Options options;
-  LazyModule module;
-  std::vector<DefinedType> defined_types;
-  std::vector<Function> functions;
-  std::map<string_view, Index> name_to_function;
-  Index imported_function_count = 0;
+  const Tool& tool;
+  ReadCtx& ctx;
+  // Where problems with the function that aren't read errors are reported.
+  std::ostream& log;
   std::vector<Label> labels;
   std::vector<Block> bbs;
   std::vector<Value> values;
-  std::map<std::pair<VarID, BBID>, ValueID> current_def;
   size_t value_stack_size = 0;
   BBID start_bbid = InvalidBBID;
   BBID current_bbid = InvalidBBID;
@@ -170,6 +212,15 @@ int Main(span<const string_view> args) {
            [&](string_view arg) { options.output_filename = arg; })
       .Add('f', "--function", "<func>", "generate DFG for <func>",
            [&](string_view arg) { options.function = arg; })
+      .Add('a', "--all",
+           "generate DFGs for all functions and print statistics instead "
+           "of a DOT file",
+           [&]() { options.all = true; })
+      .Add('j', "--jobs", "<int>",
+           "number of threads to use with --all (default: all cores)",
+           [&](string_view arg) {
+             options.threads = StrToU32(arg).value_or(0);
+           })
       .Add("<filename>", "input wasm file", [&](string_view arg) {
         if (filename.empty()) {
           filename = arg;
@@ -184,7 +235,7 @@ int Main(span<const string_view> args) {
     parser.PrintHelpAndExit(1);
   }
 
-  if (options.function.empty()) {
+  if (options.function.empty() && !options.all) {
     Format(&std::cerr, "No function given.\n");
     parser.PrintHelpAndExit(1);
   }
@@ -202,13 +253,27 @@ int Main(span<const string_view> args) {
   return result;
 }
 
+Stats& Stats::operator+=(const Stats& other) {
+  functions += other.functions;
+  blocks += other.blocks;
+  values += other.values;
+  phis += other.phis;
+  edges += other.edges;
+  return *this;
+}
+
 Tool::Tool(SpanU8 data, Options options)
     : errors{data},
       options{options},
-      module{ReadLazyModule(data, options.features, errors)} {}
+      module{ReadLazyModule(data, options.features, errors)},
+      thread_count{GetThreadCount(options.threads)} {}
 
 int Tool::Run() {
   DoPrepass();
+  if (options.all) {
+    return RunAll();
+  }
+
   auto index_opt = GetFunctionIndex();
   if (!index_opt) {
     Format(&std::cerr, "Unknown function %s\n", options.function);
@@ -220,9 +285,76 @@ int Tool::Run() {
     Format(&std::cerr, "Invalid function index %d\n", *index_opt);
     return 1;
   }
-  CalculateDFG(*ft_opt, *code_opt);
-  RemoveTrivialPhis();
-  WriteDotFile();
+  DFG dfg{*this, module.ctx, std::cerr};
+  dfg.Calculate(*ft_opt, *code_opt);
+  dfg.RemoveTrivialPhis();
+
+  std::ofstream fstream;
+  dfg.WriteDotFile(*OpenOutput(fstream));
+  return 0;
+}
+
+int Tool::RunAll() {
+  // Reading the code section only checks the locals and finds the extent of
+  // each body, so it is cheap to do up front. The bodies are read when their
+  // DFG is built.
+  std::vector<CodeView> codes;
+  for (auto section : module.sections) {
+    if (section->is_known() && section->known()->id == SectionId::Code) {
+      for (auto code :
+           ReadCodeViewSection(section->known(), module.ctx).sequence) {
+        codes.push_back(*code);
+      }
+    }
+  }
+
+  // Each function's errors and log are buffered, and reported in function
+  // order below, so the output doesn't depend on how the functions were
+  // scheduled.
+  struct FunctionResult {
+    ErrorsBuffer errors;
+    std::string log;
+  };
+  std::vector<FunctionResult> results(codes.size());
+  std::vector<Stats> thread_stats(thread_count);
+
+  // Each function is a separate item, since their sizes vary so much.
+  ParallelFor(codes.size(), thread_count, [&](u32 thread, size_t i) {
+    auto& result = results[i];
+    std::ostringstream log;
+    Index func_index = imported_function_count + static_cast<Index>(i);
+    auto ft_opt = GetFunctionType(func_index);
+    if (ft_opt) {
+      ReadCtx ctx{module.ctx.features, result.errors};
+      ctx.declared_data_count = module.ctx.declared_data_count;
+      DFG dfg{*this, ctx, log};
+      dfg.Calculate(*ft_opt, codes[i]);
+      dfg.RemoveTrivialPhis();
+      thread_stats[thread] += dfg.GetStats();
+    } else {
+      Format(&log, "Invalid function index %d\n", func_index);
+    }
+    result.log = log.str();
+  });
+
+  for (const auto& result : results) {
+    result.errors.ReplayTo(errors);
+    std::cerr << result.log;
+  }
+
+  Stats stats;
+  for (const auto& thread_stat : thread_stats) {
+    stats += thread_stat;
+  }
+
+  std::ofstream fstream;
+  std::ostream* stream = OpenOutput(fstream);
+  Format(stream, "functions: %d\n", stats.functions);
+  Format(stream, "blocks: %d\n", stats.blocks);
+  Format(stream, "values: %d\n", stats.values);
+  Format(stream, "phis: %d\n", stats.phis);
+  Format(stream, "edges: %d\n", stats.edges);
+  stream->flush();
   return 0;
 }
 
@@ -276,7 +408,7 @@ optional<Index> Tool::GetFunctionIndex() {
   return StrToU32(options.function);
 }
 
-optional<FunctionType> Tool::GetFunctionType(Index func_index) {
+optional<FunctionType> Tool::GetFunctionType(Index func_index) const {
   if (func_index >= functions.size()) {
     return nullopt;
   }
@@ -290,12 +422,12 @@ optional<FunctionType> Tool::GetFunctionType(Index func_index) {
   return defined_types[type_index].function_type();
 }
 
-optional<Code> Tool::GetCode(Index find_index) {
+optional<CodeView> Tool::GetCode(Index find_index) {
   for (auto section : module.sections) {
     if (section->is_known()) {
       auto known = section->known();
       if (known->id == SectionId::Code) {
-        auto section = ReadCodeSection(known, module.ctx);
+        auto section = ReadCodeViewSection(known, module.ctx);
         for (auto code : enumerate(section.sequence, imported_function_count)) {
           if (code.index == find_index) {
             return code.value;
@@ -307,7 +439,20 @@ optional<Code> Tool::GetCode(Index find_index) {
   return nullopt;
 }
 
-void Tool::CalculateDFG(const FunctionType& type, Code code) {
+std::ostream* Tool::OpenOutput(std::ofstream& fstream) {
+  if (!options.output_filename.empty()) {
+    fstream = std::ofstream{std::string{options.output_filename}};
+    if (fstream) {
+      return &fstream;
+    }
+  }
+  return &std::cout;
+}
+
+DFG::DFG(const Tool& tool, ReadCtx& ctx, std::ostream& log)
+    : tool{tool}, ctx{ctx}, log{log} {}
+
+void DFG::Calculate(const FunctionType& type, CodeView code) {
   // Create start block and label.
   start_bbid = NewBlock();
   StartBlock(start_bbid);
@@ -318,7 +463,7 @@ void Tool::CalculateDFG(const FunctionType& type, Code code) {
   }
 
   // Add locals, initialized to 0.
-  for (const auto& locals : code.locals) {
+  for (const auto& locals : ReadLocals(code, ctx).sequence) {
     for (Index i = 0; i < locals->count; ++i) {
       if (locals->type->is_numeric_type()) {
         switch (locals->type->numeric_type()) {
@@ -356,7 +501,7 @@ void Tool::CalculateDFG(const FunctionType& type, Code code) {
   PushUndefValues(type.result_types.size());
   PushLabel(Opcode::Return, return_bbid, return_bbid);
 
-  for (const auto& instr : ReadExpression(code.body, module.ctx)) {
+  for (const auto& instr : ReadExpression(code.body, ctx)) {
     DoInstruction(instr);
   }
 
@@ -365,7 +510,7 @@ void Tool::CalculateDFG(const FunctionType& type, Code code) {
   SealBlock(return_bbid);
 }
 
-void Tool::DoInstruction(const Instruction& instr) {
+void DFG::DoInstruction(const Instruction& instr) {
   switch (instr.opcode) {
     case Opcode::Unreachable:
       MarkUnreachable();
@@ -452,12 +597,12 @@ void Tool::DoInstruction(const Instruction& instr) {
 
     case Opcode::Call:
     case Opcode::ReturnCall: {
-      auto func_type_opt = GetFunctionType(instr.index_immediate());
+      auto func_type_opt = tool.GetFunctionType(instr.index_immediate());
       if (func_type_opt) {
         BasicInstruction(instr, func_type_opt->param_types.size(),
                          func_type_opt->result_types.size());
       } else {
-        Format(&std::cerr, "*** Error: `%s` with unknown function\n",
+        Format(&log, "*** Error: `%s` with unknown function\n",
                concat(instr));
       }
       if (instr.opcode == Opcode::ReturnCall) {
@@ -470,13 +615,14 @@ void Tool::DoInstruction(const Instruction& instr) {
     case Opcode::CallIndirect:
     case Opcode::ReturnCallIndirect: {
       auto type_index = instr.call_indirect_immediate()->index;
-      if (type_index < defined_types.size() &&
-          defined_types[type_index].is_function_type()) {
-        const auto& func_type = defined_types[type_index].function_type();
+      if (type_index < tool.defined_types.size() &&
+          tool.defined_types[type_index].is_function_type()) {
+        const auto& func_type =
+            tool.defined_types[type_index].function_type();
         BasicInstruction(instr, func_type->param_types.size() + 1,
                          func_type->result_types.size());
       } else {
-        Format(&std::cerr, "*** Error: `%s` with unknown type\n",
+        Format(&log, "*** Error: `%s` with unknown type\n",
                concat(instr));
       }
       if (instr.opcode == Opcode::ReturnCallIndirect) {
@@ -1017,15 +1163,15 @@ void Tool::DoInstruction(const Instruction& instr) {
 }
 
 // static
-size_t Tool::BlockTypeToValueCount(BlockType type) {
+size_t DFG::BlockTypeToValueCount(BlockType type) {
   return type.is_void() ? 0 : 1;
 }
 
-void Tool::PushLabel(Opcode opcode, BBID br, BBID next) {
+void DFG::PushLabel(Opcode opcode, BBID br, BBID next) {
   labels.push_back({opcode, current_bbid, br, next, value_stack_size, false});
 }
 
-Label Tool::PopLabel() {
+Label DFG::PopLabel() {
   auto top = labels.back();
   if (!top.unreachable) {
     ForwardValues(top, top.next);
@@ -1039,12 +1185,12 @@ Label Tool::PopLabel() {
   return top;
 }
 
-BBID Tool::NewBlock(size_t value_count, bool is_loop_header) {
-  bbs.push_back(Block{{}, {}, value_count, is_loop_header, false});
+BBID DFG::NewBlock(size_t value_count, bool is_loop_header) {
+  bbs.push_back(Block{{}, {}, {}, value_count, is_loop_header, false});
   return static_cast<BBID>(bbs.size() - 1);
 }
 
-void Tool::StartBlock(BBID bbid) {
+void DFG::StartBlock(BBID bbid) {
   if (current_bbid != InvalidBBID &&
       !GetBlock(current_bbid).is_loop_header) {
     SealBlock(current_bbid);
@@ -1052,43 +1198,43 @@ void Tool::StartBlock(BBID bbid) {
   current_bbid = bbid;
 }
 
-Block& Tool::GetBlock(BBID bbid) {
+Block& DFG::GetBlock(BBID bbid) {
   assert(bbid < bbs.size());
   return bbs[bbid];
 }
 
-void Tool::MarkUnreachable() {
+void DFG::MarkUnreachable() {
   assert(!labels.empty());
   labels.back().unreachable = true;
   StartBlock(NewBlock());
 }
 
-void Tool::AddPred(BBID bbid) {
+void DFG::AddPred(BBID bbid) {
   AddPred(bbid, current_bbid);
 }
 
-void Tool::AddPred(BBID bbid, BBID pred) {
+void DFG::AddPred(BBID bbid, BBID pred) {
   if (bbid != InvalidBBID) {
     GetBlock(bbid).preds.emplace_back(pred);
   }
 }
 
-void Tool::Br(Index index) {
+void DFG::Br(Index index) {
   if (index < labels.size()) {
     const auto& label = labels[labels.size() - index - 1];
     auto target = label.br;
     AddPred(target);
     ForwardValues(label, target);
   } else {
-    Format(&std::cerr, "*** Error: Invalid br depth %d\n", index);
+    Format(&log, "*** Error: Invalid br depth %d\n", index);
   }
 }
 
-void Tool::Return() {
+void DFG::Return() {
   Br(static_cast<Index>(labels.size() - 2));
 }
 
-ValueID Tool::NewValue(const Instruction& instr, size_t operand_count) {
+ValueID DFG::NewValue(const Instruction& instr, size_t operand_count) {
   values.push_back(Value{current_bbid, instr, {}});
   auto value = static_cast<ValueID>(values.size() - 1);
   ValueIDs operands;
@@ -1097,44 +1243,49 @@ ValueID Tool::NewValue(const Instruction& instr, size_t operand_count) {
   return value;
 }
 
-ValueID Tool::NewPhi(BBID bbid) {
+ValueID DFG::NewPhi(BBID bbid) {
   values.push_back(Value{bbid, nullopt, {}});
   auto value = static_cast<ValueID>(values.size() - 1);
   return value;
 }
 
-ValueID Tool::Undef() {
+ValueID DFG::Undef() {
   if (undef == InvalidValueID) {
     undef = NewValue(Instruction{At{Opcode::Unreachable}});
   }
   return undef;
 }
 
-size_t Tool::GetStackSize() const {
+size_t DFG::GetStackSize() const {
   if (labels.empty()) {
     return 0;
   }
   return value_stack_size - labels.back().value_stack_size;
 }
 
-Value& Tool::GetValue(ValueID id) {
+Value& DFG::GetValue(ValueID id) {
   assert(id < values.size());
   return values[id];
 }
 
-void Tool::CopyValues(size_t count, ValueIDs& out) {
+const Value& DFG::GetValue(ValueID id) const {
+  assert(id < values.size());
+  return values[id];
+}
+
+void DFG::CopyValues(size_t count, ValueIDs& out) {
   if (count <= GetStackSize()) {
     out.resize(count);
     for (size_t i = 0; i < count; ++i) {
       out[i] = ReadVariable(static_cast<VarID>(value_stack_size - count + i), current_bbid);
     }
   } else {
-    Format(&std::cerr, "*** Error: CopyValues(%d) past bottom of stack %d\n",
+    Format(&log, "*** Error: CopyValues(%d) past bottom of stack %d\n",
            count, GetStackSize());
   }
 }
 
-void Tool::ForwardValues(const Label& label, BBID bbid) {
+void DFG::ForwardValues(const Label& label, BBID bbid) {
   const auto& block = GetBlock(bbid);
   for (size_t i = 0; i < block.value_count; ++i) {
     auto value =
@@ -1144,18 +1295,18 @@ void Tool::ForwardValues(const Label& label, BBID bbid) {
   }
 }
 
-void Tool::PushValue(ValueID value) {
+void DFG::PushValue(ValueID value) {
   WriteVariable(static_cast<VarID>(value_stack_size++), current_bbid, value);
 }
 
-void Tool::PushUndefValues(size_t count) {
+void DFG::PushUndefValues(size_t count) {
   auto undef = Undef();
   for (size_t i = 0; i < count; ++i) {
     WriteVariable(static_cast<VarID>(value_stack_size++), current_bbid, undef);
   }
 }
 
-ValueID Tool::PopValue() {
+ValueID DFG::PopValue() {
   if (GetStackSize() == 0) {
     return InvalidValueID;
   }
@@ -1163,18 +1314,18 @@ ValueID Tool::PopValue() {
   return ReadVariable(static_cast<VarID>(--value_stack_size), current_bbid);
 }
 
-void Tool::PopValues(size_t count) {
+void DFG::PopValues(size_t count) {
   auto stack_size = GetStackSize();
   if (count <= stack_size) {
     value_stack_size -= count;
   } else {
-    Format(&std::cerr, "*** Error: PopValues(%d) past bottom of stack %d\n",
+    Format(&log, "*** Error: PopValues(%d) past bottom of stack %d\n",
            count, GetStackSize());
     value_stack_size -= stack_size;
   }
 }
 
-void Tool::BasicInstruction(const Instruction& instr,
+void DFG::BasicInstruction(const Instruction& instr,
                             size_t operand_count,
                             size_t result_count) {
   assert(result_count <= 1);  // TODO support multi-value
@@ -1188,27 +1339,31 @@ void Tool::BasicInstruction(const Instruction& instr,
 // Implementation of SSA construction from
 // https://pp.info.uni-karlsruhe.de/uploads/publikationen/braun13cc.pdf
 
-void Tool::WriteVariable(VarID var, BBID bbid, ValueID value) {
+void DFG::WriteVariable(VarID var, BBID bbid, ValueID value) {
   assert(value != InvalidValueID);
-  current_def[std::make_pair(var, bbid)] = value;
+  auto& defs = GetBlock(bbid).defs;
+  if (var >= defs.size()) {
+    defs.resize(var + 1, InvalidValueID);
+  }
+  defs[var] = value;
 }
 
-ValueID Tool::ReadVariable(VarID var, BBID bbid) {
-  auto iter = current_def.find(std::make_pair(var, bbid));
-  if (iter != current_def.end()) {
-    return iter->second;
+ValueID DFG::ReadVariable(VarID var, BBID bbid) {
+  const auto& defs = GetBlock(bbid).defs;
+  if (var < defs.size() && defs[var] != InvalidValueID) {
+    return defs[var];
   }
   auto value = ReadVariableRecurse(var, bbid);
   return value;
 }
 
-ValueID Tool::ReadVariableRecurse(VarID var, BBID bbid) {
+ValueID DFG::ReadVariableRecurse(VarID var, BBID bbid) {
   auto& block = GetBlock(bbid);
   ValueID value;
   if (!block.sealed) {
     // Incomplete CFG.
     value = NewPhi(bbid);
-    block.incomplete_phis[var] = value;
+    block.incomplete_phis.emplace_back(var, value);
   } else {
     if (block.preds.size() == 1) {
       // Optimize the common case of one predecessor: no phi needed.
@@ -1226,7 +1381,7 @@ ValueID Tool::ReadVariableRecurse(VarID var, BBID bbid) {
   return value;
 }
 
-ValueID Tool::AddPhiOperands(VarID var, ValueID phi) {
+ValueID DFG::AddPhiOperands(VarID var, ValueID phi) {
   // Determine operands from predecessors.
   auto preds = GetBlock(GetValue(phi).block).preds;
   for (BBID pred: preds) {
@@ -1236,17 +1391,20 @@ ValueID Tool::AddPhiOperands(VarID var, ValueID phi) {
   return phi;
 }
 
-void Tool::SealBlock(BBID bbid) {
+void DFG::SealBlock(BBID bbid) {
   auto& block = GetBlock(bbid);
   assert(!block.sealed);
-  for (auto pair : block.incomplete_phis) {
-    AddPhiOperands(pair.first, pair.second);
+  // Add the operands in VarID order, since that determines the IDs of any phis
+  // created in other blocks along the way.
+  std::sort(block.incomplete_phis.begin(), block.incomplete_phis.end());
+  for (auto [var, phi] : block.incomplete_phis) {
+    AddPhiOperands(var, phi);
   }
   block.incomplete_phis.clear();
   block.sealed = true;
 }
 
-optional<ValueID> Tool::GetTrivialPhiOperand(ValueID vid) {
+optional<ValueID> DFG::GetTrivialPhiOperand(ValueID vid) {
   auto& value = GetValue(vid);
   if (value.is_phi()) {
     optional<ValueID> same;
@@ -1265,10 +1423,11 @@ optional<ValueID> Tool::GetTrivialPhiOperand(ValueID vid) {
   return nullopt;
 }
 
-void Tool::RemoveTrivialPhis() {
-  using UserMap = std::multimap<ValueID, ValueID>;
-  std::set<ValueID> trivial_phis;
-  UserMap users;
+void DFG::RemoveTrivialPhis() {
+  // The users of each value, indexed by ValueID. A value that uses another
+  // value more than once is listed once per use.
+  std::vector<ValueIDs> users(values.size());
+  std::vector<bool> trivial_phis(values.size());
   ValueIDs phis;
   ValueID vid = 0;
   for (const auto& value : values) {
@@ -1276,7 +1435,7 @@ void Tool::RemoveTrivialPhis() {
       phis.emplace_back(vid);
     }
     for (auto op : value.operands) {
-      users.emplace(op, vid);
+      users[op].push_back(vid);
     }
     ++vid;
   }
@@ -1290,25 +1449,19 @@ void Tool::RemoveTrivialPhis() {
         // For all operands of this phi: replace any users that point to this
         // phi with same.
         for (auto op : phi_value.operands) {
-          auto range = users.equal_range(op);
-          for (auto it = range.first; it != range.second; ++it) {
-            if (it->second == phi) {
-              it->second = *same;
-            }
-          }
+          std::replace(users[op].begin(), users[op].end(), phi, *same);
         }
         phi_value.operands.clear();
 
         // For all users of this phi: replace any operands that point to this
         // phi with same.
-        std::vector<UserMap::value_type> new_user_pairs;
-        auto range = users.equal_range(phi);
-        for (auto it = range.first; it != range.second; ++it) {
-          auto user = it->second;
+        ValueIDs phi_users = std::move(users[phi]);
+        users[phi].clear();
+        for (auto user : phi_users) {
           if (user != phi) {
             auto& operands = GetValue(user).operands;
             std::replace(operands.begin(), operands.end(), phi, *same);
-            new_user_pairs.emplace_back(*same, user);
+            users[*same].push_back(user);
             if (GetValue(user).is_phi()) {
               // Perform another pass with any users that may have become
               // trivial by the removal of phi.
@@ -1316,13 +1469,11 @@ void Tool::RemoveTrivialPhis() {
             }
           }
         }
-        users.erase(range.first, range.second);
-        users.insert(new_user_pairs.begin(), new_user_pairs.end());
 
-        trivial_phis.insert(phi);
+        trivial_phis[phi] = true;
       }
     }
-    auto&& is_trivial = [&](ValueID x) { return trivial_phis.count(x) != 0; };
+    auto&& is_trivial = [&](ValueID x) { return trivial_phis[x]; };
     auto new_end = std::remove_if(new_phis.begin(), new_phis.end(), is_trivial);
     std::sort(new_phis.begin(), new_end);
     new_end = std::unique(new_phis.begin(), new_end);
@@ -1331,6 +1482,40 @@ void Tool::RemoveTrivialPhis() {
   }
 }
 
+std::vector<bool> DFG::GetHasUsers() const {
+  std::vector<bool> has_users(values.size());
+  for (const auto& value : values) {
+    for (auto op : value.operands) {
+      has_users[op] = true;
+    }
+  }
+  return has_users;
+}
+
+bool DFG::ShouldDisplay(ValueID vid,
+                        const std::vector<bool>& has_users) const {
+  return !GetValue(vid).operands.empty() || has_users[vid];
+}
+
+Stats DFG::GetStats() const {
+  auto has_users = GetHasUsers();
+  Stats stats;
+  stats.functions = 1;
+  stats.blocks = bbs.size();
+  ValueID vid = 0;
+  for (const auto& value : values) {
+    if (ShouldDisplay(vid, has_users)) {
+      stats.values++;
+      if (value.is_phi()) {
+        stats.phis++;
+      }
+    }
+    stats.edges += value.operands.size();
+    vid++;
+  }
+  return stats;
+}
+
 namespace {
 
 std::string EscapeString(string_view s) {
@@ -1352,55 +1537,40 @@ std::string EscapeString(string_view s) {
 
 }  // namespace
 
-void Tool::WriteDotFile() {
-  std::ofstream fstream;
-  std::ostream* stream = &std::cout;
-  if (!options.output_filename.empty()) {
-    fstream = std::ofstream{std::string{options.output_filename}};
-    if (fstream) {
-      stream = &fstream;
-    }
-  }
-
-  // Collect values for each basic block, and users of each value.
-  std::multimap<ValueID, ValueID> users;
-  std::map<BBID, std::vector<ValueID>> blocks;
+void DFG::WriteDotFile(std::ostream& stream) {
+  // Collect values for each basic block, and whether each value has users.
+  std::vector<ValueIDs> blocks(bbs.size());
   ValueID vid = 0;
   for (const auto& value : values) {
     blocks[value.block].push_back(vid);
-    for (auto op : value.operands) {
-      users.emplace(op, vid);
-    }
     vid++;
   }
-
-  auto&& should_display = [&](ValueID vid) {
-    auto& value = GetValue(vid);
-    return !value.operands.empty() || users.count(vid) != 0;
-  };
+  auto has_users = GetHasUsers();
 
   std::vector<std::pair<ValueID, ValueID>> interblock_edges;
 
-  Format(stream, "strict digraph {\n");
+  Format(&stream, "strict digraph {\n");
 
   // Write clusters.
-  for (const auto& pair : blocks) {
-    auto bbid = pair.first;
-    const auto& block_vids = pair.second;
+  for (BBID bbid = 0; bbid < blocks.size(); ++bbid) {
+    const auto& block_vids = blocks[bbid];
+    if (block_vids.empty()) {
+      continue;
+    }
 
-    Format(stream, "  subgraph cluster_%d {\n", bbid);
+    Format(&stream, "  subgraph cluster_%d {\n", bbid);
 
     // Write nodes.
     for (const auto& vid : block_vids) {
-      if (should_display(vid)) {
+      if (ShouldDisplay(vid, has_users)) {
         const auto& value = GetValue(vid);
-        Format(stream, "    %d [shape=box;label=\"", vid);
+        Format(&stream, "    %d [shape=box;label=\"", vid);
         if (value.is_phi()) {
-          Format(stream, "phi");
+          Format(&stream, "phi");
         } else {
-          Format(stream, "%s", EscapeString(concat(*value.instr)));
+          Format(&stream, "%s", EscapeString(concat(*value.instr)));
         }
-        Format(stream, "\"]\n");
+        Format(&stream, "\"]\n");
       }
     }
 
@@ -1409,23 +1579,23 @@ void Tool::WriteDotFile() {
       const auto& value = GetValue(vid);
       for (const auto& op : value.operands) {
         if (GetValue(op).block == bbid) {
-          Format(stream, "    %d -> %d\n", op, vid);
+          Format(&stream, "    %d -> %d\n", op, vid);
         } else {
           interblock_edges.push_back(std::make_pair(op, vid));
         }
       }
     }
 
-    Format(stream, "  }\n");
+    Format(&stream, "  }\n");
   }
 
   // Write edges that span between blocks.
   for (const auto& pair : interblock_edges) {
-    Format(stream, "  %d -> %d\n", pair.first, pair.second);
+    Format(&stream, "  %d -> %d\n", pair.first, pair.second);
   }
 
-  Format(stream, "}\n");
-  stream->flush();
+  Format(&stream, "}\n");
+  stream.flush();
 }
 
 }  // namespace dfg
@@ -17,7 +17,6 @@
 #include <algorithm>
 #include <cctype>
 #include <iostream>
-#include <map>
 #include <string>
 #include <vector>
 
@@ -25,17 +24,21 @@
 
 #include "src/tools/argparser.h"
 #include "src/tools/binary_errors.h"
+#include "src/tools/output_buffer.h"
 #include "wasp/base/concat.h"
 #include "wasp/base/enumerate.h"
 #include "wasp/base/features.h"
 #include "wasp/base/file.h"
 #include "wasp/base/formatters.h"
+#include "wasp/base/hashmap.h"
 #include "wasp/base/macros.h"
+#include "wasp/base/span.h"
 #include "wasp/base/str_to_u32.h"
 #include "wasp/base/string_view.h"
 #include "wasp/base/types.h"
 #include "wasp/binary/formatters.h"
 #include "wasp/binary/lazy_expression.h"
+#include "wasp/binary/lazy_locals.h"
 #include "wasp/binary/lazy_module.h"
 #include "wasp/binary/linking_section/formatters.h"
 #include "wasp/binary/linking_section/sections.h"
@@ -49,7 +52,6 @@ namespace tools {
 namespace dump {
 
 using absl::Format;
-using absl::PrintF;
 using absl::StrFormat;
 
 using namespace ::wasp::binary;
@@ -109,7 +111,7 @@ struct Tool {
     visit::Result OnElement(const At<ElementSegment>&);
     visit::Result BeginDataCountSection(DataCountSection);
     visit::Result BeginCodeSection(LazyCodeSection);
-    visit::Result BeginCode(const At<Code>&);
+    visit::Result BeginCode(const At<CodeView>&);
     visit::Result BeginDataSection(LazyDataSection);
     visit::Result OnData(const At<DataSegment>&);
 
@@ -132,7 +134,7 @@ struct Tool {
 
   void DoCount(Pass, optional<Index> count);
 
-  void Disassemble(SectionIndex, Index func_index, Code);
+  void Disassemble(SectionIndex, Index func_index, CodeView);
 
   void InsertFunctionName(Index, string_view name);
   void InsertGlobalName(Index, string_view name);
@@ -145,8 +147,9 @@ struct Tool {
   optional<string_view> GetSymbolName(Index) const;
   optional<Index> GetI32Value(const ConstantExpression&);
 
+  // Relocation entries for a section, sorted by offset.
   using RelocationEntries = std::vector<RelocationEntry>;
-  optional<RelocationEntries> GetRelocationEntries(SectionIndex);
+  const RelocationEntries* GetRelocationEntries(SectionIndex) const;
 
   enum class PrintChars { No, Yes };
 
@@ -161,7 +164,7 @@ struct Tool {
                    string_view prefix = "",
                    int octets_per_line = 16,
                    int octets_per_group = 2);
-  void PrintFunctionHeader(Index func_index, Code);
+  void PrintFunctionHeader(Index func_index, CodeView);
   void PrintInstruction(const Instruction&,
                         SpanU8 data,
                         SpanU8 post_data,
@@ -182,15 +185,16 @@ struct Tool {
   Options options;
   SpanU8 data;
   BinaryErrors errors;
+  OutputBuffer out;
   LazyModule module;
   std::vector<DefinedType> defined_types;
   std::vector<Function> functions;
-  std::map<Index, string_view> function_names;
-  std::map<Index, string_view> global_names;
-  std::map<Index, Symbol> symbol_table;
-  std::map<SectionIndex, std::string> section_names;
-  std::map<SectionIndex, size_t> section_starts;
-  std::map<SectionIndex, RelocationEntries> section_relocations;
+  flat_hash_map<Index, string_view> function_names;
+  flat_hash_map<Index, string_view> global_names;
+  flat_hash_map<Index, Symbol> symbol_table;
+  flat_hash_map<SectionIndex, std::string> section_names;
+  flat_hash_map<SectionIndex, size_t> section_starts;
+  flat_hash_map<SectionIndex, RelocationEntries> section_relocations;
   bool should_print_details = true;
   Index imported_function_count = 0;
   Index imported_table_count = 0;
@@ -253,6 +257,7 @@ int Main(span<const string_view> args) {
     SpanU8 data{*optbuf};
     Tool tool{filename, data, options};
     tool.Run();
+    tool.out.Flush();
     tool.errors.PrintTo(std::cerr);
   }
 
@@ -271,14 +276,15 @@ void Tool::Run() {
     return;
   }
 
-  PrintF("\n%s:\tfile format wasm %s\n", filename,
-         concat(FormatWrapper{*module.version}));
+  out.PrintF("\n%s:\tfile format wasm %s\n", filename,
+             concat(FormatWrapper{*module.version}));
   DoPrepass();
   // If we haven't found a function with the given name, try interpreting it as
   // an index.
   if (options.function && !options.func_index) {
     options.func_index = StrToU32(*options.function);
     if (!options.func_index) {
+      out.Flush();
       Format(&std::cerr, "unknown function %s\n", concat(*options.function));
       return;
     }
@@ -413,8 +419,17 @@ void Tool::DoPrepass() {
       } else if (starts_with(*custom->name, "reloc.")) {
         auto sec = ReadRelocationSection(custom, module.ctx);
         if (sec.section_index) {
-          section_relocations[*sec.section_index] =
-              RelocationEntries{sec.entries.begin(), sec.entries.end()};
+          auto& relocs = section_relocations[*sec.section_index];
+          relocs.assign(sec.entries.begin(), sec.entries.end());
+          // Relocations are usually already sorted, but Disassemble relies on
+          // it.
+          auto less = [](const RelocationEntry& lhs,
+                         const RelocationEntry& rhs) {
+            return *lhs.offset < *rhs.offset;
+          };
+          if (!std::is_sorted(relocs.begin(), relocs.end(), less)) {
+            std::stable_sort(relocs.begin(), relocs.end(), less);
+          }
         }
       }
     }
@@ -424,15 +439,15 @@ void Tool::DoPrepass() {
 void Tool::DoPass(Pass pass) {
   switch (pass) {
     case Pass::Headers:
-      PrintF("\nSections:\n\n");
+      out.PrintF("\nSections:\n\n");
       break;
 
     case Pass::Details:
-      PrintF("\nSection Details:\n\n");
+      out.PrintF("\nSection Details:\n\n");
       break;
 
     case Pass::Disassemble:
-      PrintF("\nCode Disassembly:\n\n");
+      out.PrintF("\nCode Disassembly:\n\n");
       break;
 
     case Pass::RawData:
@@ -493,11 +508,11 @@ void Tool::DoCustomSection(Pass pass,
                            CustomSection custom) {
   switch (pass) {
     case Pass::Headers:
-      PrintF("\"%s\"\n", custom.name);
+      out.PrintF("\"%s\"\n", custom.name);
       break;
 
     case Pass::Details:
-      PrintF(":\n - name: \"%s\"\n", custom.name);
+      out.PrintF(":\n - name: \"%s\"\n", custom.name);
       if (*custom.name == "name") {
         DoNameSection(pass, section_index, ReadNameSection(custom, module.ctx));
       } else if (*custom.name == "linking") {
@@ -522,13 +537,13 @@ void Tool::DoSectionHeader(Pass pass,
   auto size = data.size();
   switch (pass) {
     case Pass::Headers: {
-      PrintF("%9s start=%#010x end=%#010x (size=%#010x) ", concat(id), offset,
-             offset + size, size);
+      out.PrintF("%9s start=%#010x end=%#010x (size=%#010x) ", concat(id),
+                 offset, offset + size, size);
       break;
     }
 
     case Pass::Details:
-      PrintF("%s", concat(id));
+      out.PrintF("%s", concat(id));
       break;
 
     case Pass::Disassemble:
@@ -536,9 +551,10 @@ void Tool::DoSectionHeader(Pass pass,
 
     case Pass::RawData: {
       if (section.is_custom()) {
-        PrintF("\nContents of custom section (%s):\n", section.custom()->name);
+        out.PrintF("\nContents of custom section (%s):\n",
+                   section.custom()->name);
       } else {
-        PrintF("\nContents of section %s:\n", concat(id));
+        out.PrintF("\nContents of section %s:\n", concat(id));
       }
       PrintMemory(data, static_cast<Index>(offset), PrintChars::Yes);
       break;
@@ -553,7 +569,7 @@ visit::Result Tool::Visitor::BeginTypeSection(LazyTypeSection section) {
 }
 
 visit::Result Tool::Visitor::OnType(const At<DefinedType>& defined_type) {
-  PrintF(" - type[%d] %s\n", index++, concat(defined_type));
+  tool.out.PrintF(" - type[%d] %s\n", index++, concat(defined_type));
   return visit::Result::Ok;
 }
 
@@ -570,37 +586,41 @@ visit::Result Tool::Visitor::BeginImportSection(LazyImportSection section) {
 visit::Result Tool::Visitor::OnImport(const At<Import>& import) {
   switch (import->kind()) {
     case ExternalKind::Function: {
-      PrintF(" - func[%d] sig=%d", function_count, import->index());
+      tool.out.PrintF(" - func[%d] sig=%d", function_count, import->index());
       tool.PrintFunctionName(function_count);
       ++function_count;
       break;
     }
 
     case ExternalKind::Table: {
-      PrintF(" - table[%d] %s", table_count, concat(import->table_type()));
+      tool.out.PrintF(" - table[%d] %s", table_count,
+                      concat(import->table_type()));
       ++table_count;
       break;
     }
 
     case ExternalKind::Memory: {
-      PrintF(" - memory[%d] %s", memory_count, concat(import->memory_type()));
+      tool.out.PrintF(" - memory[%d] %s", memory_count,
+                      concat(import->memory_type()));
       ++memory_count;
       break;
     }
 
     case ExternalKind::Global: {
-      PrintF(" - global[%d] %s", global_count, concat(import->global_type()));
+      tool.out.PrintF(" - global[%d] %s", global_count,
+                      concat(import->global_type()));
       ++global_count;
       break;
     }
 
     case ExternalKind::Event: {
-      PrintF(" - event[%d] %s", event_count, concat(import->event_type()));
+      tool.out.PrintF(" - event[%d] %s", event_count,
+                      concat(import->event_type()));
       ++event_count;
       break;
     }
   }
-  PrintF(" <- %s.%s\n", import->module, import->name);
+  tool.out.PrintF(" <- %s.%s\n", import->module, import->name);
   return visit::Result::Ok;
 }
 
@@ -612,9 +632,9 @@ visit::Result Tool::Visitor::BeginFunctionSection(LazyFunctionSection section) {
 
 visit::Result Tool::Visitor::OnFunction(const At<Function>& func) {
   if (!tool.options.func_index || index == tool.options.func_index) {
-    PrintF(" - func[%d] sig=%d", index, func->type_index);
+    tool.out.PrintF(" - func[%d] sig=%d", index, func->type_index);
     tool.PrintFunctionName(index);
-    PrintF("\n");
+    tool.out.PrintF("\n");
   }
   ++index;
   return visit::Result::Ok;
@@ -627,7 +647,7 @@ visit::Result Tool::Visitor::BeginTableSection(LazyTableSection section) {
 }
 
 visit::Result Tool::Visitor::OnTable(const At<Table>& table) {
-  PrintF(" - table[%d] %s\n", index++, concat(table->table_type));
+  tool.out.PrintF(" - table[%d] %s\n", index++, concat(table->table_type));
   return visit::Result::Ok;
 }
 
@@ -638,7 +658,7 @@ visit::Result Tool::Visitor::BeginMemorySection(LazyMemorySection section) {
 }
 
 visit::Result Tool::Visitor::OnMemory(const At<Memory>& memory) {
-  PrintF(" - memory[%d] %s\n", index++, concat(memory->memory_type));
+  tool.out.PrintF(" - memory[%d] %s\n", index++, concat(memory->memory_type));
   return visit::Result::Ok;
 }
 
@@ -649,8 +669,8 @@ visit::Result Tool::Visitor::BeginGlobalSection(LazyGlobalSection section) {
 }
 
 visit::Result Tool::Visitor::OnGlobal(const At<Global>& global) {
-  PrintF(" - global[%d] %s - %s\n", index++, concat(global->global_type),
-         concat(global->init));
+  tool.out.PrintF(" - global[%d] %s - %s\n", index++,
+                  concat(global->global_type), concat(global->init));
   return visit::Result::Ok;
 }
 
@@ -661,7 +681,7 @@ visit::Result Tool::Visitor::BeginEventSection(LazyEventSection section) {
 }
 
 visit::Result Tool::Visitor::OnEvent(const At<Event>& event) {
-  PrintF(" - event[%d] %s\n", index++, concat(event->event_type));
+  tool.out.PrintF(" - event[%d] %s\n", index++, concat(event->event_type));
   return visit::Result::Ok;
 }
 
@@ -671,11 +691,11 @@ visit::Result Tool::Visitor::BeginExportSection(LazyExportSection section) {
 }
 
 visit::Result Tool::Visitor::OnExport(const At<Export>& export_) {
-  PrintF(" - %s[%d]", concat(export_->kind), export_->index);
+  tool.out.PrintF(" - %s[%d]", concat(export_->kind), export_->index);
   if (export_->kind == ExternalKind::Function) {
     tool.PrintFunctionName(export_->index);
   }
-  PrintF(" -> \"%s\"\n", export_->name);
+  tool.out.PrintF(" -> \"%s\"\n", export_->name);
   return visit::Result::Ok;
 }
 
@@ -683,7 +703,7 @@ visit::Result Tool::Visitor::BeginStartSection(StartSection section) {
   if (section) {
     auto start = *section;
     if (pass == Pass::Headers) {
-      PrintF("start: %d\n", start->func_index);
+      tool.out.PrintF("start: %d\n", start->func_index);
     } else {
       tool.PrintDetails(pass,
                         absl::ParsedFormat<'d'>(" - start function: %d\n"),
@@ -700,33 +720,35 @@ visit::Result Tool::Visitor::BeginElementSection(LazyElementSection section) {
 }
 
 visit::Result Tool::Visitor::OnElement(const At<ElementSegment>& segment) {
-  PrintF(" - segment[%d] %s", index, concat(segment->type));
+  tool.out.PrintF(" - segment[%d] %s", index, concat(segment->type));
   if (segment->table_index) {
-    PrintF(" table=%d", *segment->table_index);
+    tool.out.PrintF(" table=%d", *segment->table_index);
   }
 
   if (segment->has_indexes()) {
-    PrintF(" kind=%s count=%d", concat(segment->indexes().kind),
-           segment->indexes().list.size());
+    tool.out.PrintF(" kind=%s count=%d", concat(segment->indexes().kind),
+                    segment->indexes().list.size());
   } else if (segment->has_expressions()) {
-    PrintF(" elemtype=%s count=%d", concat(segment->expressions().elemtype),
-           segment->expressions().list.size());
+    tool.out.PrintF(" elemtype=%s count=%d",
+                    concat(segment->expressions().elemtype),
+                    segment->expressions().list.size());
   }
 
   Index offset = 0;
   if (segment->offset) {
     offset = tool.GetI32Value(*segment->offset).value_or(0);
-    PrintF(" - init %d", offset);
+    tool.out.PrintF(" - init %d", offset);
   }
-  PrintF("\n");
+  tool.out.PrintF("\n");
 
   if (segment->has_indexes()) {
     for (auto item : enumerate(segment->indexes().list)) {
-      PrintF("  - elem[%d] = %d\n", offset + item.index, item.value);
+      tool.out.PrintF("  - elem[%d] = %d\n", offset + item.index, item.value);
     }
   } else if (segment->has_expressions()) {
     for (auto item : enumerate(segment->expressions().list)) {
-      PrintF("  - elem[%d] = %s\n", offset + item.index, concat(item.value));
+      tool.out.PrintF("  - elem[%d] = %s\n", offset + item.index,
+                      concat(item.value));
     }
   }
 
@@ -738,7 +760,7 @@ visit::Result Tool::Visitor::BeginDataCountSection(DataCountSection section) {
   if (section) {
     auto data_count = *section;
     if (pass == Pass::Headers) {
-      PrintF("count: %d\n", data_count->count);
+      tool.out.PrintF("count: %d\n", data_count->count);
     } else {
       tool.PrintDetails(pass, absl::ParsedFormat<'d'>(" - data count: %d\n"),
                         data_count->count);
@@ -753,12 +775,13 @@ visit::Result Tool::Visitor::BeginCodeSection(LazyCodeSection section) {
   return SkipUnless(tool.ShouldPrintDetails(pass) || pass == Pass::Disassemble);
 }
 
-visit::Result Tool::Visitor::BeginCode(const At<Code>& code) {
+visit::Result Tool::Visitor::BeginCode(const At<CodeView>& code) {
   if (!tool.options.func_index || index == tool.options.func_index) {
     if (pass == Pass::Details) {
-      PrintF(" - func[%d] size=%d\n", index, code->body->data.size());
+      tool.out.PrintF(" - func[%d] size=%d\n", index, code->body->data.size());
     } else {
-      tool.Disassemble(section_index, index, code);
+      // section_index has already been advanced past the code section.
+      tool.Disassemble(section_index - 1, index, code);
     }
   }
   ++index;
@@ -773,17 +796,17 @@ visit::Result Tool::Visitor::BeginDataSection(LazyDataSection section) {
 }
 
 visit::Result Tool::Visitor::OnData(const At<DataSegment>& segment) {
-  PrintF(" - segment[%d] %s", index, concat(segment->type));
+  tool.out.PrintF(" - segment[%d] %s", index, concat(segment->type));
   if (segment->memory_index) {
-    PrintF(" memory=%d", *segment->memory_index);
+    tool.out.PrintF(" memory=%d", *segment->memory_index);
   }
-  PrintF(" size=%d", segment->init.size());
+  tool.out.PrintF(" size=%d", segment->init.size());
   Index offset = 0;
   if (segment->offset) {
     offset = tool.GetI32Value(*segment->offset).value_or(0);
-    PrintF(" - init %d", offset);
+    tool.out.PrintF(" - init %d", offset);
   }
-  PrintF("\n");
+  tool.out.PrintF("\n");
   tool.PrintMemory(segment->init, offset, PrintChars::Yes, "  - ");
   ++index;
   return visit::Result::Ok;
@@ -801,18 +824,18 @@ void Tool::DoNameSection(Pass pass,
       case NameSubsectionId::ModuleName: {
         auto module_name =
             ReadModuleNameSubsection(subsection->data, module.ctx);
-        PrintF("  module name: %s\n", module_name.value_or(""));
+        out.PrintF("  module name: %s\n", module_name.value_or(""));
         break;
       }
 
       case NameSubsectionId::FunctionNames: {
         auto function_names_subsection =
             ReadFunctionNamesSubsection(subsection->data, module.ctx);
-        PrintF("  function names[%d]:\n",
-              function_names_subsection.count.value_or(0));
+        out.PrintF("  function names[%d]:\n",
+                   function_names_subsection.count.value_or(0));
         for (auto name_assoc : enumerate(function_names_subsection.sequence)) {
-          PrintF("   - [%d]: func[%d] name=\"%s\"\n", name_assoc.index,
-                 name_assoc.value->index, name_assoc.value->name);
+          out.PrintF("   - [%d]: func[%d] name=\"%s\"\n", name_assoc.index,
+                     name_assoc.value->index, name_assoc.value->name);
         }
         break;
       }
@@ -820,16 +843,18 @@ void Tool::DoNameSection(Pass pass,
       case NameSubsectionId::LocalNames: {
         auto local_names_subsection =
             ReadLocalNamesSubsection(subsection->data, module.ctx);
-        PrintF("  local names[%d]:\n", local_names_subsection.count.value_or(0));
+        out.PrintF("  local names[%d]:\n",
+                   local_names_subsection.count.value_or(0));
         for (auto indirect_name_assoc :
              enumerate(local_names_subsection.sequence)) {
-          PrintF("   - [%d]: func[%d] count=%d\n", indirect_name_assoc.index,
-                 indirect_name_assoc.value->index,
-                 indirect_name_assoc.value->name_map.size());
+          out.PrintF("   - [%d]: func[%d] count=%d\n",
+                     indirect_name_assoc.index,
+                     indirect_name_assoc.value->index,
+                     indirect_name_assoc.value->name_map.size());
           for (auto name_assoc :
                enumerate(indirect_name_assoc.value->name_map)) {
-            PrintF("     - [%d]: local[%d] name=\"%s\"\n", name_assoc.index,
-                   name_assoc.value->index, name_assoc.value->name);
+            out.PrintF("     - [%d]: local[%d] name=\"%s\"\n", name_assoc.index,
+                       name_assoc.value->index, name_assoc.value->name);
           }
         }
         break;
@@ -847,12 +872,12 @@ void Tool::DoLinkingSection(Pass pass,
         if (ShouldPrintDetails(pass)) {
           auto segment_infos =
               ReadSegmentInfoSubsection(subsection->data, module.ctx);
-          PrintF(" - segment info [count=%d]\n",
-                 segment_infos.count.value_or(0));
+          out.PrintF(" - segment info [count=%d]\n",
+                     segment_infos.count.value_or(0));
           for (auto segment_info : enumerate(segment_infos.sequence)) {
-            PrintF("  - %d: %s p2align=%d flags=%#x\n", segment_info.index,
-                   segment_info.value->name, segment_info.value->align_log2,
-                   segment_info.value->flags);
+            out.PrintF("  - %d: %s p2align=%d flags=%#x\n", segment_info.index,
+                       segment_info.value->name, segment_info.value->align_log2,
+                       segment_info.value->flags);
           }
         }
         break;
@@ -862,11 +887,11 @@ void Tool::DoLinkingSection(Pass pass,
         if (ShouldPrintDetails(pass)) {
           auto init_functions =
               ReadInitFunctionsSubsection(subsection->data, module.ctx);
-          PrintF(" - init functions [count=%d]\n",
-                init_functions.count.value_or(0));
+          out.PrintF(" - init functions [count=%d]\n",
+                     init_functions.count.value_or(0));
           for (auto init_function : init_functions.sequence) {
-            PrintF("  - %d: priority=%d\n", init_function->index,
-                  init_function->priority);
+            out.PrintF("  - %d: priority=%d\n", init_function->index,
+                       init_function->priority);
           }
         }
         break;
@@ -875,14 +900,14 @@ void Tool::DoLinkingSection(Pass pass,
       case LinkingSubsectionId::ComdatInfo: {
         if (ShouldPrintDetails(pass)) {
           auto comdats = ReadComdatSubsection(subsection->data, module.ctx);
-          PrintF(" - comdat [count=%d]\n", comdats.count.value_or(0));
+          out.PrintF(" - comdat [count=%d]\n", comdats.count.value_or(0));
           for (auto comdat : enumerate(comdats.sequence)) {
-            PrintF("  - %d: \"%s\" flags=%#x [count=%d]\n", comdat.index,
-                   comdat.value->name, comdat.value->flags,
-                   comdat.value->symbols.size());
+            out.PrintF("  - %d: \"%s\" flags=%#x [count=%d]\n", comdat.index,
+                       comdat.value->name, comdat.value->flags,
+                       comdat.value->symbols.size());
             for (auto symbol : enumerate(comdat.value->symbols)) {
-              PrintF("   - %d: %s index=%d\n", symbol.index,
-                     concat(symbol.value->kind), symbol.value->index);
+              out.PrintF("   - %d: %s index=%d\n", symbol.index,
+                         concat(symbol.value->kind), symbol.value->index);
             }
           }
         }
@@ -893,34 +918,34 @@ void Tool::DoLinkingSection(Pass pass,
         if (ShouldPrintDetails(pass)) {
           auto print_symbol_flags = [&](SymbolInfo::Flags flags) {
             if (flags.undefined == SymbolInfo::Flags::Undefined::Yes) {
-              PrintF(" %s", concat(flags.undefined));
+              out.PrintF(" %s", concat(flags.undefined));
             }
-            PrintF(" binding=%s vis=%s", concat(flags.binding),
-                   concat(flags.visibility));
+            out.PrintF(" binding=%s vis=%s", concat(flags.binding),
+                       concat(flags.visibility));
             if (flags.explicit_name == SymbolInfo::Flags::ExplicitName::Yes) {
-              PrintF(" %s", concat(flags.explicit_name));
+              out.PrintF(" %s", concat(flags.explicit_name));
             }
           };
 
           auto symbol_table =
               ReadSymbolTableSubsection(subsection->data, module.ctx);
-          PrintF(" - symbol table [count=%d]\n",
-                symbol_table.count.value_or(0));
+          out.PrintF(" - symbol table [count=%d]\n",
+                     symbol_table.count.value_or(0));
           for (auto symbol : enumerate(symbol_table.sequence)) {
             switch (symbol.value->kind()) {
               case SymbolInfoKind::Function: {
                 const auto& base = symbol.value->base();
-                PrintF("  - %d: F <%s> func=%d", symbol.index,
-                       base.name.value_or(
-                           GetFunctionName(base.index).value_or("")),
-                       base.index);
+                out.PrintF("  - %d: F <%s> func=%d", symbol.index,
+                           base.name.value_or(
+                               GetFunctionName(base.index).value_or("")),
+                           base.index);
                 print_symbol_flags(symbol.value->flags);
                 break;
               }
 
               case SymbolInfoKind::Global: {
                 const auto& base = symbol.value->base();
-                PrintF(
+                out.PrintF(
                     "  - %d: G <%s> global=%d", symbol.index,
                     base.name.value_or(GetGlobalName(base.index).value_or("")),
                     base.index);
@@ -931,18 +956,19 @@ void Tool::DoLinkingSection(Pass pass,
               case SymbolInfoKind::Event: {
                 const auto& base = symbol.value->base();
                 // TODO GetEventName.
-                PrintF("  - %d: E <%s> event=%d", symbol.index,
-                       base.name.value_or(""_sv), base.index);
+                out.PrintF("  - %d: E <%s> event=%d", symbol.index,
+                           base.name.value_or(""_sv), base.index);
                 print_symbol_flags(symbol.value->flags);
                 break;
               }
 
               case SymbolInfoKind::Data: {
                 const auto& data = symbol.value->data();
-                PrintF("  - %d: D <%s>", symbol.index, data.name);
+                out.PrintF("  - %d: D <%s>", symbol.index, data.name);
                 if (data.defined) {
-                  PrintF(" segment=%d offset=%d size=%d", data.defined->index,
-                        data.defined->offset, data.defined->size);
+                  out.PrintF(" segment=%d offset=%d size=%d",
+                             data.defined->index, data.defined->offset,
+                             data.defined->size);
                 }
                 print_symbol_flags(symbol.value->flags);
                 break;
@@ -950,14 +976,14 @@ void Tool::DoLinkingSection(Pass pass,
 
               case SymbolInfoKind::Section: {
                 auto section_index = symbol.value->section().section;
-                PrintF("  - %d: S <%s> section=%d", symbol.index,
-                      GetSectionName(section_index).value_or(""),
-                      section_index);
+                out.PrintF("  - %d: S <%s> section=%d", symbol.index,
+                           GetSectionName(section_index).value_or(""),
+                           section_index);
                 print_symbol_flags(symbol.value->flags);
                 break;
               }
             }
-            PrintF("\n");
+            out.PrintF("\n");
           }
         }
         break;
@@ -983,25 +1009,25 @@ void Tool::DoRelocationSection(Pass pass,
       total_offset += start->second;
     }
     if (ShouldPrintDetails(pass)) {
-      PrintF("   - %18s offset=%#08x(file=%#08x) ", concat(entry->type),
-             entry->offset, total_offset);
+      out.PrintF("   - %18s offset=%#08x(file=%#08x) ", concat(entry->type),
+                 entry->offset, total_offset);
       if (entry->type == RelocationType::TypeIndexLEB) {
-        PrintF("type=%d", entry->index);
+        out.PrintF("type=%d", entry->index);
       } else {
-        PrintF("symbol=%d <%s>", entry->index,
-              GetSymbolName(entry->index).value_or(""));
+        out.PrintF("symbol=%d <%s>", entry->index,
+                   GetSymbolName(entry->index).value_or(""));
       }
       if (entry->addend && *entry->addend != 0) {
-        PrintF("%+#x", *entry->addend);
+        out.PrintF("%+#x", *entry->addend);
       }
-      PrintF("\n");
+      out.PrintF("\n");
     }
   }
 }
 
 void Tool::DoCount(Pass pass, optional<Index> count) {
   if (pass == Pass::Headers) {
-    PrintF("count: %d\n", count.value_or(0));
+    out.PrintF("count: %d\n", count.value_or(0));
   } else {
     PrintDetails(pass, absl::ParsedFormat<'d'>("[%d]:\n"), count.value_or(0));
   }
@@ -1009,7 +1035,7 @@ void Tool::DoCount(Pass pass, optional<Index> count) {
 
 void Tool::Disassemble(SectionIndex section_index,
                        Index func_index,
-                       Code code) {
+                       CodeView code) {
   PrintFunctionHeader(func_index, code);
   int indent = 0;
   auto section_start = section_starts[section_index];
@@ -1017,8 +1043,12 @@ void Tool::Disassemble(SectionIndex section_index,
     return file_offset(data) - section_start;
   };
   auto last_data = code.body->data;
-  auto relocs =
-      GetRelocationEntries(section_index).value_or(RelocationEntries{});
+  // Find the first relocation in this function, then advance past the
+  // relocations for each instruction as it is printed.
+  span<const RelocationEntry> relocs;
+  if (auto* entries = GetRelocationEntries(section_index)) {
+    relocs = *entries;
+  }
   auto reloc_it =
       std::lower_bound(relocs.begin(), relocs.end(), section_offset(last_data),
                        [&](const RelocationEntry& lhs, size_t offset) {
@@ -1145,13 +1175,13 @@ optional<Index> Tool::GetI32Value(const ConstantExpression& expr) {
   return expr.instructions[0]->s32_immediate();
 }
 
-optional<Tool::RelocationEntries> Tool::GetRelocationEntries(
-    SectionIndex section_index) {
+auto Tool::GetRelocationEntries(SectionIndex section_index) const
+    -> const RelocationEntries* {
   auto it = section_relocations.find(section_index);
   if (it != section_relocations.end()) {
-    return it->second;
+    return &it->second;
   } else {
-    return nullopt;
+    return nullptr;
   }
 }
 
@@ -1162,19 +1192,19 @@ bool Tool::ShouldPrintDetails(Pass pass) const {
 template <typename Format, typename... Args>
 void Tool::PrintDetails(Pass pass, Format format, const Args&... args) {
   if (ShouldPrintDetails(pass)) {
-    PrintF(format, args...);
+    out.PrintF(format, args...);
   }
 }
 
 void Tool::PrintFunctionName(Index func_index) {
   if (auto name = GetFunctionName(func_index)) {
-    PrintF(" <%s>", *name);
+    out.PrintF(" <%s>", *name);
   }
 }
 
 void Tool::PrintGlobalName(Index func_index) {
   if (auto name = GetGlobalName(func_index)) {
-    PrintF(" <%s>", *name);
+    out.PrintF(" <%s>", *name);
   }
 }
 
@@ -1188,49 +1218,51 @@ void Tool::PrintMemory(SpanU8 start,
   while (!data.empty()) {
     auto line_size = std::min<size_t>(data.size(), octets_per_line);
     const SpanU8 line = data.subspan(0, line_size);
-    PrintF("%s", prefix);
-    PrintF("%07x: ", (line.begin() - start.begin()) + offset);
+    out.Write(prefix);
+    out.WriteHex((line.begin() - start.begin()) + offset, 7);
+    out.Write(": ");
     for (int i = 0; i < octets_per_line;) {
       for (int j = 0; j < octets_per_group; ++j, ++i) {
         if (i < static_cast<int>(line_size)) {
-          PrintF("%02x", line[i]);
+          out.WriteHexByte(line[i]);
         } else {
-          PrintF("  ");
+          out.WriteSpaces(2);
         }
       }
-      PrintF(" ");
+      out.Write(' ');
     }
 
     if (print_chars == PrintChars::Yes) {
-      PrintF(" ");
+      out.Write(' ');
       for (int c : line) {
-        PrintF("%c", isprint(c) ? static_cast<char>(c) : '.');
+        out.Write(isprint(c) ? static_cast<char>(c) : '.');
       }
     }
-    PrintF("\n");
+    out.Write('\n');
     data.remove_prefix(line_size);
   }
 }
 
-void Tool::PrintFunctionHeader(Index func_index, Code code) {
+void Tool::PrintFunctionHeader(Index func_index, CodeView code) {
   auto func_type = GetFunctionType(func_index);
   size_t param_count = 0;
-  PrintF("func[%d]", func_index);
+  out.PrintF("func[%d]", func_index);
   PrintFunctionName(func_index);
-  PrintF(":");
+  out.PrintF(":");
   if (func_type) {
-    PrintF(" %s\n", concat(*func_type));
+    out.PrintF(" %s\n", concat(*func_type));
     param_count = func_type->param_types.size();
   } else {
-    PrintF("\n");
+    out.PrintF("\n");
   }
   size_t local_count = param_count;
-  for (auto locals : code.locals) {
-    PrintF(" %*s | locals[%d", 7 + max_octets_per_line * 3, "", local_count);
+  for (auto locals : ReadLocals(code, module.ctx).sequence) {
+    out.PrintF(" %*s | locals[%d", 7 + max_octets_per_line * 3, "",
+               local_count);
     if (locals->count != 1) {
-      PrintF("..%d", local_count + locals->count - 1);
+      out.PrintF("..%d", local_count + locals->count - 1);
     }
-    PrintF("] type=%s\n", concat(locals->type));
+    out.PrintF("] type=%s\n", concat(locals->type));
     local_count += locals->count;
   }
 }
@@ -1241,18 +1273,24 @@ void Tool::PrintInstruction(const Instruction& instr,
                             int indent) {
   bool first_line = true;
   while (data.begin() < post_data.begin()) {
-    PrintF(" %06x:", file_offset(data));
+    out.Write(' ');
+    out.WriteHex(file_offset(data), 6);
+    out.Write(':');
     int line_octets =
         std::min<int>(max_octets_per_line,
                       static_cast<int>(post_data.begin() - data.begin()));
     for (int i = 0; i < line_octets; ++i) {
-      PrintF(" %02x", data[i]);
+      out.Write(' ');
+      out.WriteHexByte(data[i]);
     }
     data.remove_prefix(line_octets);
-    PrintF("%*s |", (max_octets_per_line - line_octets) * 3, "");
+    out.WriteSpaces((max_octets_per_line - line_octets) * 3);
+    out.Write(" |");
     if (first_line) {
       first_line = false;
-      PrintF(" %*s%s", indent, "", concat(instr));
+      out.Write(' ');
+      out.WriteSpaces(indent);
+      out.Write(concat(instr));
 
       if (instr.opcode == Opcode::Call) {
         PrintFunctionName(instr.index_immediate());
@@ -1264,25 +1302,25 @@ void Tool::PrintInstruction(const Instruction& instr,
         if (block_type->is_index()) {
           auto defined_type_opt = GetDefinedType(block_type->index());
           if (defined_type_opt) {
-            PrintF(" <%s>", concat(defined_type_opt->type));
+            out.PrintF(" <%s>", concat(defined_type_opt->type));
           }
         }
       }
     }
-    PrintF("\n");
+    out.PrintF("\n");
   }
 }
 
 void Tool::PrintRelocation(const RelocationEntry& entry, size_t file_offset) {
-  PrintF("           %06x: %18s %d", file_offset, concat(entry.type),
-         entry.index);
+  out.PrintF("           %06x: %18s %d", file_offset, concat(entry.type),
+             entry.index);
   if (entry.addend && *entry.addend) {
-    PrintF(" %+d", *entry.addend);
+    out.PrintF(" %+d", *entry.addend);
   }
   if (entry.type != RelocationType::TypeIndexLEB) {
-    PrintF(" <%s>", GetSymbolName(entry.index).value_or(""));
+    out.PrintF(" <%s>", GetSymbolName(entry.index).value_or(""));
   }
-  PrintF("\n");
+  out.PrintF("\n");
 }
 
 size_t Tool::file_offset(SpanU8 data) {
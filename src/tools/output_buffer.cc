@@ -0,0 +1,77 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/tools/output_buffer.h"
+
+namespace wasp::tools {
+
+namespace {
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+}  // namespace
+
+#define WASP_HEX_ROW(hi)                                               \
+  #hi "0" #hi "1" #hi "2" #hi "3" #hi "4" #hi "5" #hi "6" #hi "7" #hi \
+      "8" #hi "9" #hi "a" #hi "b" #hi "c" #hi "d" #hi "e" #hi "f"
+
+const char OutputBuffer::kHexBytes[] =
+    WASP_HEX_ROW(0) WASP_HEX_ROW(1) WASP_HEX_ROW(2) WASP_HEX_ROW(3)
+    WASP_HEX_ROW(4) WASP_HEX_ROW(5) WASP_HEX_ROW(6) WASP_HEX_ROW(7)
+    WASP_HEX_ROW(8) WASP_HEX_ROW(9) WASP_HEX_ROW(a) WASP_HEX_ROW(b)
+    WASP_HEX_ROW(c) WASP_HEX_ROW(d) WASP_HEX_ROW(e) WASP_HEX_ROW(f);
+
+#undef WASP_HEX_ROW
+
+OutputBuffer::OutputBuffer(std::FILE* file) : file_{file} {
+  buffer_.reserve(kFlushSize * 2);
+}
+
+OutputBuffer::~OutputBuffer() {
+  Flush();
+}
+
+void OutputBuffer::WriteSpaces(int count) {
+  if (count > 0) {
+    buffer_.append(count, ' ');
+    MaybeFlush();
+  }
+}
+
+void OutputBuffer::WriteHex(u64 value, int width) {
+  char digits[16];
+  int size = 0;
+  do {
+    digits[size++] = kHexDigits[value & 0xf];
+    value >>= 4;
+  } while (value != 0);
+  if (width > size) {
+    buffer_.append(width - size, '0');
+  }
+  while (size > 0) {
+    buffer_ += digits[--size];
+  }
+  MaybeFlush();
+}
+
+void OutputBuffer::Flush() {
+  if (!buffer_.empty()) {
+    std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+    buffer_.clear();
+  }
+}
+
+}  // namespace wasp::tools
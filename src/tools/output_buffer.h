@@ -0,0 +1,86 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef SRC_TOOLS_OUTPUT_BUFFER_H_
+#define SRC_TOOLS_OUTPUT_BUFFER_H_
+
+#include <cstdio>
+#include <string>
+
+#include "absl/strings/str_format.h"
+
+#include "wasp/base/string_view.h"
+#include "wasp/base/types.h"
+
+namespace wasp::tools {
+
+// Collects output and writes it to a file in large blocks, instead of making
+// a stdio call for every piece of output. Also provides unformatted writes
+// (including hex) for output that is produced a few characters at a time.
+class OutputBuffer {
+ public:
+  explicit OutputBuffer(std::FILE* file = stdout);
+  OutputBuffer(const OutputBuffer&) = delete;
+  OutputBuffer& operator=(const OutputBuffer&) = delete;
+  ~OutputBuffer();
+
+  template <typename... Args>
+  void PrintF(const absl::FormatSpec<Args...>& format, const Args&... args) {
+    absl::StrAppendFormat(&buffer_, format, args...);
+    MaybeFlush();
+  }
+
+  void Write(char c) {
+    buffer_ += c;
+    MaybeFlush();
+  }
+
+  void Write(string_view s) {
+    buffer_.append(s.data(), s.size());
+    MaybeFlush();
+  }
+
+  void WriteSpaces(int count);
+
+  // Same as PrintF("%02x", value).
+  void WriteHexByte(u8 value) {
+    buffer_.append(&kHexBytes[value * 2], 2);
+    MaybeFlush();
+  }
+
+  // Same as PrintF("%0*x", width, value).
+  void WriteHex(u64 value, int width);
+
+  // Writes all buffered output to the file.
+  void Flush();
+
+ private:
+  static constexpr size_t kFlushSize = 64 * 1024;
+  static const char kHexBytes[];
+
+  void MaybeFlush() {
+    if (buffer_.size() >= kFlushSize) {
+      Flush();
+    }
+  }
+
+  std::FILE* file_;
+  std::string buffer_;
+};
+
+}  // namespace wasp::tools
+
+#endif  // SRC_TOOLS_OUTPUT_BUFFER_H_
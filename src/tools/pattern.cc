@@ -19,8 +19,9 @@
 #include <fstream>
 #include <functional>
 #include <iostream>
-#include <map>
+#include <iterator>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/str_format.h"
@@ -35,19 +36,23 @@
 #include "wasp/base/hash.h"
 #include "wasp/base/hashmap.h"
 #include "wasp/base/optional.h"
+#include "wasp/base/parallel.h"
 #include "wasp/base/str_to_u32.h"
 #include "wasp/base/string_view.h"
 #include "wasp/base/types.h"
 #include "wasp/binary/formatters.h"
 #include "wasp/binary/lazy_expression.h"
 #include "wasp/binary/lazy_module.h"
+#include "wasp/binary/sequence_range.h"
 #include "wasp/binary/visitor.h"
+#include "wasp/binary/write.h"
 
 namespace wasp {
 namespace tools {
 namespace pattern {
 
-const size_t kMaxPatternSize = 5;
+const u32 kDefaultMaxPatternSize = 5;
+const u32 kMaxPatternSizeLimit = 64;
 
 using absl::PrintF;
 using absl::Format;
@@ -56,11 +61,67 @@ using namespace ::wasp::binary;
 
 using Instructions = std::vector<Instruction>;
 
+// Each distinct instruction is interned to a dense ID, so patterns are just
+// sequences of IDs. Instructions are keyed by their canonical encoding rather
+// than the bytes in the module, so e.g. an index encoded with a padded LEB128
+// gets the same ID as the minimal encoding.
+using InstrId = u32;
+
 struct Options {
   Features features;
   string_view function;
   string_view output_filename;
   u32 max = 10;
+  u32 max_length = kDefaultMaxPatternSize;
+  u32 threads = 0;
+};
+
+// A sequence of `length` instruction IDs. `ids` points into the ID stream of
+// one of the shards, which outlives all patterns. `hash` is the rolling hash
+// of the IDs, so hashing a pattern never has to touch the IDs themselves.
+struct Pattern {
+  const InstrId* ids;
+  u32 length;
+  u64 hash;
+
+  friend bool operator==(const Pattern& lhs, const Pattern& rhs) {
+    return lhs.hash == rhs.hash && lhs.length == rhs.length &&
+           std::equal(lhs.ids, lhs.ids + lhs.length, rhs.ids);
+  }
+
+  template <typename H>
+  friend H AbslHashValue(H h, const Pattern& pattern) {
+    return H::combine(std::move(h), pattern.hash);
+  }
+};
+
+using PatternMap = flat_hash_map<Pattern, u64>;
+
+// All of the state for one contiguous range of function bodies. Each shard is
+// only touched by one thread at a time.
+struct Shard {
+  explicit Shard(SpanU8 data);
+
+  void Decode(const SequenceRange& codes, const ReadCtx& module_ctx);
+  void Remap(const std::vector<InstrId>& global_ids);
+  void Count(u32 max_length, u32 partition_count);
+
+  BinaryErrors errors;
+
+  // Shard-local interning; remapped to global IDs after all shards have
+  // finished decoding. `raw_ids` is keyed by the bytes in the module, so an
+  // instruction is only re-encoded the first time those bytes are seen.
+  flat_hash_map<string_view, InstrId> raw_ids;
+  flat_hash_map<std::string, InstrId> local_ids;
+  std::vector<Instruction> local_instrs;
+
+  // The IDs of every instruction in every body of this shard, and the offset
+  // one past the last instruction of each body.
+  std::vector<InstrId> ids;
+  std::vector<size_t> body_ends;
+
+  // Pattern counts, partitioned by hash so they can be merged in parallel.
+  std::vector<PatternMap> partitions;
 };
 
 struct Tool {
@@ -73,16 +134,24 @@ struct Tool {
 
     visit::Result OnSection(At<Section>);
     visit::Result BeginCodeSection(LazyCodeSection);
-    visit::Result BeginCode(const At<Code>&);
 
     Tool& tool;
   };
 
+  void Intern();
+
   BinaryErrors errors;
   Options options;
   LazyModule module;
 
-  flat_hash_map<Instructions, u64> patterns;
+  u32 thread_count;
+  SequenceRangeList code_ranges;
+  std::vector<Shard> shards;
+
+  // Global interning, built by merging the shards' tables in order.
+  flat_hash_map<std::string, InstrId> instr_ids;
+  std::vector<Instruction> instrs;
+
   u64 total_instructions = 0;
 };
 
@@ -99,6 +168,14 @@ int Main(span<const string_view> args) {
            [&](string_view arg) { options.output_filename = arg; })
       .Add('d', "--display", "<int>", "maximum to display",
            [&](string_view arg) { options.max = StrToU32(arg).value_or(10); })
+      .Add('l', "--max-length", "<int>", "maximum pattern length",
+           [&](string_view arg) {
+             options.max_length =
+                 StrToU32(arg).value_or(kDefaultMaxPatternSize);
+           })
+      .Add('j', "--jobs", "<int>",
+           "number of threads to use (default: all cores)",
+           [&](string_view arg) { options.threads = StrToU32(arg).value_or(0); })
       .Add("<filename>", "input wasm file", [&](string_view arg) {
         if (filename.empty()) {
           filename = arg;
@@ -113,6 +190,12 @@ int Main(span<const string_view> args) {
     parser.PrintHelpAndExit(1);
   }
 
+  if (options.max_length < 2 || options.max_length > kMaxPatternSizeLimit) {
+    Format(&std::cerr, "Maximum pattern length must be between 2 and %d.\n",
+           kMaxPatternSizeLimit);
+    return 1;
+  }
+
   auto optbuf = ReadFile(filename);
   if (!optbuf) {
     Format(&std::cerr, "Error reading file %s.\n", filename);
@@ -124,29 +207,147 @@ int Main(span<const string_view> args) {
 
   int result = tool.Run();
   tool.errors.PrintTo(std::cerr);
+  for (auto& shard : tool.shards) {
+    shard.errors.PrintTo(std::cerr);
+  }
   return result;
 }
 
+// Sets `key` to the canonical encoding of `instr`, for interning.
+void EncodeKey(const Instruction& instr, std::string& key) {
+  key.clear();
+  Write(instr, std::back_inserter(key));
+}
+
+Shard::Shard(SpanU8 data) : errors{data} {}
+
+void Shard::Decode(const SequenceRange& codes, const ReadCtx& module_ctx) {
+  ReadCtx ctx{module_ctx.features, errors};
+  ctx.declared_data_count = module_ctx.declared_data_count;
+  std::string key;
+  for (const auto& code : ReadSequenceRange<CodeView>(codes, ctx)) {
+    for (const auto& instr : ReadExpression(code->body, ctx)) {
+      auto [raw_iter, raw_inserted] =
+          raw_ids.try_emplace(ToStringView(instr.loc()), 0);
+      if (raw_inserted) {
+        EncodeKey(*instr, key);
+        auto [iter, inserted] = local_ids.try_emplace(
+            key, static_cast<InstrId>(local_instrs.size()));
+        if (inserted) {
+          local_instrs.push_back(*instr);
+        }
+        raw_iter->second = iter->second;
+      }
+      ids.push_back(raw_iter->second);
+    }
+    body_ends.push_back(ids.size());
+  }
+}
+
+void Shard::Remap(const std::vector<InstrId>& global_ids) {
+  for (auto& id : ids) {
+    id = global_ids[id];
+  }
+}
+
+void Shard::Count(u32 max_length, u32 partition_count) {
+  // Polynomial rolling hash over the IDs; each step extends the previous
+  // pattern by one instruction, so every n-gram costs O(1) to hash.
+  const u64 kMultiplier = 0x100000001b3ull;
+  const u64 kSeed = 0xcbf29ce484222325ull;
+
+  partitions.resize(partition_count);
+  size_t body_begin = 0;
+  for (auto body_end : body_ends) {
+    for (size_t start = body_begin; start + 1 < body_end; ++start) {
+      size_t end = std::min<size_t>(body_end, start + max_length);
+      u64 hash = (kSeed ^ ids[start]) * kMultiplier;
+      for (size_t i = start + 1; i < end; ++i) {
+        hash = (hash ^ ids[i]) * kMultiplier;
+        Pattern pattern{&ids[start], static_cast<u32>(i - start + 1), hash};
+        ++partitions[(hash >> 32) % partition_count][pattern];
+      }
+    }
+    body_begin = body_end;
+  }
+}
+
 Tool::Tool(SpanU8 data, Options options)
     : errors{data},
       options{options},
-      module{ReadLazyModule(data, options.features, errors)} {}
+      module{ReadLazyModule(data, options.features, errors)},
+      thread_count{GetThreadCount(options.threads)} {}
 
 int Tool::Run() {
   Visitor visitor{*this};
   visit::Visit(module, visitor);
 
-  using pair = std::pair<Instructions, u64>;
-  std::vector<pair> sorted(options.max);
-  std::partial_sort_copy(
-      patterns.begin(), patterns.end(), sorted.begin(), sorted.end(),
-      [](const pair& lhs, const pair& rhs) { return lhs.second > rhs.second; });
-
-  for (const auto& pattern : sorted) {
-    if (pattern.second > 1) {
-      u64 pattern_instructions = u64(pattern.first.size()) * pattern.second;
-      PrintF("%d: [%d] %s %.2f%%\n", pattern.second, pattern.first.size(),
-             concat(pattern.first),
+  // Each shard decodes one contiguous range of the code section. There is
+  // always at least one shard, since the partitions are merged into the first.
+  if (code_ranges.empty()) {
+    code_ranges.push_back(SequenceRange{});
+  }
+  const size_t shard_count = code_ranges.size();
+  shards.reserve(shard_count);
+  for (size_t i = 0; i < shard_count; ++i) {
+    shards.emplace_back(module.data);
+  }
+
+  ParallelFor(shard_count, thread_count, [&](u32, size_t i) {
+    shards[i].Decode(code_ranges[i], module.ctx);
+  });
+
+  Intern();
+
+  ParallelFor(shard_count, thread_count, [&](u32, size_t i) {
+    shards[i].Count(options.max_length, thread_count);
+  });
+
+  // Merge each partition across all shards, and keep only the top entries of
+  // each partition.
+  using pair = std::pair<Pattern, u64>;
+  auto compare = [](const pair& lhs, const pair& rhs) {
+    if (lhs.second != rhs.second) {
+      return lhs.second > rhs.second;
+    }
+    return std::lexicographical_compare(lhs.first.ids,
+                                        lhs.first.ids + lhs.first.length,
+                                        rhs.first.ids,
+                                        rhs.first.ids + rhs.first.length);
+  };
+
+  std::vector<std::vector<pair>> tops(thread_count);
+  ParallelFor(thread_count, thread_count, [&](u32, size_t p) {
+    PatternMap& merged = shards[0].partitions[p];
+    for (size_t i = 1; i < shard_count; ++i) {
+      for (const auto& [pattern, count] : shards[i].partitions[p]) {
+        merged[pattern] += count;
+      }
+      shards[i].partitions[p].clear();
+    }
+
+    tops[p].resize(std::min<size_t>(options.max, merged.size()));
+    std::partial_sort_copy(merged.begin(), merged.end(), tops[p].begin(),
+                           tops[p].end(), compare);
+  });
+
+  std::vector<pair> candidates;
+  for (const auto& top : tops) {
+    candidates.insert(candidates.end(), top.begin(), top.end());
+  }
+  std::vector<pair> sorted(std::min<size_t>(options.max, candidates.size()));
+  std::partial_sort_copy(candidates.begin(), candidates.end(), sorted.begin(),
+                         sorted.end(), compare);
+
+  for (const auto& [pattern, count] : sorted) {
+    if (count > 1) {
+      Instructions instructions;
+      for (u32 i = 0; i < pattern.length; ++i) {
+        instructions.push_back(instrs[pattern.ids[i]]);
+      }
+      u64 pattern_instructions = u64(pattern.length) * count;
+      PrintF("%d: [%d] %s %.2f%%\n", count, pattern.length,
+             concat(instructions),
              100.0 * pattern_instructions / total_instructions);
     }
   }
@@ -154,6 +355,32 @@ int Tool::Run() {
   return 0;
 }
 
+void Tool::Intern() {
+  std::vector<std::vector<InstrId>> global_ids(shards.size());
+  std::string key;
+  for (auto&& [i, shard] : enumerate(shards)) {
+    for (const auto& instr : shard.local_instrs) {
+      EncodeKey(instr, key);
+      auto [iter, inserted] =
+          instr_ids.try_emplace(key, static_cast<InstrId>(instrs.size()));
+      if (inserted) {
+        instrs.push_back(instr);
+      }
+      // Local IDs are assigned in order, so this is indexed by local ID.
+      global_ids[i].push_back(iter->second);
+    }
+    total_instructions += shard.ids.size();
+  }
+
+  ParallelFor(shards.size(), thread_count,
+              [&](u32, size_t i) {
+                shards[i].Remap(global_ids[i]);
+                shards[i].raw_ids.clear();
+                shards[i].local_ids.clear();
+                shards[i].local_instrs.clear();
+              });
+}
+
 Tool::Visitor::Visitor(Tool& tool) : tool{tool} {}
 
 visit::Result Tool::Visitor::OnSection(At<Section> section) {
@@ -161,41 +388,10 @@ visit::Result Tool::Visitor::OnSection(At<Section> section) {
                                           : visit::Result::Skip;
 }
 
-visit::Result Tool::Visitor::BeginCodeSection(LazyCodeSection) {
-  return visit::Result::Ok;
-}
-
-visit::Result Tool::Visitor::BeginCode(const At<Code>& code) {
-  Instructions instructions;
-
-  auto instrs = ReadExpression(code->body, tool.module.ctx);
-  for (auto it = instrs.begin(), end = instrs.end(); it != end; ++it) {
-    auto instr = *it;
-#if 0
-    // Make all offsets and indexes 0.
-    if (instr.has_mem_arg_immediate()) {
-      instr.mem_arg_immediate().offset = 0;
-    } else if (instr.has_index_immediate()) {
-      instr.index_immediate() = 0;
-    }
-#endif
-
-    instructions.push_back(instr);
-
-    if (instructions.size() > kMaxPatternSize) {
-      instructions.erase(instructions.begin());
-    }
-    if (instructions.size() > 1) {
-      Instructions slice;
-      slice.push_back(instructions[0]);
-      for (size_t i = 1; i < instructions.size(); ++i) {
-        slice.push_back(instructions[i]);
-        ++tool.patterns[slice];
-      }
-    }
-    ++tool.total_instructions;
-  }
-  // Skip iterating over instructions.
+visit::Result Tool::Visitor::BeginCodeSection(LazyCodeSection section) {
+  // Only find the function boundaries here; the bodies are decoded in
+  // parallel later.
+  tool.code_ranges = SplitSequence(section.sequence, tool.thread_count);
   return visit::Result::Skip;
 }
 
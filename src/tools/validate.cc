@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <array>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -37,6 +38,7 @@
 #include "wasp/binary/formatters.h"
 #include "wasp/valid/valid_ctx.h"
 #include "wasp/valid/validate_visitor.h"
+#include "wasp/valid/validation_cache.h"
 
 namespace wasp {
 namespace tools {
@@ -47,13 +49,19 @@ using absl::PrintF;
 
 using namespace ::wasp::binary;
 
+namespace fs = std::filesystem;
+
 struct Options {
   Features features;
   bool verbose = false;
+  string_view cache_dir;
 };
 
 struct Tool {
-  explicit Tool(string_view filename, SpanU8 data, Options);
+  explicit Tool(string_view filename,
+                SpanU8 data,
+                Options,
+                valid::ValidationCache* cache = nullptr);
 
   bool Run();
 
@@ -63,6 +71,7 @@ struct Tool {
   BinaryErrors errors;
   LazyModule module;
   valid::ValidateVisitor visitor;
+  valid::ValidationCache* cache;
 };
 
 int Main(span<const string_view> args) {
@@ -75,6 +84,10 @@ int Main(span<const string_view> args) {
            [&]() { parser.PrintHelpAndExit(0); })
       .Add('v', "--verbose", "print filename and whether it was valid",
            [&]() { options.verbose = true; })
+      .Add("--cache-dir", "<dir>",
+           "skip modules and functions that were already validated, using "
+           "the cache in <dir>",
+           [&](string_view arg) { options.cache_dir = arg; })
       .AddFeatureFlags(options.features)
       .Add("<filenames...>", "input wasm files",
            [&](string_view arg) { filenames.push_back(arg); });
@@ -85,6 +98,15 @@ int Main(span<const string_view> args) {
     parser.PrintHelpAndExit(1);
   }
 
+  optional<valid::ValidationCache> cache;
+  std::string cache_filename;
+  if (!options.cache_dir.empty()) {
+    cache_filename = (fs::path(options.cache_dir) / "validate.cache").string();
+    cache.emplace();
+    // A missing or unreadable cache is the same as an empty one.
+    cache->Load(cache_filename);
+  }
+
   bool ok = true;
   for (auto filename : filenames) {
     auto optbuf = ReadFile(filename);
@@ -95,7 +117,7 @@ int Main(span<const string_view> args) {
     }
 
     SpanU8 data{*optbuf};
-    Tool tool{filename, data, options};
+    Tool tool{filename, data, options, cache ? &*cache : nullptr};
     bool valid = tool.Run();
     if (!valid || options.verbose) {
       PrintF("[%4s] %s\n", valid ? " OK " : "FAIL", filename);
@@ -104,20 +126,38 @@ int Main(span<const string_view> args) {
     ok &= valid;
   }
 
+  if (cache && cache->modified()) {
+    std::error_code error;
+    fs::create_directories(options.cache_dir, error);
+    if (!cache->Save(cache_filename)) {
+      Format(&std::cerr, "Error writing cache file %s.\n", cache_filename);
+    }
+  }
+
   return ok ? 0 : 1;
 }
 
-Tool::Tool(string_view filename, SpanU8 data, Options options)
+Tool::Tool(string_view filename,
+           SpanU8 data,
+           Options options,
+           valid::ValidationCache* cache)
     : filename(filename),
       options{options},
       data{data},
       errors{data},
       module{ReadLazyModule(data, options.features, errors)},
-      visitor{options.features, errors} {}
+      visitor{options.features, errors},
+      cache{cache} {}
 
 bool Tool::Run() {
   if (module.magic && module.version) {
-    visit::Visit(module, visitor);
+    if (cache) {
+      valid::CachingValidateVisitor caching_visitor{options.features, errors,
+                                                    *cache};
+      visit::Visit(module, caching_visitor);
+    } else {
+      visit::Visit(module, visitor);
+    }
   }
   return !errors.HasError();
 }
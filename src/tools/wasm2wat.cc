@@ -28,6 +28,7 @@
 #include "wasp/base/file.h"
 #include "wasp/base/formatters.h"
 #include "wasp/base/span.h"
+#include "wasp/base/str_to_u32.h"
 #include "wasp/base/string_view.h"
 #include "wasp/binary/encoding.h"
 #include "wasp/binary/formatters.h"
@@ -53,6 +54,7 @@ using absl::Format;
 struct Options {
   Features features;
   bool validate = true;
+  u32 threads = 1;
   optional<std::string> output_filename;
 };
 
@@ -80,6 +82,9 @@ int Main(span<const string_view> args) {
            [&](string_view arg) { options.output_filename = arg; })
       .Add("--no-validate", "Don't validate before writing",
            [&]() { options.validate = false; })
+      .Add('j', "--jobs", "<int>",
+           "number of threads to use (0 means all cores, default 1)",
+           [&](string_view arg) { options.threads = StrToU32(arg).value_or(1); })
       .AddFeatureFlags(options.features)
       .Add("<filename>", "input wasm file", [&](string_view arg) {
         if (filename.empty()) {
@@ -118,7 +123,8 @@ Tool::Tool(string_view filename, SpanU8 data, Options options)
 int Tool::Run() {
   BinaryErrors errors{data};
   binary::ReadCtx read_context{options.features, errors};
-  auto binary_module = binary::ReadModule(data, read_context);
+  auto binary_module =
+      binary::ReadModule(data, read_context, options.threads);
   if (errors.HasError()) {
     errors.PrintTo(std::cerr);
     return 1;
@@ -17,17 +17,23 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 #include "absl/strings/str_format.h"
 
 #include "src/tools/argparser.h"
 #include "src/tools/text_errors.h"
+#include "wasp/base/arena.h"
 #include "wasp/base/buffer.h"
 #include "wasp/base/errors.h"
+#include "wasp/base/errors_buffer.h"
 #include "wasp/base/features.h"
 #include "wasp/base/file.h"
 #include "wasp/base/formatters.h"
+#include "wasp/base/parallel.h"
 #include "wasp/base/span.h"
+#include "wasp/base/str_to_u32.h"
 #include "wasp/base/string_view.h"
 #include "wasp/binary/encoding.h"
 #include "wasp/binary/formatters.h"
@@ -59,6 +65,7 @@ using absl::Format;
 struct Options {
   Features features;
   bool validate = true;
+  u32 threads = 1;
   std::string output_filename;
 };
 
@@ -86,6 +93,9 @@ int Main(span<const string_view> args) {
            [&](string_view arg) { options.output_filename = arg; })
       .Add("--no-validate", "Don't validate before writing",
            [&]() { options.validate = false; })
+      .Add('j', "--jobs", "<int>",
+           "number of threads to use (0 means all cores, default 1)",
+           [&](string_view arg) { options.threads = StrToU32(arg).value_or(1); })
       .AddFeatureFlags(options.features)
       .Add("<filename>", "input wasm file", [&](string_view arg) {
         if (filename.empty()) {
@@ -124,34 +134,65 @@ Tool::Tool(string_view filename, SpanU8 data, Options options)
 int Tool::Run() {
   text::Tokenizer tokenizer{data};
   tools::TextErrors errors{filename, data};
+  // The lists of the text module are allocated from an arena while it is
+  // read, which needs far fewer heap allocations (see ReadCtx::arena).
+  Arena arena;
   text::ReadCtx read_context{options.features, errors};
+  read_context.arena = &arena;
   auto text_module =
       ReadSingleModule(tokenizer, read_context).value_or(text::Module{});
   Expect(tokenizer, read_context, text::TokenType::Eof);
 
-  Resolve(text_module, errors);
-  Desugar(text_module);
+  u32 thread_count = GetThreadCount(options.threads);
+  Resolve(text_module, errors, thread_count);
 
   if (errors.HasError()) {
     errors.PrintTo(std::cerr);
     return 1;
   }
 
+  // Desugar without modifying the text module, so it is still available (as
+  // written) for diagnostics.
+  auto desugared = DesugarView(text_module);
   convert::BinCtx convert_context{options.features};
-  auto binary_module = convert::ToBinary(convert_context, text_module);
 
+  // Encode directly to bytes, so the binary module's function bodies are never
+  // all in memory at once. When validating, each function body is converted
+  // and validated just before it is written. Function bodies may be validated
+  // in parallel, so each thread has its own copy of the module context, and
+  // each body's errors are buffered and reported in order afterward.
+  valid::ValidCtx validate_context{options.features, errors};
+  std::vector<std::unique_ptr<valid::ValidCtx>> thread_contexts;
+  std::vector<ErrorsBuffer> code_errors;
+  convert::EncodeCallbacks callbacks;
   if (options.validate) {
-    valid::ValidCtx validate_context{options.features, errors};
-    Validate(validate_context, binary_module);
+    callbacks.on_module = [&](const binary::Module& module) {
+      Validate(validate_context, module);
+      for (u32 i = 0; i < thread_count; ++i) {
+        thread_contexts.push_back(
+            std::make_unique<valid::ValidCtx>(validate_context, errors));
+      }
+      code_errors.resize(module.functions.size());
+    };
+    callbacks.on_code = [&](u32 thread_index, Index code_index,
+                            const At<binary::UnpackedCode>& code) {
+      auto& thread_context = *thread_contexts[thread_index];
+      thread_context.errors = &code_errors[code_index];
+      thread_context.code_count = code_index;
+      Validate(thread_context, code);
+    };
+  }
 
-    if (errors.HasError()) {
-      errors.PrintTo(std::cerr);
-      return 1;
-    }
+  Buffer buffer = convert::ToBinaryBytes(convert_context, desugared, callbacks,
+                                         thread_count);
+  for (auto&& code_error : code_errors) {
+    code_error.ReplayTo(errors);
   }
 
-  Buffer buffer;
-  Write(binary_module, std::back_inserter(buffer));
+  if (errors.HasError()) {
+    errors.PrintTo(std::cerr);
+    return 1;
+  }
 
   std::ofstream fstream(options.output_filename,
                         std::ios_base::out | std::ios_base::binary);
@@ -22,21 +22,52 @@
 
 namespace wasp::valid {
 
-LocalMap::LocalMap() {
+LocalMap::LocalMap(Index dense_limit) : dense_limit_{dense_limit} {
   Reset();
 }
 
 void LocalMap::Reset() {
+  dense_ = true;
+  types_.clear();
+  let_starts_.clear();
+  let_starts_.push_back(0);
   pairs_.clear();
   let_stack_.clear();
   let_stack_.push_back(0);
 }
 
 auto LocalMap::GetCount() const -> Index {
+  if (dense_) {
+    return static_cast<Index>(types_.size());
+  }
   return pairs_.empty() ? 0 : pairs_.back().second;
 }
 
 auto LocalMap::GetType(Index index) const -> optional<binary::ValueType>{
+  if (dense_) {
+    if (index >= types_.size()) {
+      return nullopt;
+    }
+    if (let_starts_.size() == 1) {
+      return types_[index];
+    }
+
+    // The innermost let block's locals come first, so walk the blocks from
+    // the end of the array.
+    Index end = static_cast<Index>(types_.size());
+    for (auto iter = let_starts_.rbegin(); iter != let_starts_.rend();
+         ++iter) {
+      Index count = end - *iter;
+      if (index < count) {
+        return types_[*iter + index];
+      }
+      index -= count;
+      end = *iter;
+    }
+    assert(false);  // Checked against the count above.
+    return nullopt;
+  }
+
   struct Compare {
     bool operator()(const Pair& lhs, Index rhs) { return lhs.second < rhs; }
     bool operator()(Index lhs, const Pair& rhs) { return lhs < rhs.second; }
@@ -58,6 +89,18 @@ bool LocalMap::Append(Index count, binary::ValueType value_type) {
     return false;
   }
 
+  if (dense_ && u64{GetCount()} + count > dense_limit_) {
+    Compress();
+  }
+  if (dense_) {
+    types_.insert(types_.end(), count, value_type);
+  } else {
+    AppendCompressed(count, value_type);
+  }
+  return true;
+}
+
+void LocalMap::AppendCompressed(Index count, binary::ValueType value_type) {
   // Locals may be "appended" to the middle of the list, if we are currently in
   // a let block, e.g.
   //
@@ -95,7 +138,6 @@ bool LocalMap::Append(Index count, binary::ValueType value_type) {
   }
 
   AdjustPartialSums(pairs_.begin() + let_stack_.back(), count);
-  return true;
 }
 
 bool LocalMap::Append(const binary::ValueTypeList& value_types) {
@@ -124,11 +166,51 @@ void LocalMap::AdjustPartialSums(Pairs::iterator first, Index count) {
   }
 }
 
+void LocalMap::Compress() {
+  assert(dense_);
+  pairs_.clear();
+  let_stack_.assign(let_starts_.size(), 0);
+
+  // Runs are only combined within a let block, so each block's pairs can be
+  // erased when it is popped.
+  Index count = 0;
+  Index end = static_cast<Index>(types_.size());
+  for (size_t i = let_starts_.size(); i-- > 0;) {
+    Index start = let_starts_[i];
+    for (Index j = start; j < end; ++j) {
+      ++count;
+      if (j > start && pairs_.back().first == types_[j]) {
+        pairs_.back().second = count;
+      } else {
+        pairs_.emplace_back(types_[j], count);
+        let_stack_[i]++;
+      }
+    }
+    end = start;
+  }
+
+  types_.clear();
+  types_.shrink_to_fit();
+  let_starts_.clear();
+  dense_ = false;
+}
+
 void LocalMap::Push() {
-  let_stack_.push_back(0);
+  if (dense_) {
+    let_starts_.push_back(static_cast<Index>(types_.size()));
+  } else {
+    let_stack_.push_back(0);
+  }
 }
 
 void LocalMap::Pop() {
+  if (dense_) {
+    assert(let_starts_.size() > 1);
+    types_.erase(types_.begin() + let_starts_.back(), types_.end());
+    let_starts_.pop_back();
+    return;
+  }
+
   assert(!let_stack_.empty());
   Index pair_count = let_stack_.back();
   let_stack_.pop_back();
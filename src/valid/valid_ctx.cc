@@ -41,7 +41,27 @@ ValidCtx::ValidCtx(const ValidCtx& other, Errors& errors) {
 }
 
 void ValidCtx::Reset() {
-  *this = ValidCtx{features, *errors};
+  // Clear the containers rather than reassigning a new context, so a context
+  // that is reused for many modules keeps its allocations.
+  types.clear();
+  functions.clear();
+  tables.clear();
+  memories.clear();
+  globals.clear();
+  events.clear();
+  element_segments.clear();
+  defined_type_count = 0;
+  imported_function_count = 0;
+  imported_global_count = 0;
+  declared_data_count.reset();
+  code_count = 0;
+  locals.Reset();
+  type_stack.clear();
+  label_stack.clear();
+  export_names.clear();
+  declared_functions.clear();
+  same_types.Reset(0);
+  match_types.Reset(0);
 }
 
 bool ValidCtx::IsStackPolymorphic() const {
@@ -432,6 +432,11 @@ bool Validate(ValidCtx& ctx, const binary::FieldTypeList& values) {
 bool Validate(ValidCtx& ctx, const At<binary::Function>& value) {
   ErrorsContextGuard guard{*ctx.errors, value.loc(), "function"};
   ctx.functions.push_back(value);
+  if (ctx.functions.size() > ctx.limits.max_functions) {
+    ctx.errors->OnError(value.loc(), concat("Too many functions; max is ",
+                                            ctx.limits.max_functions));
+    return false;
+  }
   if (!ValidateTypeIndex(ctx, value->type_index)) {
     return false;
   }
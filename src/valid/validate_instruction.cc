@@ -15,7 +15,6 @@
 //
 
 #include <cassert>
-#include <limits>
 
 #include "wasp/base/concat.h"
 #include "wasp/base/errors.h"
@@ -519,6 +518,12 @@ bool PushLabel(ValidCtx& ctx,
                Location loc,
                LabelType label_type,
                const FunctionType& type) {
+  // The function's label is always on the stack, but isn't counted.
+  if (ctx.label_stack.size() > ctx.limits.max_block_depth) {
+    ctx.errors->OnError(loc, concat("Too many nested blocks; max is ",
+                                    ctx.limits.max_block_depth));
+    return false;
+  }
   auto stack_param_types = ToStackTypeList(type.param_types);
   auto stack_result_types = ToStackTypeList(type.result_types);
   bool valid = PopTypes(ctx, loc, stack_param_types);
@@ -615,6 +620,12 @@ bool BrIf(ValidCtx& ctx, Location loc, At<Index> depth) {
 bool BrTable(ValidCtx& ctx,
              Location loc,
              const At<BrTableImmediate>& immediate) {
+  if (immediate->targets.size() > ctx.limits.max_br_table_targets) {
+    ctx.errors->OnError(loc, concat("Too many br_table targets; max is ",
+                                    ctx.limits.max_br_table_targets, ", got ",
+                                    immediate->targets.size()));
+    return false;
+  }
   bool valid = PopType(ctx, loc, StackType::I32());
   const auto* default_label = GetLabel(ctx, immediate->default_target);
   if (!default_label) {
@@ -1314,7 +1325,22 @@ bool FuncBind(ValidCtx& ctx, Location loc, At<FuncBindImmediate> immediate) {
                                         stack_results));
 }
 
+void ReportTooManyLocals(ValidCtx& ctx, Location loc, u64 local_count) {
+  ctx.errors->OnError(loc, concat("Too many locals; max is ",
+                                  ctx.limits.max_locals, ", got ",
+                                  local_count));
+}
+
 bool Let(ValidCtx& ctx, Location loc, const At<LetImmediate>& immediate) {
+  // Check the number of locals before ToStackTypeList expands them.
+  u64 local_count = ctx.locals.GetCount();
+  for (const auto& locals : immediate->locals) {
+    local_count += locals->count;
+  }
+  if (local_count > ctx.limits.max_locals) {
+    ReportTooManyLocals(ctx, loc, local_count);
+    return false;
+  }
   bool valid = PopTypes(ctx, loc, ToStackTypeList(immediate->locals));
   valid &= PushLabel(ctx, loc, LabelType::Let, immediate->block_type);
   ctx.locals.Push();
@@ -1754,12 +1780,10 @@ bool Validate(ValidCtx& ctx,
   }
   valid &= Validate(ctx, value->type);
 
-  if (!ctx.locals.Append(value->count, value->type)) {
-    const Index max = std::numeric_limits<Index>::max();
-    ctx.errors->OnError(
-        value.loc(),
-        concat("Too many locals; max is ", max, ", got ",
-               static_cast<u64>(ctx.locals.GetCount()) + value->count));
+  u64 local_count = u64{ctx.locals.GetCount()} + value->count;
+  if (local_count > ctx.limits.max_locals ||
+      !ctx.locals.Append(value->count, value->type)) {
+    ReportTooManyLocals(ctx, value.loc(), local_count);
     valid = false;
   }
   return valid;
@@ -0,0 +1,168 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/valid/validation_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "wasp/base/errors.h"
+#include "wasp/base/file.h"
+
+namespace wasp::valid {
+
+namespace {
+
+// Changing the validator may change its results, so bump the version to
+// invalidate existing caches.
+constexpr u64 kVersion = 2;
+constexpr u8 kMagic[] = {'w', 'a', 's', 'p', 'v', 'c', 0, kVersion};
+
+// The data hashed for a module key and for a function body key start with
+// different tags, so they are never the same (and the keys can only be the
+// same if SHA-256 has a collision).
+constexpr u64 kModuleTag = 0x6d6f64756c65;  // "module"
+constexpr u64 kCodeTag = 0x636f6465;        // "code"
+
+Sha256 BeginKey(u64 tag, const Features& features) {
+  Sha256 hasher;
+  hasher.Update(tag);
+  hasher.Update(u64{kVersion});
+  hasher.Update(u64{features.bits()});
+  return hasher;
+}
+
+}  // namespace
+
+void ValidationCache::Insert(Key key) {
+  if (keys_.insert(key).second) {
+    modified_ = true;
+  }
+}
+
+bool ValidationCache::Load(string_view filename) {
+  auto optbuf = ReadFile(filename);
+  if (!optbuf) {
+    return false;
+  }
+  SpanU8 data{*optbuf};
+  SpanU8 magic{kMagic};
+  if (data.size() < magic.size() || data.first(magic.size()) != magic ||
+      (data.size() - magic.size()) % sizeof(Key) != 0) {
+    return false;
+  }
+  data.remove_prefix(magic.size());
+  keys_.reserve(keys_.size() + data.size() / sizeof(Key));
+  for (; !data.empty(); data.remove_prefix(sizeof(Key))) {
+    Key key;
+    std::copy_n(data.begin(), sizeof(Key), key.begin());
+    keys_.insert(key);
+  }
+  return true;
+}
+
+bool ValidationCache::Save(string_view filename) {
+  std::vector<u8> buffer(std::begin(kMagic), std::end(kMagic));
+  buffer.reserve(buffer.size() + keys_.size() * sizeof(Key));
+  for (const Key& key : keys_) {
+    buffer.insert(buffer.end(), key.begin(), key.end());
+  }
+
+  // Write to a temporary file first, so another process never sees a
+  // partially written cache.
+  std::string temp_filename = std::string{filename} + ".tmp";
+  {
+    std::ofstream stream{temp_filename, std::ios::out | std::ios::binary};
+    stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    if (!stream) {
+      return false;
+    }
+  }
+  if (std::rename(temp_filename.c_str(), std::string{filename}.c_str()) != 0) {
+    std::remove(temp_filename.c_str());
+    return false;
+  }
+  modified_ = false;
+  return true;
+}
+
+CachingValidateVisitor::CachingValidateVisitor(Features features,
+                                               Errors& errors,
+                                               ValidationCache& cache)
+    : ValidateVisitor{features, errors}, cache{cache} {}
+
+auto CachingValidateVisitor::BeginModule(binary::LazyModule& module)
+    -> Result {
+  Sha256 module_hasher = BeginKey(kModuleTag, features);
+  module_hasher.Update(module.data);
+  module_key = module_hasher.Finish();
+  context_hasher = BeginKey(kCodeTag, features);
+  code_key = nullopt;
+  cached_code_count = 0;
+  validated_code_count = 0;
+  return cache.Contains(module_key) ? Result::Skip : Result::Ok;
+}
+
+auto CachingValidateVisitor::EndModule(binary::LazyModule&) -> Result {
+  if (!errors.HasError()) {
+    cache.Insert(module_key);
+  }
+  return Result::Ok;
+}
+
+auto CachingValidateVisitor::OnSection(At<binary::Section> section) -> Result {
+  if (section->is_known()) {
+    auto id = section->known()->id;
+    if (id != binary::SectionId::Code && id != binary::SectionId::Data) {
+      // The length keeps the boundaries between sections unambiguous.
+      context_hasher.Update(u64{section.loc().size()});
+      context_hasher.Update(section.loc());
+    }
+  }
+  return Result::Ok;
+}
+
+auto CachingValidateVisitor::BeginCode(const At<binary::Code>& code)
+    -> Result {
+  Index func_index = ctx.imported_function_count + ctx.code_count;
+  Sha256 hasher = context_hasher;
+  hasher.Update(u64{func_index});
+  hasher.Update(code.loc());
+  auto key = hasher.Finish();
+  if (cache.Contains(key)) {
+    // Skip the body, but keep ValidCtx in sync as valid::BeginCode would.
+    ctx.code_count++;
+    cached_code_count++;
+    code_key = nullopt;
+    return Result::Skip;
+  }
+  validated_code_count++;
+  code_key = key;
+  code_error_count = errors.error_count();
+  return ValidateVisitor::BeginCode(code);
+}
+
+auto CachingValidateVisitor::EndCode(const At<binary::Code>&) -> Result {
+  if (code_key && errors.error_count() == code_error_count) {
+    cache.Insert(*code_key);
+  }
+  code_key = nullopt;
+  return Result::Ok;
+}
+
+}  // namespace wasp::valid
@@ -0,0 +1,146 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/base/arena.h"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace ::wasp;
+
+TEST(ArenaTest, Allocate) {
+  Arena arena{1024};
+  auto* a = static_cast<u8*>(arena.Allocate(10, 1));
+  auto* b = static_cast<u8*>(arena.Allocate(8, 8));
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(b) % 8);
+  EXPECT_LE(a + 10, b);
+  EXPECT_EQ(1024u, arena.reserved_bytes());
+}
+
+TEST(ArenaTest, Allocate_NewChunk) {
+  Arena arena{1024};
+  for (int i = 0; i < 10; ++i) {
+    arena.Allocate(200, 1);
+  }
+  EXPECT_EQ(2048u, arena.reserved_bytes());
+}
+
+TEST(ArenaTest, Allocate_Large) {
+  Arena arena{1024};
+  auto* a = static_cast<u8*>(arena.Allocate(16, 1));
+  arena.Allocate(4000, 16);
+  // The large allocation has its own chunk, so the first one is still used.
+  auto* b = static_cast<u8*>(arena.Allocate(16, 1));
+  EXPECT_EQ(a + 16, b);
+  EXPECT_EQ(1024u + 4016u, arena.reserved_bytes());
+}
+
+TEST(ArenaTest, Deallocate) {
+  Arena arena{1024};
+  void* a = arena.Allocate(24, 8);
+  void* b = arena.Allocate(24, 8);
+  arena.Deallocate(a, 24, 8);
+  // The block is reused for an allocation of the same size only.
+  EXPECT_NE(a, arena.Allocate(32, 8));
+  EXPECT_EQ(a, arena.Allocate(24, 8));
+  EXPECT_NE(b, arena.Allocate(24, 8));
+}
+
+TEST(ArenaTest, Deallocate_Large) {
+  Arena arena{1024};
+  void* a = arena.Allocate(4000, 8);
+  EXPECT_EQ(4008u, arena.reserved_bytes());
+  arena.Deallocate(a, 4000, 8);
+  EXPECT_EQ(0u, arena.reserved_bytes());
+}
+
+TEST(ArenaTest, Allocate_MultipleThreads) {
+  Arena arena{1024};
+  const int kThreads = 4, kCount = 1000;
+  std::vector<std::vector<u32*>> results(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kCount; ++i) {
+        auto* p = static_cast<u32*>(arena.Allocate(sizeof(u32), alignof(u32)));
+        *p = t * kCount + i;
+        results[t].push_back(p);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < kThreads; ++t) {
+    for (int i = 0; i < kCount; ++i) {
+      EXPECT_EQ(u32(t * kCount + i), *results[t][i]);
+    }
+  }
+}
+
+TEST(ArenaTest, Scope) {
+  Arena arena;
+  EXPECT_EQ(nullptr, Arena::current());
+  {
+    ArenaScope scope{&arena};
+    EXPECT_EQ(&arena, Arena::current());
+    {
+      ArenaScope inner{nullptr};
+      EXPECT_EQ(nullptr, Arena::current());
+    }
+    EXPECT_EQ(&arena, Arena::current());
+  }
+  EXPECT_EQ(nullptr, Arena::current());
+}
+
+TEST(ArenaTest, Allocator) {
+  Arena arena;
+  ArenaVector<ArenaVector<int>> outer;
+  {
+    ArenaScope scope{&arena};
+    ArenaVector<ArenaVector<int>> vec(1);
+    vec[0].push_back(1);
+    EXPECT_EQ(&arena, GetArena(vec.data()));
+    EXPECT_EQ(&arena, GetArena(vec[0].data()));
+    outer = std::move(vec);
+  }
+  // Moving keeps the arena's blocks.
+  EXPECT_EQ(&arena, GetArena(outer.data()));
+
+  // Allocating outside the scope uses the heap, including for copies.
+  auto copy = outer;
+  EXPECT_EQ(nullptr, GetArena(copy.data()));
+  EXPECT_EQ(nullptr, GetArena(copy[0].data()));
+  EXPECT_EQ(outer, copy);
+  outer[0].resize(100);
+  EXPECT_EQ(nullptr, GetArena(outer[0].data()));
+}
+
+TEST(ArenaTest, Allocator_OverAligned) {
+  struct alignas(64) Aligned {
+    u8 data[64];
+  };
+  Arena arena;
+  ArenaVector<Aligned> heap(3);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(heap.data()) % 64);
+  ArenaScope scope{&arena};
+  ArenaVector<Aligned> vec(3);
+  EXPECT_EQ(&arena, GetArena(vec.data()));
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(vec.data()) % 64);
+}
@@ -0,0 +1,65 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/base/parallel.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace ::wasp;
+
+TEST(ParallelTest, GetThreadCount) {
+  EXPECT_EQ(3u, GetThreadCount(3));
+  EXPECT_LE(1u, GetThreadCount(0));
+}
+
+TEST(ParallelTest, ParallelFor_Empty) {
+  int calls = 0;
+  ParallelFor(0, 4, [&](u32, size_t) { ++calls; });
+  EXPECT_EQ(0, calls);
+}
+
+TEST(ParallelTest, ParallelFor_SingleThread) {
+  std::vector<size_t> order;
+  ParallelFor(5, 1, [&](u32 thread_index, size_t i) {
+    EXPECT_EQ(0u, thread_index);
+    order.push_back(i);
+  });
+  EXPECT_EQ((std::vector<size_t>{0, 1, 2, 3, 4}), order);
+}
+
+TEST(ParallelTest, ParallelFor_MultipleThreads) {
+  const size_t kCount = 1000;
+  const u32 kThreads = 4;
+  std::vector<std::atomic<int>> visited(kCount);
+  std::vector<u64> per_thread(kThreads);
+  ParallelFor(kCount, kThreads, [&](u32 thread_index, size_t i) {
+    ASSERT_LT(thread_index, kThreads);
+    visited[i]++;
+    per_thread[thread_index] += i;
+  });
+
+  for (auto& v : visited) {
+    EXPECT_EQ(1, v.load());
+  }
+  u64 sum = 0;
+  for (auto x : per_thread) {
+    sum += x;
+  }
+  EXPECT_EQ(kCount * (kCount - 1) / 2, sum);
+}
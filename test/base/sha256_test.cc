@@ -0,0 +1,100 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/base/sha256.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+
+using namespace ::wasp;
+
+namespace {
+
+std::string ToHex(const Sha256::Digest& digest) {
+  std::string result;
+  char buf[3];
+  for (u8 byte : digest) {
+    snprintf(buf, sizeof(buf), "%02x", byte);
+    result += buf;
+  }
+  return result;
+}
+
+SpanU8 ToSpan(const std::string& str) {
+  return SpanU8{reinterpret_cast<const u8*>(str.data()), str.size()};
+}
+
+}  // namespace
+
+TEST(Sha256Test, Hash) {
+  // Test vectors from FIPS 180-4.
+  EXPECT_EQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+            ToHex(Sha256::Hash(SpanU8{})));
+  EXPECT_EQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+            ToHex(Sha256::Hash("abc"_su8)));
+  EXPECT_EQ(
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+      ToHex(Sha256::Hash(
+          "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"_su8)));
+}
+
+TEST(Sha256Test, Hash_Long) {
+  std::string data(1000000, 'a');
+  EXPECT_EQ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+            ToHex(Sha256::Hash(ToSpan(data))));
+}
+
+TEST(Sha256Test, Update) {
+  // Updating in pieces of any size gives the same digest, including pieces
+  // that cross a block boundary.
+  std::string data(200, 'x');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i);
+  }
+  auto expected = Sha256::Hash(ToSpan(data));
+  for (size_t size = 1; size <= 65; ++size) {
+    Sha256 sha;
+    SpanU8 rest = ToSpan(data);
+    while (!rest.empty()) {
+      size_t n = std::min(size, rest.size());
+      sha.Update(rest.first(n));
+      rest.remove_prefix(n);
+    }
+    EXPECT_EQ(expected, sha.Finish()) << size;
+  }
+}
+
+TEST(Sha256Test, Update_U64) {
+  Sha256 sha;
+  sha.Update(u64{0x0807060504030201});
+  const u8 bytes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  EXPECT_EQ(Sha256::Hash(SpanU8{bytes}), sha.Finish());
+}
+
+TEST(Sha256Test, Copy) {
+  // A copy can be updated independently, e.g. to hash many inputs that share
+  // a prefix.
+  Sha256 prefix;
+  prefix.Update("prefix"_su8);
+  Sha256 copy = prefix;
+  copy.Update("a"_su8);
+  prefix.Update("b"_su8);
+  EXPECT_EQ(Sha256::Hash("prefixa"_su8), copy.Finish());
+  EXPECT_EQ(Sha256::Hash("prefixb"_su8), prefix.Finish());
+}
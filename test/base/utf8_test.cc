@@ -17,6 +17,7 @@
 #include "wasp/base/utf8.h"
 
 #include <cassert>
+#include <string>
 
 #include "gtest/gtest.h"
 
@@ -169,3 +170,77 @@ TEST(Utf8Test, invalid_4_bytes) {
     assert_is_valid_utf8(false, 4, cu0, 0x80, 0x80, 0x80);
   }
 }
+
+// Longer strings use an ASCII fast path between characters, so check that
+// every sequence of up to 3 bytes gives the same result when surrounded by
+// ASCII, at offsets around the 16-byte blocks the fast path reads.
+namespace {
+
+bool IsValidUtf8Embedded(int offset, string_view seq) {
+  std::string str(offset, 'a');
+  str += seq;
+  str.append(40, 'b');
+  return IsValidUtf8(str);
+}
+
+}  // end anonymous namespace
+
+TEST(Utf8Test, embedded_1_and_2_bytes) {
+  FOR_RANGE(offset, 0, 34) {
+    FOR_EACH_BYTE(cu0) {
+      char buf[2] = {static_cast<char>(cu0), 0};
+      string_view seq1{buf, 1};
+      ASSERT_EQ(IsValidUtf8(seq1), IsValidUtf8Embedded(offset, seq1))
+          << offset << ": " << cu0;
+      FOR_EACH_BYTE(cu1) {
+        buf[1] = static_cast<char>(cu1);
+        string_view seq2{buf, 2};
+        ASSERT_EQ(IsValidUtf8(seq2), IsValidUtf8Embedded(offset, seq2))
+            << offset << ": " << cu0 << ", " << cu1;
+      }
+    }
+  }
+}
+
+TEST(Utf8Test, embedded_3_bytes) {
+  // Straddles the end of the first 16-byte block.
+  const int offset = 15;
+  std::string str(offset + 3 + 40, 'a');
+  FOR_EACH_BYTE(cu0) {
+    FOR_EACH_BYTE(cu1) {
+      FOR_EACH_BYTE(cu2) {
+        char buf[3] = {static_cast<char>(cu0), static_cast<char>(cu1),
+                       static_cast<char>(cu2)};
+        str.replace(offset, 3, buf, 3);
+        ASSERT_EQ(IsValidUtf8(string_view{buf, 3}), IsValidUtf8(str))
+            << cu0 << ", " << cu1 << ", " << cu2;
+      }
+    }
+  }
+}
+
+TEST(Utf8Test, long_strings) {
+  std::string ascii(1000, 'x');
+  EXPECT_TRUE(IsValidUtf8(ascii));
+
+  // Multi-byte characters between long ASCII runs.
+  std::string mixed = ascii + "\xc3\xa9" + ascii + "\xe2\x82\xac" + ascii +
+                      "\xf0\x9f\x98\x80" + ascii;
+  EXPECT_TRUE(IsValidUtf8(mixed));
+  for (size_t i = 0; i < mixed.size(); ++i) {
+    if (static_cast<unsigned char>(mixed[i]) >= 0x80) {
+      // Dropping any byte of a multi-byte character makes it invalid.
+      std::string bad = mixed;
+      bad.erase(i, 1);
+      EXPECT_FALSE(IsValidUtf8(bad)) << i;
+    }
+  }
+
+  // Only non-ASCII characters.
+  std::string euros;
+  for (int i = 0; i < 100; ++i) {
+    euros += "\xe2\x82\xac";
+  }
+  EXPECT_TRUE(IsValidUtf8(euros));
+  EXPECT_FALSE(IsValidUtf8(euros.substr(0, euros.size() - 1)));
+}
@@ -0,0 +1,166 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/control_flow_graph.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/test_utils.h"
+#include "wasp/binary/read/read_ctx.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::test;
+
+using K = ControlFlowEdgeKind;
+
+namespace {
+
+const BasicBlockId kExit = kInvalidBasicBlockId;
+
+struct ExpectedEdge {
+  BasicBlockId target;
+  K kind;
+  Index case_index = 0;
+};
+
+void ExpectBlock(const ControlFlowGraph& cfg,
+                 BasicBlockId id,
+                 u32 begin,
+                 u32 end,
+                 const std::vector<ExpectedEdge>& expected) {
+  ASSERT_LT(id, cfg.blocks.size());
+  EXPECT_EQ(begin, cfg.blocks[id].begin) << "block " << id;
+  EXPECT_EQ(end, cfg.blocks[id].end) << "block " << id;
+  auto successors = cfg.successors(id);
+  ASSERT_EQ(expected.size(), successors.size()) << "block " << id;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i].target, successors[i].target)
+        << "block " << id << ", edge " << i;
+    EXPECT_EQ(expected[i].kind, successors[i].kind)
+        << "block " << id << ", edge " << i;
+    if (expected[i].kind == K::Case) {
+      EXPECT_EQ(expected[i].case_index, successors[i].case_index)
+          << "block " << id << ", edge " << i;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(BinaryControlFlowGraphTest, Empty) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  // end
+  auto cfg = BuildControlFlowGraph("\x0b"_su8, ctx);
+  ExpectNoErrors(errors);
+  EXPECT_EQ(kInvalidBasicBlockId, cfg.start);
+  EXPECT_EQ(0u, cfg.blocks.size());
+  EXPECT_EQ(0u, cfg.edges.size());
+}
+
+TEST(BinaryControlFlowGraphTest, StraightLine) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  // nop
+  // end
+  auto body = "\x01\x0b"_su8;
+  auto cfg = BuildControlFlowGraph(body, ctx);
+  ExpectNoErrors(errors);
+  EXPECT_EQ(0u, cfg.start);
+  ASSERT_EQ(1u, cfg.blocks.size());
+  ExpectBlock(cfg, 0, 0, 2, {{kExit, K::Unconditional}});
+  EXPECT_EQ(body, cfg.code(body, 0));
+}
+
+TEST(BinaryControlFlowGraphTest, IfElse) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  // 0: local.get 0
+  // 2: if
+  // 4:   nop
+  // 5: else
+  // 6:   nop
+  // 7: end
+  // 8: end
+  auto body = "\x20\x00\x04\x40\x01\x05\x01\x0b\x0b"_su8;
+  auto cfg = BuildControlFlowGraph(body, ctx);
+  ExpectNoErrors(errors);
+  EXPECT_EQ(0u, cfg.start);
+  // The block after the `if` only holds the final `end`, so it is removed.
+  ASSERT_EQ(3u, cfg.blocks.size());
+  ExpectBlock(cfg, 0, 0, 4, {{1, K::True}, {2, K::False}});
+  ExpectBlock(cfg, 1, 4, 6, {{kExit, K::Unconditional}});
+  ExpectBlock(cfg, 2, 6, 8, {{kExit, K::Unconditional}});
+}
+
+TEST(BinaryControlFlowGraphTest, LoopBrIf) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  // 0: loop
+  // 2:   local.get 0
+  // 4:   br_if 0
+  // 6: end
+  // 7: nop
+  // 8: end
+  auto body = "\x03\x40\x20\x00\x0d\x00\x0b\x01\x0b"_su8;
+  auto cfg = BuildControlFlowGraph(body, ctx);
+  ExpectNoErrors(errors);
+  // The empty blocks before the loop and after the br_if are removed.
+  EXPECT_EQ(0u, cfg.start);
+  ASSERT_EQ(2u, cfg.blocks.size());
+  ExpectBlock(cfg, 0, 0, 6, {{0, K::True}, {1, K::False}});
+  ExpectBlock(cfg, 1, 7, 9, {{kExit, K::Unconditional}});
+}
+
+TEST(BinaryControlFlowGraphTest, BrTable) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  //  0: block
+  //  2:   block
+  //  4:     local.get 0
+  //  6:     br_table 0 1 0
+  // 11:   end
+  // 12:   nop
+  // 13: end
+  // 14: nop
+  // 15: end
+  auto body =
+      "\x02\x40\x02\x40\x20\x00\x0e\x02\x00\x01\x00\x0b\x01\x0b\x01\x0b"_su8;
+  auto cfg = BuildControlFlowGraph(body, ctx);
+  ExpectNoErrors(errors);
+  EXPECT_EQ(0u, cfg.start);
+  ASSERT_EQ(3u, cfg.blocks.size());
+  ExpectBlock(cfg, 0, 0, 11,
+              {{2, K::Case, 0}, {1, K::Case, 1}, {2, K::Default}});
+  ExpectBlock(cfg, 1, 14, 16, {{kExit, K::Unconditional}});
+  ExpectBlock(cfg, 2, 12, 14, {{1, K::Unconditional}});
+}
+
+TEST(BinaryControlFlowGraphTest, InvalidBranchDepth) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  // nop
+  // br 1
+  // end
+  auto body = "\x01\x0c\x01\x0b"_su8;
+  auto cfg = BuildControlFlowGraph(body, ctx);
+  ExpectError({{2, "Invalid branch depth: 1"}}, errors, body);
+  EXPECT_EQ(0u, cfg.start);
+  ASSERT_EQ(1u, cfg.blocks.size());
+  ExpectBlock(cfg, 0, 0, 3, {});
+}
@@ -0,0 +1,123 @@
+//
+// Copyright 2018 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/lazy_locals.h"
+
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/binary/constants.h"
+#include "test/binary/test_utils.h"
+#include "test/test_utils.h"
+#include "wasp/base/concat.h"
+#include "wasp/binary/formatters.h"
+#include "wasp/binary/read.h"
+#include "wasp/binary/read/read_ctx.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::binary::test;
+using namespace ::wasp::test;
+
+namespace {
+
+// Iterates the sequence once, since reading the locals updates the context.
+LocalsList ToList(LazyLocals&& locals) {
+  LocalsList result;
+  for (const auto& item : locals.sequence) {
+    result.push_back(item);
+  }
+  return result;
+}
+
+const SpanU8 kCodeData = "\x07\x02\x02\x7f\x03\x7e\x01\x0b"_su8;
+
+// (func
+//   (local i32 i32 i64 i64 i64)
+//   (nop))
+const CodeView kView{"\x02\x02\x7f\x03\x7e"_su8,
+                     At{"\x01\x0b"_su8, "\x01\x0b"_expr}};
+
+// Not a global, since VT_I32 and VT_I64 may not be initialized yet.
+LocalsList ExpectedLocals() {
+  return {At{"\x02\x7f"_su8,
+             Locals{At{"\x02"_su8, Index{2}}, At{"\x7f"_su8, VT_I32}}},
+          At{"\x03\x7e"_su8,
+             Locals{At{"\x03"_su8, Index{3}}, At{"\x7e"_su8, VT_I64}}}};
+}
+
+}  // namespace
+
+TEST(BinaryLazyLocalsTest, ReadLocals) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  auto locals = ReadLocals(kView, ctx);
+  EXPECT_EQ(2u, locals.count);
+  EXPECT_EQ(ExpectedLocals(), ToList(std::move(locals)));
+  EXPECT_EQ(5u, ctx.local_count);
+  ExpectNoErrors(errors);
+}
+
+TEST(BinaryLazyLocalsTest, ReadLocals_RestartsLocalCount) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  ctx.limits.max_locals = 5;
+  // As if the view had just been read.
+  ctx.local_count = 5;
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(ExpectedLocals(), ToList(ReadLocals(kView, ctx)));
+  }
+  EXPECT_EQ(5u, ctx.local_count);
+  ExpectNoErrors(errors);
+}
+
+TEST(BinaryLazyLocalsTest, ToCode) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  SpanU8 data = kCodeData;
+  auto view = Read<CodeView>(&data, ctx);
+  ASSERT_TRUE(view.has_value());
+  EXPECT_EQ(kView, **view);
+
+  // The Code is the same as if it had been read directly.
+  data = kCodeData;
+  auto expected = Read<Code>(&data, ctx);
+  auto code = ToCode(*view, ctx);
+  ASSERT_TRUE(code.has_value());
+  EXPECT_EQ(*expected, *code);
+  EXPECT_EQ(expected->loc(), code->loc());
+  EXPECT_EQ(5u, ctx.local_count);
+  ExpectNoErrors(errors);
+}
+
+TEST(BinaryLazyLocalsTest, ToCode_AllocationLimit) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  SpanU8 data = kCodeData;
+  auto view = Read<CodeView>(&data, ctx);
+  ASSERT_TRUE(view.has_value());
+
+  // Reading the view doesn't allocate, but building the Code does.
+  const u64 size = 2 * sizeof(At<Locals>);
+  ctx.limits.max_allocated_bytes = size - 1;
+  EXPECT_FALSE(ToCode(*view, ctx).has_value());
+  ExpectError({{0, "code"},
+               {1, "locals vector"},
+               {1, concat("Allocation of ", size, " bytes exceeds limit; 0 of ",
+                          size - 1, " bytes used")}},
+              errors, kCodeData);
+}
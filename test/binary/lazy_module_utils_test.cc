@@ -69,6 +69,20 @@ TEST(BinaryLazyModuleUtilsTest, ForEachFunctionName) {
   });
 }
 
+TEST(BinaryLazyModuleUtilsTest, ForEachFunctionName_ModuleCanBeReread) {
+  Features features;
+  TestErrors errors;
+  auto module = ReadLazyModule(GetModuleData(), features, errors);
+
+  ForEachFunctionName(module, [](const std::pair<Index, string_view>&) {});
+  // The module's context isn't used, so reading the sections afterward
+  // doesn't report them as out of order.
+  for (auto section : module.sections) {
+    (void)section;
+  }
+  ExpectNoErrors(errors);
+}
+
 TEST(BinaryLazyModuleUtilsTest, CopyFunctionNames) {
   Features features;
   TestErrors errors;
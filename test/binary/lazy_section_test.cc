@@ -286,6 +286,24 @@ TEST(BinaryLazySectionTest, Code) {
   ExpectNoErrors(errors);
 }
 
+TEST(BinaryLazySectionTest, CodeView) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  auto sec = ReadCodeViewSection(
+      "\x02"                           // Count.
+      "\x02\x00\x0b"                   // (func)
+      "\x05\x01\x01\x7f\x6a\x0b"_su8,  // (func (local i32) i32.add)
+      ctx);
+
+  ExpectSection(
+      {
+          CodeView{"\x00"_su8, At{"\x0b"_su8, "\x0b"_expr}},
+          CodeView{"\x01\x01\x7f"_su8, At{"\x6a\x0b"_su8, "\x6a\x0b"_expr}},
+      },
+      sec);
+  ExpectNoErrors(errors);
+}
+
 TEST(BinaryLazySectionTest, Data) {
   TestErrors errors;
   ReadCtx ctx{errors};
@@ -0,0 +1,142 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/packed_instruction_list.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "gtest/gtest.h"
+#include "test/binary/constants.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::binary::test;
+
+using I = Instruction;
+using O = Opcode;
+
+namespace {
+
+// One instruction of each immediate kind. The packed list doesn't keep
+// locations, so the inline immediates don't have any.
+InstructionList MakeInstructions() {
+  return InstructionList{
+      I{O::Nop},
+      I{O::I32Const, s32{-5}},
+      I{O::I64Const, s64{-0x1'0000'0000}},
+      I{O::F32Const, f32{1.5f}},
+      I{O::F64Const, f64{-2.25}},
+      I{O::V128Const, At{v128{u64{1}, u64{2}}}},
+      I{O::LocalGet, Index{7}},
+      I{O::Block, At{BlockType{At{VoidType{}}}}},
+      I{O::Block, At{BlockType{At{ValueType{At{NumericType::I32}}}}}},
+      I{O::Block, At{BT_Funcref}},
+      I{O::Block, At{BlockType{At{Index{3}}}}},
+      I{O::BrOnExn, At{BrOnExnImmediate{1, 2}}},
+      I{O::BrTable, At{BrTableImmediate{{1, 2, 3}, 4}}},
+      I{O::BrTable, At{BrTableImmediate{{}, 0}}},
+      I{O::CallIndirect, At{CallIndirectImmediate{5, 0}}},
+      I{O::MemoryCopy, At{CopyImmediate{0, 1}}},
+      I{O::MemoryInit, At{InitImmediate{2, 0}}},
+      I{O::Let, At{LetImmediate{At{BT_Void},
+                                {At{Locals{2, At{VT_I32}}},
+                                 At{Locals{1, At{VT_F64}}}}}}},
+      I{O::I32Load, At{MemArgImmediate{2, 16}}},
+      I{O::RefNull, At{HeapType{At{HeapKind::Extern}}}},
+      I{O::RefNull, At{HeapType{At{Index{1}}}}},
+      I{O::SelectT, At{SelectImmediate{At{VT_I64}, At{VT_Externref}}}},
+      I{O::I8X16Shuffle,
+        At{ShuffleImmediate{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+                            15}}},
+      I{O::I8X16ExtractLaneS, SimdLaneImmediate{3}},
+      I{O::FuncBind, At{FuncBindImmediate{6}}},
+      I{O::BrOnCast, At{BrOnCastImmediate{1, HeapType2Immediate{
+                                                  At{HT_Any}, At{HT_0}}}}},
+      I{O::RefTest, At{HeapType2Immediate{At{HT_Any}, At{HT_2}}}},
+      I{O::RttSub,
+        At{RttSubImmediate{1, HeapType2Immediate{At{HT_Eq}, At{HT_0}}}}},
+      I{O::StructGet, At{StructFieldImmediate{3, 4}}},
+  };
+}
+
+}  // namespace
+
+TEST(BinaryPackedInstructionListTest, RoundTrip) {
+  auto instrs = MakeInstructions();
+  PackedInstructionList packed{instrs};
+
+  ASSERT_EQ(instrs.size(), packed.size());
+  for (size_t i = 0; i < instrs.size(); ++i) {
+    EXPECT_EQ(*instrs[i]->opcode, packed.opcode(i)) << "at index " << i;
+    EXPECT_EQ(instrs[i]->kind(), packed.kind(i)) << "at index " << i;
+    EXPECT_EQ(instrs[i].value(), packed[i]) << "at index " << i;
+  }
+  EXPECT_EQ(instrs, packed.ToInstructionList());
+}
+
+TEST(BinaryPackedInstructionListTest, PushBack) {
+  PackedInstructionList packed;
+  EXPECT_TRUE(packed.empty());
+
+  packed.push_back(I{O::LocalGet, Index{1}});
+  packed.push_back(I{O::BrTable, At{BrTableImmediate{{1, 2}, 0}}});
+  packed.push_back(I{O::Nop});
+
+  ASSERT_EQ(3u, packed.size());
+  EXPECT_EQ((I{O::BrTable, At{BrTableImmediate{{1, 2}, 0}}}), packed[1]);
+
+  packed.clear();
+  EXPECT_TRUE(packed.empty());
+}
+
+TEST(BinaryPackedInstructionListTest, Iterator) {
+  auto instrs = MakeInstructions();
+  PackedInstructionList packed{instrs};
+
+  EXPECT_EQ(static_cast<std::ptrdiff_t>(instrs.size()),
+            std::distance(packed.begin(), packed.end()));
+  EXPECT_TRUE(std::equal(
+      packed.begin(), packed.end(), instrs.begin(), instrs.end(),
+      [](const Instruction& lhs, const At<Instruction>& rhs) {
+        return lhs == rhs.value();
+      }));
+
+  auto iter = packed.begin() + 12;
+  EXPECT_EQ(packed[12], *iter);
+  EXPECT_EQ(packed[10], iter[-2]);
+  EXPECT_EQ(12, iter - packed.begin());
+  EXPECT_TRUE(packed.begin() < iter);
+}
+
+TEST(BinaryPackedInstructionListTest, Equality) {
+  auto instrs = MakeInstructions();
+  PackedInstructionList packed1{instrs};
+  PackedInstructionList packed2{instrs};
+  EXPECT_EQ(packed1, packed2);
+
+  packed2.push_back(I{O::Nop});
+  EXPECT_NE(packed1, packed2);
+}
+
+TEST(BinaryPackedInstructionListTest, MemorySize) {
+  InstructionList instrs;
+  for (Index i = 0; i < 100; ++i) {
+    instrs.push_back(At{I{O::LocalGet, i}});
+  }
+  PackedInstructionList packed{instrs};
+  EXPECT_EQ(100 * sizeof(PackedInstructionList::Record), packed.memory_size());
+}
@@ -16,10 +16,13 @@
 
 #include "wasp/binary/read.h"
 
+#include <cassert>
+
 #include "gtest/gtest.h"
 #include "test/binary/constants.h"
 #include "test/binary/test_utils.h"
 #include "test/test_utils.h"
+#include "wasp/base/buffer.h"
 #include "wasp/binary/read/read_ctx.h"
 
 using namespace ::wasp;
@@ -30,17 +33,46 @@ using namespace ::wasp::binary::test;
 class BinaryReadModuleTest : public ::testing::Test {
  protected:
   void OK(const Module& expected, SpanU8 data) {
-    auto actual = ReadModule(data, ctx);
-    ExpectNoErrors(errors);
-    ASSERT_TRUE(actual.has_value());
-    EXPECT_EQ(expected, actual.value());
+    for (u32 thread_count : {1, 4}) {
+      auto actual = ReadModule(data, ctx, thread_count);
+      ExpectNoErrors(errors);
+      ASSERT_TRUE(actual.has_value());
+      EXPECT_EQ(expected, actual.value());
+    }
   }
 
   void Fail(const ExpectedError& error, SpanU8 data) {
-    auto actual = ReadModule(data, ctx);
-    EXPECT_FALSE(actual.has_value());
-    ExpectError(error, errors, data);
-    errors.Clear();
+    for (u32 thread_count : {1, 4}) {
+      auto actual = ReadModule(data, ctx, thread_count);
+      EXPECT_FALSE(actual.has_value());
+      ExpectError(error, errors, data);
+      errors.Clear();
+    }
+  }
+
+  // Reads `data` sequentially and in parallel, and checks that the results
+  // and the errors are the same.
+  void ExpectSameAsSequential(SpanU8 data) {
+    TestErrors sequential_errors;
+    ReadCtx sequential_ctx{sequential_errors};
+    auto expected = ReadModule(data, sequential_ctx, 1);
+
+    TestErrors parallel_errors;
+    ReadCtx parallel_ctx{parallel_errors};
+    auto actual = ReadModule(data, parallel_ctx, 4);
+
+    EXPECT_EQ(expected, actual);
+    ASSERT_EQ(sequential_errors.errors.size(), parallel_errors.errors.size());
+    for (size_t i = 0; i < sequential_errors.errors.size(); ++i) {
+      const auto& expected_list = sequential_errors.errors[i];
+      const auto& actual_list = parallel_errors.errors[i];
+      ASSERT_EQ(expected_list.size(), actual_list.size());
+      for (size_t j = 0; j < expected_list.size(); ++j) {
+        EXPECT_EQ(expected_list[j].loc.data(), actual_list[j].loc.data());
+        EXPECT_EQ(expected_list[j].loc.size(), actual_list[j].loc.size());
+        EXPECT_EQ(expected_list[j].message, actual_list[j].message);
+      }
+    }
   }
 
   TestErrors errors;
@@ -151,3 +183,81 @@ TEST_F(BinaryReadModuleTest, BadTypeSection) {
        "\x01\x00"_su8  // Empty type section.
   );
 }
+
+namespace {
+
+// Returns a module with `count` functions of type (func (result i32)). Body
+// `i` is (i32.const i) followed by `i` nops, so the bodies vary in size.
+Buffer MakeCodeModule(Index count) {
+  Buffer funcs;
+  Buffer codes;
+  for (Index i = 0; i < count; ++i) {
+    funcs.push_back(0);
+    codes.push_back(static_cast<u8>(i + 4));  // Body size.
+    codes.insert(codes.end(), {0x00, 0x41, static_cast<u8>(i & 0x3f)});
+    codes.insert(codes.end(), i, 0x01);
+    codes.push_back(0x0b);
+  }
+  assert(count < 64 && codes.size() < 16384);
+
+  Buffer result{0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00};
+  result.insert(result.end(), {0x01, 0x05, 0x01, 0x60, 0x00, 0x01, 0x7f});
+  result.insert(result.end(), {0x03, static_cast<u8>(count + 1),
+                               static_cast<u8>(count)});
+  result.insert(result.end(), funcs.begin(), funcs.end());
+  size_t length = codes.size() + 1;
+  result.insert(result.end(), {0x0a, static_cast<u8>((length & 0x7f) | 0x80),
+                               static_cast<u8>(length >> 7),
+                               static_cast<u8>(count)});
+  result.insert(result.end(), codes.begin(), codes.end());
+  return result;
+}
+
+// Returns the offset of body `index` in a module from MakeCodeModule.
+size_t CodeOffset(const Buffer& module, Index count, Index index) {
+  size_t offset = module.size();
+  for (Index i = count; i > index; --i) {
+    offset -= (i - 1) + 5;
+  }
+  return offset;
+}
+
+}  // namespace
+
+TEST_F(BinaryReadModuleTest, Parallel) {
+  auto data = MakeCodeModule(40);
+  auto module = ReadModule(SpanU8{data}, ctx, 4);
+  ExpectNoErrors(errors);
+  ASSERT_TRUE(module.has_value());
+  ASSERT_EQ(40u, module->codes.size());
+  EXPECT_EQ(2u + 39u, module->codes[39]->body.instructions.size());
+  ExpectSameAsSequential(SpanU8{data});
+}
+
+TEST_F(BinaryReadModuleTest, Parallel_UnknownOpcode) {
+  auto data = MakeCodeModule(40);
+  data[CodeOffset(data, 40, 20) + 4] = 0xff;
+  data[CodeOffset(data, 40, 30) + 4] = 0xff;
+  ExpectSameAsSequential(SpanU8{data});
+}
+
+TEST_F(BinaryReadModuleTest, Parallel_BadLocals) {
+  // A bad locals vector stops reading the code section.
+  auto data = MakeCodeModule(40);
+  data[CodeOffset(data, 40, 25) + 1] = 0x80;
+  data[CodeOffset(data, 40, 35) + 4] = 0xff;
+  ExpectSameAsSequential(SpanU8{data});
+}
+
+TEST_F(BinaryReadModuleTest, Parallel_BadLength) {
+  // A body that extends past the end of the section.
+  auto data = MakeCodeModule(40);
+  data[CodeOffset(data, 40, 39)] = 0x7f;
+  ExpectSameAsSequential(SpanU8{data});
+}
+
+TEST_F(BinaryReadModuleTest, Parallel_CountMismatch) {
+  auto data = MakeCodeModule(40);
+  data[CodeOffset(data, 40, 0) - 1] = 41;
+  ExpectSameAsSequential(SpanU8{data});
+}
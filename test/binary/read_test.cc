@@ -23,6 +23,7 @@
 #include "test/binary/constants.h"
 #include "test/binary/test_utils.h"
 #include "test/test_utils.h"
+#include "wasp/binary/encoding.h"
 #include "wasp/binary/formatters.h"
 #include "wasp/binary/name_section/read.h"
 #include "wasp/binary/read/read_ctx.h"
@@ -255,6 +256,18 @@ TEST_F(BinaryReadTest, BrTableImmediate_PastEnd) {
        "\x00"_su8);
 }
 
+TEST_F(BinaryReadTest, BrTableImmediate_TooManyTargets) {
+  ctx.limits.max_br_table_targets = 1;
+
+  OK(Read<BrTableImmediate>,
+     BrTableImmediate{{At{"\x01"_su8, Index{1}}}, At{"\x02"_su8, Index{2}}},
+     "\x01\x01\x02"_su8);
+
+  Fail(Read<BrTableImmediate>,
+       {{0, "br_table"}, {0, "targets"}, {0, "Count exceeds limit: 2 > 1"}},
+       "\x02\x01\x02\x03"_su8);
+}
+
 TEST_F(BinaryReadTest, ReadBytes) {
   const SpanU8 data = "\x12\x34\x56"_su8;
   SpanU8 copy = data;
@@ -354,6 +367,65 @@ TEST_F(BinaryReadTest, Code_TooManyLocals) {
   );
 }
 
+TEST_F(BinaryReadTest, Code_LocalsLimit) {
+  ctx.limits.max_locals = 2;
+
+  Fail(Read<Code>,
+       {{0, "code"},
+        {1, "locals vector"},
+        {4, "locals"},
+        {4, "Too many locals: 3"}},
+       "\x05"          // length
+       "\x02"          // local decls count
+       "\x02\x7f"      // (local i32 i32)
+       "\x01\x7e"_su8  // (local i64)
+  );
+}
+
+TEST_F(BinaryReadTest, CodeView) {
+  OK(Read<CodeView>, CodeView{"\x00"_su8, At{""_su8, ""_expr}},
+     "\x01\x00"_su8);
+
+  // (func
+  //   (local i32 i32 i64 i64 i64)
+  //   (nop))
+  OK(Read<CodeView>,
+     CodeView{"\x02\x02\x7f\x03\x7e"_su8,
+              At{"\x01\x0b"_su8, "\x01\x0b"_expr}},
+     "\x07\x02\x02\x7f\x03\x7e\x01\x0b"_su8);
+}
+
+TEST_F(BinaryReadTest, CodeView_PastEnd) {
+  Fail(
+      Read<CodeView>,
+      {{0, "code"}, {1, "locals vector"}, {1, "Count extends past end: 1 > 0"}},
+      "\x01\x01"_su8);
+
+  Fail(Read<CodeView>,
+       {{0, "code"},
+        {1, "locals vector"},
+        {4, "locals"},
+        {4, "count"},
+        {4, "Unable to read u8"}},
+       "\x03\x02\x01\x7f"_su8);
+}
+
+TEST_F(BinaryReadTest, CodeView_LocalsLimit) {
+  ctx.limits.max_locals = 2;
+
+  // The locals are checked, even though they aren't stored.
+  Fail(Read<CodeView>,
+       {{0, "code"},
+        {1, "locals vector"},
+        {4, "locals"},
+        {4, "Too many locals: 3"}},
+       "\x05"          // length
+       "\x02"          // local decls count
+       "\x02\x7f"      // (local i32 i32)
+       "\x01\x7e"_su8  // (local i64)
+  );
+}
+
 TEST_F(BinaryReadTest, ConstantExpression) {
   // i32.const
   OK(Read<ConstantExpression>,
@@ -1171,6 +1243,14 @@ TEST_F(BinaryReadTest, Function_PastEnd) {
        {{0, "function"}, {0, "type index"}, {0, "Unable to read u8"}}, ""_su8);
 }
 
+TEST_F(BinaryReadTest, Function_TooManyFunctions) {
+  ctx.limits.max_functions = 1;
+
+  OK(Read<Function>, Function{At{"\x01"_su8, Index{1}}}, "\x01"_su8);
+  Fail(Read<Function>, {{0, "function"}, {0, "Too many functions; max is 1"}},
+       "\x01"_su8);
+}
+
 TEST_F(BinaryReadTest, FunctionType) {
   OK(Read<FunctionType>, FunctionType{{}, {}}, "\x00\x00"_su8);
   OK(Read<FunctionType>,
@@ -1179,6 +1259,18 @@ TEST_F(BinaryReadTest, FunctionType) {
      "\x02\x7f\x7e\x01\x7c"_su8);
 }
 
+TEST_F(BinaryReadTest, FunctionType_AllocationLimit) {
+  const u64 type_size = sizeof(At<ValueType>);
+  ctx.limits.max_allocated_bytes = 2 * type_size;
+
+  Fail(Read<FunctionType>,
+       {{0, "function type"},
+        {3, "result types"},
+        {3, concat("Allocation of ", type_size, " bytes exceeds limit; ",
+                   2 * type_size, " of ", 2 * type_size, " bytes used")}},
+       "\x02\x7f\x7e\x01\x7c"_su8);
+}
+
 TEST_F(BinaryReadTest, FunctionType_PastEnd) {
   Fail(Read<FunctionType>,
        {{0, "function type"},
@@ -1721,6 +1813,19 @@ TEST_F(BinaryReadTest, Instruction_BadMemoryReserved) {
        "\x40\x01"_su8);
 }
 
+TEST_F(BinaryReadTest, Instruction_TooManyNestedBlocks) {
+  ctx.limits.max_block_depth = 1;
+
+  OK(Read<I>, I{At{"\x02"_su8, O::Block}, At{"\x40"_su8, BT_Void}},
+     "\x02\x40"_su8);
+  Fail(Read<I>, {{0, "Too many nested blocks; max is 1"}}, "\x03\x40"_su8);
+
+  // Closing the block allows another to be opened.
+  OK(Read<I>, I{At{"\x0b"_su8, O::End}}, "\x0b"_su8);
+  OK(Read<I>, I{At{"\x03"_su8, O::Loop}, At{"\x40"_su8, BT_Void}},
+     "\x03\x40"_su8);
+}
+
 TEST_F(BinaryReadTest, InstructionList_BlockEnd) {
   OK(Read<InstructionList>,
      InstructionList{
@@ -2998,6 +3103,30 @@ TEST_F(BinaryReadTest, Opcode_Unknown_misc_prefix) {
   FailUnknownOpcode(0xfc, 268435456);
 }
 
+TEST_F(BinaryReadTest, Opcode_FixedFeatures) {
+  namespace encoding = ::wasp::binary::encoding;
+  // The default and all-features sets are decoded with tables built at
+  // compile time. Setting an unused feature bit selects the general decoder,
+  // which must give the same results.
+  const Features::Bits kUnusedBit = Features::Bits{1} << 63;
+  for (auto bits : {kDefaultFeatureBits, kAllFeatureBits}) {
+    Features fixed{bits};
+    Features general{bits | kUnusedBit};
+    for (u32 code = 0; code < 256; ++code) {
+      EXPECT_EQ(encoding::Opcode::IsPrefixByte(code, general),
+                encoding::Opcode::IsPrefixByte(code, fixed));
+      EXPECT_EQ(encoding::Opcode::Decode(code, general),
+                encoding::Opcode::Decode(code, fixed));
+    }
+    for (u8 prefix = 0xfa; prefix != 0; ++prefix) {
+      for (u32 code = 0; code < 512; ++code) {
+        EXPECT_EQ(encoding::Opcode::Decode(prefix, code, general),
+                  encoding::Opcode::Decode(prefix, code, fixed));
+      }
+    }
+  }
+}
+
 TEST_F(BinaryReadTest, Opcode_simd) {
   ctx.features.enable_simd();
 
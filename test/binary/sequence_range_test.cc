@@ -0,0 +1,131 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/sequence_range.h"
+
+#include "gtest/gtest.h"
+#include "test/test_utils.h"
+#include "wasp/base/errors_nop.h"
+#include "wasp/binary/name_section/read.h"
+#include "wasp/binary/read.h"
+#include "wasp/binary/read/read_ctx.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::test;
+
+namespace {
+
+// Four codes, each with no locals and the body `end`.
+const auto kCodes = "\x02\x00\x0b\x02\x00\x0b\x02\x00\x0b\x02\x00\x0b"_su8;
+
+}  // namespace
+
+TEST(BinarySequenceRangeTest, Code) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  LazySequence<Code> seq{kCodes, 4, "code section", ctx};
+
+  auto ranges = SplitSequence(seq, 2);
+  ASSERT_EQ(2u, ranges.size());
+  EXPECT_EQ(kCodes.subspan(0, 6), ranges[0].data);
+  EXPECT_EQ(0u, ranges[0].first_index);
+  EXPECT_EQ(2u, ranges[0].count);
+  EXPECT_EQ(kCodes.subspan(6), ranges[1].data);
+  EXPECT_EQ(2u, ranges[1].first_index);
+  EXPECT_EQ(2u, ranges[1].count);
+
+  // Each range can be read with its own context.
+  for (auto&& range : ranges) {
+    ReadCtx range_ctx{errors};
+    Index count = 0;
+    for (auto&& code : ReadSequenceRange<Code>(range, range_ctx)) {
+      EXPECT_EQ(0u, code->locals.size());
+      count++;
+    }
+    EXPECT_EQ(range.count, count);
+    EXPECT_EQ(range.first_index + range.count, range_ctx.code_count);
+  }
+  ExpectNoErrors(errors);
+}
+
+TEST(BinarySequenceRangeTest, MoreRangesThanItems) {
+  ErrorsNop errors;
+  ReadCtx ctx{errors};
+  LazySequence<Code> seq{kCodes, 4, "code section", ctx};
+
+  auto ranges = SplitSequence(seq, 10);
+  ASSERT_EQ(4u, ranges.size());
+  for (Index i = 0; i < 4; ++i) {
+    EXPECT_EQ(i, ranges[i].first_index);
+    EXPECT_EQ(1u, ranges[i].count);
+  }
+}
+
+TEST(BinarySequenceRangeTest, Empty) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  LazySequence<Code> seq{""_su8, 0, "code section", ctx};
+
+  EXPECT_TRUE(SplitSequence(seq, 4).empty());
+  ExpectNoErrors(errors);
+}
+
+TEST(BinarySequenceRangeTest, CountMismatch) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  LazySequence<Code> seq{kCodes, 5, "code section", ctx};
+
+  auto ranges = SplitSequence(seq, 1);
+  ASSERT_EQ(1u, ranges.size());
+  EXPECT_EQ(4u, ranges[0].count);
+  ExpectError({{12, "Expected code section to have count 5, got 4"}}, errors,
+              kCodes);
+}
+
+TEST(BinarySequenceRangeTest, BadLength) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  // The second code's length extends past the end of the data.
+  const auto data = "\x02\x00\x0b\x05\x00\x0b"_su8;
+  LazySequence<Code> seq{data, ctx};
+
+  auto ranges = SplitSequence(seq, 2);
+  ASSERT_EQ(1u, ranges.size());
+  EXPECT_EQ(data.subspan(0, 3), ranges[0].data);
+  EXPECT_EQ(1u, ranges[0].count);
+  EXPECT_TRUE(errors.HasError());
+}
+
+TEST(BinarySequenceRangeTest, NameSubsection) {
+  ErrorsNop errors;
+  ReadCtx ctx{errors};
+  // Two subsections: id 0 with one byte, and id 1 with two bytes.
+  const auto data = "\x00\x01\x00\x01\x02\x00\x00"_su8;
+  LazySequence<NameSubsection> seq{data, ctx};
+
+  auto ranges = SplitSequence(seq, 2);
+  ASSERT_EQ(2u, ranges.size());
+  EXPECT_EQ(data.subspan(0, 3), ranges[0].data);
+  EXPECT_EQ(data.subspan(3), ranges[1].data);
+  EXPECT_EQ(1u, ranges[1].first_index);
+
+  ReadCtx range_ctx{errors};
+  auto seq1 = ReadSequenceRange<NameSubsection>(ranges[1], range_ctx);
+  auto it = seq1.begin();
+  ASSERT_NE(seq1.end(), it);
+  EXPECT_EQ(NameSubsectionId::FunctionNames, (*it)->id);
+}
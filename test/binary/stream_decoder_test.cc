@@ -0,0 +1,369 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/stream_decoder.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/test_utils.h"
+#include "wasp/base/concat.h"
+#include "wasp/base/features.h"
+#include "wasp/binary/formatters.h"
+#include "wasp/binary/lazy_module.h"
+#include "wasp/binary/visitor.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::test;
+
+namespace {
+
+// The same module as in visitor_test.cc.
+const u8 kTestModule[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0e, 0x03, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x60, 0x01, 0x7d, 0x01, 0x7d, 0x60, 0x00, 0x00,
+    0x02, 0x0b, 0x01, 0x03, 0x66, 0x6f, 0x6f, 0x03, 0x62, 0x61, 0x72, 0x00,
+    0x00, 0x03, 0x03, 0x02, 0x01, 0x02, 0x04, 0x05, 0x01, 0x70, 0x01, 0x01,
+    0x02, 0x05, 0x03, 0x01, 0x00, 0x01, 0x06, 0x06, 0x01, 0x7f, 0x00, 0x41,
+    0x01, 0x0b, 0x07, 0x08, 0x01, 0x04, 0x71, 0x75, 0x75, 0x78, 0x00, 0x01,
+    0x08, 0x01, 0x02, 0x09, 0x08, 0x01, 0x00, 0x41, 0x00, 0x0b, 0x02, 0x00,
+    0x01, 0x0a, 0x0c, 0x02, 0x07, 0x00, 0x43, 0x00, 0x00, 0x28, 0x42, 0x0b,
+    0x02, 0x00, 0x0b, 0x0b, 0x0b, 0x01, 0x00, 0x41, 0x02, 0x0b, 0x05, 0x68,
+    0x65, 0x6c, 0x6c, 0x6f,
+};
+
+// Records every callback, without locations, so the callbacks from Visit()
+// and StreamDecoder can be compared.
+struct RecordingVisitor {
+  using Result = visit::Result;
+
+  Result Record(std::string str) {
+    log.push_back(std::move(str));
+    return Result::Ok;
+  }
+
+  template <typename Section>
+  Result RecordSection(string_view name, const Section& sec) {
+    return Record(sec.count ? concat(name, " ", sec.count->value())
+                          : std::string(name));
+  }
+
+  Result BeginModule(LazyModule&) { return Record("BeginModule"); }
+  Result EndModule(LazyModule&) { return Record("EndModule"); }
+  Result OnSection(At<Section> section) {
+    if (section->is_known()) {
+      return Record(concat("OnSection ", section->known()->id));
+    }
+    return Record(concat("OnSection ", section->custom()->name));
+  }
+
+#define WASP_RECORD_SECTION(Name, SectionType, ItemType)      \
+  Result Begin##Name##Section(SectionType sec) {              \
+    return RecordSection("Begin" #Name, sec);                 \
+  }                                                           \
+  Result On##Name(const At<ItemType>& item) {                 \
+    return Record(concat("On" #Name " ", *item));             \
+  }                                                           \
+  Result End##Name##Section(SectionType sec) {                \
+    return RecordSection("End" #Name, sec);                   \
+  }
+
+  WASP_RECORD_SECTION(Type, LazyTypeSection, DefinedType)
+  WASP_RECORD_SECTION(Import, LazyImportSection, Import)
+  WASP_RECORD_SECTION(Function, LazyFunctionSection, Function)
+  WASP_RECORD_SECTION(Table, LazyTableSection, Table)
+  WASP_RECORD_SECTION(Memory, LazyMemorySection, Memory)
+  WASP_RECORD_SECTION(Global, LazyGlobalSection, Global)
+  WASP_RECORD_SECTION(Event, LazyEventSection, Event)
+  WASP_RECORD_SECTION(Export, LazyExportSection, Export)
+  WASP_RECORD_SECTION(Element, LazyElementSection, ElementSegment)
+  WASP_RECORD_SECTION(Data, LazyDataSection, DataSegment)
+
+#undef WASP_RECORD_SECTION
+
+  Result BeginStartSection(StartSection) { return Record("BeginStart"); }
+  Result OnStart(const At<Start>& start) {
+    return Record(concat("OnStart ", *start));
+  }
+  Result EndStartSection(StartSection) { return Record("EndStart"); }
+
+  Result BeginDataCountSection(DataCountSection) {
+    return Record("BeginDataCount");
+  }
+  Result OnDataCount(const At<DataCount>& data_count) {
+    return Record(concat("OnDataCount ", *data_count));
+  }
+  Result EndDataCountSection(DataCountSection) {
+    return Record("EndDataCount");
+  }
+
+  Result BeginCodeSection(LazyCodeSection sec) {
+    RecordSection("BeginCodeSection", sec);
+    return skip_code ? Result::Skip : Result::Ok;
+  }
+  Result BeginCode(const At<Code>& code) {
+    return Record(concat("BeginCode ", code->locals.size()));
+  }
+  Result OnInstruction(const At<Instruction>& instr) {
+    return Record(concat("OnInstruction ", *instr));
+  }
+  Result EndCode(const At<Code>&) { return Record("EndCode"); }
+  Result EndCodeSection(LazyCodeSection sec) {
+    return RecordSection("EndCodeSection", sec);
+  }
+
+  bool skip_code = false;
+  std::vector<std::string> log;
+};
+
+std::vector<std::string> GetMessages(const TestErrors& errors) {
+  std::vector<std::string> result;
+  for (auto&& error_list : errors.errors) {
+    result.push_back(error_list.back().message);
+  }
+  return result;
+}
+
+// Appends `value` as an unsigned LEB128.
+void WriteU32(std::vector<u8>& out, u32 value) {
+  do {
+    u8 byte = value & 0x7f;
+    value >>= 7;
+    out.push_back(value ? byte | 0x80 : byte);
+  } while (value);
+}
+
+void WriteSection(std::vector<u8>& out, u8 id, const std::vector<u8>& data) {
+  out.push_back(id);
+  WriteU32(out, data.size());
+  out.insert(out.end(), data.begin(), data.end());
+}
+
+// A module with `count` functions of type (func (result i32)), each returning
+// its index, and a data segment of `data_size` bytes.
+std::vector<u8> MakeLargeModule(u32 count, u32 data_size) {
+  std::vector<u8> module{0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00};
+  WriteSection(module, 1, {0x01, 0x60, 0x00, 0x01, 0x7f});
+
+  std::vector<u8> functions;
+  WriteU32(functions, count);
+  functions.insert(functions.end(), count, 0x00);
+  WriteSection(module, 3, functions);
+
+  WriteSection(module, 5, {0x01, 0x00, 0x01});
+
+  std::vector<u8> codes;
+  WriteU32(codes, count);
+  for (u32 i = 0; i < count; ++i) {
+    std::vector<u8> body{0x00, 0x41};  // No locals; i32.const.
+    WriteU32(body, i & 0x3f);
+    body.push_back(0x0b);
+    WriteU32(codes, body.size());
+    codes.insert(codes.end(), body.begin(), body.end());
+  }
+  WriteSection(module, 10, codes);
+
+  std::vector<u8> data{0x01, 0x00, 0x41, 0x00, 0x0b};
+  WriteU32(data, data_size);
+  data.insert(data.end(), data_size, 'x');
+  WriteSection(module, 11, data);
+  return module;
+}
+
+class BinaryStreamDecoderTest : public ::testing::Test {
+ protected:
+  // Visits `data` with Visit(), for comparison.
+  std::vector<std::string> VisitAll(SpanU8 data) {
+    RecordingVisitor visitor;
+    visitor.skip_code = skip_code;
+    TestErrors errors;
+    LazyModule module = ReadLazyModule(data, features, errors);
+    visit::Visit(module, visitor);
+    expected_errors = GetMessages(errors);
+    return visitor.log;
+  }
+
+  // Feeds `data` to a StreamDecoder, in chunks whose sizes are chosen by
+  // `next_size`.
+  template <typename F>
+  std::vector<std::string> Stream(SpanU8 data, F&& next_size) {
+    RecordingVisitor visitor;
+    visitor.skip_code = skip_code;
+    TestErrors errors;
+    visit::StreamDecoder decoder{visitor, features, errors};
+    max_buffered_size = 0;
+    while (!data.empty()) {
+      size_t size = std::min<size_t>(next_size(), data.size());
+      EXPECT_EQ(visit::Result::Ok, decoder.Feed(data.first(size)));
+      max_buffered_size = std::max(max_buffered_size, decoder.buffered_size());
+      data = data.subspan(size);
+    }
+    decoder.Finish();
+    stream_errors = GetMessages(errors);
+    return visitor.log;
+  }
+
+  Features features;
+  bool skip_code = false;
+  std::vector<std::string> expected_errors;
+  std::vector<std::string> stream_errors;
+  size_t max_buffered_size = 0;
+};
+
+}  // namespace
+
+TEST_F(BinaryStreamDecoderTest, FixedChunkSizes) {
+  SpanU8 data{kTestModule};
+  auto expected = VisitAll(data);
+  ASSERT_TRUE(expected_errors.empty());
+
+  for (size_t size = 1; size <= data.size(); ++size) {
+    EXPECT_EQ(expected, Stream(data, [&]() { return size; })) << size;
+    EXPECT_TRUE(stream_errors.empty()) << size;
+  }
+}
+
+TEST_F(BinaryStreamDecoderTest, RandomChunkSizes) {
+  auto module = MakeLargeModule(1000, 3000);
+  SpanU8 data{module};
+  auto expected = VisitAll(data);
+  ASSERT_TRUE(expected_errors.empty());
+
+  std::mt19937 rng{0};
+  std::uniform_int_distribution<size_t> dist{1, 64};
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_EQ(expected, Stream(data, [&]() { return dist(rng); }));
+    EXPECT_TRUE(stream_errors.empty());
+  }
+}
+
+TEST_F(BinaryStreamDecoderTest, BufferIsBoundedByLargestItem) {
+  const u32 kDataSize = 1000;
+  auto module = MakeLargeModule(10000, kDataSize);
+  SpanU8 data{module};
+  const size_t kChunkSize = 16;
+  auto expected = VisitAll(data);
+  EXPECT_EQ(expected, Stream(data, [&]() { return kChunkSize; }));
+  EXPECT_TRUE(stream_errors.empty());
+
+  // The data segment is the largest item; everything else is a few bytes.
+  // Since a partial item is only reread once the buffer grows by half, the
+  // buffer may hold up to half an item more than the item itself.
+  EXPECT_LT(max_buffered_size, kDataSize * 3 / 2 + 2 * kChunkSize);
+  EXPECT_LT(max_buffered_size, data.size() / 10);
+}
+
+TEST_F(BinaryStreamDecoderTest, SkipSection) {
+  skip_code = true;
+  auto module = MakeLargeModule(100, 10);
+  SpanU8 data{module};
+  auto expected = VisitAll(data);
+  ASSERT_TRUE(expected_errors.empty());
+  // Skipping the code section still counts its items.
+  EXPECT_EQ(expected, Stream(data, [&]() { return 7; }));
+  EXPECT_TRUE(stream_errors.empty());
+}
+
+TEST_F(BinaryStreamDecoderTest, CustomSection) {
+  std::vector<u8> module{0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00};
+  WriteSection(module, 0, {0x04, 'n', 'a', 'm', 'e', 0x00, 0x01, 0x02});
+  SpanU8 data{module};
+  auto expected = VisitAll(data);
+  EXPECT_EQ(
+      (std::vector<std::string>{"BeginModule", "OnSection name",
+                                "EndModule"}),
+      expected);
+  EXPECT_EQ(expected, Stream(data, [&]() { return 3; }));
+}
+
+TEST_F(BinaryStreamDecoderTest, MalformedItem) {
+  // The second type has a bad form.
+  std::vector<u8> module{0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00};
+  WriteSection(module, 1, {0x02, 0x60, 0x00, 0x00, 0x40, 0x00, 0x00});
+  WriteSection(module, 3, {0x00});
+  SpanU8 data{module};
+  auto expected = VisitAll(data);
+  ASSERT_FALSE(expected_errors.empty());
+  EXPECT_EQ(expected, Stream(data, [&]() { return 2; }));
+  EXPECT_EQ(expected_errors, stream_errors);
+}
+
+TEST_F(BinaryStreamDecoderTest, MalformedItem_ReportedEarly) {
+  // The first type has a bad form, and is followed by the rest of a large
+  // section; it should be reported without waiting for the section.
+  std::vector<u8> types{0x02, 0x60, 0x00, 0x00, 0x40};
+  types.insert(types.end(), 1000, 0x00);
+  std::vector<u8> module{0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00};
+  WriteSection(module, 1, types);
+  SpanU8 data{module};
+  auto expected = VisitAll(data);
+  ASSERT_FALSE(expected_errors.empty());
+  EXPECT_EQ(expected, Stream(data, [&]() { return 16; }));
+  EXPECT_EQ(expected_errors, stream_errors);
+  EXPECT_LT(max_buffered_size, 64u);
+}
+
+TEST_F(BinaryStreamDecoderTest, StreamOffset) {
+  // Records the stream offset of each error, since the locations themselves
+  // are only valid during the call.
+  struct OffsetErrors : Errors {
+    bool HasError() const override { return !offsets.empty(); }
+    void HandlePushContext(Location, string_view) override {}
+    void HandlePopContext() override {}
+    void HandleOnError(Location loc, string_view) override {
+      offsets.push_back(decoder->stream_offset(loc.data()));
+    }
+
+    const StreamDecoderBase* decoder = nullptr;
+    std::vector<size_t> offsets;
+  };
+
+  // The second type has a bad form, at offset 14.
+  std::vector<u8> module{0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00};
+  WriteSection(module, 1, {0x02, 0x60, 0x00, 0x00, 0x40, 0x00, 0x00});
+  SpanU8 data{module};
+  RecordingVisitor visitor;
+  OffsetErrors errors;
+  visit::StreamDecoder decoder{visitor, features, errors};
+  errors.decoder = &decoder;
+  while (!data.empty()) {
+    size_t size = std::min<size_t>(3, data.size());
+    decoder.Feed(data.first(size));
+    data = data.subspan(size);
+  }
+  decoder.Finish();
+  ASSERT_FALSE(errors.offsets.empty());
+  EXPECT_EQ(14u, errors.offsets[0]);
+}
+
+TEST_F(BinaryStreamDecoderTest, Truncated) {
+  SpanU8 data = SpanU8{kTestModule}.first(sizeof(kTestModule) - 3);
+  Stream(data, [&]() { return 5; });
+  ASSERT_EQ(1u, stream_errors.size());
+  EXPECT_EQ("Length extends past end: 11 > 8", stream_errors[0]);
+}
+
+TEST_F(BinaryStreamDecoderTest, BadMagic) {
+  std::vector<u8> module{0x00, 0x61, 0x73, 0x6e, 0x01, 0x00, 0x00, 0x00};
+  SpanU8 data{module};
+  auto expected = VisitAll(data);
+  EXPECT_EQ(expected, Stream(data, [&]() { return 1; }));
+  EXPECT_EQ(expected_errors, stream_errors);
+}
@@ -22,6 +22,8 @@
 #include "gtest/gtest.h"
 #include "test/test_utils.h"
 #include "wasp/base/features.h"
+#include "wasp/binary/compose_visitor.h"
+#include "wasp/binary/formatters.h"
 #include "wasp/binary/lazy_module.h"
 
 using namespace ::wasp;
@@ -110,6 +112,32 @@ struct VisitorMock {
   MOCK_METHOD1(EndDataSection, visit::Result(LazyDataSection));
 };
 
+// Takes a CodeView in BeginCode and EndCode, so no Code is built.
+struct CodeViewVisitor : visit::Visitor {
+  visit::Result BeginCode(const At<CodeView>& code) {
+    begin_codes.push_back(*code);
+    return visit::Result::Ok;
+  }
+
+  visit::Result EndCode(const At<CodeView>& code) {
+    end_codes.push_back(*code);
+    return visit::Result::Ok;
+  }
+
+  std::vector<CodeView> begin_codes;
+  std::vector<CodeView> end_codes;
+};
+
+// Takes a Code in BeginCode, and the default CodeView in EndCode.
+struct CodeVisitor : visit::Visitor {
+  visit::Result BeginCode(const At<Code>& code) {
+    codes.push_back(*code);
+    return visit::Result::Ok;
+  }
+
+  std::vector<Code> codes;
+};
+
 class BinaryVisitorTest : public ::testing::Test {
  protected:
   virtual void SetUp() {}
@@ -282,3 +310,141 @@ TEST_F(BinaryVisitorTest, OkSkipFail) {
 
   EXPECT_EQ(Result::Fail, Visit(v));
 }
+
+TEST_F(BinaryVisitorTest, Compose_AllOk) {
+  using ::testing::_;
+  using ::wasp::binary::visit::Result;
+
+  VisitorMock v2;
+  for (auto* mock : {&v, &v2}) {
+    EXPECT_CALL(*mock, BeginModule(_)).Times(1);
+    EXPECT_CALL(*mock, EndModule(_)).Times(1);
+    EXPECT_CALL(*mock, OnSection(_)).Times(kSectionCount);
+    EXPECT_CALL(*mock, OnType(_)).Times(kTypeCount);
+    EXPECT_CALL(*mock, OnFunction(_)).Times(kFunctionCount);
+    EXPECT_CALL(*mock, BeginCode(_)).Times(kFunctionCount);
+    EXPECT_CALL(*mock, OnInstruction(_)).Times(kInstructionCount);
+    EXPECT_CALL(*mock, EndCode(_)).Times(kFunctionCount);
+    EXPECT_CALL(*mock, OnData(_)).Times(1);
+  }
+
+  auto composed = visit::Compose(v, v2);
+  EXPECT_EQ(Result::Ok, Visit(composed));
+  EXPECT_EQ(Result::Ok, composed.result(0));
+  EXPECT_EQ(Result::Ok, composed.result(1));
+}
+
+TEST_F(BinaryVisitorTest, Compose_SkipIsPerVisitor) {
+  using ::testing::_;
+  using ::testing::Return;
+  using ::wasp::binary::visit::Result;
+
+  VisitorMock v2;
+  // `v` skips the type section and all code; `v2` skips one code.
+  EXPECT_CALL(v, BeginTypeSection(_)).WillOnce(Return(Result::Skip));
+  EXPECT_CALL(v, OnType(_)).Times(0);
+  EXPECT_CALL(v, EndTypeSection(_)).Times(0);
+  EXPECT_CALL(v, BeginCodeSection(_)).WillOnce(Return(Result::Skip));
+  EXPECT_CALL(v, BeginCode(_)).Times(0);
+  EXPECT_CALL(v, OnInstruction(_)).Times(0);
+  EXPECT_CALL(v, EndCodeSection(_)).Times(0);
+  EXPECT_CALL(v, OnData(_)).Times(1);
+
+  EXPECT_CALL(v2, OnType(_)).Times(kTypeCount);
+  EXPECT_CALL(v2, EndTypeSection(_)).Times(1);
+  EXPECT_CALL(v2, BeginCode(_))
+      .Times(kFunctionCount)
+      .WillOnce(Return(Result::Skip))
+      .WillOnce(Return(Result::Ok));
+  // Only the second function's `end` instruction.
+  EXPECT_CALL(v2, OnInstruction(_)).Times(1);
+  EXPECT_CALL(v2, EndCode(_)).Times(1);
+  EXPECT_CALL(v2, EndCodeSection(_)).Times(1);
+  EXPECT_CALL(v2, OnData(_)).Times(1);
+
+  auto composed = visit::Compose(v, v2);
+  EXPECT_EQ(Result::Ok, Visit(composed));
+}
+
+TEST_F(BinaryVisitorTest, Compose_FailIsPerVisitor) {
+  using ::testing::_;
+  using ::testing::Return;
+  using ::wasp::binary::visit::Result;
+
+  VisitorMock v2;
+  // `v` fails on the first type, and receives no more callbacks.
+  EXPECT_CALL(v, BeginModule(_)).Times(1);
+  EXPECT_CALL(v, OnSection(_)).Times(1);
+  EXPECT_CALL(v, OnType(_)).WillOnce(Return(Result::Fail));
+  EXPECT_CALL(v, EndTypeSection(_)).Times(0);
+  EXPECT_CALL(v, BeginImportSection(_)).Times(0);
+  EXPECT_CALL(v, EndModule(_)).Times(0);
+
+  EXPECT_CALL(v2, OnSection(_)).Times(kSectionCount);
+  EXPECT_CALL(v2, OnType(_)).Times(kTypeCount);
+  EXPECT_CALL(v2, OnInstruction(_)).Times(kInstructionCount);
+  EXPECT_CALL(v2, EndModule(_)).Times(1);
+
+  auto composed = visit::Compose(v, v2);
+  EXPECT_EQ(Result::Ok, Visit(composed));
+  EXPECT_EQ(Result::Fail, composed.result(0));
+  EXPECT_EQ(Result::Ok, composed.result(1));
+}
+
+TEST_F(BinaryVisitorTest, Compose_AllFailed) {
+  using ::testing::_;
+  using ::testing::Return;
+  using ::wasp::binary::visit::Result;
+
+  VisitorMock v2;
+  EXPECT_CALL(v, BeginTypeSection(_)).WillOnce(Return(Result::Fail));
+  EXPECT_CALL(v, OnType(_)).Times(0);
+  EXPECT_CALL(v2, BeginTypeSection(_)).WillOnce(Return(Result::Ok));
+  EXPECT_CALL(v2, OnType(_)).WillOnce(Return(Result::Fail));
+  EXPECT_CALL(v2, EndTypeSection(_)).Times(0);
+
+  auto composed = visit::Compose(v, v2);
+  EXPECT_EQ(Result::Fail, Visit(composed));
+  EXPECT_EQ(Result::Fail, composed.result(0));
+  EXPECT_EQ(Result::Fail, composed.result(1));
+}
+
+TEST_F(BinaryVisitorTest, CodeView) {
+  using ::wasp::binary::visit::Result;
+
+  static_assert(visit::BeginCodeTakesView<CodeViewVisitor>::value);
+  static_assert(!visit::BeginCodeTakesView<CodeVisitor>::value);
+  static_assert(visit::EndCodeTakesView<CodeVisitor>::value);
+
+  const std::vector<CodeView> expected{
+      CodeView{"\x00"_su8,
+               At{"\x43\x00\x00\x28\x42\x0b"_su8,
+                  Expression{"\x43\x00\x00\x28\x42\x0b"_su8}}},
+      CodeView{"\x00"_su8, At{"\x0b"_su8, Expression{"\x0b"_su8}}},
+  };
+
+  CodeViewVisitor visitor;
+  EXPECT_EQ(Result::Ok, Visit(visitor));
+  EXPECT_EQ(expected, visitor.begin_codes);
+  EXPECT_EQ(expected, visitor.end_codes);
+  ExpectNoErrors(errors);
+}
+
+TEST_F(BinaryVisitorTest, Compose_CodeViewAndCode) {
+  using ::wasp::binary::visit::Result;
+
+  CodeViewVisitor view_visitor;
+  CodeVisitor code_visitor;
+  auto composed = visit::Compose(view_visitor, code_visitor);
+  EXPECT_EQ(Result::Ok, Visit(composed));
+
+  ASSERT_EQ(2u, view_visitor.begin_codes.size());
+  ASSERT_EQ(2u, code_visitor.codes.size());
+  for (size_t i = 0; i < 2; ++i) {
+    const auto& view = view_visitor.begin_codes[i];
+    const auto& code = code_visitor.codes[i];
+    EXPECT_EQ(view.body, code.body);
+    EXPECT_EQ(LocalsList{}, code.locals);
+  }
+  ExpectNoErrors(errors);
+}
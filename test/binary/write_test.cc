@@ -15,7 +15,10 @@
 //
 
 #include <cmath>
+#include <iterator>
+#include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -45,6 +48,11 @@ void ExpectWrite(SpanU8 expected, const T& value) {
   EXPECT_FALSE(iter.overflow());
   EXPECT_EQ(iter.base(), result.end());
   EXPECT_EQ(expected, SpanU8{result});
+
+  // Writing to a Buffer takes the bulk paths.
+  Buffer appended;
+  binary::Write(value, std::back_inserter(appended));
+  EXPECT_EQ(expected, SpanU8{appended});
 }
 
 }  // namespace
@@ -1317,6 +1325,32 @@ TEST(BinaryWriteTest, Module_Code) {
       module);
 }
 
+TEST(BinaryWriteTest, Module_Code_Parallel) {
+  Module module;
+  module.functions.push_back(Function{Index{0}});
+  for (u32 i = 0; i < 100; ++i) {
+    InstructionList instrs;
+    for (u32 j = 0; j <= i; ++j) {
+      instrs.push_back(Instruction{Opcode::I32Const, s32(i * j)});
+      instrs.push_back(Instruction{Opcode::Drop});
+    }
+    instrs.push_back(Instruction{Opcode::End});
+    module.codes.push_back(
+        UnpackedCode{LocalsList{Locals{i, VT_I32}},
+                     UnpackedExpression{std::move(instrs)}});
+  }
+
+  Buffer expected;
+  binary::Write(module, std::back_inserter(expected));
+  for (u32 thread_count : {1, 2, 3, 8}) {
+    EXPECT_EQ(SpanU8{expected}, SpanU8{WriteModule(module, thread_count)});
+  }
+
+  // An empty module has no code section.
+  EXPECT_EQ("\x00\x61\x73\x6d\x01\x00\x00\x00"_su8,
+            SpanU8{WriteModule(Module{}, 4)});
+}
+
 TEST(BinaryWriteTest, Module_Data) {
   Module module;
   module.data_segments.push_back(DataSegment{"hi"_su8});
@@ -2032,6 +2066,60 @@ TEST(BinaryWriteTest, ValueType_gc) {
   ExpectWrite("\x69\x00\x00"_su8, VT_RTT_0_0);
 }
 
+TEST(BinaryWriteTest, VarIntSize) {
+  EXPECT_EQ(1, VarIntSize(u32{0}));
+  EXPECT_EQ(1, VarIntSize(u32{127}));
+  EXPECT_EQ(2, VarIntSize(u32{128}));
+  EXPECT_EQ(4, VarIntSize(u32{(1 << 28) - 1}));
+  EXPECT_EQ(5, VarIntSize(u32{1 << 28}));
+  EXPECT_EQ(5, VarIntSize(std::numeric_limits<u32>::max()));
+
+  EXPECT_EQ(1, VarIntSize(s32{63}));
+  EXPECT_EQ(2, VarIntSize(s32{64}));
+  EXPECT_EQ(1, VarIntSize(s32{-64}));
+  EXPECT_EQ(2, VarIntSize(s32{-65}));
+  EXPECT_EQ(5, VarIntSize(std::numeric_limits<s32>::min()));
+  EXPECT_EQ(5, VarIntSize(std::numeric_limits<s32>::max()));
+
+  EXPECT_EQ(9, VarIntSize(s64{1} << 55));
+  EXPECT_EQ(10, VarIntSize(s64{1} << 62));
+  EXPECT_EQ(10, VarIntSize(std::numeric_limits<s64>::min()));
+  EXPECT_EQ(10, VarIntSize(std::numeric_limits<s64>::max()));
+}
+
+TEST(BinaryWriteTest, VarInt_Limits) {
+  ExpectWrite("\xff\xff\xff\xff\x0f"_su8, std::numeric_limits<u32>::max());
+  ExpectWrite("\x80\x80\x80\x80\x78"_su8, std::numeric_limits<s32>::min());
+  ExpectWrite("\xff\xff\xff\xff\x07"_su8, std::numeric_limits<s32>::max());
+  ExpectWrite("\x80\x80\x80\x80\x80\x80\x80\x80\x80\x7f"_su8,
+              std::numeric_limits<s64>::min());
+  ExpectWrite("\xff\xff\xff\xff\xff\xff\xff\xff\xff\x00"_su8,
+              std::numeric_limits<s64>::max());
+}
+
+TEST(BinaryWriteTest, WriteIndexVector) {
+  const auto expected =
+      "\x04"  // Count.
+      "\x00"
+      "\x7f"
+      "\x80\x01"
+      "\xff\xff\xff\xff\x0f"_su8;
+  const IndexList input{At{Index{0}}, At{Index{127}}, At{Index{128}},
+                        At{std::numeric_limits<Index>::max()}};
+
+  Buffer output(expected.size());
+  auto iter = WriteIndexVector(
+      input, MakeClampedIterator(output.begin(), output.end()));
+  EXPECT_FALSE(iter.overflow());
+  EXPECT_EQ(iter.base(), output.end());
+  EXPECT_EQ(expected, SpanU8{output});
+
+  Buffer appended{0xaa};
+  WriteIndexVector(input, std::back_inserter(appended));
+  EXPECT_EQ(0xaa, appended[0]);
+  EXPECT_EQ(expected, SpanU8{appended}.subspan(1));
+}
+
 TEST(BinaryWriteTest, WriteVector_u8) {
   const auto expected = "\x05hello"_su8;
   const std::vector<u8> input{{'h', 'e', 'l', 'l', 'o'}};
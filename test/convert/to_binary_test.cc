@@ -20,6 +20,7 @@
 #include "test/binary/constants.h"
 #include "test/text/constants.h"
 #include "wasp/binary/formatters.h"
+#include "wasp/binary/write.h"
 #include "wasp/text/formatters.h"
 
 using namespace ::wasp;
@@ -1377,3 +1378,96 @@ TEST_F(ConvertToBinaryTest, DataCount_BulkMemory) {
                         text::DataItem{text::Text{"\"hello\""_sv, 5}}}}}},
         }});
 }
+
+TEST_F(ConvertToBinaryTest, DesugaredModule) {
+  const text::FunctionDesc desc{nullopt, At{loc2, text::Var{Index{0}}}, {}};
+  const text::Module module{
+      // (func (type 0) (import "m" "n"))
+      text::ModuleItem{At{
+          loc1, text::Function{
+                    desc,
+                    At{loc3, text::InlineImport{
+                                 At{loc4, text::Text{"\"m\""_sv, 1}},
+                                 At{loc5, text::Text{"\"n\""_sv, 1}}}},
+                    {}}}},
+      // (func (type 0) (export "e") nop)
+      text::ModuleItem{At{
+          loc6,
+          text::Function{
+              desc,
+              {},
+              {At{loc7, text::Instruction{At{loc8, Opcode::Nop}}}},
+              {At{loc3, text::InlineExport{
+                            At{loc4, text::Text{"\"e\""_sv, 1}}}}}}}},
+  };
+
+  text::Module copy = module;
+  text::Desugar(copy);
+  auto expected = ToBinary(ctx, copy);
+
+  auto desugared = text::DesugarView(module);
+  EXPECT_EQ(expected, ToBinary(ctx, desugared));
+
+  // The original module is unchanged.
+  EXPECT_EQ(1u, module[1].function()->exports.size());
+}
+
+TEST_F(ConvertToBinaryTest, ToBinaryBytes) {
+  const text::FunctionDesc desc{nullopt, At{loc2, text::Var{Index{0}}}, {}};
+  const text::Module module{
+      // (type (func))
+      text::ModuleItem{At{
+          loc1, text::DefinedType{nullopt, text::BoundFunctionType{{}, {}}}}},
+      // (func (import "m" "n") (type 0))
+      text::ModuleItem{At{
+          loc1, text::Function{
+                    desc,
+                    At{loc3, text::InlineImport{
+                                 At{loc4, text::Text{"\"m\""_sv, 1}},
+                                 At{loc5, text::Text{"\"n\""_sv, 1}}}},
+                    {}}}},
+      // (func (type 0) (local i32 i32 i64) nop)
+      text::ModuleItem{At{
+          loc6, text::Function{
+                    desc,
+                    {At{loc2, text::BoundValueType{nullopt, tt::VT_I32}},
+                     At{loc3, text::BoundValueType{nullopt, tt::VT_I32}},
+                     At{loc4, text::BoundValueType{nullopt, tt::VT_I64}}},
+                    {At{loc7, text::Instruction{At{loc8, Opcode::Nop}}}},
+                    {}}}},
+      // (func (type 0) (export "e") nop)
+      text::ModuleItem{At{
+          loc6,
+          text::Function{
+              desc,
+              {},
+              {At{loc7, text::Instruction{At{loc8, Opcode::Nop}}}},
+              {At{loc3, text::InlineExport{
+                            At{loc4, text::Text{"\"e\""_sv, 1}}}}}}}},
+  };
+
+  auto desugared = text::DesugarView(module);
+  auto binary_module = ToBinary(ctx, desugared);
+  Buffer expected;
+  binary::Write(*binary_module, std::back_inserter(expected));
+
+  EXPECT_EQ(expected, ToBinaryBytes(ctx, desugared));
+
+  // The callbacks see the module without its code, then each code in order.
+  std::vector<At<binary::UnpackedCode>> codes;
+  EncodeCallbacks callbacks;
+  callbacks.on_module = [&](const binary::Module& value) {
+    EXPECT_TRUE(value.codes.empty());
+    EXPECT_EQ(binary_module->functions, value.functions);
+  };
+  callbacks.on_code = [&](u32 thread_index, Index code_index,
+                          const At<binary::UnpackedCode>& value) {
+    EXPECT_EQ(codes.size(), code_index);
+    codes.push_back(value);
+  };
+  EXPECT_EQ(expected, ToBinaryBytes(ctx, desugared, callbacks));
+  EXPECT_EQ(binary_module->codes, codes);
+
+  // The output doesn't depend on the thread count.
+  EXPECT_EQ(expected, ToBinaryBytes(ctx, desugared, {}, 4));
+}
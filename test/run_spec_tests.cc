@@ -16,8 +16,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <utility>
 
 #include "absl/strings/str_format.h"
@@ -25,10 +28,14 @@
 #include "src/tools/argparser.h"
 #include "src/tools/binary_errors.h"
 #include "src/tools/text_errors.h"
+#include "wasp/base/arena.h"
 #include "wasp/base/enumerate.h"
 #include "wasp/base/error.h"
+#include "wasp/base/errors_nop.h"
 #include "wasp/base/features.h"
 #include "wasp/base/file.h"
+#include "wasp/base/parallel.h"
+#include "wasp/base/str_to_u32.h"
 #include "wasp/binary/lazy_expression.h"
 #include "wasp/binary/lazy_module.h"
 #include "wasp/binary/visitor.h"
@@ -48,6 +55,9 @@ using absl::StrFormat;
 using namespace ::wasp;
 namespace fs = std::filesystem;
 
+using Clock = std::chrono::steady_clock;
+using Duration = std::chrono::duration<double, std::milli>;
+
 static int s_verbose = 0;
 
 struct DirectoryInfo {
@@ -68,6 +78,32 @@ const std::vector<DirectoryInfo> directory_info_map = {
     {"threads", true, Features::Threads},
 };
 
+// Per-thread state, reused for every command run on that thread.
+struct Worker {
+  auto GetValidCtx(const Features&, Errors&) -> valid::ValidCtx&;
+
+  ErrorsNop errors_nop;
+  valid::ValidCtx valid_ctx{errors_nop};
+};
+
+// The results of running a single command. These are buffered so they can be
+// reported in order, regardless of which thread ran the command.
+struct CommandResult {
+  explicit CommandResult(string_view filename, SpanU8 data)
+      : errors{filename, data} {}
+
+  tools::TextErrors errors;
+  std::string output;
+  Duration time{0};
+};
+
+// Everything needed to run one command; each thread has its own.
+struct CommandCtx {
+  Worker& worker;
+  CommandResult& result;
+  int assertion_index;
+};
+
 class Tool {
  public:
   explicit Tool(string_view filename, SpanU8 data, const Features& features)
@@ -76,37 +112,75 @@ class Tool {
         features{features},
         errors{filename, data} {}
 
-  void Run();
+  bool Parse();
+  auto command_count() const -> size_t;
+  void RunCommand(size_t index, Worker&);
+  void PrintTo(std::ostream& out, std::ostream& err) const;
+  auto time() const -> Duration;
 
  private:
-  void OnCommand(At<text::Command>&);
-  void OnScriptModuleCommand(const text::ScriptModule&);
-  void OnAssertionCommand(text::Assertion&);
-  void OnAssertMalformedText(Location, string_view filename, const Buffer&);
-  void OnAssertMalformedBinary(Location, string_view filename, const Buffer&);
-  void OnAssertInvalid(Location, const text::Module&);
-  void OnAssertInvalidBinary(Location, string_view filename, const Buffer&);
+  void OnCommand(CommandCtx&, At<text::Command>&);
+  void OnScriptModuleCommand(CommandCtx&, const text::ScriptModule&);
+  void OnAssertionCommand(CommandCtx&, text::Assertion&);
+  void OnAssertMalformedText(CommandCtx&,
+                             Location,
+                             string_view filename,
+                             const Buffer&);
+  void OnAssertMalformedBinary(CommandCtx&,
+                               Location,
+                               string_view filename,
+                               const Buffer&);
+  void OnAssertInvalid(CommandCtx&, Location, const text::Module&);
+  void OnAssertInvalidBinary(CommandCtx&,
+                             Location,
+                             string_view filename,
+                             const Buffer&);
 
   std::string filename;
   SpanU8 data;
   Features features;
   tools::TextErrors errors;
-  int assertion_count = 0;
+  Arena arena;  // Holds the script, so it must be declared first.
+  optional<text::Script> script;
+  Duration parse_time{0};
+
+  // The index used to name each assertion's nested module, numbered in
+  // command order.
+  std::vector<int> assertion_indexes;
+  std::vector<std::unique_ptr<CommandResult>> results;
+};
+
+// A single .wast file, and everything needed to run it.
+struct Job {
+  fs::path path;
+  Features features;
+  bool enabled = true;
+  optional<Buffer> data;
+  std::unique_ptr<Tool> tool;
 };
 
-void DoFile(const fs::path&, const Features&);
+void PrepareJob(Job&);
+void ReportJob(const Job&, bool timing);
+void ReportSlowest(const std::vector<Job>&);
 
 int main(int argc, char** argv) {
   std::vector<string_view> args(argc - 1);
   std::copy(&argv[1], &argv[argc], args.begin());
 
   std::vector<string_view> filenames;
+  u32 jobs = 1;
+  bool timing = false;
 
   tools::ArgParser parser{"run_spec_tests"};
   parser
       .Add('h', "--help", "print help and exit",
            [&]() { parser.PrintHelpAndExit(0); })
       .Add('v', "--verbose", "verbose output", [&]() { s_verbose++; })
+      .Add('j', "--jobs", "<int>",
+           "number of threads to use (0 means all cores, default 1)",
+           [&](string_view arg) { jobs = StrToU32(arg).value_or(1); })
+      .Add('t', "--timing", "print the time taken by each file",
+           [&]() { timing = true; })
       .Add("<filename>", "filename",
            [&](string_view arg) { filenames.push_back(arg); });
   parser.Parse(args);
@@ -131,81 +205,200 @@ int main(int argc, char** argv) {
   }
 
   std::sort(sources.begin(), sources.end());
-  for (auto& source : sources) {
-    Features features;
-    bool enabled = true;
+  std::vector<Job> all_jobs(sources.size());
+  for (auto&& [i, source] : enumerate(sources)) {
+    Job& job = all_jobs[i];
+    job.path = source;
     for (auto&& info : directory_info_map) {
       if (source.string().find(info.directory) != std::string::npos) {
-        enabled = info.enabled;
-        features = Features{info.feature_bits};
+        job.enabled = info.enabled;
+        job.features = Features{info.feature_bits};
         break;
       }
     }
 
-    if (!enabled) {
-      if (s_verbose) {
-        PrintF("Skipping %s.\n", source.string());
+    // TODO: Merge these defaults into features.def, since they're now merged
+    // to the upstream spec.
+    job.features.enable_mutable_globals();
+    job.features.enable_multi_value();
+    job.features.enable_saturating_float_to_int();
+    job.features.enable_sign_extension();
+  }
+
+  const u32 thread_count = GetThreadCount(jobs);
+
+  // Read and parse every file.
+  ParallelFor(all_jobs.size(), thread_count,
+              [&](u32, size_t i) { PrepareJob(all_jobs[i]); });
+
+  // Then run every command of every file, so large files are split across
+  // threads too.
+  std::vector<std::pair<Tool*, size_t>> commands;
+  for (auto& job : all_jobs) {
+    if (job.tool) {
+      for (size_t i = 0; i < job.tool->command_count(); ++i) {
+        commands.emplace_back(job.tool.get(), i);
       }
-      continue;
     }
+  }
 
-    // TODO: Merge these defaults into features.def, since they're now merged
-    // to the upstream spec.
-    features.enable_mutable_globals();
-    features.enable_multi_value();
-    features.enable_saturating_float_to_int();
-    features.enable_sign_extension();
+  std::vector<Worker> workers(thread_count);
+  ParallelFor(commands.size(), thread_count, [&](u32 thread_index, size_t i) {
+    auto [tool, index] = commands[i];
+    tool->RunCommand(index, workers[thread_index]);
+  });
+
+  for (auto& job : all_jobs) {
+    ReportJob(job, timing);
+  }
+  if (timing) {
+    ReportSlowest(all_jobs);
+  }
+}
+
+void PrepareJob(Job& job) {
+  if (!job.enabled) {
+    return;
+  }
 
-    DoFile(source, features);
+  std::string filename = job.path.string();
+  job.data = ReadFile(filename);
+  if (!job.data) {
+    return;
   }
+
+  job.tool = std::make_unique<Tool>(filename, *job.data, job.features);
+  job.tool->Parse();
 }
 
-void DoFile(const fs::path& path, const Features& features) {
+void ReportJob(const Job& job, bool timing) {
+  if (!job.enabled) {
+    if (s_verbose) {
+      PrintF("Skipping %s.\n", job.path.string());
+    }
+    return;
+  }
+
   if (s_verbose) {
-    PrintF("Reading %s...\n", path.string());
+    PrintF("Reading %s...\n", job.path.string());
   }
 
-  std::string filename = path.string();
-  auto data = ReadFile(filename);
-  if (!data) {
-    Format(&std::cerr, "Error reading file %s", path.filename().string());
+  if (!job.data) {
+    Format(&std::cerr, "Error reading file %s", job.path.filename().string());
     return;
   }
 
-  Tool tool{filename, *data, features};
-  tool.Run();
+  job.tool->PrintTo(std::cout, std::cerr);
+  if (timing) {
+    PrintF("%10.2fms %s\n", job.tool->time().count(), job.path.string());
+  }
+}
+
+void ReportSlowest(const std::vector<Job>& all_jobs) {
+  const size_t kMaxSlowest = 10;
+
+  std::vector<const Job*> sorted;
+  Duration total{0};
+  for (auto& job : all_jobs) {
+    if (job.tool) {
+      sorted.push_back(&job);
+      total += job.tool->time();
+    }
+  }
+
+  auto count = std::min(kMaxSlowest, sorted.size());
+  std::partial_sort(sorted.begin(), sorted.begin() + count, sorted.end(),
+                    [](const Job* lhs, const Job* rhs) {
+                      return lhs->tool->time() > rhs->tool->time();
+                    });
+
+  PrintF("Slowest files:\n");
+  for (size_t i = 0; i < count; ++i) {
+    PrintF("%10.2fms %s\n", sorted[i]->tool->time().count(),
+           sorted[i]->path.string());
+  }
+  PrintF("%10.2fms total\n", total.count());
+}
+
+auto Worker::GetValidCtx(const Features& features, Errors& errors)
+    -> valid::ValidCtx& {
+  valid_ctx.features = features;
+  valid_ctx.errors = &errors;
+  valid_ctx.Reset();
+  return valid_ctx;
 }
 
-void Tool::Run() {
+bool Tool::Parse() {
+  auto start = Clock::now();
   text::Tokenizer tokenizer{data};
   text::ReadCtx ctx{features, errors};
-  auto script = ReadScript(tokenizer, ctx);
+  ctx.arena = &arena;
+  script = ReadScript(tokenizer, ctx);
   if (script) {
     Resolve(*script, errors);
   }
+  parse_time = Clock::now() - start;
 
   if (!script || errors.HasError()) {
-    errors.PrintTo(std::cerr);
-    return;
+    script.reset();
+    return false;
   }
 
+  int assertion_count = 0;
   for (auto&& command : *script) {
-    OnCommand(command);
+    assertion_indexes.push_back(assertion_count);
+    if (command->kind() == text::CommandKind::Assertion) {
+      auto&& assertion = command->assertion();
+      if ((assertion.kind == text::AssertionKind::Malformed ||
+           assertion.kind == text::AssertionKind::Invalid) &&
+          get<text::ModuleAssertion>(assertion.desc)
+              .module->has_text_list()) {
+        assertion_count++;
+      }
+    }
+    results.push_back(std::make_unique<CommandResult>(filename, data));
   }
+  return true;
+}
+
+auto Tool::command_count() const -> size_t {
+  return results.size();
+}
+
+void Tool::RunCommand(size_t index, Worker& worker) {
+  auto start = Clock::now();
+  CommandCtx ctx{worker, *results[index], assertion_indexes[index]};
+  OnCommand(ctx, (*script)[index]);
+  ctx.result.time = Clock::now() - start;
+}
 
-  if (errors.HasError()) {
-    errors.PrintTo(std::cerr);
+void Tool::PrintTo(std::ostream& out, std::ostream& err) const {
+  for (auto& result : results) {
+    out << result->output;
+  }
+
+  errors.PrintTo(err);
+  for (auto& result : results) {
+    result->errors.PrintTo(err);
   }
 }
 
-void Tool::OnCommand(At<text::Command>& command) {
+auto Tool::time() const -> Duration {
+  Duration total = parse_time;
+  for (auto& result : results) {
+    total += result->time;
+  }
+  return total;
+}
+
+void Tool::OnCommand(CommandCtx& ctx, At<text::Command>& command) {
   switch (command->kind()) {
     case text::CommandKind::ScriptModule:
-      OnScriptModuleCommand(command->script_module());
+      OnScriptModuleCommand(ctx, command->script_module());
       break;
 
     case text::CommandKind::Assertion:
-      OnAssertionCommand(command->assertion());
+      OnAssertionCommand(ctx, command->assertion());
       break;
 
     default:
@@ -213,18 +406,18 @@ void Tool::OnCommand(At<text::Command>& command) {
   }
 }
 
-void Tool::OnScriptModuleCommand(const text::ScriptModule& script_module) {
+void Tool::OnScriptModuleCommand(CommandCtx& ctx,
+                                 const text::ScriptModule& script_module) {
   if (script_module.has_module()) {
-    auto text_module = script_module.module();
-    text::Desugar(text_module);
+    auto desugared = text::DesugarView(script_module.module());
     convert::BinCtx convert_context{features};
-    auto binary_module = convert::ToBinary(convert_context, text_module);
-    valid::ValidCtx valid_context{features, errors};
-    Validate(valid_context, binary_module);
+    auto binary_module = convert::ToBinary(convert_context, desugared);
+    Validate(ctx.worker.GetValidCtx(features, ctx.result.errors),
+             binary_module);
   }
 }
 
-void Tool::OnAssertionCommand(text::Assertion& assertion) {
+void Tool::OnAssertionCommand(CommandCtx& ctx, text::Assertion& assertion) {
   if (assertion.kind != text::AssertionKind::Malformed &&
       assertion.kind != text::AssertionKind::Invalid) {
     return;
@@ -240,95 +433,107 @@ void Tool::OnAssertionCommand(text::Assertion& assertion) {
 
     if (assertion.kind == text::AssertionKind::Malformed) {
       if (script_module->kind == text::ScriptModuleKind::Quote) {
-        OnAssertMalformedText(script_module.loc(),
-                              StrFormat("malformed_%d.wat", assertion_count++),
-                              buffer);
+        OnAssertMalformedText(
+            ctx, script_module.loc(),
+            StrFormat("malformed_%d.wat", ctx.assertion_index), buffer);
       } else {
         OnAssertMalformedBinary(
-            script_module.loc(),
-            StrFormat("malformed_%d.wasm", assertion_count++), buffer);
+            ctx, script_module.loc(),
+            StrFormat("malformed_%d.wasm", ctx.assertion_index), buffer);
       }
     } else if (assertion.kind == text::AssertionKind::Invalid) {
       if (script_module->kind == text::ScriptModuleKind::Binary) {
-        OnAssertInvalidBinary(script_module.loc(),
-                              StrFormat("malformed_%d.wasm", assertion_count++),
-                              buffer);
+        OnAssertInvalidBinary(
+            ctx, script_module.loc(),
+            StrFormat("malformed_%d.wasm", ctx.assertion_index), buffer);
       } else {
-        errors.OnError(script_module.loc(), "assert_invalid with quote?");
+        ctx.result.errors.OnError(script_module.loc(),
+                                  "assert_invalid with quote?");
       }
     }
   } else if (script_module->has_module()) {
-    OnAssertInvalid(script_module.loc(), script_module->module());
+    OnAssertInvalid(ctx, script_module.loc(), script_module->module());
   }
 }
 
-void Tool::OnAssertMalformedText(Location loc,
+void Tool::OnAssertMalformedText(CommandCtx& ctx,
+                                 Location loc,
                                  string_view filename,
                                  const Buffer& buffer) {
   text::Tokenizer tokenizer{buffer};
   tools::TextErrors nested_errors{filename, buffer};
-  text::ReadCtx ctx{features, nested_errors};
-  auto script = ReadScript(tokenizer, ctx);
+  text::ReadCtx read_ctx{features, nested_errors};
+  auto script = ReadScript(tokenizer, read_ctx);
   if (script) {
     Resolve(*script, nested_errors);
   }
   if (!nested_errors.HasError()) {
-    errors.OnError(loc, "Expected malformed text module.");
+    ctx.result.errors.OnError(loc, "Expected malformed text module.");
   }
   if (s_verbose > 1) {
-    nested_errors.PrintTo(std::cout);
+    std::ostringstream out;
+    nested_errors.PrintTo(out);
+    ctx.result.output += out.str();
   }
 }
 
-void Tool::OnAssertMalformedBinary(Location loc,
-                                 string_view filename,
-                                 const Buffer& buffer) {
+void Tool::OnAssertMalformedBinary(CommandCtx& ctx,
+                                   Location loc,
+                                   string_view filename,
+                                   const Buffer& buffer) {
   tools::BinaryErrors nested_errors{filename, buffer};
   binary::LazyModule module =
       binary::ReadLazyModule(buffer, features, nested_errors);
   binary::visit::Visitor visitor;
   binary::visit::Visit(module, visitor);
   if (!nested_errors.HasError()) {
-    errors.OnError(loc, "Expected malformed binary module.");
+    ctx.result.errors.OnError(loc, "Expected malformed binary module.");
   }
   if (s_verbose > 1) {
-    nested_errors.PrintTo(std::cout);
+    std::ostringstream out;
+    nested_errors.PrintTo(out);
+    ctx.result.output += out.str();
   }
 }
 
-void Tool::OnAssertInvalid(Location loc, const text::Module& orig_text_module) {
+void Tool::OnAssertInvalid(CommandCtx& ctx,
+                           Location loc,
+                           const text::Module& text_module) {
   tools::TextErrors nested_errors{filename, data};
-  // TODO: Have to copy since Desugar modifies the module in-place. Should we
-  // have a version that returns a new Module too?
-  text::Module text_module = orig_text_module;
-  text::Desugar(text_module);
+  auto desugared = text::DesugarView(text_module);
   convert::BinCtx convert_context;
-  auto binary_module = convert::ToBinary(convert_context, text_module);
-  valid::ValidCtx valid_context{features, nested_errors};
-  bool result = Validate(valid_context, binary_module);
-  if (result || !nested_errors.HasError()) {
-    errors.OnError(loc, "Expected invalid module.");
+  auto binary_module = convert::ToBinary(convert_context, desugared);
+  bool valid = Validate(ctx.worker.GetValidCtx(features, nested_errors),
+                        binary_module);
+  if (valid || !nested_errors.HasError()) {
+    ctx.result.errors.OnError(loc, "Expected invalid module.");
   }
   if (s_verbose > 1) {
-    nested_errors.PrintTo(std::cout);
+    std::ostringstream out;
+    nested_errors.PrintTo(out);
+    ctx.result.output += out.str();
   }
 }
 
-void Tool::OnAssertInvalidBinary(Location loc,
+void Tool::OnAssertInvalidBinary(CommandCtx& ctx,
+                                 Location loc,
                                  string_view filename,
                                  const Buffer& buffer) {
   tools::BinaryErrors nested_errors{filename, buffer};
   binary::ReadCtx read_context{features, nested_errors};
   auto binary_module = binary::ReadModule(buffer, read_context);
   if (!binary_module.has_value() || nested_errors.HasError()) {
-    errors.OnError(loc, "Expected invalid binary module, not malformed.");
+    ctx.result.errors.OnError(loc,
+                              "Expected invalid binary module, not malformed.");
     return;
   }
-  valid::ValidCtx valid_context{features, nested_errors};
-  if (Validate(valid_context, *binary_module)) {
-    errors.OnError(loc, "Expected invalid binary module.");
+  if (Validate(ctx.worker.GetValidCtx(features, nested_errors),
+               *binary_module)) {
+    ctx.result.errors.OnError(loc, "Expected invalid binary module.");
   }
   if (s_verbose > 1) {
-    nested_errors.PrintTo(std::cout);
+    std::ostringstream out;
+    nested_errors.PrintTo(out);
+    ctx.result.output += out.str();
   }
 }
@@ -58,6 +58,19 @@ class TextDesugarTest : public ::testing::Test {
     Module copy = before;
     Desugar(copy);
     EXPECT_EQ(after, copy);
+
+    auto view = DesugarView(before);
+    ASSERT_EQ(after.size(), view.size());
+    for (size_t i = 0; i < after.size(); ++i) {
+      const ModuleItem& item = view[i];
+      if (&item >= before.data() && &item < before.data() + before.size()) {
+        // Items shared with the original module still have their inline
+        // exports, etc., so only the kind can be compared.
+        EXPECT_EQ(after[i].kind(), item.kind());
+      } else {
+        EXPECT_EQ(after[i], item);
+      }
+    }
   }
 };
 
@@ -144,6 +144,12 @@ TEST(LexTest, Reserved) {
   ExpectLex({8, TT::Reserved}, "23skidoo"_su8);
   ExpectLex({8, TT::Reserved}, "i32.addd"_su8);
   ExpectLex({5, TT::Reserved}, "32.5x"_su8);
+  ExpectLex({4, TT::Reserved}, "nanx"_su8);
+  ExpectLex({6, TT::Reserved}, "nan:0x"_su8);
+  ExpectLex({7, TT::Reserved}, "nan:0xz"_su8);
+  ExpectLex({5, TT::Reserved}, "-infx"_su8);
+  ExpectLex({40, TT::Reserved},
+            "i32.add_with_a_name_longer_than_any_word"_su8);
 }
 
 TEST(LexTest, Whitespace) {
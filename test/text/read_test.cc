@@ -19,6 +19,7 @@
 #include "gtest/gtest.h"
 #include "test/test_utils.h"
 #include "test/text/constants.h"
+#include "wasp/base/arena.h"
 #include "wasp/base/errors.h"
 #include "wasp/text/formatters.h"
 #include "wasp/text/read/macros.h"
@@ -3137,6 +3138,23 @@ TEST_F(TextReadTest, Module_MultipleStart) {
        "(start 0) (start 0)"_su8);
 }
 
+TEST_F(TextReadTest, Module_Arena) {
+  Arena arena;
+  ctx.arena = &arena;
+  auto span = "(func (local i32) nop)"_su8;
+  Tokenizer tokenizer{span};
+  auto module = ReadModule(tokenizer, ctx);
+  ASSERT_TRUE(module.has_value());
+  ExpectNoErrors(errors);
+
+  auto& function = module->at(0).function();
+  EXPECT_EQ(&arena, GetArena(module->data()));
+  EXPECT_EQ(&arena, GetArena(function->locals.data()));
+  EXPECT_EQ(&arena, GetArena(function->instructions.data()));
+  // The arena is only installed while reading.
+  EXPECT_EQ(nullptr, Arena::current());
+}
+
 TEST_F(TextReadTest, SingleModule) {
   // Can be optionally wrapped in (module).
   OK(ReadSingleModule, Module{}, "(module)"_su8);
@@ -16,13 +16,17 @@
 
 #include "wasp/text/resolve.h"
 
+#include <string>
+
 #include "gtest/gtest.h"
 #include "test/test_utils.h"
 #include "test/text/constants.h"
 #include "wasp/base/errors.h"
 #include "wasp/text/formatters.h"
 #include "wasp/text/read/name_map.h"
+#include "wasp/text/read.h"
 #include "wasp/text/read/read_ctx.h"
+#include "wasp/text/read/tokenizer.h"
 #include "wasp/text/resolve_ctx.h"
 
 using namespace ::wasp;
@@ -1685,3 +1689,58 @@ TEST_F(TextResolveTest, ModuleWithDeferredTypes_AndStruct) {
                               {}}},
       });
 }
+
+TEST_F(TextResolveTest, Module_Parallel) {
+  auto check = [](SpanU8 data) {
+    TestErrors errors;
+    Tokenizer tokenizer{data};
+    ReadCtx read_ctx{errors};
+    read_ctx.features.enable_exceptions();
+    auto module = ReadModule(tokenizer, read_ctx);
+    ASSERT_TRUE(module.has_value());
+    ExpectNoErrors(errors);
+
+    Module serial = *module;
+    TestErrors serial_errors;
+    Resolve(serial, serial_errors);
+
+    Module parallel = *module;
+    TestErrors parallel_errors;
+    Resolve(parallel, parallel_errors, 4);
+
+    EXPECT_EQ(serial, parallel);
+    ASSERT_EQ(3u, serial_errors.errors.size());
+    ASSERT_EQ(serial_errors.errors.size(), parallel_errors.errors.size());
+    for (size_t i = 0; i < serial_errors.errors.size(); ++i) {
+      auto& expected = serial_errors.errors[i].back();
+      auto& actual = parallel_errors.errors[i].back();
+      EXPECT_EQ(expected.loc, actual.loc);
+      EXPECT_EQ(expected.message, actual.message);
+    }
+  };
+
+  // Deferred types are used by function bodies and by the items between
+  // them, and some names are undefined, so the parallel resolve must assign
+  // the same deferred type indexes and report the same errors, in order.
+  auto data =
+      "(type $t (func))\n"
+      "(func $f (param $p i32) (local $l i64)\n"
+      "  (block $b (param i32) (result i64) drop local.get $l)\n"
+      "  drop\n"
+      "  (call_indirect (param f32) (f32.const 0))\n"
+      "  local.get $undefined1)\n"
+      "(event (param f64))\n"
+      "(func (type $t) call $f)\n"
+      "(export \"f\" (func $undefined2))\n"
+      "(func (param f32) (call_indirect (param f32) (local.get 0))\n"
+      "  (call_indirect (param f64) (f64.const 0)) br $undefined3)\n"_su8;
+  check(data);
+
+  // A function can also refer to a deferred type by index; here type 3 is
+  // the deferred type (func (param f32)) from the first call_indirect.
+  std::string with_type_index =
+      std::string{ToStringView(data)} +
+      "(func (call_indirect (type 3) (f32.const 0) (i32.const 0)))\n";
+  check(SpanU8{reinterpret_cast<const u8*>(with_type_index.data()),
+               with_type_index.size()});
+}
@@ -87,3 +87,14 @@ TEST(TextTokenTest, TextToString_HexEscape) {
     EXPECT_EQ(test.expected, test.text.ToString());
   }
 }
+
+TEST(TextTokenTest, AppendToBuffer_Runs) {
+  // Escapes at the start, between runs, and at the end, appended to a buffer
+  // that isn't empty.
+  Text value{R"("\41bc\ndef\\ghi\7a")", 12};
+  Buffer buffer{'x'};
+  value.AppendToBuffer(buffer);
+  EXPECT_EQ("xAbc\ndef\\ghiz"_sv,
+            string_view(reinterpret_cast<const char*>(buffer.data()),
+                        buffer.size()));
+}
@@ -164,3 +164,49 @@ TEST(ValidLocalMapTest, PopToEmpty) {
   locals.Pop();
   ExpectTypes(locals, {});
 }
+
+TEST(ValidLocalMapTest, DenseLimit) {
+  LocalMap locals{4};
+  EXPECT_TRUE(locals.Append(2, VT_I32));
+  EXPECT_TRUE(locals.Append(2, VT_F32));
+  EXPECT_TRUE(locals.is_dense());
+  ExpectTypes(locals, {VT_I32, VT_I32, VT_F32, VT_F32});
+
+  EXPECT_TRUE(locals.Append(1, VT_F32));
+  EXPECT_FALSE(locals.is_dense());
+  ExpectTypes(locals, {VT_I32, VT_I32, VT_F32, VT_F32, VT_F32});
+
+  locals.Reset();
+  EXPECT_TRUE(locals.is_dense());
+  ExpectTypes(locals, {});
+}
+
+TEST(ValidLocalMapTest, DenseLimit_PushPop) {
+  LocalMap locals{5};
+  EXPECT_TRUE(locals.Append(1, VT_I32));
+
+  locals.Push();
+  EXPECT_TRUE(locals.Append({VT_F32, VT_I32}));
+
+  locals.Push();
+  EXPECT_TRUE(locals.Append(1, VT_I32));
+  ExpectTypes(locals, {VT_I32, VT_F32, VT_I32, VT_I32});
+  EXPECT_TRUE(locals.is_dense());
+
+  // The locals are compressed while there are let blocks, and a run isn't
+  // combined with the same type in the enclosing block.
+  EXPECT_TRUE(locals.Append(2, VT_I32));
+  EXPECT_FALSE(locals.is_dense());
+  ExpectTypes(locals, {VT_I32, VT_I32, VT_I32, VT_F32, VT_I32, VT_I32});
+
+  locals.Pop();
+  ExpectTypes(locals, {VT_F32, VT_I32, VT_I32});
+
+  locals.Push();
+  EXPECT_TRUE(locals.Append(1, VT_F64));
+  ExpectTypes(locals, {VT_F64, VT_F32, VT_I32, VT_I32});
+
+  locals.Pop();
+  locals.Pop();
+  ExpectTypes(locals, {VT_I32});
+}
@@ -247,6 +247,14 @@ TEST_F(ValidateInstructionTest, Block_Void) {
   ExpectNoErrors(errors);
 }
 
+TEST_F(ValidateInstructionTest, Block_TooManyNestedBlocks) {
+  ctx.limits.max_block_depth = 2;
+  Ok(I{O::Block, BT_Void});
+  Ok(I{O::Loop, BT_Void});
+  Fail(I{O::Block, BT_Void});
+  ExpectError({"instruction", "Too many nested blocks; max is 2"}, errors);
+}
+
 TEST_F(ValidateInstructionTest, Block_SingleResult) {
   for (const auto& info : all_value_types) {
     Ok(I{O::Block, info.block_type});
@@ -971,6 +979,14 @@ TEST_F(ValidateInstructionTest, BrTable_Void) {
   ExpectNoErrors(errors);
 }
 
+TEST_F(ValidateInstructionTest, BrTable_TooManyTargets) {
+  ctx.limits.max_br_table_targets = 2;
+  Ok(I{O::I32Const, s32{}});
+  Fail(I{O::BrTable, BrTableImmediate{{0, 0, 0}, 0}});
+  ExpectError({"instruction", "Too many br_table targets; max is 2, got 3"},
+              errors);
+}
+
 TEST_F(ValidateInstructionTest, BrTable_MultiDepth_Void) {
   Ok(I{O::Block, BT_Void});  // 3
   Ok(I{O::Block, BT_Void});  // 2
@@ -3107,6 +3123,15 @@ TEST_F(ValidateInstructionTest, Let_Defaultable) {
                 {VT_Ref0}, {});
 }
 
+TEST_F(ValidateInstructionTest, Let_TooManyLocals) {
+  ctx.limits.max_locals = 2;
+  AddLocal(VT_I32);
+  Ok(I{O::I32Const, s32{}});
+  Ok(I{O::I32Const, s32{}});
+  Fail(I{O::Let, LetImmediate{BT_Void, {Locals{2, VT_I32}}}});
+  ExpectError({"instruction", "Too many locals; max is 2, got 3"}, errors);
+}
+
 TEST_F(ValidateInstructionTest, RefEq) {
   TestSignature(I{O::RefEq}, {VT_RefEq, VT_RefEq}, {VT_I32});
 }
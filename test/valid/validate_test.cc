@@ -641,6 +641,17 @@ TEST(ValidateTest, Function_InvalidType) {
   EXPECT_FALSE(Validate(ctx, Function{0}));
 }
 
+TEST(ValidateTest, Function_TooManyFunctions) {
+  TestErrors errors;
+  ValidCtx ctx{errors};
+  ctx.limits.max_functions = 1;
+  ctx.types.push_back(DefinedType{FunctionType{}});
+  ctx.defined_type_count = 1;
+  EXPECT_TRUE(Validate(ctx, Function{0}));
+  EXPECT_FALSE(Validate(ctx, Function{0}));
+  ExpectError({"function", "Too many functions; max is 1"}, errors);
+}
+
 TEST(ValidateTest, FunctionType) {
   const FunctionType tests[] = {
       FunctionType{},
@@ -986,6 +997,15 @@ TEST(ValidateTest, Locals_RefType_IndexOOB) {
   EXPECT_FALSE(Validate(ctx, Locals{1, VT_RefNull0}, RequireDefaultable::Yes));
 }
 
+TEST(ValidateTest, Locals_TooManyLocals) {
+  TestErrors errors;
+  ValidCtx ctx{errors};
+  ctx.limits.max_locals = 3;
+  EXPECT_TRUE(Validate(ctx, Locals{2, VT_I32}, RequireDefaultable::No));
+  EXPECT_FALSE(Validate(ctx, Locals{2, VT_I32}, RequireDefaultable::No));
+  ExpectError({"locals", "Too many locals; max is 3, got 4"}, errors);
+}
+
 TEST(ValidateTest, Memory) {
   const Memory tests[] = {
       Memory{MemoryType{Limits{0}}},
@@ -0,0 +1,201 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/valid/validation_cache.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/test_utils.h"
+#include "wasp/base/features.h"
+#include "wasp/binary/lazy_module.h"
+#include "wasp/binary/visitor.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::valid;
+using namespace ::wasp::test;
+
+namespace {
+
+// A module with a function for each of `bodies`, which are the bytes of each
+// function's instructions; every function has type (func (result i32)).
+std::vector<u8> MakeModule(const std::vector<std::vector<u8>>& bodies) {
+  const u8 count = static_cast<u8>(bodies.size());
+  std::vector<u8> functions{count};
+  functions.resize(count + 1, 0x00);  // Each function has type 0.
+
+  std::vector<u8> codes{count};
+  for (auto&& body : bodies) {
+    codes.push_back(static_cast<u8>(body.size() + 1));
+    codes.push_back(0x00);  // No locals.
+    codes.insert(codes.end(), body.begin(), body.end());
+  }
+
+  const std::vector<u8> sections[] = {
+      {0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00},
+      {0x01, 0x05, 0x01, 0x60, 0x00, 0x01, 0x7f},
+      {0x03, static_cast<u8>(functions.size())},
+      functions,
+      {0x0a, static_cast<u8>(codes.size())},
+      codes,
+  };
+  std::vector<u8> module;
+  for (auto&& section : sections) {
+    module.insert(module.end(), section.begin(), section.end());
+  }
+  return module;
+}
+
+std::vector<u8> Const(u8 value) {
+  return {0x41, value, 0x0b};  // i32.const value; end
+}
+
+class ValidationCacheTest : public ::testing::Test {
+ protected:
+  // Returns the result of Visit, and updates cached and validated.
+  visit::Result Validate(const std::vector<u8>& data) {
+    errors.Clear();
+    CachingValidateVisitor visitor{features, errors, cache};
+    LazyModule module = ReadLazyModule(SpanU8{data}, features, errors);
+    auto result = visit::Visit(module, visitor);
+    cached = visitor.cached_code_count;
+    validated = visitor.validated_code_count;
+    return result;
+  }
+
+  Features features;
+  TestErrors errors;
+  ValidationCache cache;
+  Index cached = 0;
+  Index validated = 0;
+};
+
+}  // namespace
+
+TEST_F(ValidationCacheTest, UnchangedModule) {
+  auto module = MakeModule({Const(1), Const(2), Const(3)});
+  EXPECT_EQ(visit::Result::Ok, Validate(module));
+  ExpectNoErrors(errors);
+  EXPECT_EQ(0u, cached);
+  EXPECT_EQ(3u, validated);
+  // The module and each function body.
+  EXPECT_EQ(4u, cache.size());
+
+  // The whole module is skipped.
+  EXPECT_EQ(visit::Result::Skip, Validate(module));
+  ExpectNoErrors(errors);
+  EXPECT_EQ(0u, cached);
+  EXPECT_EQ(0u, validated);
+}
+
+TEST_F(ValidationCacheTest, ChangedBody) {
+  Validate(MakeModule({Const(1), Const(2), Const(3)}));
+
+  EXPECT_EQ(visit::Result::Ok,
+            Validate(MakeModule({Const(1), Const(5), Const(3)})));
+  ExpectNoErrors(errors);
+  EXPECT_EQ(2u, cached);
+  EXPECT_EQ(1u, validated);
+}
+
+TEST_F(ValidationCacheTest, MovedBody) {
+  Validate(MakeModule({Const(1), Const(2)}));
+
+  // A body is keyed by its index too, since that determines its type.
+  Validate(MakeModule({Const(2), Const(1)}));
+  EXPECT_EQ(0u, cached);
+  EXPECT_EQ(2u, validated);
+}
+
+TEST_F(ValidationCacheTest, ChangedContext) {
+  Validate(MakeModule({Const(1), Const(2)}));
+
+  // Adding a function changes the function section, so no body can be reused.
+  Validate(MakeModule({Const(1), Const(2), Const(3)}));
+  EXPECT_EQ(0u, cached);
+  EXPECT_EQ(3u, validated);
+}
+
+TEST_F(ValidationCacheTest, ChangedFeatures) {
+  auto module = MakeModule({Const(1)});
+  Validate(module);
+
+  features.enable_threads();
+  EXPECT_EQ(visit::Result::Ok, Validate(module));
+  EXPECT_EQ(0u, cached);
+  EXPECT_EQ(1u, validated);
+}
+
+TEST_F(ValidationCacheTest, InvalidIsNotCached) {
+  // The second body is missing its result.
+  auto module = MakeModule({Const(1), {0x0b}});
+  EXPECT_EQ(visit::Result::Fail, Validate(module));
+  EXPECT_TRUE(errors.HasError());
+  // Only the first body was valid.
+  EXPECT_EQ(1u, cache.size());
+
+  EXPECT_EQ(visit::Result::Fail, Validate(module));
+  EXPECT_TRUE(errors.HasError());
+  EXPECT_EQ(1u, cached);
+  EXPECT_EQ(1u, validated);
+}
+
+TEST_F(ValidationCacheTest, ValidAfterInvalidIsCached) {
+  // The first body has an unknown opcode, which doesn't stop the visit.
+  auto module = MakeModule({{0xff, 0x0b}, Const(2)});
+  Validate(module);
+  EXPECT_TRUE(errors.HasError());
+  // Only the second body was valid.
+  EXPECT_EQ(1u, cache.size());
+
+  Validate(module);
+  EXPECT_TRUE(errors.HasError());
+  EXPECT_EQ(1u, cached);
+  EXPECT_EQ(1u, validated);
+}
+
+TEST_F(ValidationCacheTest, SaveAndLoad) {
+  auto module = MakeModule({Const(1), Const(2)});
+  Validate(module);
+  EXPECT_TRUE(cache.modified());
+
+  std::string filename = ::testing::TempDir() + "validation_cache_test.cache";
+  ASSERT_TRUE(cache.Save(filename));
+  EXPECT_FALSE(cache.modified());
+
+  ValidationCache loaded;
+  ASSERT_TRUE(loaded.Load(filename));
+  EXPECT_EQ(cache.size(), loaded.size());
+  EXPECT_FALSE(loaded.modified());
+
+  cache = std::move(loaded);
+  EXPECT_EQ(visit::Result::Skip, Validate(module));
+}
+
+TEST_F(ValidationCacheTest, LoadInvalidFile) {
+  EXPECT_FALSE(cache.Load(::testing::TempDir() + "does-not-exist.cache"));
+
+  std::string filename = ::testing::TempDir() + "validation_cache_bad.cache";
+  {
+    std::ofstream stream{filename};
+    stream << "not a cache";
+  }
+  EXPECT_FALSE(cache.Load(filename));
+  EXPECT_EQ(0u, cache.size());
+}